@@ -33,8 +33,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "ma/module/fileWriter.h"
 #include "ma/util/execution-context.h"
 #include "ma/util/export.h"
+#include "ms/module/trace.h"
 #include "ms/util/version.h"
 #include "util/debug.h"
+#include "util/indexMemory.h"
 
 /// @cond DOXYGEN_SHOW_SYSTEM_INCLUDES
 #include <iostream>
@@ -166,7 +168,17 @@ void generateHelpMessage( ParameterSetManager& rManager, bool bFull = true )
                  "Generate a FMD-index for a Fasta file. 'fasta_file_name' has to be the file-path of the Fasta file "
                  "holding the genome used for index creation. 'output_folder' is the folder-path of the location used "
                  "for index storage. 'index_name' is the name used for identifying the new FMD-Index. In the context "
-                 "of alignments, the genome-name is used for FMD-index selection.",
+                 "of alignments, the genome-name is used for FMD-index selection. Large genomes can be split into "
+                 "several FMD-index shards via the 'Index Shard Size' option (it has to be given before this option).",
+                 "Independent of presettings.",
+                 sIndentDesc );
+    printOption( "Trace",
+                 AlignerParameterBase::NO_SHORT_DEFINED,
+                 "file_name",
+                 "",
+                 "Record the runtime of every module execution. After the alignment, latency histograms of all "
+                 "modules are printed and a Chrome trace is written to 'file_name' (it can be viewed via "
+                 "chrome://tracing or ui.perfetto.dev).",
                  "Independent of presettings.",
                  sIndentDesc );
     for( auto xPair : rManager.pGeneralParameterSet->xpParametersByCategory )
@@ -289,6 +301,8 @@ int main( int argc, char* argv[] )
         return 0;
     } // if
 
+    // output file of the Tracer; empty if tracing is disabled
+    std::string sTraceFileName;
     try
     {
         for( int iI = 1; iI < argc; iI++ )
@@ -305,7 +319,12 @@ int main( int argc, char* argv[] )
             if( sOptionName == "-x" || ParameterSetBase::uniqueParameterName( sOptionName ) == "--index" )
             {
                 std::string sOptionValue = argv[ iI + 1 ];
-                const std::string s = xExecutionContext.xGenomeManager.loadGenome( sOptionValue );
+                auto pGeneral = xExecutionContext.xParameterSetManager.pGeneralParameterSet;
+                // the placement policy applies to all index arrays that are allocated from now on
+                IndexMemory::bHugePages = pGeneral->pbIndexHugePages->get( );
+                IndexMemory::bInterleave = pGeneral->pbInterleaveIndex->get( );
+                const std::string s =
+                    xExecutionContext.xGenomeManager.loadGenome( sOptionValue, pGeneral->pbMapIndex->get( ) );
                 if( !s.empty( ) )
                     throw std::runtime_error( s );
                 iI++; // also ignore the following argument
@@ -329,6 +348,14 @@ int main( int argc, char* argv[] )
                 continue;
             } // if
 
+            if( ParameterSetBase::uniqueParameterName( sOptionName ) == "--trace" )
+            {
+                sTraceFileName = argv[ iI + 1 ];
+                Tracer::enable( );
+                iI++; // also ignore the following argument
+                continue;
+            } // if
+
             if( sOptionName == "-X" || ParameterSetBase::uniqueParameterName( sOptionName ) == "--createindex" )
             {
                 std::string sOptionValue = argv[ iI + 1 ];
@@ -339,7 +366,8 @@ int main( int argc, char* argv[] )
                     fs::path( vsStrings[ 1 ] ), //
                     fs::path( vsStrings[ 0 ] ), //
                     vsStrings[ 2 ], //
-                    []( const std::string s ) { std::cout << s << std::endl; } // lambda
+                    []( const std::string s ) { std::cout << s << std::endl; }, // lambda
+                    xExecutionContext.xParameterSetManager.pGeneralParameterSet->piIndexShardSize->get( ) //
                 );
                 return 0;
             } // if
@@ -414,6 +442,11 @@ int main( int argc, char* argv[] )
                                    } // lambda
         );
         std::cerr << "\rdone.                         " << std::endl;
+        if( !sTraceFileName.empty( ) )
+        {
+            std::cerr << Tracer::summary( );
+            Tracer::writeChromeTrace( sTraceFileName );
+        } // if
     } // try
     catch( std::runtime_error& ex )
     {
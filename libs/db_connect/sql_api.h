@@ -57,10 +57,13 @@ using nlohmann::json;
 #ifdef POSTGRESQL
 
 #define ST_INTERSCTS "ST_Intersects"
+// integer division (in Postgres / of two integers is already an integer division)
+#define INT_DIV "/"
 
 #else /* MySQL */
 
 #define ST_INTERSCTS "MBRIntersects"
+#define INT_DIV "DIV"
 
 #endif
 
@@ -10,6 +10,7 @@
 #include "kswcpp_mem.h"
 #include <algorithm>
 #include <array>
+#include <functional>
 #include <iostream>
 #include <limits>
 #include <stdint.h>
@@ -186,5 +187,9 @@ static inline void kswcpp_dispatch( int qlen, // query length -- TO DO: size_t
                          m, mat, q, e, q2, e2,
 #endif
                          w, zdrop, flag, ez,
-                         rxMemManager ); // dispatch
+                         // std::bind copies its arguments; without std::ref the memory of the manager would not
+                         // be reused across calls
+                         std::ref( rxMemManager ) ); // dispatch
+    // the CIGAR is in ez now; release oversized buffers, so that a huge DP does not pin its memory
+    rxMemManager.shrink( );
 } // inlined static function
\ No newline at end of file
@@ -356,7 +356,7 @@ static inline void kswcpp_inner_core( const int qlen, // query length
     // allocate max. 8GB of array (for larger arrays use hash map instead)
     // use chunks of 1.000 within the hash map in order to minimize buckets (we know that actually used indices occur
     // in sequence)
-    CIGARMemoryManager<TP_DIFF_VEC, 8> xMem;
+    CIGARMemoryManager<TP_DIFF_VEC, 8> xMem( rxMemManager );
 #endif
 
     ksw_reset_extz( ez );
@@ -105,6 +105,13 @@ template <typename T, std::size_t N = 16> class AlignmentAllocator
     }
 };
 
+/* High-water mark of an AlignedMemoryManager in bytes (per buffer).
+ * Larger buffers are freed after the DP that required them (see AlignedMemoryManager::shrink).
+ */
+#ifndef KSWCPP_MAX_KEPT_BYTES
+#define KSWCPP_MAX_KEPT_BYTES ( (size_t)64 * 1024 * 1024 )
+#endif
+
 #ifdef USE_VECTOR
 template <typename SIMD_VEC_TP>
 #endif
@@ -113,16 +120,36 @@ class AlignedMemoryManager
   public:
     uint8_t* pMemMat = NULL;
     uint8_t* pMemMatAligned = NULL;
+    // capacities are in bytes, since the DPs request their memory with different (vector) types
     size_t uiCapacityMemMat = 0;
 
     void* pMemH = NULL;
     size_t uiCapacityMemH = 0;
 
+    void* pMemTraceback = NULL;
+    size_t uiCapacityMemTraceback = 0;
+
+    /* Number of (re-)allocations so far.
+     * Stays constant once the manager has seen the largest DP, if the manager is reused across DPs.
+     */
+    size_t uiNumAllocations = 0;
+
+    static const size_t uiMaxVecAlignment = 64;
+
+    /* Buffers above this capacity are freed by shrink.
+     * Managers live as long as their thread (see DPWorkspace); without the limit, a single huge DP would pin its
+     * matrix and traceback (the traceback can reach gigabytes) for the rest of the run.
+     */
+    size_t uiMaxKeptBytes = KSWCPP_MAX_KEPT_BYTES;
+
     AlignedMemoryManager( )
     {
         //// std::cout << "Make Memory Manager" << std::endl;
     } // default constructor
 
+    // a copy would free the memory of the original
+    AlignedMemoryManager( const AlignedMemoryManager& ) = delete;
+
 #ifdef USE_VECTOR
     std::vector<SIMD_VEC_TP, AlignmentAllocator<SIMD_VEC_TP, sizeof( SIMD_VEC_TP )>> vs_u;
     std::vector<SIMD_VEC_TP, AlignmentAllocator<SIMD_VEC_TP, sizeof( SIMD_VEC_TP )>> vs_v;
@@ -144,19 +171,21 @@ class AlignedMemoryManager
     __mXXXi* reserveMemMatrix( size_t uiRequestedSize )
 #endif
     {
-        if( ( uiRequestedSize > this->uiCapacityMemMat ) || ( this->pMemMat == NULL ) )
+        if( ( uiRequestedSize * sizeof( __mXXXi ) > this->uiCapacityMemMat ) || ( this->pMemMat == NULL ) )
         {
             //// std::cout << "Allocate memory " << uiRequestedSize << " " << this->uiCapacityMemMat <<std::endl;
             if( this->pMemMat != NULL )
                 free( this->pMemMat );
 
-            this->pMemMat = (uint8_t*)malloc( uiRequestedSize * sizeof( __mXXXi ) + sizeof( __mXXXi ) );
-            this->pMemMatAligned = (uint8_t*)( ( ( size_t )( this->pMemMat ) + ( sizeof( __mXXXi ) - 1 ) ) /
-                                               sizeof( __mXXXi ) * sizeof( __mXXXi ) );
+            // align for the widest vector type (the memory is reused for all of them)
+            this->pMemMat = (uint8_t*)malloc( uiRequestedSize * sizeof( __mXXXi ) + uiMaxVecAlignment );
+            this->uiNumAllocations++;
+            this->pMemMatAligned = (uint8_t*)( ( ( size_t )( this->pMemMat ) + ( uiMaxVecAlignment - 1 ) ) /
+                                               uiMaxVecAlignment * uiMaxVecAlignment );
 
             // this->pMemMat = (uint8_t*)aligned_alloc( sizeof(__mXXXi), uiRequestedSize * sizeof( __mXXXi ) );
             // this->pMemMatAligned = this->pMemMat;
-            this->uiCapacityMemMat = uiRequestedSize;
+            this->uiCapacityMemMat = uiRequestedSize * sizeof( __mXXXi );
         } // if
         memset( this->pMemMatAligned, 0, uiRequestedSize * sizeof( __mXXXi ) );
 
@@ -188,18 +217,70 @@ class AlignedMemoryManager
 
     template <typename T_Scoring> T_Scoring* reserveMemH_Vector( size_t uiRequestedSize )
     {
-        if( ( uiRequestedSize > this->uiCapacityMemH ) || ( this->pMemH == NULL ) )
+        if( ( uiRequestedSize * sizeof( T_Scoring ) > this->uiCapacityMemH ) || ( this->pMemH == NULL ) )
         {
             if( this->pMemH != NULL )
                 free( this->pMemH );
 
             this->pMemH = (void*)malloc( uiRequestedSize * sizeof( T_Scoring ) );
-            this->uiCapacityMemH = uiRequestedSize;
+            this->uiCapacityMemH = uiRequestedSize * sizeof( T_Scoring );
+            this->uiNumAllocations++;
         } // if
 
         return (T_Scoring*)( this->pMemH );
     } // method
 
+    /* Delivers uninitialized memory for the traceback (see CIGARMemoryManager).
+     * Allocates on demand.
+     */
+    void* reserveMemTraceback( size_t uiRequestedBytes )
+    {
+        if( ( uiRequestedBytes > this->uiCapacityMemTraceback ) || ( this->pMemTraceback == NULL ) )
+        {
+            if( this->pMemTraceback != NULL )
+                free( this->pMemTraceback );
+
+            this->pMemTraceback = malloc( uiRequestedBytes );
+            this->uiCapacityMemTraceback = uiRequestedBytes;
+            this->uiNumAllocations++;
+        } // if
+
+        return this->pMemTraceback;
+    } // method
+
+    /* Frees all buffers whose capacity exceeds uiMaxKeptBytes.
+     * Called after each DP (see kswcpp_dispatch); smaller buffers are kept for the next DP.
+     */
+    void shrink( )
+    {
+        if( this->uiCapacityMemMat > this->uiMaxKeptBytes )
+        {
+            free( this->pMemMat );
+            this->pMemMat = NULL;
+            this->pMemMatAligned = NULL;
+            this->uiCapacityMemMat = 0;
+        } // if
+        if( this->uiCapacityMemH > this->uiMaxKeptBytes )
+        {
+            free( this->pMemH );
+            this->pMemH = NULL;
+            this->uiCapacityMemH = 0;
+        } // if
+        if( this->uiCapacityMemTraceback > this->uiMaxKeptBytes )
+        {
+            free( this->pMemTraceback );
+            this->pMemTraceback = NULL;
+            this->uiCapacityMemTraceback = 0;
+        } // if
+    } // method
+
+    /* Bytes that are currently held by the manager.
+     */
+    size_t capacity( ) const
+    {
+        return this->uiCapacityMemMat + this->uiCapacityMemH + this->uiCapacityMemTraceback;
+    } // method
+
     ~AlignedMemoryManager( )
     {
         if( this->pMemMat != NULL )
@@ -207,6 +288,9 @@ class AlignedMemoryManager
 
         if( this->pMemH != NULL )
             free( this->pMemH );
+
+        if( this->pMemTraceback != NULL )
+            free( this->pMemTraceback );
     } // destructor
 }; // class
 
@@ -305,7 +389,8 @@ template <typename TP_DIFF_VEC, int64_t CHUNK_SIZE_GB> class CIGARMemoryManager
 {
     // since there are 10 chunks divide final size by 10
     static const int64_t CHUNK_SIZE = ( CHUNK_SIZE_GB * 107374182 ) / sizeof( TP_DIFF_VEC );
-    void* mem2 = nullptr;
+    // the in-memory traceback is owned by the AlignedMemoryManager, so that it is reused across DPs
+    AlignedMemoryManager& rxMemManager;
     TP_DIFF_VEC* p_pstruct = nullptr;
     int64_t iPROffset = 0;
     // eventhough we know the size of the vector in xCache during compiletime
@@ -313,22 +398,20 @@ template <typename TP_DIFF_VEC, int64_t CHUNK_SIZE_GB> class CIGARMemoryManager
     CyclicFileCache<int64_t, std::vector<TP_DIFF_VEC>, 10> xCache;
 
   public:
-    CIGARMemoryManager( )
+    CIGARMemoryManager( AlignedMemoryManager& rxMemManager ) : rxMemManager( rxMemManager )
     {} // constructor
 
     void resize( size_t uiSize )
     {
         if( uiSize * sizeof( TP_DIFF_VEC ) <= uiKswHashTableGbMinSize * 1073741824 )
         {
-            if( p_pstruct != nullptr ) // safety check
-                free( mem2 );
             // std::cout << "allocating " << uiSize * sizeof( TP_DIFF_VEC ) << " / " << uiKswHashTableGbMinSize *
             // 1073741824
             //          << " bytes." << std::endl;
             // std::cout << "that is " << uiSize * sizeof( TP_DIFF_VEC ) / 1073741824.0 << " / " <<
             // uiKswHashTableGbMinSize
             //          << " gigabytes." << std::endl;
-            mem2 = malloc( uiSize * sizeof( TP_DIFF_VEC ) );
+            void* mem2 = rxMemManager.reserveMemTraceback( uiSize * sizeof( TP_DIFF_VEC ) + sizeof( TP_DIFF_VEC ) );
             p_pstruct = (TP_DIFF_VEC*)( ( ( (size_t)mem2 + ( sizeof( TP_DIFF_VEC ) - 1 ) ) / sizeof( TP_DIFF_VEC ) ) *
                                         sizeof( TP_DIFF_VEC ) );
         } // if
@@ -373,12 +456,6 @@ template <typename TP_DIFF_VEC, int64_t CHUNK_SIZE_GB> class CIGARMemoryManager
         else
             return ( (TP_RET_TYPE*)p_pstruct )[ uiIndex ];
     }
-
-    ~CIGARMemoryManager( )
-    {
-        if( p_pstruct != nullptr )
-            free( mem2 );
-    }
 }; // class
 
 //// void ksw_extd2_old( void *km,
@@ -144,6 +144,28 @@ class Alignment : public libMS::Container
 
     Alignment( const Alignment& rOther ) = delete;
 
+    /**
+     * @brief explicit deep copy
+     * @details
+     * The copy constructor is deleted so that alignments are not copied by accident.
+     * Used by the AlignmentCache, which hands out copies, since later modules modify the alignments.
+     */
+    inline std::shared_ptr<Alignment> clone( ) const
+    {
+        auto pRet = std::make_shared<Alignment>( uiBeginOnRef, uiBeginOnQuery, uiEndOnRef, uiEndOnQuery );
+#if DEBUG_LEVEL >= 1
+        pRet->vGapsScatter = vGapsScatter;
+#endif
+        pRet->data = data;
+        pRet->uiLength = uiLength;
+        pRet->iScore = iScore;
+        pRet->fMappingQuality = fMappingQuality;
+        pRet->xStats = xStats;
+        pRet->bSecondary = bSecondary;
+        pRet->bSupplementary = bSupplementary;
+        return pRet;
+    } // method
+
     inline std::string toString( ) const
     {
         std::string sRet = "Alignment Dump: ";
@@ -592,7 +614,6 @@ class Alignment : public libMS::Container
 
     nucSeqIndex getSamPosition( Pack& rPack ) const
     {
-        std::string sRefName = getContig( rPack );
         auto uiRet = rPack.posInSequence( uiBeginOnRef, uiEndOnRef );
         if( rPack.bPositionIsOnReversStrand( uiBeginOnRef ) )
             uiRet += 1;
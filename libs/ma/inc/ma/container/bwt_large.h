@@ -18,7 +18,10 @@
  */
 #include <algorithm>
 #include <array>
+#include <functional>
 #include <memory>
+#include <tuple>
+#include <vector>
 /// @endcond
 
 #ifdef USE_MALLOC_WRAPPERS
@@ -37,8 +40,31 @@ typedef uint64_t bgint_t;
 typedef int64_t sbgint_t;
 
 
+/**
+ * @brief Delivers the text for bwtLarge in byte packed form.
+ * @details
+ * fSource( uiFirstByte, uiNumBytes, pOut ) has to write the bytes [uiFirstByte, uiFirstByte + uiNumBytes) of the
+ * byte packed text to pOut. Each byte holds 4 nucleotides, where the first nucleotide occupies the two highest bits
+ * (the layout of a .pac file). Bytes behind the end of the text must be zero.
+ * bwtLarge requests the text in blocks from back to front.
+ */
+typedef std::function<void( bgint_t, bgint_t, unsigned char* )> PackedTextSource;
+
 /**
  * @brief BWT-Index Construction for large inputs
  */
 std::tuple<bgint_t, bgint_t, std::vector<bgint_t>, std::vector<unsigned int>>
-    DLL_PORT(MA) bwtLarge( const char* pcFileNamePack );
\ No newline at end of file
+    DLL_PORT(MA) bwtLarge( const char* pcFileNamePack );
+
+/**
+ * @brief BWT-Index Construction for large inputs without intermediate file.
+ * @details
+ * Builds the BWT of a text of uiTextLength nucleotides that is delivered by fSource.
+ * The BWT is built incrementally in blocks of uiIncMaxBuildSize nucleotides;
+ * uiNumThreads threads sort the independent buckets of each merge step.
+ * If bVerbose is set, prints a one-line summary (build time and peak RSS) to stderr.
+ */
+std::tuple<bgint_t, bgint_t, std::vector<bgint_t>, std::vector<unsigned int>>
+    DLL_PORT(MA) bwtLarge( bgint_t uiTextLength, const PackedTextSource& fSource, unsigned int uiNumThreads = 1,
+                           bgint_t uiInitialMaxBuildSize = 10000000, bgint_t uiIncMaxBuildSize = 10000000,
+                           bool bVerbose = false );
\ No newline at end of file
@@ -215,7 +215,7 @@ class FMIndex : public SuffixArrayInterface
      */
     uint32_t _aCountTable[ 256 ];
 
-    std::vector<uint32_t> bwt;
+    IndexVector<uint32_t> bwt;
 
     /* Size of the reference sequence that was used for BWT construction.
      * Length of the reference sequence (forward plus reverse strand)
@@ -227,7 +227,35 @@ class FMIndex : public SuffixArrayInterface
 
     /* suffix array
      */
-    std::vector<bwtint_t> sa;
+    IndexVector<bwtint_t> sa;
+
+    /* If the index was loaded with bMapped, bwt and sa stay empty and the memory mapped files are used instead
+     * (see vMapBWT and vMapSuffixArray). The pointers are nullptr if the index is not mapped.
+     * pMappedSaData points to sa[ 1 ] (sa[ 0 ] is not stored) and is not aligned for bwtint_t.
+     */
+    std::shared_ptr<MappedFile> pMappedBwt, pMappedSa;
+    const uint32_t* pMappedBwtData = nullptr;
+    const uint8_t* pMappedSaData = nullptr;
+
+    /* The BWT with injected occurrence counters, regardless whether it is mapped or in bwt.
+     */
+    inline const uint32_t* bwtData( ) const
+    {
+        return pMappedBwtData != nullptr ? pMappedBwtData : bwt.data( );
+    } // method
+
+    /* sa[ uiI ], regardless whether the suffix array is mapped or in sa.
+     */
+    inline bwtint_t saValue( size_t uiI ) const
+    {
+        if( pMappedSaData == nullptr )
+            return sa[ uiI ];
+        if( uiI == 0 )
+            return -1; // special marker value (see vRestoreSuffixArray)
+        bwtint_t iRet;
+        std::memcpy( &iRet, pMappedSaData + ( uiI - 1 ) * sizeof( bwtint_t ), sizeof( bwtint_t ) );
+        return iRet;
+    } // method
 
     /** Core BWT construction for short sequences.
      * Initializes the BWT using the given nucleotide sequence.
@@ -254,7 +282,7 @@ class FMIndex : public SuffixArrayInterface
  * counter. (Note that bwt_t::bwt is not exactly the BWT string and therefore this macro is called
  * bwt_B0 instead of bwt_B.) REMARK: Only correct in the case of OCC_INTERVAL==0x80
  */
-#define bwt_bwt( k ) ( bwt[ ( ( k ) >> 7 << 4 ) + sizeof( bwtint_t ) + ( ( (k)&0x7f ) >> 4 ) ] )
+#define bwt_bwt( k ) ( bwtData( )[ ( ( k ) >> 7 << 4 ) + sizeof( bwtint_t ) + ( ( (k)&0x7f ) >> 4 ) ] )
 #define bwt_B0( k ) ( bwt_bwt( k ) >> ( ( ~(k)&0xf ) << 1 ) & 3 )
 
     /** The function Occ(c, k) is the number of occurrences of character c in the prefix L[1..k].
@@ -283,7 +311,7 @@ class FMIndex : public SuffixArrayInterface
     inline bwtint_t bwt_occ( t_bwtIndex k, ubyte_t c )
     {
         bwtint_t n;
-        uint32_t *p, *end;
+        const uint32_t *p, *end;
 
         if( k == (t_bwtIndex)uiRefSeqLength )
         {
@@ -301,7 +329,7 @@ class FMIndex : public SuffixArrayInterface
 
         /* retrieve Occ at k/OCC_INTERVAL
          */
-        n = ( (bwtint_t*)( p = bwt_occ_intv( k ) ) )[ c ];
+        n = ( (const bwtint_t*)( p = bwt_occ_intv( k ) ) )[ c ];
         p += sizeof( bwtint_t ); // jump to the start of the first BWT cell
 
         /* calculate Occ up to the last k/32
@@ -431,9 +459,9 @@ class FMIndex : public SuffixArrayInterface
      * FIX ME: In the context of the BWT as vector this is not nice at all. (Work with references
      * over here)
      */
-    inline uint32_t* bwt_occ_intv( t_bwtIndex k )
+    inline const uint32_t* bwt_occ_intv( t_bwtIndex k ) const
     {
-        return &bwt[ 0 ] + ( ( k >> 7 ) << 4 ); // (k / 128) * 16  (we take 16, because we need twice the size)
+        return bwtData( ) + ( ( k >> 7 ) << 4 ); // (k / 128) * 16  (we take 16, because we need twice the size)
     } // method
 
     /** k (input) is the position of some nucleotide within the BWT.
@@ -448,7 +476,8 @@ class FMIndex : public SuffixArrayInterface
     )
     {
         uint64_t x; // originally 64 bit, but should work with a 32 bit value as well.
-        uint32_t *p, tmp, *end; // pointer into bwt.
+        const uint32_t *p, *end; // pointer into bwt.
+        uint32_t tmp;
 
         if( k == ( t_bwtIndex )( -1 ) )
         {
@@ -662,6 +691,71 @@ class FMIndex : public SuffixArrayInterface
         } // if
     } // method
 
+    /** Maps the BWT file into memory instead of reading it (same layout as in vRestoreBWT).
+     * The BWT starts behind primary and L2, so it is aligned for uint32_t.
+     */
+    void vMapBWT( const std::string& rsFileName )
+    {
+        auto pMapped = std::make_shared<MappedFile>( rsFileName );
+        const size_t uiHeaderSize = sizeof( primary ) + sizeof( L2[ 0 ] ) * 4;
+        if( pMapped->size( ) < uiHeaderSize )
+        {
+            throw std::runtime_error( "Mapping of BWT of FM index failed: file too small." );
+        } // if
+        std::memcpy( &primary, pMapped->data( ), sizeof( primary ) );
+        std::memcpy( &L2[ 1 ], pMapped->data( ) + sizeof( primary ), sizeof( L2[ 0 ] ) * 4 );
+
+        bwt.clear( );
+        bwt.shrink_to_fit( );
+        pMappedBwtData = (const uint32_t*)( pMapped->data( ) + uiHeaderSize );
+        pMappedBwt = pMapped;
+
+        uiRefSeqLength = L2[ 4 ]; // restore seq_len;
+        L2[ 0 ] = 0; // clean L2[0]
+    } // method
+
+    /** Maps the suffix array file into memory instead of reading it (same layout as in vRestoreSuffixArray).
+     */
+    void vMapSuffixArray( const std::string& rsFileName )
+    {
+        auto pMapped = std::make_shared<MappedFile>( rsFileName );
+        const size_t uiHeaderSize =
+            sizeof( primary ) + sizeof( L2[ 0 ] ) * 4 + sizeof( sa_intv ) + sizeof( uiRefSeqLength );
+        if( pMapped->size( ) < uiHeaderSize )
+        {
+            throw std::runtime_error( "Mapping of suffix array of FM index failed: file too small." );
+        } // if
+        const uint8_t* pHeader = pMapped->data( );
+
+        decltype( primary ) uiPrimaryReferenceValue;
+        std::memcpy( &uiPrimaryReferenceValue, pHeader, sizeof( primary ) );
+        if( primary != uiPrimaryReferenceValue )
+        {
+            throw std::runtime_error( "BWT and suffix array have different primary." );
+        } // if
+        pHeader += sizeof( primary ) + sizeof( L2[ 0 ] ) * 4; // L2 is ignored
+        std::memcpy( &sa_intv, pHeader, sizeof( sa_intv ) );
+        pHeader += sizeof( sa_intv );
+        decltype( uiRefSeqLength ) uiSeqLenReferenceValue;
+        std::memcpy( &uiSeqLenReferenceValue, pHeader, sizeof( uiRefSeqLength ) );
+        if( this->uiRefSeqLength != uiSeqLenReferenceValue )
+        {
+            throw std::runtime_error( "SA-BWT inconsistency: suffix array has non matching sequence length stored." );
+        } // if
+
+        size_t uiExpectedSASize = ( uiRefSeqLength + sa_intv ) / sa_intv;
+        if( pMapped->size( ) < uiHeaderSize + sizeof( bwtint_t ) * ( uiExpectedSASize - 1 ) )
+        {
+            throw std::runtime_error( std::string( "Mapping suffix array failed due to non matching "
+                                                   "expected size." ) );
+        } // if
+
+        sa.clear( );
+        sa.shrink_to_fit( );
+        pMappedSaData = pMapped->data( ) + uiHeaderSize;
+        pMappedSa = pMapped;
+    } // method
+
   public:
     /** Like bwt_occ4, but it computes the counters for two indices simultaneously.
      * If k and l belong to the same internal interval (the FM index has a block structure),
@@ -693,7 +787,8 @@ class FMIndex : public SuffixArrayInterface
            */
             uint64_t x,
                 y; // originally already 64 bit, but should work with a 32 bit value as well.
-            uint32_t *p, tmp, *endk, *endl;
+            const uint32_t *p, *endk, *endl;
+            uint32_t tmp;
 
             /* Adjust k and l, because $ is not in bwt
              */
@@ -805,7 +900,7 @@ class FMIndex : public SuffixArrayInterface
         /* Without setting bwt->sa[0] = -1 in bwt_cal_sa_step3, the following line should be
          * changed to (sa + bwt->sa[k/bwt->sa_intv]) % (bwt->seq_len + 1)
          */
-        auto uiReturnedPosition = sa + this->sa[ uiBWTposition / sa_intv ];
+        auto uiReturnedPosition = sa + saValue( ( size_t )( uiBWTposition / sa_intv ) );
         assert( ( uiReturnedPosition >= 0 ) &&
                 ( uiReturnedPosition <
                   static_cast<bwtint_t>( uiRefSeqLength ) ) ); // Out of range for returned reference position
@@ -826,6 +921,8 @@ class FMIndex : public SuffixArrayInterface
      */
     void vStoreFMIndex_boost( const std::string& rxFileNamePrefix )
     {
+        if( pMappedBwtData != nullptr )
+            throw std::runtime_error( "Cannot store a memory mapped FM index." );
         { /* Save burrow wheeler transform
            */
             std::ofstream xOutputStream( rxFileNamePrefix + ".bwt",
@@ -850,14 +947,23 @@ class FMIndex : public SuffixArrayInterface
     } // function
 
     /** Load an FM-Index previously stored by vStoreFMIndex.
+     * If bMapped is set, the files are mapped into memory read-only instead of being copied.
+     * All processes that map the same index share its memory and the index is available without reading the files
+     * upfront.
      */
-    void vLoadFMIndex_boost( const std::string& rxFileNamePrefix )
+    void vLoadFMIndex_boost( const std::string& rxFileNamePrefix, bool bMapped = false )
     {
         {
             if( !fileExists( rxFileNamePrefix + ".bwt" ) )
             {
                 throw std::runtime_error( "File opening error: " + rxFileNamePrefix + ".bwt" );
             } // if
+            if( bMapped )
+            {
+                vMapBWT( rxFileNamePrefix + ".bwt" );
+                vMapSuffixArray( rxFileNamePrefix + ".sa" );
+                return;
+            } // if
 
             std::ifstream xInputFiletream( rxFileNamePrefix + ".bwt", std::ios::binary | std::ios::in );
             if( xInputFiletream.fail( ) ) // check whether we could successfully open the stream
@@ -883,10 +989,10 @@ class FMIndex : public SuffixArrayInterface
         } // scope
     } // method
 
-    void vLoadFMIndex( std::string sPrefix )
+    void vLoadFMIndex( std::string sPrefix, bool bMapped = false )
     {
         std::string sPath( sPrefix );
-        vLoadFMIndex_boost( sPath );
+        vLoadFMIndex_boost( sPath, bMapped );
     } // function
 
     /* Debug function for comparing BWT.
@@ -949,9 +1055,9 @@ class FMIndex : public SuffixArrayInterface
 
     /* FM-Index constructor. Loads a fm index.
      */
-    FMIndex( const std::string sFileName ) : FMIndex( ) // call the default constructor
+    FMIndex( const std::string sFileName, bool bMapped = false ) : FMIndex( ) // call the default constructor
     {
-        vLoadFMIndex( sFileName );
+        vLoadFMIndex( sFileName, bMapped );
     } // constructor
 
     /* FM-Index constructor. Builds a FM index on foundation of pxSequence.
@@ -48,7 +48,7 @@ class Index : public libMS::Container
         } // destructor
     }; // class
 
-    mm_tbuf_t* mm_tbuf_init( void )
+    static mm_tbuf_t* mm_tbuf_init( void )
     {
         mm_tbuf_t* b;
         b = (mm_tbuf_t*)calloc( 1, sizeof( mm_tbuf_t ) );
@@ -57,7 +57,7 @@ class Index : public libMS::Container
         return b;
     }
 
-    void mm_tbuf_destroy( mm_tbuf_t* b )
+    static void mm_tbuf_destroy( mm_tbuf_t* b )
     {
         if( b == 0 )
             return;
@@ -65,6 +65,51 @@ class Index : public libMS::Container
         free( b );
     }
 
+    /**
+     * @brief per thread seeding context
+     * @details
+     * Holds the minimap thread buffer (and with it the kalloc arena that collect_seeds allocates the minimizer and
+     * seed arrays from), so that the arena is not created and destroyed for every query.
+     * Once the arena has grown beyond uiMaxArenaSize it is recreated (same as minimap's cap_kalloc).
+     */
+    class SeedingBuffer
+    {
+      public:
+        static const size_t uiMaxArenaSize = 1 << 30;
+        mm_tbuf_t* pTBuf;
+
+        SeedingBuffer( ) : pTBuf( mm_tbuf_init( ) )
+        {} // constructor
+
+        SeedingBuffer( const SeedingBuffer& ) = delete;
+
+        ~SeedingBuffer( )
+        {
+            mm_tbuf_destroy( pTBuf );
+        } // destructor
+
+        /// @brief recreates the arena if it became too large
+        void shrink( )
+        {
+            if( pTBuf->km == nullptr )
+                return;
+            km_stat_t xStat;
+            km_stat( pTBuf->km, &xStat );
+            if( xStat.capacity > uiMaxArenaSize )
+            {
+                km_destroy( pTBuf->km );
+                pTBuf->km = km_init( );
+            } // if
+        } // method
+
+        /// @brief the buffer of the calling thread
+        static SeedingBuffer& get( )
+        {
+            thread_local SeedingBuffer xBuffer;
+            return xBuffer;
+        } // method
+    }; // class
+
     void mm_mapopt_init( mm_mapopt_t* opt )
     {
         memset( opt, 0, sizeof( mm_mapopt_t ) );
@@ -204,18 +249,18 @@ class Index : public libMS::Container
     } // method
 
 
-    std::shared_ptr<libMA::Seeds> seed_one( const char* sSeq, const int iSize, bool bRectangular,
-                                            std::shared_ptr<libMA::Pack> pPack,
-                                            void ( *mm_filter )( mm128_t*, size_t&, void* ), void* pFilterArg )
+    /**
+     * @brief turns the minimap seed array a (of length n_a) for a query of size iSize into Seeds.
+     * @details
+     * Frees a (which must have been allocated from the arena km).
+     */
+    static std::shared_ptr<libMA::Seeds> toSeeds( mm128_t* a, int64_t n_a, const int iSize, bool bRectangular,
+                                                  std::shared_ptr<libMA::Pack> pPack, void* km )
     {
         auto pRet = std::make_shared<libMA::Seeds>( );
-        int64_t n_a = 0;
-
-        mm_tbuf_t* tbuf = mm_tbuf_init( );
-        // const char* seqs = (const char*)&pQuery->pxSequenceRef;
-        mm128_t* a = collect_seeds( pData, 1, &iSize, &sSeq, tbuf, &xMapOpt, 0, &n_a, mm_filter, pFilterArg );
         if( a != NULL )
         {
+            pRet->reserve( (size_t)n_a );
             for( int64_t uiI = 0; uiI < n_a; uiI++ )
             {
                 if( ( a[ uiI ].x >> 63 ) == 0 )
@@ -257,11 +302,10 @@ class Index : public libMS::Container
                     assert( !pPack->bPositionIsOnReversStrand( pRet->back( ).start_ref( ) - pRet->back( ).size( ) ) );
                 } // else
             } // for
-            kfree( tbuf->km, a );
+            kfree( km, a );
         } // if
         else if( n_a > 0 )
             throw std::runtime_error( "minimizer vector is empty" );
-        mm_tbuf_destroy( tbuf );
 
         // delta values need to be set in case we want to compute a SoC...
         // @todo this should be done by the SoC module but is done as well in the binary seeding module so i added it
@@ -272,6 +316,101 @@ class Index : public libMS::Container
         return pRet;
     } // method
 
+    std::shared_ptr<libMA::Seeds> seed_one( const char* sSeq, const int iSize, bool bRectangular,
+                                            std::shared_ptr<libMA::Pack> pPack,
+                                            void ( *mm_filter )( mm128_t*, size_t&, void* ), void* pFilterArg )
+    {
+        int64_t n_a = 0;
+
+        SeedingBuffer& rBuffer = SeedingBuffer::get( );
+        mm128_t* a =
+            collect_seeds( pData, 1, &iSize, &sSeq, rBuffer.pTBuf, &xMapOpt, 0, &n_a, mm_filter, pFilterArg );
+        auto pRet = toSeeds( a, n_a, iSize, bRectangular, pPack, rBuffer.pTBuf->km );
+        rBuffer.shrink( );
+        return pRet;
+    } // method
+
+    /**
+     * @brief seeds many queries at once.
+     * @details
+     * All queries are sketched first; then the minimizers of all queries are looked up in one pass that prefetches
+     * the hash table slots of upcoming minimizers. So, the lookups hide the DRAM latency of large indices.
+     * Returns the same seeds as seed_one for each query.
+     */
+    std::vector<std::shared_ptr<libMA::Seeds>> seed_batch( const std::vector<const char*>& vSeqs,
+                                                           const std::vector<int>& vSizes, bool bRectangular,
+                                                           std::shared_ptr<libMA::Pack> pPack,
+                                                           void ( *mm_filter )( mm128_t*, size_t&, void* ),
+                                                           void* pFilterArg )
+    {
+        assert( vSeqs.size( ) == vSizes.size( ) );
+        std::vector<std::shared_ptr<libMA::Seeds>> vRet;
+        vRet.reserve( vSeqs.size( ) );
+
+        SeedingBuffer& rBuffer = SeedingBuffer::get( );
+        auto xConsume = std::make_tuple( &vRet, &vSizes, bRectangular, pPack, rBuffer.pTBuf->km );
+        if( !vSeqs.empty( ) )
+            collect_seeds_batch(
+                pData, (int)vSeqs.size( ), vSizes.data( ), const_cast<const char**>( vSeqs.data( ) ), rBuffer.pTBuf,
+                &xMapOpt, mm_filter, pFilterArg,
+                []( int iId, mm128_t* a, int64_t n_a, void* pArg ) {
+                    auto& rConsume = *(decltype( xConsume )*)pArg;
+                    std::get<0>( rConsume )
+                        ->push_back( toSeeds( a, n_a, ( *std::get<1>( rConsume ) )[ iId ], std::get<2>( rConsume ),
+                                              std::get<3>( rConsume ), std::get<4>( rConsume ) ) );
+                }, // lambda
+                &xConsume );
+        rBuffer.shrink( );
+        return vRet;
+    } // method
+
+    /// @brief seed_batch on the numeric form of the queries (see seed_one)
+    std::vector<std::shared_ptr<libMA::Seeds>> seed_batch( const std::vector<std::shared_ptr<libMA::NucSeq>>& vQueries,
+                                                           bool bRectangular, std::shared_ptr<libMA::Pack> pPack,
+                                                           void ( *mm_filter )( mm128_t*, size_t&, void* ),
+                                                           void* pFilterArg )
+    {
+        std::vector<const char*> vSeqs;
+        std::vector<int> vSizes;
+        vSeqs.reserve( vQueries.size( ) );
+        vSizes.reserve( vQueries.size( ) );
+        for( auto& pQuery : vQueries )
+        {
+            vSeqs.push_back( (const char*)pQuery->pxSequenceRef );
+            vSizes.push_back( (int)pQuery->length( ) );
+        } // for
+        return seed_batch( vSeqs, vSizes, bRectangular, pPack, mm_filter, pFilterArg );
+    } // method
+
+    std::vector<std::shared_ptr<libMA::Seeds>> seed_batch( const std::vector<std::shared_ptr<libMA::NucSeq>>& vQueries,
+                                                           bool bRectangular, std::shared_ptr<libMA::Pack> pPack )
+    {
+        return seed_batch( vQueries, bRectangular, pPack, &mm_filter_none, nullptr );
+    } // method
+
+    /**
+     * @brief seeds the section [uiFrom, uiTo) of rQuery.
+     * @details
+     * Works on the numeric form of the query directly: seq_nt4_table maps 0-3 onto themselves and 4 (N) onto 4.
+     * So, there is no need to translate (and thereby modify) the query or to copy it into a string.
+     * Seed positions on the query are relative to uiFrom.
+     */
+    std::shared_ptr<libMA::Seeds> seed_one( const libMA::NucSeq& rQuery, libMA::nucSeqIndex uiFrom,
+                                            libMA::nucSeqIndex uiTo, bool bRectangular,
+                                            std::shared_ptr<libMA::Pack> pPack,
+                                            void ( *mm_filter )( mm128_t*, size_t&, void* ), void* pFilterArg )
+    {
+        assert( uiFrom <= uiTo && uiTo <= rQuery.length( ) );
+        return seed_one( (const char*)rQuery.pxSequenceRef + uiFrom, (int)( uiTo - uiFrom ), bRectangular, pPack,
+                         mm_filter, pFilterArg );
+    } // method
+
+    std::shared_ptr<libMA::Seeds> seed_one( const libMA::NucSeq& rQuery, bool bRectangular,
+                                            std::shared_ptr<libMA::Pack> pPack )
+    {
+        return seed_one( rQuery, 0, rQuery.length( ), bRectangular, pPack, &mm_filter_none, nullptr );
+    } // method
+
     std::shared_ptr<libMA::Seeds> seed_one( std::string& sQuery, bool bRectangular, std::shared_ptr<libMA::Pack> pPack )
     {
         const char* sSeq = sQuery.c_str( );
@@ -487,12 +626,14 @@ class Index : public libMS::Container
     std::vector<std::shared_ptr<libMA::Seeds>> seed( std::vector<std::string> vQueries, bool bRectangular,
                                                      std::shared_ptr<libMA::Pack> pPack )
     {
-        std::vector<std::shared_ptr<libMA::Seeds>> vRet;
-
+        std::vector<const char*> vSeqs;
+        std::vector<int> vSizes;
         for( auto& sQuery : vQueries )
-            vRet.push_back( seed_one( sQuery, bRectangular, pPack ) );
-
-        return vRet;
+        {
+            vSeqs.push_back( sQuery.c_str( ) );
+            vSizes.push_back( (int)sQuery.size( ) );
+        } // for
+        return seed_batch( vSeqs, vSizes, bRectangular, pPack, &mm_filter_none, nullptr );
     } // method
 
     void setMaxOcc( size_t uiNewMaxOcc )
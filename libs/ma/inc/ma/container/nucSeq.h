@@ -157,6 +157,41 @@ class NucSeq : public libMS::Container
     int64_t iId = -1;
     DEBUG( size_t uiFromLine = 0; ) // DEBUG
 
+    /// @brief id of the FileStream that the read came from (0 = not read by a FileReader)
+    size_t uiStreamId = 0;
+    /// @brief position of the read in its FileStream; used for restoring the read order in the writers
+    uint64_t uiIndexInStream = 0;
+
+    /// @brief number of seeds that the alignment modules processed for this read (see "Seed Budget Per Read")
+    uint64_t uiSeedsProcessed = 0;
+    /// @brief number of DP cells that were computed for this read (see "DP Cell Budget Per Read")
+    uint64_t uiDPCells = 0;
+    /// @brief set once the read exceeds one of its budgets; the read is then reported unmapped
+    bool bOverBudget = false;
+
+    /**
+     * @brief accounts for uiNum seeds that are about to be processed
+     * @details
+     * Returns false if the read exceeds its budget uiBudget (0 = unlimited).
+     * Modules that see false stop working on the read and return empty results.
+     */
+    inline bool spendSeeds( uint64_t uiNum, uint64_t uiBudget )
+    {
+        uiSeedsProcessed += uiNum;
+        if( uiBudget != 0 && uiSeedsProcessed > uiBudget )
+            bOverBudget = true;
+        return !bOverBudget;
+    } // method
+
+    /// @brief same as spendSeeds but for DP cells
+    inline bool spendDPCells( uint64_t uiNum, uint64_t uiBudget )
+    {
+        uiDPCells += uiNum;
+        if( uiBudget != 0 && uiDPCells > uiBudget )
+            bOverBudget = true;
+        return !bOverBudget;
+    } // method
+
 #if WITH_QUALITY
     void addQuality( )
     {
@@ -18,6 +18,8 @@
 #include <cstdint>
 
 #include "ma/container/nucSeq.h"
+#include "util/indexMemory.h"
+#include "util/mappedFile.h"
 
 #ifdef FASTA_READER
 class FastaDescriptor;
@@ -148,7 +150,36 @@ class Pack : public libMS::Container
      * Compressed in 2 bit format. 0 -> A, 1 -> C, 2 -> G, 3 -> T
      * Each byte contains 4 Nucleotides.
      */
-    std::vector<uint8_t> xPackedNucSeqs;
+    IndexVector<uint8_t> xPackedNucSeqs;
+
+    /* If the pack was loaded with bMapped, the packed sequences are not copied into xPackedNucSeqs.
+     * Instead they are read from the memory mapped .pac file, that is shared by all processes using the pack.
+     * pMappedPackedNucSeqs points to the first byte of the mapping (nullptr if the pack is not mapped).
+     */
+    std::shared_ptr<MappedFile> pMappedPack;
+    const uint8_t* pMappedPackedNucSeqs = nullptr;
+    size_t uiMappedPackedNucSeqsSize = 0;
+
+    /* The bytes of the packed sequences, regardless whether they are mapped or in xPackedNucSeqs.
+     */
+    inline const uint8_t* packedNucSeqs( ) const
+    {
+        return pMappedPackedNucSeqs != nullptr ? pMappedPackedNucSeqs : xPackedNucSeqs.data( );
+    } // method
+
+    inline size_t packedNucSeqsSize( ) const
+    {
+        return pMappedPackedNucSeqs != nullptr ? uiMappedPackedNucSeqsSize : xPackedNucSeqs.size( );
+    } // method
+
+    /* Copy of the packed sequences (required for storing a mapped pack).
+     */
+    inline decltype( xPackedNucSeqs ) packedNucSeqsCopy( ) const
+    {
+        if( pMappedPackedNucSeqs == nullptr )
+            return xPackedNucSeqs;
+        return decltype( xPackedNucSeqs )( pMappedPackedNucSeqs, pMappedPackedNucSeqs + uiMappedPackedNucSeqsSize );
+    } // method
 
     /* The random seed value used for starting the generation of random numbers.
      */
@@ -172,7 +203,7 @@ class Pack : public libMS::Container
     inline uint8_t getNucleotideOnPos( const uint64_t uiPosition ) const
     { /* We expect a correct position, when we come here.
        */
-        return xPackedNucSeqs[ ( size_t )( uiPosition >> 2 ) ] >> ( ( ~uiPosition & 3UL ) << 1 ) & 3;
+        return packedNucSeqs( )[ ( size_t )( uiPosition >> 2 ) ] >> ( ( ~uiPosition & 3UL ) << 1 ) & 3;
     } // inline method
   private:
     /* Method can throw exception if I/O operation fails.
@@ -271,54 +302,82 @@ class Pack : public libMS::Container
     /* Method can throw exception if I/O operation fails.
      * Restores a pack from the file-system.
      * When we come here, we expect, that uiUnpackedSizeForwardStrand has already been set.
+     * If bMapped is set, the file is mapped into memory instead of being read (see MappedFile).
      */
     void vLoadPackedSequence( std::string sFileNamePrefix,
-                              uint64_t uiUnpackedSize // this size should be known in the moment of pack reconstruction
-    )
+                              uint64_t uiUnpackedSize, // this size should be known in the moment of pack reconstruction
+                              bool bMapped = false )
     {
         /* Create the full file name and open the stream for input
          */
         sFileNamePrefix.append( ".pac" );
-        std::ifstream xFileInputStream( sFileNamePrefix, std::ios::in | std::ios::binary );
 
-        if( xFileInputStream.fail( ) )
+        /* In the context of the construction depending on the checksum we injected a zero-byte
+         */
+        bool bZeroByteInjection = uiUnpackedSize % 4 == 0;
+
+        uint8_t uiZeroByte = 0;
+        uint8_t uiChecksum;
+        if( bMapped )
         {
-            throw std::runtime_error( "Reading pack-file failed, because file opening failed." );
+            auto pMapped = std::make_shared<MappedFile>( sFileNamePrefix );
+            if( pMapped->size( ) < (size_t)( 1 + bZeroByteInjection ) )
+            {
+                throw std::runtime_error( "Loading pack failed. Inconsistent pack size recognized." );
+            } // if
+            xPackedNucSeqs.clear( );
+            xPackedNucSeqs.shrink_to_fit( );
+            uiMappedPackedNucSeqsSize = pMapped->size( ) - ( 1 + bZeroByteInjection );
+            pMappedPackedNucSeqs = pMapped->data( );
+            pMappedPack = pMapped;
+            if( bZeroByteInjection )
+                uiZeroByte = pMapped->data( )[ pMapped->size( ) - 2 ];
+            uiChecksum = pMapped->data( )[ pMapped->size( ) - 1 ];
         } // if
+        else
+        {
+            std::ifstream xFileInputStream( sFileNamePrefix, std::ios::in | std::ios::binary );
 
-        /* We get the size of the pac file. And move the read position back to the beginning of the
-         * file.
-         */
-        xFileInputStream.seekg( 0, std::ifstream::end );
-        std::streamoff uiFileSize = xFileInputStream.tellg( );
-        xFileInputStream.seekg( 0, std::ifstream::beg );
+            if( xFileInputStream.fail( ) )
+            {
+                throw std::runtime_error( "Reading pack-file failed, because file opening failed." );
+            } // if
 
-        /* In the context of the construction depending on the checksum we injected a zero-byte
-         */
-        bool bZeroByteInjection = uiUnpackedSize % 4 == 0;
+            /* We get the size of the pac file. And move the read position back to the beginning of the
+             * file.
+             */
+            xFileInputStream.seekg( 0, std::ifstream::end );
+            std::streamoff uiFileSize = xFileInputStream.tellg( );
+            xFileInputStream.seekg( 0, std::ifstream::beg );
 
-        /* Read the pack back from the file.
-         * TO DO: On 32 Bit systems check for some overflow.
-         */
-        xPackedNucSeqs.resize( ( size_t )( uiFileSize - ( 1 + bZeroByteInjection ) ) );
-        xFileInputStream.read( (char*)&xPackedNucSeqs[ 0 ], uiFileSize - ( 1 + bZeroByteInjection ) );
+            /* Read the pack back from the file.
+             * TO DO: On 32 Bit systems check for some overflow.
+             */
+            pMappedPack = nullptr;
+            pMappedPackedNucSeqs = nullptr;
+            xPackedNucSeqs.resize( ( size_t )( uiFileSize - ( 1 + bZeroByteInjection ) ) );
+            xFileInputStream.read( (char*)&xPackedNucSeqs[ 0 ], uiFileSize - ( 1 + bZeroByteInjection ) );
+
+            if( bZeroByteInjection )
+            {
+                xFileInputStream.read( (char*)&uiZeroByte, 1 );
+            } // if
+            xFileInputStream.read( (char*)&uiChecksum, 1 );
+
+            /* Close the file input stream
+             */
+            xFileInputStream.close( );
+        } // else
 
         /* Check existence of injected zero-byte.
          */
-        if( bZeroByteInjection )
+        if( uiZeroByte != 0 )
         {
-            uint8_t uiZeroByte;
-            xFileInputStream.read( (char*)&uiZeroByte, 1 );
-            if( uiZeroByte != 0 )
-            {
-                throw std::runtime_error( "Loading pack failed. Missed expected zero-byte." );
-            } // if
+            throw std::runtime_error( "Loading pack failed. Missed expected zero-byte." );
         } // if
 
-        /* Read and verify the checksum.
+        /* Verify the checksum.
          */
-        uint8_t uiChecksum;
-        xFileInputStream.read( (char*)&uiChecksum, 1 );
         if( uiChecksum != uiUnpackedSize % 4 )
         {
             throw std::runtime_error( "Loading pack failed. Wrong checksum." );
@@ -326,17 +385,10 @@ class Pack : public libMS::Container
 
         /* Check whether the unpacked sequence size is reasonable.
          */
-        if( ( uiUnpackedSize >> 2 ) + ( ( uiUnpackedSize & 3 ) == 0 ? 0 : 1 ) != xPackedNucSeqs.size( ) )
+        if( ( uiUnpackedSize >> 2 ) + ( ( uiUnpackedSize & 3 ) == 0 ? 0 : 1 ) != packedNucSeqsSize( ) )
         {
-            //// std::cout << uiUnpackedSizeForwardStrand << "\n";
-            //// std::cout << ( uiUnpackedSizeForwardStrand >> 2) + (( uiUnpackedSizeForwardStrand &
-            /// 3 ) == 0 ? 0 : 1 ) << "\n"; / std::cout << ( xPackedNucSeqs.size() - 1 ) << "\n";
             throw std::runtime_error( "Loading pack failed. Inconsistent pack size recognized." );
         } // if
-
-        /* Close the file input stream
-         */
-        xFileInputStream.close( );
     } // method
 
     /* WARNING! Never do this for some already used (filled) sequence collection.
@@ -509,8 +561,9 @@ class Pack : public libMS::Container
     } // default constructor
 
     /* constructor.
+     * Loads the pack; if bMapped is set, the packed sequences are memory mapped (see vLoadCollection).
      */
-    Pack( std::string sFileName )
+    Pack( std::string sFileName, bool bMapped = false )
         : bPackComprisesReverseStrand( false ),
           xVectorOfSequenceDescriptors( ),
           xVectorOfHoleDescriptors( ),
@@ -521,7 +574,7 @@ class Pack : public libMS::Container
         /* Initialize the random number generator
          */
         srand( seed );
-        this->vLoadCollection( sFileName );
+        this->vLoadCollection( sFileName, bMapped );
     } // constructor
 
 
@@ -589,6 +642,8 @@ class Pack : public libMS::Container
                                                    // and is not referred after method termination.)
     )
     {
+        if( pMappedPackedNucSeqs != nullptr )
+            throw std::runtime_error( "Cannot append sequences to a memory mapped pack." );
         metaMeasureAndLogDuration<false>( "vAppendSequence", [ & ]( ) {
             /* Skip empty sequences, because they may become troublemaker, particularly if the occur on
              * tail positions.
@@ -729,7 +784,7 @@ class Pack : public libMS::Container
         /* 1. Store the .pac file ( pcPackPrefix.pac )
          * 2. Store the .amb file and the .ann file
          */
-        vStorePack( rsPackPrefix, xPackedNucSeqs, uiUnpackedSizeForwardStrand );
+        vStorePack( rsPackPrefix, packedNucSeqsCopy( ), uiUnpackedSizeForwardStrand );
         vStoreCollectionDescripton( rsPackPrefix );
     } // method
 
@@ -740,7 +795,7 @@ class Pack : public libMS::Container
     {
         /* Make a copy of the packed nucleotide sequence.
          */
-        decltype( xPackedNucSeqs ) xPackedSequence = xPackedNucSeqs;
+        decltype( xPackedNucSeqs ) xPackedSequence = packedNucSeqsCopy( );
 
         uint64_t uiRequiredSize = ( uiUnpackedSizeForwardPlusReverse( ) + 3 ) / 4; // required size of packed sequence
 
@@ -771,6 +826,35 @@ class Pack : public libMS::Container
          */
         vStorePack( rxFilePath, xPackedSequence, uiUnpackedSizeForwardPlusReverse( ) );
     } // method
+    /* Delivers the bytes [uiFirstByte, uiFirstByte + uiNumBytes) of the pack together with its reverse strand
+     * in the byte packed form of vCreateAndStorePackForBWTProcessing, without creating the full copy.
+     * Bytes behind the end of the reverse strand are zero.
+     */
+    void vGetPackedForwardPlusReverse( uint64_t uiFirstByte, uint64_t uiNumBytes, uint8_t* pOut ) const
+    {
+        const uint64_t uiSizeForwardPlusReverse = uiUnpackedSizeForwardPlusReverse( );
+        for( uint64_t uiByte = uiFirstByte; uiByte < uiFirstByte + uiNumBytes; uiByte++ )
+        {
+            uint64_t uiPosition = uiByte << 2;
+            /* Bytes that lie completely on the forward strand are copied.
+             */
+            if( uiPosition + 4 <= uiUnpackedSizeForwardStrand )
+            {
+                *pOut++ = packedNucSeqs( )[ (size_t)uiByte ];
+                continue;
+            } // if
+            uint8_t uiValue = 0;
+            for( ; uiPosition < ( uiByte + 1 ) << 2 && uiPosition < uiSizeForwardPlusReverse; uiPosition++ )
+            {
+                uint8_t uiNuc = uiPosition < uiUnpackedSizeForwardStrand
+                                    ? getNucleotideOnPos( uiPosition )
+                                    : 3 - getNucleotideOnPos( uiSizeForwardPlusReverse - 1 - uiPosition );
+                uiValue |= uiNuc << ( ( ~uiPosition & 3UL ) << 1 );
+            } // for
+            *pOut++ = uiValue;
+        } // for
+    } // method
+
     /* Checks whether the files required for loading a pack does exist on the file system.
      */
     static bool packExistsOnFileSystem( const std::string& rsPrefix )
@@ -795,8 +879,11 @@ class Pack : public libMS::Container
 
     /* Restores a nucleotide sequence collection from the file system using the prefix given as
      * argument.
+     * If bMapped is set, the .pac file is mapped into memory read-only instead of being copied.
+     * All processes that map the same pack share its memory and the pack is available without reading the
+     * file upfront. Such a pack cannot be extended by further sequences.
      */
-    void vLoadCollection( const std::string& rsFileNamePrefix )
+    void vLoadCollection( const std::string& rsFileNamePrefix, bool bMapped = false )
     {
         if( !packExistsOnFileSystem( rsFileNamePrefix ) ) // if the files of the pack does not
                                                           // exist, we inform the caller.
@@ -805,7 +892,7 @@ class Pack : public libMS::Container
         } // if
 
         vLoadSequenceDescriptorVector( rsFileNamePrefix.c_str( ) ); // load the .ann file
-        vLoadPackedSequence( rsFileNamePrefix, uiUnpackedSizeForwardStrand ); // load the .pac file
+        vLoadPackedSequence( rsFileNamePrefix, uiUnpackedSizeForwardStrand, bMapped ); // load the .pac file
         vLoadHoleDescriptorVector( rsFileNamePrefix.c_str( ) ); // load the .amb file
 
         assert( debugCheckSequenceDescriptorVector( ) );
@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <csignal>
 #include <list>
+#include <type_traits>
 /// @endcond
 
 namespace libMA
@@ -203,6 +204,75 @@ class Seed : public libMS::Container, public geom::Interval<nucSeqIndex>
 }; // class
 
 
+/**
+ * @brief A packed, trivially copyable representation of a Seed.
+ * @details
+ * Seed carries the vtable of libMS::Container and several members that are not required while computing the SoCs.
+ * The SoC sort and sweep touch every seed of a read (several times), so they work on this 32 byte record instead of the
+ * 64 byte Seed.
+ * uiIndex refers to the Seed in the originating Seeds container; the conversion back to Seed is done via this index
+ * (see SoCPriorityQueue::pop).
+ */
+class PackedSeed
+{
+  public:
+    nucSeqIndex uiDelta;
+    nucSeqIndex uiPosOnReference;
+    uint32_t uiPosOnQuery;
+    uint32_t uiSize : 31;
+    uint32_t bOnForwStrand : 1;
+    uint32_t uiAmbiguity;
+    uint32_t uiIndex;
+
+    PackedSeed( ) = default;
+
+    PackedSeed( const Seed& rS, uint32_t uiIndex )
+        : uiDelta( rS.uiDelta ),
+          uiPosOnReference( rS.uiPosOnReference ),
+          uiPosOnQuery( (uint32_t)rS.start( ) ),
+          uiSize( (uint32_t)rS.size( ) ),
+          bOnForwStrand( rS.bOnForwStrand ? 1 : 0 ),
+          uiAmbiguity( rS.uiAmbiguity ),
+          uiIndex( uiIndex )
+    {
+        assert( rS.start( ) <= UINT32_MAX );
+        assert( rS.size( ) < ( 1u << 31 ) );
+    } // constructor
+
+    inline nucSeqIndex start( ) const
+    {
+        return uiPosOnQuery;
+    } // function
+
+    inline nucSeqIndex size( ) const
+    {
+        return uiSize;
+    } // function
+
+    inline nucSeqIndex end( ) const
+    {
+        return start( ) + size( );
+    } // function
+
+    inline nucSeqIndex start_ref( ) const
+    {
+        return uiPosOnReference;
+    } // function
+
+    inline nucSeqIndex end_ref( ) const
+    {
+        return uiPosOnReference + size( );
+    } // function
+
+    inline nucSeqIndex getValue( ) const
+    {
+        return size( );
+    } // function
+}; // class
+
+static_assert( std::is_trivially_copyable<PackedSeed>::value, "PackedSeed must be trivially copyable" );
+static_assert( sizeof( PackedSeed ) == 32, "PackedSeed is expected to be 32 bytes wide" );
+
 inline std::ostream& operator<<( std::ostream& os, const Seed& rS )
 {
     os << "iStart= " << rS.iStart << " iSize= " << rS.iSize << " uiPosOnReference= " << rS.uiPosOnReference
@@ -633,6 +703,19 @@ class Seeds : public libMS::Container
                                 std::get<2>( xTemp )->size( ) );
     } // method
 
+    /**
+     * @brief appends the packed representation of all seeds to rvOut.
+     * @details
+     * PackedSeed::uiIndex is set to the index of the respective seed in this container.
+     */
+    inline void pack( std::vector<PackedSeed>& rvOut ) const
+    {
+        assert( vContent.size( ) <= UINT32_MAX );
+        rvOut.reserve( rvOut.size( ) + vContent.size( ) );
+        for( size_t uiI = 0; uiI < vContent.size( ); uiI++ )
+            rvOut.emplace_back( vContent[ uiI ], (uint32_t)uiI );
+    } // method
+
     void DLL_PORT( MA )
         confirmSeedPositions( std::shared_ptr<NucSeq> pQuery, std::shared_ptr<Pack> pRef, bool bIsMaxExtended );
 }; // class
@@ -0,0 +1,119 @@
+/**
+ * @file shardedFMIndex.h
+ * @brief FMD-index that is split into several shards of whole contigs.
+ */
+#ifndef SHARDED_FM_INDEX_H
+#define SHARDED_FM_INDEX_H
+
+#include "ma/container/fMIndex.h"
+#include "ma/container/pack.h"
+
+/// @cond DOXYGEN_SHOW_SYSTEM_INCLUDES
+#include <functional>
+/// @endcond
+
+namespace libMA
+{
+
+/**
+ * @brief FMD-index that is split into shards of whole contigs.
+ * @details
+ * Each shard is a separate FMD-index over a consecutive group of contigs of the genome's pack.
+ * The construction of the suffix array requires several times the memory of the final index;
+ * by building the shards one after the other, index creation only ever has to hold one shard's construction.
+ * The seeding modules query the shards one after the other (see ShardedSeeding) and translate the seeds
+ * into the coordinates of the genome's pack.
+ * Stored shards are memory mapped by default when they are loaded. Then, the shards are not copied into the heap: only
+ * the pages that the current reads touch become resident and the kernel can evict the pages of the other shards under
+ * memory pressure (the pages are backed by the index files). Hence, alignment does not need to hold the sum of all
+ * shards in memory either. Note that the genome's pack is not sharded (it is 2-bit packed and the DP needs it as a
+ * whole); GenomeManager maps it as well for sharded genomes.
+ */
+class ShardedFMIndex : public libMS::Container
+{
+  public:
+    struct Shard
+    {
+        /// @brief first contig of the shard (id in the genome's pack)
+        size_t uiFirstContig;
+        size_t uiNumContigs;
+        /// @brief start of the shard on the forward strand of the genome's pack
+        uint64_t uiOffset;
+        /// @brief length of the shard on the forward strand
+        uint64_t uiLength;
+        std::shared_ptr<FMIndex> pFMIndex;
+    }; // struct
+
+    std::vector<Shard> vShards;
+    /// @brief length of the forward plus reverse strand of the genome's pack
+    const uint64_t uiRefSeqLength;
+
+    /**
+     * @brief groups the contigs of rPack into shards of at most uiMaxShardSize nucleotides
+     * @details
+     * Returns the first contig of every shard.
+     * Contigs are never split, so a contig larger than uiMaxShardSize gets a shard on its own.
+     */
+    static std::vector<size_t> DLL_PORT( MA ) groupContigs( const Pack& rPack, uint64_t uiMaxShardSize );
+
+    /**
+     * @brief returns a pack with the contigs [uiFirstContig, uiFirstContig + uiNumContigs) of rPack
+     * @details
+     * Copies the nucleotides that are stored in rPack (holes are not restored),
+     * so that the shard's BWT matches the genome's pack.
+     */
+    static std::shared_ptr<Pack> DLL_PORT( MA )
+        shardPack( const Pack& rPack, size_t uiFirstContig, size_t uiNumContigs );
+
+    /// @brief prefix of the files of the uiShard'th shard
+    static std::string shardPrefix( const std::string& sPrefix, size_t uiShard )
+    {
+        return sPrefix + ".shard" + std::to_string( uiShard );
+    } // method
+
+    /**
+     * @brief computes and stores the shards of rPack one after the other.
+     * @details
+     * Only one shard is kept in memory at a time.
+     * Returns the first contig of every shard (this is required for loading the shards).
+     */
+    static std::vector<size_t> DLL_PORT( MA )
+        storeShards( const Pack& rPack, uint64_t uiMaxShardSize, const std::string& sPrefix,
+                     std::function<void( const std::string& )> fCallBack = []( const std::string& ) {} );
+
+    /// @brief computes all shards in memory
+    DLL_PORT( MA ) ShardedFMIndex( const Pack& rPack, uint64_t uiMaxShardSize );
+
+    /// @brief loads the shards that were stored by storeShards (unmapped shards are loaded in parallel)
+    /// @details if bMapped is set, the shards are memory mapped (see FMIndex::vLoadFMIndex)
+    DLL_PORT( MA ) ShardedFMIndex( const Pack& rPack, const std::vector<size_t>& vFirstContigs,
+                                   const std::string& sPrefix, bool bMapped = true );
+
+    ShardedFMIndex( const ShardedFMIndex& ) = delete;
+
+    uint64_t getRefSeqLength( void ) const
+    {
+        return uiRefSeqLength;
+    } // method
+
+    size_t numShards( void ) const
+    {
+        return vShards.size( );
+    } // method
+
+  private:
+    /// @brief sets up the shard descriptors (without indices)
+    void initShards( const Pack& rPack, const std::vector<size_t>& vFirstContigs );
+}; // class
+
+} // namespace libMA
+
+#ifdef WITH_PYTHON
+/**
+ * @brief function called in order to export this @ref libMS::Container "container"
+ * @ingroup export
+ */
+void exportShardedFMIndex( libMS::SubmoduleOrganizer& xOrganizer );
+#endif
+
+#endif
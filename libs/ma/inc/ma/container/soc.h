@@ -7,6 +7,7 @@
 #define SOC_H
 
 #include "ma/container/seed.h"
+#include "util/radixSort.h"
 
 /// @cond DOXYGEN_SHOW_SYSTEM_INCLUDES
 #include <algorithm>
@@ -37,8 +38,9 @@ class SoCOrder
      * @brief Add another seed to the SoC score.
      * @details
      * Adjusts all three stored values accordingly.
+     * Works for Seed and PackedSeed.
      */
-    inline void operator+=( const Seed& rS )
+    template <typename TP_SEED> inline void operator+=( const TP_SEED& rS )
     {
         uiSeedAmbiguity += rS.uiAmbiguity;
         uiSeedAmount++;
@@ -53,7 +55,7 @@ class SoCOrder
      * was added to this SoC score before.
      * Otherwise this may result in undefined behaviour while sorting SoCs.
      */
-    inline void operator-=( const Seed& rS )
+    template <typename TP_SEED> inline void operator-=( const TP_SEED& rS )
     {
         assert( uiSeedAmbiguity >= rS.uiAmbiguity );
         uiSeedAmbiguity -= rS.uiAmbiguity;
@@ -131,15 +133,23 @@ class SoCPriorityQueue : public libMS::Container
 #endif
     /// @brief The index of the next SoC during the extraction process.
     unsigned int uiSoCIndex = 0;
-    /// @brief The complete seed set.
+    /// @brief The complete seed set (in the order it was given to the SoC computation).
     std::shared_ptr<Seeds> pSeeds;
+    /**
+     * @brief The packed seeds sorted by the SoC order.
+     * @details
+     * PackedSeed::uiIndex refers to the seeds in pSeeds.
+     * The Seeds are materialized only for the SoCs that are popped.
+     */
+    std::vector<PackedSeed> vPackedSeeds;
+    /// @brief A SoC in form of a tuple (score, start, end); start and end are indices in vPackedSeeds.
+    typedef std::tuple<SoCOrder, size_t, size_t> SoCTuple;
     /// @brief Contains the SoCs in for of tuples (score, start, end).
-    std::vector<std::tuple<SoCOrder, std::vector<Seed>::iterator, std::vector<Seed>::iterator>> vMaxima;
+    std::vector<SoCTuple> vMaxima;
     /// @brief End position of the last SoC during collection; required to determine overlaps.
     nucSeqIndex uiLastEnd = 0;
     /// @brief Function used to for the make_max_heap call.
-    static bool heapOrder( const std::tuple<SoCOrder, std::vector<Seed>::iterator, std::vector<Seed>::iterator>& rA,
-                           const std::tuple<SoCOrder, std::vector<Seed>::iterator, std::vector<Seed>::iterator>& rB )
+    static bool heapOrder( const SoCTuple& rA, const SoCTuple& rB )
     {
         return std::get<0>( rA ) < std::get<0>( rB );
     } // method
@@ -199,34 +209,36 @@ class SoCPriorityQueue : public libMS::Container
         // populate vRefPosMaxima with the reference start and end positions of all SoCs.
         for( auto& tSoC : vMaxima )
         {
-            auto xItStart = std::get<1>( tSoC );
-            auto xItEnd = std::get<2>( tSoC );
-            vRefPosMaxima.emplace_back( xItStart->start_ref( ), xItStart->start_ref( ) );
-            while( xItStart != xItEnd )
+            size_t uiStart = std::get<1>( tSoC );
+            size_t uiEnd = std::get<2>( tSoC );
+            vRefPosMaxima.emplace_back( vPackedSeeds[ uiStart ].start_ref( ), vPackedSeeds[ uiStart ].start_ref( ) );
+            while( uiStart != uiEnd )
             {
-                vRefPosMaxima.back( ).first = std::min( vRefPosMaxima.back( ).first, xItStart->start_ref( ) );
-                vRefPosMaxima.back( ).second = std::max( vRefPosMaxima.back( ).second, xItStart->start_ref( ) );
-                xItStart++;
+                vRefPosMaxima.back( ).first =
+                    std::min( vRefPosMaxima.back( ).first, vPackedSeeds[ uiStart ].start_ref( ) );
+                vRefPosMaxima.back( ).second =
+                    std::max( vRefPosMaxima.back( ).second, vPackedSeeds[ uiStart ].start_ref( ) );
+                uiStart++;
             } // while
         } // for
         // sort seeds after the start and end positions.
-        std::sort( pSeeds->begin( ), pSeeds->end( ),
-                   []( const Seed& rA, const Seed& rB ) { return rA.start_ref( ) < rB.start_ref( ); } );
+        radix::sort( vPackedSeeds.begin( ), vPackedSeeds.end( ),
+                     []( const PackedSeed& rS ) { return rS.start_ref( ); } );
         // repopulate vMaxima
         vMaxima.clear( );
         for( auto& rP : vRefPosMaxima )
         {
             vMaxima.emplace_back( );
-            std::get<1>( vMaxima.back( ) ) =
-                std::lower_bound( pSeeds->begin( ), pSeeds->end( ), rP.first,
-                                  []( const Seed& rS, nucSeqIndex uiPos ) { return rS.start_ref( ) < uiPos; } );
-            auto xIt = std::get<1>( vMaxima.back( ) );
-            while( xIt != pSeeds->end( ) && xIt->start_ref( ) <= rP.second )
+            auto xIt = std::lower_bound(
+                vPackedSeeds.begin( ), vPackedSeeds.end( ), rP.first,
+                []( const PackedSeed& rS, nucSeqIndex uiPos ) { return rS.start_ref( ) < uiPos; } );
+            std::get<1>( vMaxima.back( ) ) = xIt - vPackedSeeds.begin( );
+            while( xIt != vPackedSeeds.end( ) && xIt->start_ref( ) <= rP.second )
             {
                 std::get<0>( vMaxima.back( ) ) += *xIt;
                 xIt++;
             } // while
-            std::get<2>( vMaxima.back( ) ) = xIt;
+            std::get<2>( vMaxima.back( ) ) = xIt - vPackedSeeds.begin( );
         } // for
     } // method
 
@@ -245,8 +257,8 @@ class SoCPriorityQueue : public libMS::Container
         // get the expected amount of seeds in the SoC from the order class and reserve memory
         pRet->reserve( std::get<0>( vMaxima.front( ) ).uiSeedAmount );
         // iterator walking till the end of the strip that shall be collected
-        auto xCollect2 = std::get<1>( vMaxima.front( ) );
-        assert( xCollect2 != pSeeds->end( ) );
+        auto xCollect2 = vPackedSeeds.begin( ) + std::get<1>( vMaxima.front( ) );
+        assert( xCollect2 != vPackedSeeds.end( ) );
         // save SoC index
         pRet->xStats = pSeeds->xStats;
         pRet->xStats.index_of_strip = uiSoCIndex++;
@@ -255,8 +267,8 @@ class SoCPriorityQueue : public libMS::Container
         pRet->xStats.uiInitialRefBegin = xCollect2->start_ref( );
         pRet->xStats.uiInitialQueryEnd = xCollect2->end( );
         pRet->xStats.uiInitialRefEnd = xCollect2->end_ref( );
-        auto xCollectEnd = std::get<2>( vMaxima.front( ) );
-        while( xCollect2 != pSeeds->end( ) && xCollect2 != xCollectEnd )
+        auto xCollectEnd = vPackedSeeds.begin( ) + std::get<2>( vMaxima.front( ) );
+        while( xCollect2 != vPackedSeeds.end( ) && xCollect2 != xCollectEnd )
         {
             // save the beginning and end of the SoC
             // all these things are not used at the moment...
@@ -271,8 +283,10 @@ class SoCPriorityQueue : public libMS::Container
             pRet->xStats.num_seeds_in_strip++;
             assert( xCollect2->start( ) <= xCollect2->end( ) );
             // if the iterator is still within the strip add the seed and increment the iterator
-            xCollect2->uiSoCNt = std::get<0>( vMaxima.front( ) ).uiAccumulativeLength;
-            pRet->push_back( *( xCollect2++ ) );
+            // (this is where the packed seeds are turned back into Seeds)
+            Seed& rSeed = ( *pSeeds )[ ( xCollect2++ )->uiIndex ];
+            rSeed.uiSoCNt = std::get<0>( vMaxima.front( ) ).uiAccumulativeLength;
+            pRet->push_back( rSeed );
         } // while
 
 
@@ -295,10 +309,8 @@ class SoCPriorityQueue : public libMS::Container
         DEBUG( assert( !empty( ) ); assert( bInPriorityMode ); ) // DEBUG
 
         // the information that shall be returned
-        auto xCollect = std::get<1>( vMaxima.front( ) );
-        auto xCollectEnd = std::get<2>( vMaxima.front( ) );
-        nucSeqIndex uiStart = xCollect->start_ref( );
-        nucSeqIndex uiEnd = ( xCollectEnd - 1 )->end_ref( );
+        nucSeqIndex uiStart = vPackedSeeds[ std::get<1>( vMaxima.front( ) ) ].start_ref( );
+        nucSeqIndex uiEnd = vPackedSeeds[ std::get<2>( vMaxima.front( ) ) - 1 ].end_ref( );
         uint32_t uiScore = (uint32_t)std::get<0>( vMaxima.front( ) ).uiAccumulativeLength;
 
         // move to the next strip
@@ -314,10 +326,8 @@ class SoCPriorityQueue : public libMS::Container
         DEBUG( assert( !empty( ) ); assert( bInPriorityMode ); ) // DEBUG
 
         // the information that shall be returned
-        auto xCollect = std::get<1>( vMaxima.front( ) );
-        auto xCollectEnd = std::get<2>( vMaxima.front( ) );
-        nucSeqIndex uiStart = xCollect->start_ref( );
-        nucSeqIndex uiEnd = ( xCollectEnd - 1 )->end_ref( );
+        nucSeqIndex uiStart = vPackedSeeds[ std::get<1>( vMaxima.front( ) ) ].start_ref( );
+        nucSeqIndex uiEnd = vPackedSeeds[ std::get<2>( vMaxima.front( ) ) - 1 ].end_ref( );
         uint32_t uiScore = (uint32_t)std::get<0>( vMaxima.front( ) ).uiAccumulativeLength;
 
         return std::make_tuple( uiStart, uiEnd, uiScore );
@@ -328,23 +338,23 @@ class SoCPriorityQueue : public libMS::Container
         return (uint32_t)std::get<0>( vMaxima.front( ) ).uiAccumulativeLength;
     }
 
-    inline void adjustScore( SoCOrder& rScore, std::vector<Seed>::iterator xCutStart,
-                             std::vector<Seed>::iterator xCutEnd, std::vector<Seed>::iterator xCountStart,
-                             std::vector<Seed>::iterator xCountEnd )
+    inline void adjustScore( SoCOrder& rScore, size_t uiCutStart, size_t uiCutEnd, size_t uiCountStart,
+                             size_t uiCountEnd )
     {
         // determine which score calculation is cheaper
-        if( xCutEnd - xCutStart <= xCountEnd - xCountStart )
+        // (signed: the cut region can be empty with uiCutEnd < uiCutStart)
+        if( (int64_t)uiCutEnd - (int64_t)uiCutStart <= (int64_t)uiCountEnd - (int64_t)uiCountStart )
         {
             // it is cheaper to substract the cut out region
-            for( auto xIt = xCutStart; xIt < xCutEnd; xIt++ )
-                rScore -= *xIt;
+            for( size_t uiI = uiCutStart; uiI < uiCutEnd; uiI++ )
+                rScore -= vPackedSeeds[ uiI ];
         } // if
         else
         {
             // it is cheaper to add up all seeds outside the cut off region
             SoCOrder xNewScore;
-            for( auto xIt = xCountStart; xIt < xCountEnd; xIt++ )
-                xNewScore += *xIt;
+            for( size_t uiI = uiCountStart; uiI < uiCountEnd; uiI++ )
+                xNewScore += vPackedSeeds[ uiI ];
             rScore = xNewScore;
         } // else
     } // method
@@ -357,14 +367,14 @@ class SoCPriorityQueue : public libMS::Container
      * This functions either replaces the last SoC if the new one has a higher score or
      * discards the new SoC in case of overlaps.
      * Otherwise the new SoC is merely pushed onto the stack.
-     * @note itStripEnd points to one element past end of the SoC.
+     * @note uiStripEnd points to one element past end of the SoC; both are indices in vPackedSeeds.
      */
-    inline void push_back_no_overlap( SoCOrder rCurrScore, std::vector<Seed>::iterator itStrip,
-                                      std::vector<Seed>::iterator itStripEnd, nucSeqIndex uiMinScore )
+    inline void push_back_no_overlap( SoCOrder rCurrScore, size_t uiStrip, size_t uiStripEnd,
+                                      nucSeqIndex uiMinScore )
     {
         DEBUG( assert( !bInPriorityMode ); )
         // check if current and last SoC overlap
-        while( !vMaxima.empty( ) && std::get<2>( vMaxima.back( ) ) > itStrip )
+        while( !vMaxima.empty( ) && std::get<2>( vMaxima.back( ) ) > uiStrip )
         {
             // they do overlap
             // make the higher value SoC vacuum up the seeds it shares with lower value one
@@ -372,9 +382,9 @@ class SoCPriorityQueue : public libMS::Container
             {
                 // current SoC has a higher score
                 // remove seeds from last SoC
-                adjustScore( std::get<0>( vMaxima.back( ) ), itStrip, std::get<2>( vMaxima.back( ) ),
-                             std::get<1>( vMaxima.back( ) ), itStrip );
-                std::get<2>( vMaxima.back( ) ) = itStrip;
+                adjustScore( std::get<0>( vMaxima.back( ) ), uiStrip, std::get<2>( vMaxima.back( ) ),
+                             std::get<1>( vMaxima.back( ) ), uiStrip );
+                std::get<2>( vMaxima.back( ) ) = uiStrip;
 
                 // check if last SoC now has less seeds that is worth keeping
                 if( std::get<0>( vMaxima.back( ) ).uiAccumulativeLength < uiMinScore ||
@@ -387,9 +397,9 @@ class SoCPriorityQueue : public libMS::Container
             else
             {
                 // current SoC has lower score
-                adjustScore( rCurrScore, itStrip, std::get<2>( vMaxima.back( ) ), std::get<2>( vMaxima.back( ) ),
-                             itStripEnd );
-                itStrip = std::get<2>( vMaxima.back( ) );
+                adjustScore( rCurrScore, uiStrip, std::get<2>( vMaxima.back( ) ), std::get<2>( vMaxima.back( ) ),
+                             uiStripEnd );
+                uiStrip = std::get<2>( vMaxima.back( ) );
 
                 // check if this SoC now has less seeds that is worth keeping
                 if( rCurrScore.uiAccumulativeLength < uiMinScore || rCurrScore.uiAccumulativeLength == 0 )
@@ -400,7 +410,7 @@ class SoCPriorityQueue : public libMS::Container
             } // else
         } // while
         // they do not overlap (anymore) and we want to keep the current SoC
-        vMaxima.push_back( std::make_tuple( rCurrScore, itStrip, itStripEnd ) );
+        vMaxima.push_back( std::make_tuple( rCurrScore, uiStrip, uiStripEnd ) );
     } // method
 
     /**
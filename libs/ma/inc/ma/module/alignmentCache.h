@@ -0,0 +1,238 @@
+/**
+ * @file alignmentCache.h
+ * @brief Reuses the alignments of identical reads.
+ */
+#pragma once
+
+#include "ma/container/alignment.h"
+#include "ma/module/binarySeeding.h"
+#include "ma/module/harmonization.h"
+#include "ma/module/mappingQuality.h"
+#include "ma/module/needlemanWunsch.h"
+#include "ma/module/shardedSeeding.h"
+#include "ma/module/stripOfConsideration.h"
+#include "ms/module/module.h"
+
+/// @cond DOXYGEN_SHOW_SYSTEM_INCLUDES
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+/// @endcond
+
+namespace libMA
+{
+/**
+ * @brief LRU cache from read sequences to their alignments.
+ * @details
+ * The cache is content addressed: the key is the nucleotide sequence of the read, so reads with different names but
+ * identical sequences share an entry. Hits compare the full sequence, so hash collisions cannot deliver the
+ * alignments of another read.
+ * The entries are distributed over uiNumShards shards by the hash of the sequence. Each shard has its own lock and LRU
+ * list, so the threads of a graph rarely wait for each other. The locks are held during lookup and insertion only,
+ * never while aligning.
+ * Memory is bounded by the number of reads (uiMaxReads, split evenly over the shards).
+ * Entries keep whether the read exceeded its work budget (NucSeq::bOverBudget), so that hits are reported like the
+ * original read.
+ */
+class AlignmentCache
+{
+  public:
+    typedef std::vector<std::shared_ptr<Alignment>> Alignments;
+
+  private:
+    struct Entry
+    {
+        Alignments vAlignments;
+        /// copy of NucSeq::bOverBudget of the aligned read
+        bool bOverBudget;
+    }; // struct
+    typedef std::list<std::pair<std::string, Entry>> LruList;
+
+    struct Shard
+    {
+        std::mutex xMutex;
+        /// most recently used entry first
+        LruList xLru;
+        /// keys are views on the strings in xLru (list elements do not move)
+        std::unordered_map<std::string_view, LruList::iterator> xIndex;
+    }; // struct
+
+    static const size_t uiNumShards = 64;
+    std::vector<Shard> vShards;
+    const size_t uiMaxReadsPerShard;
+
+    /// @brief deep copy, so that later modules can modify the alignments
+    static Alignments copy( const Alignments& rAlignments )
+    {
+        Alignments vRet;
+        vRet.reserve( rAlignments.size( ) );
+        for( auto& pAlignment : rAlignments )
+            vRet.push_back( pAlignment->clone( ) );
+        return vRet;
+    } // method
+
+    static std::string_view key( const NucSeq& rQuery )
+    {
+        return std::string_view( (const char*)rQuery.pxSequenceRef, rQuery.length( ) );
+    } // method
+
+    Shard& shard( std::string_view sKey )
+    {
+        return vShards[ std::hash<std::string_view>( )( sKey ) % uiNumShards ];
+    } // method
+
+  public:
+    std::atomic<size_t> uiHits;
+    std::atomic<size_t> uiMisses;
+
+    AlignmentCache( size_t uiMaxReads )
+        : vShards( uiNumShards ),
+          uiMaxReadsPerShard( std::max( (size_t)1, ( uiMaxReads + uiNumShards - 1 ) / uiNumShards ) ),
+          uiHits( 0 ),
+          uiMisses( 0 )
+    {} // constructor
+
+    /**
+     * @brief looks up the alignments of rQuery
+     * @details
+     * Returns true and sets rvOut to a copy of the alignments on a hit.
+     * The alignments carry the name of rQuery and rQuery.bOverBudget is set as for the cached read.
+     */
+    bool get( NucSeq& rQuery, Alignments& rvOut )
+    {
+        auto sKey = key( rQuery );
+        Shard& rShard = shard( sKey );
+        {
+            std::lock_guard<std::mutex> xGuard( rShard.xMutex );
+            auto xIt = rShard.xIndex.find( sKey );
+            if( xIt == rShard.xIndex.end( ) )
+            {
+                uiMisses++;
+                return false;
+            } // if
+            // move to the front of the LRU list
+            rShard.xLru.splice( rShard.xLru.begin( ), rShard.xLru, xIt->second );
+            rvOut = copy( xIt->second->second.vAlignments );
+            rQuery.bOverBudget = xIt->second->second.bOverBudget;
+        } // scope
+        uiHits++;
+        for( auto& pAlignment : rvOut )
+            pAlignment->xStats.sName = rQuery.sName;
+        return true;
+    } // method
+
+    /**
+     * @brief stores a copy of the alignments of rQuery; evicts the least recently used entry if the shard is full
+     * @details
+     * Call this after aligning rQuery, so that rQuery.bOverBudget is final.
+     */
+    void put( const NucSeq& rQuery, const Alignments& rvAlignments )
+    {
+        // copy before locking
+        auto vCopy = copy( rvAlignments );
+        std::string sKey( key( rQuery ) );
+        Shard& rShard = shard( sKey );
+        std::lock_guard<std::mutex> xGuard( rShard.xMutex );
+        // another thread might have aligned the same sequence concurrently
+        if( rShard.xIndex.count( sKey ) != 0 )
+            return;
+        rShard.xLru.emplace_front( std::move( sKey ), Entry{ std::move( vCopy ), rQuery.bOverBudget } );
+        rShard.xIndex.emplace( rShard.xLru.front( ).first, rShard.xLru.begin( ) );
+        if( rShard.xLru.size( ) > uiMaxReadsPerShard )
+        {
+            rShard.xIndex.erase( rShard.xLru.back( ).first );
+            rShard.xLru.pop_back( );
+        } // if
+    } // method
+
+    /// @brief number of cached reads
+    size_t size( )
+    {
+        size_t uiRet = 0;
+        for( auto& rShard : vShards )
+        {
+            std::lock_guard<std::mutex> xGuard( rShard.xMutex );
+            uiRet += rShard.xLru.size( );
+        } // for
+        return uiRet;
+    } // method
+}; // class
+
+/**
+ * @brief Aligns a read or reuses the alignments of a previous read with the same sequence.
+ * @ingroup module
+ * @details
+ * Performs the same computation as the seeding, SoC, harmonization, DP and mapping quality modules of setUpCompGraph.
+ * Amplicon and high duplicate libraries contain many reads with identical sequences; for those the pipeline runs only
+ * once, as long as the sequence stays in the cache (see AlignmentCache).
+ * The cache is shared by all threads that use this module.
+ */
+class CachedAlignment : public libMS::Module<libMS::ContainerVector<std::shared_ptr<Alignment>>, false, FMIndex,
+                                             NucSeq, Pack>
+{
+  public:
+    BinarySeeding xSeeding;
+    StripOfConsideration xSoC;
+    Harmonization xHarmonization;
+    NeedlemanWunsch xDP;
+    MappingQuality xMappingQuality;
+
+    AlignmentCache xCache;
+
+    CachedAlignment( const ParameterSetManager& rParameters )
+        : xSeeding( rParameters ),
+          xSoC( rParameters ),
+          xHarmonization( rParameters ),
+          xDP( rParameters ),
+          xMappingQuality( rParameters ),
+          xCache( rParameters.pGeneralParameterSet->piAlignmentCacheSize->get( ) )
+    {} // constructor
+
+    // overload
+    virtual std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>> DLL_PORT( MA )
+        execute( std::shared_ptr<FMIndex> pFMIndex, std::shared_ptr<NucSeq> pQuery, std::shared_ptr<Pack> pPack );
+}; // class
+
+/**
+ * @brief The CachedAlignment module for a ShardedFMIndex.
+ * @ingroup module
+ * @details
+ * Performs the same computation as the alignment steps of setUpCompGraphSharded.
+ */
+class CachedShardedAlignment : public libMS::Module<libMS::ContainerVector<std::shared_ptr<Alignment>>, false,
+                                                    ShardedFMIndex, NucSeq, Pack>
+{
+  public:
+    ShardedSeeding xSeeding;
+    StripOfConsiderationSeeds xSoC;
+    ShardedHarmonization xHarmonization;
+    NeedlemanWunsch xDP;
+    MappingQuality xMappingQuality;
+
+    AlignmentCache xCache;
+
+    CachedShardedAlignment( const ParameterSetManager& rParameters )
+        : xSeeding( rParameters ),
+          xSoC( rParameters ),
+          xHarmonization( rParameters ),
+          xDP( rParameters ),
+          xMappingQuality( rParameters ),
+          xCache( rParameters.pGeneralParameterSet->piAlignmentCacheSize->get( ) )
+    {} // constructor
+
+    // overload
+    virtual std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>> DLL_PORT( MA )
+        execute( std::shared_ptr<ShardedFMIndex> pIndex, std::shared_ptr<NucSeq> pQuery,
+                 std::shared_ptr<Pack> pPack );
+}; // class
+} // namespace libMA
+
+#ifdef WITH_PYTHON
+/**
+ * @brief export the CachedAlignment and CachedShardedAlignment @ref libMA::Module "modules" to python.
+ * @ingroup export
+ */
+void exportAlignmentCache( libMS::SubmoduleOrganizer& xOrganizer );
+#endif
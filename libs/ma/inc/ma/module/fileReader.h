@@ -18,6 +18,7 @@
 
 
 /// @cond DOXYGEN_SHOW_SYSTEM_INCLUDES
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 /// @endcond
@@ -27,12 +28,19 @@ namespace libMA
 
 class FileStream : public libMS::Container
 {
+    /// @brief returns a new, process wide unique, stream id (ids are increasing, starting with 1)
+    static size_t DLL_PORT( MA ) nextStreamId( );
+
   public:
     std::mutex xMutex;
     DEBUG( size_t uiNumLinesWithNs = 0; ) // DEBUG
     DEBUG( size_t uiNumLinesRead = 0; ) // DEBUG
+    /// @brief id that the FileReader gives to all reads of this stream (see NucSeq::uiStreamId)
+    const size_t uiStreamId;
+    /// @brief number of reads that the FileReader extracted from this stream so far
+    uint64_t uiNumReadsRead = 0;
 
-    FileStream( )
+    FileStream( ) : uiStreamId( nextStreamId( ) )
     {}
 
     FileStream( const FileStream& ) = delete;
@@ -471,9 +479,14 @@ class FileStreamFromPath : public FileStream
  * @brief Reads Queries from a file.
  * @details
  * Reads (multi-)fasta or fastaq format.
+ * Numbers the reads of each stream (see NucSeq::uiIndexInStream).
+ * Reads from a ReadWindowStream are returned in the order of the window.
  */
 class FileReader : public libMS::Module<NucSeq, true, FileStream>
 {
+    /// @brief reads the next query from pStream; pStream must be locked
+    std::shared_ptr<NucSeq> read( std::shared_ptr<FileStream> pStream );
+
     void advanceTillNext( std::shared_ptr<FileStream> pStream )
     {
         pStream->peek( );
@@ -495,7 +508,88 @@ class FileReader : public libMS::Module<NucSeq, true, FileStream>
 
 }; // class
 
+/**
+ * @brief Reads a window of reads ahead and hands them out from the longest to the shortest one.
+ * @details
+ * Wraps a FileStream; the FileReader recognizes this stream and takes its reads from the window.
+ * Long reads are started first, so that the short reads at the end of each window fill the gaps of the threads.
+ * (Reads keep the index in their original stream, so the writers can restore the file order.)
+ * The stream is eof only if the wrapped stream is eof and the window is empty.
+ */
+class ReadWindowStream : public FileStream
+{
+    std::shared_ptr<FileStream> pStream;
+    const size_t uiWindowSize;
+    /// @brief reads of the current window; sorted by length, the longest read last
+    std::vector<std::shared_ptr<NucSeq>> vWindow;
+
+  public:
+    ReadWindowStream( std::shared_ptr<FileStream> pStream, size_t uiWindowSize )
+        : pStream( pStream ), uiWindowSize( std::max( uiWindowSize, (size_t)1 ) )
+    {} // constructor
+
+    /// @brief returns the next read of the window (refills the window using rReader if necessary)
+    std::shared_ptr<NucSeq> DLL_PORT( MA ) next( FileReader& rReader );
+
+    virtual bool eof( ) const
+    {
+        return vWindow.empty( ) && pStream->eof( );
+    }
+
+    virtual bool is_open( ) const
+    {
+        return pStream->is_open( );
+    }
+    virtual void close( )
+    {
+        pStream->close( );
+    }
+    virtual size_t tellg( )
+    {
+        return pStream->tellg( );
+    }
+    virtual size_t fileSize( )
+    {
+        return pStream->fileSize( );
+    }
+    virtual char peek( )
+    {
+        throw std::runtime_error( "ReadWindowStream can only be read by a FileReader" );
+    }
+    virtual char pop( )
+    {
+        throw std::runtime_error( "ReadWindowStream can only be read by a FileReader" );
+    }
+    virtual std::string fileName( )
+    {
+        return pStream->fileName( );
+    } // method
+    virtual void safeGetLine( std::string& t )
+    {
+        throw std::runtime_error( "ReadWindowStream can only be read by a FileReader" );
+    }
+}; // class
+
 using FileStreamQueue = libMS::CyclicQueue<FileStream>;
+
+/**
+ * @brief wraps all streams of pQueue into ReadWindowStreams of size uiWindowSize
+ * @details
+ * Returns pQueue itself if uiWindowSize is zero.
+ */
+inline std::shared_ptr<FileStreamQueue> windowFileStreams( std::shared_ptr<FileStreamQueue> pQueue,
+                                                           size_t uiWindowSize )
+{
+    if( uiWindowSize == 0 )
+        return pQueue;
+    auto pRet = std::make_shared<FileStreamQueue>( );
+    while( pQueue->numUnifinished( ) > 0 )
+    {
+        pRet->add( std::make_shared<ReadWindowStream>( pQueue->pop( ), uiWindowSize ) );
+        pQueue->informThatContainerIsFinished( );
+    } // while
+    return pRet;
+} // function
 class PairedFileStream : public FileStream, public std::pair<std::shared_ptr<FileStream>, std::shared_ptr<FileStream>>
 {
   public:
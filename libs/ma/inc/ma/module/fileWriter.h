@@ -7,8 +7,15 @@
 #define FILE_WRITER_H
 
 #include "ma/container/alignment.h"
+#include "ma/container/nucSeq.h"
 #include "ms/module/module.h"
 
+/// @cond DOXYGEN_SHOW_SYSTEM_INCLUDES
+#include <array>
+#include <charconv>
+#include <map>
+/// @endcond
+
 namespace libMA
 {
 
@@ -20,7 +27,7 @@ namespace libMA
 class OutStream
 {
   public:
-    virtual OutStream& operator<<( std::string )
+    virtual OutStream& operator<<( const std::string& )
     {
         return *this;
     };
@@ -36,7 +43,7 @@ class OutStream
 class StdOutStream : public OutStream
 {
   public:
-    StdOutStream& operator<<( std::string s )
+    StdOutStream& operator<<( const std::string& s )
     {
         std::cout << s << std::flush;
         return *this;
@@ -66,13 +73,173 @@ class FileOutStream : public OutStream
         file.close( );
     } // deconstructor
 
-    FileOutStream& operator<<( std::string s )
+    FileOutStream& operator<<( const std::string& s )
     {
         file << s << std::flush;
         return *this;
     } // function
 }; // class
 
+/**
+ * @brief restores the order of the reads in the output of the file writers.
+ * @details
+ * Holds back the SAM lines of a read until the lines of all reads that precede it in its FileStream have been written.
+ * The reads of different streams do not wait for each other.
+ * Reads that have not been read by a FileReader (NucSeq::uiStreamId == 0) are written immediately.
+ * Not thread safe: the writers call write under their lock.
+ */
+class ReadOrderBuffer
+{
+    /// @brief stream id -> (index of the next read to write, held back lines by read index)
+    std::map<size_t, std::pair<uint64_t, std::map<uint64_t, std::string>>> xStreams;
+
+  public:
+    /// @brief returns a new buffer if "Restore Read Order" is set and nullptr otherwise
+    static std::shared_ptr<ReadOrderBuffer> make( const ParameterSetManager& rParameters )
+    {
+        if( rParameters.pGeneralParameterSet->pbRestoreReadOrder->get( ) )
+            return std::make_shared<ReadOrderBuffer>( );
+        return nullptr;
+    } // method
+
+    /**
+     * @brief writes sLines (the output for rQuery) as soon as all preceding reads of its stream are written
+     * @details
+     * sLines is only moved from if it has to be held back; otherwise it is written directly, so that the caller can
+     * keep using its capacity.
+     */
+    void write( OutStream& rOut, const NucSeq& rQuery, std::string&& sLines )
+    {
+        if( rQuery.uiStreamId == 0 )
+        {
+            rOut << sLines;
+            return;
+        } // if
+        auto& rStream = xStreams[ rQuery.uiStreamId ];
+        if( rQuery.uiIndexInStream != rStream.first )
+        {
+            rStream.second.emplace( rQuery.uiIndexInStream, std::move( sLines ) );
+            return;
+        } // if
+        if( !sLines.empty( ) )
+            rOut << sLines;
+        rStream.first++;
+        while( !rStream.second.empty( ) && rStream.second.begin( )->first == rStream.first )
+        {
+            if( !rStream.second.begin( )->second.empty( ) )
+                rOut << rStream.second.begin( )->second;
+            rStream.second.erase( rStream.second.begin( ) );
+            rStream.first++;
+        } // while
+    } // method
+
+    /**
+     * @brief writes all held back lines in read order, skipping the reads that never arrived
+     * @details
+     * Called when the writer is closed. Lines are only held back at that point if reads of a stream got lost, so a
+     * warning is printed. Returns the number of reads that were held back.
+     */
+    size_t flush( OutStream& rOut )
+    {
+        size_t uiNumHeldBack = numHeldBack( );
+        if( uiNumHeldBack == 0 )
+            return 0;
+        std::cerr << "WARNING: " << uiNumHeldBack
+                  << " reads were held back until the output was closed, since preceding reads are missing"
+                  << std::endl;
+        for( auto& rStream : xStreams )
+        {
+            for( auto& rLines : rStream.second.second )
+                if( !rLines.second.empty( ) )
+                    rOut << rLines.second;
+            rStream.second.second.clear( );
+        } // for
+        return uiNumHeldBack;
+    } // method
+
+    /// @brief number of reads that are held back
+    size_t numHeldBack( ) const
+    {
+        size_t uiRet = 0;
+        for( auto& rStream : xStreams )
+            uiRet += rStream.second.second.size( );
+        return uiRet;
+    } // method
+}; // class
+
+/**
+ * @brief appends the decimal representation of a number to sOut.
+ */
+template <typename TP> inline void appendNumber( std::string& sOut, TP xNumber )
+{
+    char aBuffer[ 24 ];
+    auto xResult = std::to_chars( aBuffer, aBuffer + sizeof( aBuffer ), xNumber );
+    sOut.append( aBuffer, xResult.ptr );
+} // function
+
+/**
+ * @brief appends the CIGAR of rAlignment to sOut.
+ * @details
+ * Same output as Alignment::cigarString and Alignment::cigarStringWithMInsteadOfXandEqual, but does not create
+ * temporary strings and does not reverse the alignment for reverse strand alignments.
+ */
+void DLL_PORT( MA ) appendCigar( std::string& sOut, const Alignment& rAlignment, const Pack& rPack,
+                                 size_t uiQuerySize, bool bSoftClip, bool bMInsteadOfXAndEqual );
+
+/**
+ * @brief buffer for the SAM records of one read.
+ * @details
+ * The file writers format all records of a read into the thread local instance of this class (see local()).
+ * The buffer keeps its capacity across reads and the SEQ of a read is translated at most once per orientation,
+ * regardless of how many records are written for the read.
+ */
+class SamLineBuffer
+{
+    /// @brief SEQ of a read in forward and reverse complement orientation; filled on first use
+    struct SeqCache
+    {
+        const NucSeq* pQuery = nullptr;
+        bool bForwValid = false;
+        bool bRevCompValid = false;
+        std::string sForw;
+        std::string sRevComp;
+    }; // struct
+    /// @brief two entries for paired reads
+    std::array<SeqCache, 2> aSeqCache;
+
+    const std::string& DLL_PORT( MA ) seq( const NucSeq& rQuery, bool bRevComp );
+
+  public:
+    /// @brief the SAM records of the current read
+    std::string sLines;
+
+    /// @brief the buffer of the calling thread
+    static SamLineBuffer& local( )
+    {
+        thread_local SamLineBuffer xBuffer;
+        return xBuffer;
+    } // method
+
+    /// @brief clears the records and forgets the cached sequences
+    void startRead( )
+    {
+        sLines.clear( );
+        for( auto& rCache : aSeqCache )
+            rCache.pQuery = nullptr;
+    } // method
+
+    /**
+     * @brief appends the SEQ of rQuery from uiFrom to uiTo.
+     * @details
+     * If bRevComp is set, the reverse complement is appended (uiFrom and uiTo are positions on the forward strand,
+     * like in NucSeq::fromToComplement).
+     */
+    void DLL_PORT( MA ) appendSeq( const NucSeq& rQuery, nucSeqIndex uiFrom, nucSeqIndex uiTo, bool bRevComp );
+
+    /// @brief appends the QUAL of rQuery from uiFrom to uiTo or '*' if the query has no qualities.
+    void DLL_PORT( MA ) appendQual( const NucSeq& rQuery, nucSeqIndex uiFrom, nucSeqIndex uiTo );
+}; // class
+
 class TagGenerator
 {
   public:
@@ -93,6 +260,7 @@ class TagGenerator
     const size_t uiMaxCigarLen = 0x10000; // NGMLR SAM emulation
     const bool bForcedConsistentConsequtiveInsertionDeletionOrder; // NGMLR SAM emulation
     const bool bSoftClip;
+    const bool bOmitSecondarySeq;
 
     TagGenerator( const ParameterSetManager& rParameters )
         : bMDTag( rParameters.getSelected( )->xEmulateNgmlrTags->get( ) ),
@@ -109,18 +277,19 @@ class TagGenerator
           bSATag( rParameters.getSelected( )->xEmulateNgmlrTags->get( ) ),
           bCGTag( rParameters.getSelected( )->xCGTag->get( ) ),
           bForcedConsistentConsequtiveInsertionDeletionOrder( rParameters.getSelected( )->xEmulateNgmlrTags->get( ) ),
-          bSoftClip( rParameters.getSelected( )->xSoftClip->get( ) )
+          bSoftClip( rParameters.getSelected( )->xSoftClip->get( ) ),
+          bOmitSecondarySeq( rParameters.getSelected( )->xOmitSecondarySeq->get( ) )
     {} // constructor
 
-    std::string computeTag( const std::shared_ptr<NucSeq> pQuery,
-                            const std::shared_ptr<Alignment>
-                                pAlignment,
-                            const std::shared_ptr<Pack>
-                                pPack,
-                            const std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>>
-                                pvAllAlignments ) const
+    /// @brief appends the SAM tags of pAlignment to sTag; every tag starts with a '\t'
+    void appendTag( std::string& sTag, const std::shared_ptr<NucSeq> pQuery,
+                    const std::shared_ptr<Alignment>
+                        pAlignment,
+                    const std::shared_ptr<Pack>
+                        pPack,
+                    const std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>>
+                        pvAllAlignments ) const
     {
-        std::string sTag = "";
         if( bMDTag )
         {
             sTag.append( "\tMD:Z:" );
@@ -139,7 +308,7 @@ class TagGenerator
                     uiNumMatchesAndSeeds > 0 )
                 {
                     // append the number of seeds and matches
-                    sTag.append( std::to_string( uiNumMatchesAndSeeds ) );
+                    appendNumber( sTag, uiNumMatchesAndSeeds );
                     uiNumMatchesAndSeeds = 0;
                 } // if
                 bool bFirst = !bLastWasDeletion;
@@ -184,7 +353,7 @@ class TagGenerator
                 } // switch
             } // for
             if( uiNumMatchesAndSeeds > 0 )
-                sTag.append( std::to_string( uiNumMatchesAndSeeds ) );
+                appendNumber( sTag, uiNumMatchesAndSeeds );
         } // if
         if( bSVTag )
         {
@@ -214,18 +383,20 @@ class TagGenerator
                 uiTag += 1;
             if( pAlignment->uiEndOnQuery - pAlignment->uiBeginOnQuery >= pQuery->length( ) * 0.95 || bSoftClip )
                 uiTag += 2;
-            sTag.append( "\tSV:i:" ).append( std::to_string( uiTag ) );
+            sTag.append( "\tSV:i:" );
+            appendNumber( sTag, uiTag );
         } // if
         if( bASTag )
         {
             // the alignment score
-            sTag.append( "\tAS:i:" ).append( std::to_string( pAlignment->score( ) ) );
+            sTag.append( "\tAS:i:" );
+            appendNumber( sTag, pAlignment->score( ) );
         } // if
         if( bNMTag )
         {
             // see function pAlignment->getNumDifferences
-            sTag.append( "\tNM:i:" )
-                .append( std::to_string( pAlignment->getNumDifferences( pPack, bNMTagDoNOTCountIndels ) ) );
+            sTag.append( "\tNM:i:" );
+            appendNumber( sTag, pAlignment->getNumDifferences( pPack, bNMTagDoNOTCountIndels ) );
         } // if
         if( bXITag )
         {
@@ -249,14 +420,16 @@ class TagGenerator
              *
              * @note: actually NGMLR outputs the alignment score as the XE tag
              */
-            sTag.append( "\tXE:i:" ).append( std::to_string( pAlignment->score( ) ) );
+            sTag.append( "\tXE:i:" );
+            appendNumber( sTag, pAlignment->score( ) );
         } // if
         if( bXRTag )
         {
             /*
              * XR is length of alignment on query
              */
-            sTag.append( "\tXR:i:" ).append( std::to_string( pAlignment->uiEndOnQuery - pAlignment->uiBeginOnQuery ) );
+            sTag.append( "\tXR:i:" );
+            appendNumber( sTag, pAlignment->uiEndOnQuery - pAlignment->uiBeginOnQuery );
         } // if
         if( bCVTag )
         {
@@ -276,8 +449,10 @@ class TagGenerator
              * Conventionally, at a supplementary line, the first element points to the primary line:
              * We hold this convention implicitly, since our alignments are sorted by score...
              */
+            // the tag is written directly; it is removed again if there are no sister alignments
+            const size_t uiTagStart = sTag.size( );
             bool bFoundSupplementarySisters = false;
-            std::string sSATag;
+            sTag.append( "\tSA:Z:" );
 
             for( auto pOtherAlignment : *pvAllAlignments )
             {
@@ -288,40 +463,38 @@ class TagGenerator
                 if( pOtherAlignment->xStats.bFirst != pAlignment->xStats.bFirst )
                     continue;
                 bFoundSupplementarySisters = true;
-                sSATag.append( pOtherAlignment->getContig( *pPack ) ).append( "," );
-                sSATag.append( std::to_string( pOtherAlignment->getSamPosition( *pPack ) ) ).append( "," );
-                sSATag.append( ( pPack->bPositionIsOnReversStrand( pOtherAlignment->uiBeginOnRef ) ? "-," : "+," ) );
-                sSATag
-                    .append( bOutputMInsteadOfXAndEqual
-                                 ? pOtherAlignment->cigarStringWithMInsteadOfXandEqual( *pPack, pQuery->length( ),
-                                                                                        bSoftClip )
-                                 : pOtherAlignment->cigarString( *pPack, pQuery->length( ), bSoftClip ) )
-                    .append( "," );
-
-                std::string sMapQual;
+                sTag.append( pPack->nameOfSequenceWithId(
+                                 pPack->uiSequenceIdForPosition( pOtherAlignment->uiBeginOnRef ) ) )
+                    .push_back( ',' );
+                appendNumber( sTag, pOtherAlignment->getSamPosition( *pPack ) );
+                sTag.push_back( ',' );
+                sTag.append( ( pPack->bPositionIsOnReversStrand( pOtherAlignment->uiBeginOnRef ) ? "-," : "+," ) );
+                appendCigar( sTag, *pOtherAlignment, *pPack, pQuery->length( ), bSoftClip,
+                             bOutputMInsteadOfXAndEqual );
+                sTag.push_back( ',' );
+
                 if( std::isnan( pOtherAlignment->fMappingQuality ) )
-                    sMapQual = "255";
+                    sTag.append( "255" );
                 else
-                    sMapQual =
-                        std::to_string( static_cast<int>( std::ceil( pOtherAlignment->fMappingQuality * 254 ) ) );
-                sSATag.append( sMapQual ).append( "," );
-                sSATag.append( std::to_string( pAlignment->getNumDifferences( pPack, bNMTagDoNOTCountIndels ) ) );
+                    appendNumber( sTag, static_cast<int>( std::ceil( pOtherAlignment->fMappingQuality * 254 ) ) );
+                sTag.push_back( ',' );
+                appendNumber( sTag, pAlignment->getNumDifferences( pPack, bNMTagDoNOTCountIndels ) );
 
-                sSATag.append( ";" );
+                sTag.push_back( ';' );
             } // for
 
-            if( bFoundSupplementarySisters )
-                sTag.append( "\tSA:Z:" ).append( sSATag );
+            if( !bFoundSupplementarySisters )
+                sTag.resize( uiTagStart );
         } // if
         if( bQS_QETag )
         {
             /*
              * Output start and end of alignment on read
              */
-            sTag.append( "\tQS:i:" )
-                .append( std::to_string( pAlignment->uiBeginOnQuery ) )
-                .append( "\tQE:i:" )
-                .append( std::to_string( pAlignment->uiEndOnQuery ) );
+            sTag.append( "\tQS:i:" );
+            appendNumber( sTag, pAlignment->uiBeginOnQuery );
+            sTag.append( "\tQE:i:" );
+            appendNumber( sTag, pAlignment->uiEndOnQuery );
         } // if
         // check if the total number of CIGAR operations is too large
         if( bCGTag && pAlignment->data.size( ) >= uiMaxCigarLen )
@@ -351,9 +524,22 @@ class TagGenerator
                 } // switch
 
                 uint32_t uiOut = ( uint32_t )( rPair.second << 4 ) | uiOperation;
-                sTag.append( "," ).append( std::to_string( uiOut ) );
+                sTag.push_back( ',' );
+                appendNumber( sTag, uiOut );
             } // for
         } // if
+    } // method
+
+    std::string computeTag( const std::shared_ptr<NucSeq> pQuery,
+                            const std::shared_ptr<Alignment>
+                                pAlignment,
+                            const std::shared_ptr<Pack>
+                                pPack,
+                            const std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>>
+                                pvAllAlignments ) const
+    {
+        std::string sTag;
+        appendTag( sTag, pQuery, pAlignment, pPack, pvAllAlignments );
         return sTag;
     } // method
 }; // class
@@ -371,6 +557,8 @@ class FileWriter
     // holds a file ourstream if necessary
     std::shared_ptr<OutStream> pOut;
     std::shared_ptr<std::mutex> pLock;
+    /// @brief restores the read order if "Restore Read Order" is set (nullptr otherwise); shared with synced writers
+    std::shared_ptr<ReadOrderBuffer> pReadOrder;
     const bool bNoSecondary;
     const bool bNoSupplementary;
 
@@ -384,6 +572,7 @@ class FileWriter
     FileWriter( const ParameterSetManager& rParameters, std::string sFileName, std::shared_ptr<Pack> pPackContainer )
         : TagGenerator( rParameters ),
           pLock( new std::mutex ),
+          pReadOrder( ReadOrderBuffer::make( rParameters ) ),
           bNoSecondary( rParameters.getSelected( )->xNoSecondary->get( ) ),
           bNoSupplementary( rParameters.getSelected( )->xNoSupplementary->get( ) )
     {
@@ -409,6 +598,7 @@ class FileWriter
         : TagGenerator( rParameters ),
           pOut( pOut ),
           pLock( new std::mutex ),
+          pReadOrder( ReadOrderBuffer::make( rParameters ) ),
           bNoSecondary( rParameters.getSelected( )->xNoSecondary->get( ) ),
           bNoSupplementary( rParameters.getSelected( )->xNoSupplementary->get( ) )
     {
@@ -430,6 +620,7 @@ class FileWriter
         : TagGenerator( rParameters ),
           pOut( pOther->pOut ),
           pLock( pOther->pLock ),
+          pReadOrder( pOther->pReadOrder ),
           bNoSecondary( rParameters.getSelected( )->xNoSecondary->get( ) ),
           bNoSupplementary( rParameters.getSelected( )->xNoSupplementary->get( ) )
     {} // constructor
@@ -441,11 +632,22 @@ class FileWriter
                  std::shared_ptr<Pack>
                      pPack );
 
+    /// @brief writes the reads that are held back by pReadOrder and releases the outstream
     void close( )
     {
+        if( pReadOrder != nullptr && pOut != nullptr )
+        {
+            std::lock_guard<std::mutex> xGuard( *pLock );
+            pReadOrder->flush( *pOut );
+        } // if
         pOut.reset( );
     } // method
 
+    ~FileWriter( )
+    {
+        close( );
+    } // deconstructor
+
 }; // class
 
 /**
@@ -461,6 +663,8 @@ class PairedFileWriter : public libMS::Module<libMS::Container, false, NucSeq, N
     // holds a file ourstream if necessary
     std::shared_ptr<OutStream> pOut;
     std::shared_ptr<std::mutex> pLock;
+    /// @brief restores the read order if "Restore Read Order" is set (nullptr otherwise); shared with synced writers
+    std::shared_ptr<ReadOrderBuffer> pReadOrder;
     const bool bNoSecondary;
     const bool bNoSupplementary;
 
@@ -475,6 +679,7 @@ class PairedFileWriter : public libMS::Module<libMS::Container, false, NucSeq, N
                       std::shared_ptr<Pack> pPackContainer )
         : TagGenerator( rParameters ),
           pLock( new std::mutex ),
+          pReadOrder( ReadOrderBuffer::make( rParameters ) ),
           bNoSecondary( rParameters.getSelected( )->xNoSecondary->get( ) ),
           bNoSupplementary( rParameters.getSelected( )->xNoSupplementary->get( ) )
     {
@@ -500,6 +705,7 @@ class PairedFileWriter : public libMS::Module<libMS::Container, false, NucSeq, N
         : TagGenerator( rParameters ),
           pOut( pOut ),
           pLock( new std::mutex ),
+          pReadOrder( ReadOrderBuffer::make( rParameters ) ),
           bNoSecondary( rParameters.getSelected( )->xNoSecondary->get( ) ),
           bNoSupplementary( rParameters.getSelected( )->xNoSupplementary->get( ) )
     {
@@ -521,6 +727,7 @@ class PairedFileWriter : public libMS::Module<libMS::Container, false, NucSeq, N
         : TagGenerator( rParameters ),
           pOut( pOther->pOut ),
           pLock( pOther->pLock ),
+          pReadOrder( pOther->pReadOrder ),
           bNoSecondary( rParameters.getSelected( )->xNoSecondary->get( ) ),
           bNoSupplementary( rParameters.getSelected( )->xNoSupplementary->get( ) )
     {} // constructor
@@ -535,6 +742,7 @@ class PairedFileWriter : public libMS::Module<libMS::Container, false, NucSeq, N
         : TagGenerator( rParameters ),
           pOut( pOther->pOut ),
           pLock( pOther->pLock ),
+          pReadOrder( pOther->pReadOrder ),
           bNoSecondary( rParameters.getSelected( )->xNoSecondary->get( ) ),
           bNoSupplementary( rParameters.getSelected( )->xNoSupplementary->get( ) )
     {} // constructor
@@ -544,10 +752,21 @@ class PairedFileWriter : public libMS::Module<libMS::Container, false, NucSeq, N
                  std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>> pAlignments,
                  std::shared_ptr<Pack> pPack );
 
+    /// @brief writes the reads that are held back by pReadOrder and releases the outstream
     void close( )
     {
+        if( pReadOrder != nullptr && pOut != nullptr )
+        {
+            std::lock_guard<std::mutex> xGuard( *pLock );
+            pReadOrder->flush( *pOut );
+        } // if
         pOut.reset( );
     } // method
+
+    ~PairedFileWriter( )
+    {
+        close( );
+    } // deconstructor
 }; // class
 
 } // namespace libMA
@@ -13,6 +13,7 @@
 #include "ma/module/seedFilters.h"
 #include <algorithm>
 #include <csignal>
+#include <future>
 #include <set>
 #include <unordered_map>
 
@@ -94,6 +95,25 @@ class Harmonization
     std::shared_ptr<Seeds> harmonizeOne( std::shared_ptr<Seeds>& pIn, std::shared_ptr<NucSeq> pQuery,
                                          std::shared_ptr<SoCPriorityQueue> pSoCIn );
 
+    /// @brief harmonized seeds of the forward and the reverse strand of one SoC
+    typedef std::pair<std::shared_ptr<Seeds>, std::shared_ptr<Seeds>> HarmonizedSoC;
+
+    /**
+     * @brief harmonizes the seeds of one SoC (separately for both strands).
+     * @details
+     * Only modifies pSeedsIn, so the SoCs of a read can be harmonized concurrently.
+     */
+    HarmonizedSoC harmonizeSoC( std::shared_ptr<Seeds> pSeedsIn, std::shared_ptr<NucSeq> pQuery,
+                                uint64_t uiRefSeqLength, std::shared_ptr<SoCPriorityQueue> pSoCIn );
+
+    /// @brief a SoC that was popped from the SoC queue and whose harmonization might still be running
+    struct PendingSoC
+    {
+        size_t uiNumSeeds;
+        nucSeqIndex uiSoCScore;
+        std::shared_future<HarmonizedSoC> xHarmonized;
+    }; // struct
+
   public:
     /**
      * @brief true: estimate all possible position as matches in the gap cost filter
@@ -147,6 +167,14 @@ class Harmonization
 
     const nucSeqIndex uiMinDeltaDist;
 
+    /// @brief maximal number of seeds per read (0 = unlimited); see NucSeq::spendSeeds
+    const uint64_t uiSeedBudget;
+
+    /// @brief number of threads that harmonize the SoCs of one read concurrently (0 = sequential)
+    const size_t uiSoCThreads;
+    /// @brief the SoCs of queries shorter than this are harmonized sequentially
+    const nucSeqIndex uiMinQueryLenSoCThreads;
+
     // const double dMaxSVRatio;
 
     // const int64_t iMinSVDistance;
@@ -167,15 +195,30 @@ class Harmonization
           bDoHeuristics( !rParameters.getSelected( )->xDisableHeuristics->get( ) ),
           bDoGapCostEstimationCutting( !rParameters.getSelected( )->xDisableGapCostEstimationCutting->get( ) ),
           dMaxDeltaDist( rParameters.getSelected( )->xMaxDeltaDist->get( ) ),
-          uiMinDeltaDist( rParameters.getSelected( )->xMinDeltaDist->get( ) )
+          uiMinDeltaDist( rParameters.getSelected( )->xMinDeltaDist->get( ) ),
+          uiSeedBudget( rParameters.getSelected( )->xSeedBudgetPerRead->get( ) ),
+          uiSoCThreads( rParameters.getSelected( )->xSoCThreads->get( ) ),
+          uiMinQueryLenSoCThreads( rParameters.getSelected( )->xMinQueryLenSoCThreads->get( ) )
     // dMaxSVRatio( rParameters.getSelected( )->xMaxSVRatio->get( ) ),
     // iMinSVDistance( rParameters.getSelected( )->xMinSVDistance->get( ) ),
     {} // default constructor
 
+    /**
+     * @brief harmonizes the SoCs of pQuery
+     * @details
+     * uiRefSeqLength is the length of the forward plus reverse strand of the reference.
+     * (Used by modules that do not have an FMIndex; e.g. ShardedHarmonization.)
+     */
+    std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Seeds>>> DLL_PORT( MA )
+        harmonize( std::shared_ptr<SoCPriorityQueue> pSoCIn, std::shared_ptr<NucSeq> pQuery, uint64_t uiRefSeqLength );
+
     // overload
     virtual std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Seeds>>> DLL_PORT( MA )
         execute( std::shared_ptr<SoCPriorityQueue> pSoCIn, std::shared_ptr<NucSeq> pQuery,
-                 std::shared_ptr<FMIndex> pFM_Index );
+                 std::shared_ptr<FMIndex> pFM_Index )
+    {
+        return harmonize( pSoCIn, pQuery, pFM_Index->getRefSeqLength( ) );
+    } // method
 
 }; // class
 
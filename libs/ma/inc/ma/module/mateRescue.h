@@ -0,0 +1,148 @@
+/**
+ * @file mateRescue.h
+ * @brief Aligns the second mate of a read pair within a window around the first mate.
+ */
+#pragma once
+
+#include "ma/container/alignment.h"
+#include "ma/module/binarySeeding.h"
+#include "ma/module/harmonization.h"
+#include "ma/module/mappingQuality.h"
+#include "ma/module/needlemanWunsch.h"
+#include "ma/module/shardedSeeding.h"
+#include "ma/module/stripOfConsideration.h"
+#include "ms/module/module.h"
+
+namespace libMA
+{
+/**
+ * @brief Aligns the second mate of a read pair using the alignment of the first mate.
+ * @ingroup module
+ * @details
+ * If the best alignment of the first mate is confident (mapping quality >= fMinMapQ),
+ * the second mate is expected on the opposite strand within mean +- 3 * std of the first mate.
+ * In this case the second mate is seeded against that reference window only:
+ * The k-mers of the query are hashed into 2 bit packed integers and looked up for each window position;
+ * consecutive k-mer hits on a diagonal are merged into maximal seeds.
+ * The window seeds are processed by the regular SoC, harmonization and DP modules.
+ * If this does not yield an alignment with a score of at least fMinScore * (maximal possible score),
+ * the second mate is seeded on the whole genome (the same computation as setUpCompGraph performs).
+ */
+class MateRescue : public libMS::Module<libMS::ContainerVector<std::shared_ptr<Alignment>>, false,
+                                        NucSeq, // Query of the mate that shall be aligned
+                                        libMS::ContainerVector<std::shared_ptr<Alignment>>, // alignments other mate
+                                        FMIndex, Pack>
+{
+  public:
+    BinarySeeding xSeeding;
+    StripOfConsideration xSoC;
+    StripOfConsiderationSeeds xSoCSeeds;
+    Harmonization xHarmonization;
+    NeedlemanWunsch xDP;
+    MappingQuality xMappingQuality;
+
+    ///@brief the mean of the insert size
+    const double dMean;
+    ///@brief the standard deviation of the insert size
+    const double dStd;
+    ///@brief minimal mapping quality of the other mate for a rescue attempt
+    const double fMinMapQ;
+    ///@brief minimal score of a rescued alignment relative to the maximal possible score
+    const double fMinScore;
+    ///@brief seeds are split on strands (i.e. no rectangular SoCs)
+    const bool bSplitStrands;
+    ///@brief k-mer size for the window seeding (at most 32 so that k-mers fit into 64 bit)
+    const nucSeqIndex uiSeedSize;
+
+    MateRescue( const ParameterSetManager& rParameters )
+        : xSeeding( rParameters ),
+          xSoC( rParameters ),
+          xSoCSeeds( rParameters ),
+          xHarmonization( rParameters ),
+          xDP( rParameters ),
+          xMappingQuality( rParameters ),
+          dMean( rParameters.getSelected( )->xMeanPairedReadDistance->get( ) ),
+          dStd( rParameters.getSelected( )->xStdPairedReadDistance->get( ) ),
+          fMinMapQ( rParameters.getSelected( )->xMateRescueMinMapQ->get( ) ),
+          fMinScore( rParameters.getSelected( )->xMateRescueMinScore->get( ) ),
+          bSplitStrands( !rParameters.getSelected( )->xRectangularSoc->get( ) ),
+          uiSeedSize( std::min( (nucSeqIndex)rParameters.getSelected( )->xMinSeedLength->get( ), (nucSeqIndex)32 ) )
+    {} // constructor
+
+    /**
+     * @brief Computes the seeds of pQuery within the window of the reference, where the mate is expected.
+     * @details
+     * The seeds are returned in the format of ExtractSeeds (reverse strand seeds are mirrored and have their
+     * delta values set), so that they can be processed by the StripOfConsiderationSeeds module.
+     * Returns an empty seed set if pAlignment is not in a position to rescue its mate.
+     */
+    std::shared_ptr<Seeds> DLL_PORT( MA ) windowSeeds( std::shared_ptr<NucSeq> pQuery,
+                                                       std::shared_ptr<Alignment> pAlignment,
+                                                       std::shared_ptr<Pack> pPack );
+
+    /**
+     * @brief Aligns pQuery within the window of the reference, where the mate is expected.
+     * @details
+     * Returns nullptr if the other mate is not confident enough or if the rescued alignment does not reach
+     * fMinScore. Does not require an index: uiRefSeqLength is the length of the reference (both strands).
+     */
+    std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>> DLL_PORT( MA )
+        rescue( std::shared_ptr<NucSeq> pQuery,
+                std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>>
+                    pOtherAlignments,
+                uint64_t uiRefSeqLength,
+                std::shared_ptr<Pack>
+                    pPack );
+
+    /// @brief Aligns pQuery on the whole genome.
+    std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>> DLL_PORT( MA )
+        fullAlignment( std::shared_ptr<NucSeq> pQuery, std::shared_ptr<FMIndex> pFMIndex, std::shared_ptr<Pack> pPack );
+
+    // overload
+    virtual std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>> DLL_PORT( MA )
+        execute( std::shared_ptr<NucSeq> pQuery,
+                 std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>>
+                     pOtherAlignments,
+                 std::shared_ptr<FMIndex>
+                     pFMIndex,
+                 std::shared_ptr<Pack>
+                     pPack );
+}; // class
+
+/**
+ * @brief The MateRescue module for a ShardedFMIndex.
+ * @ingroup module
+ * @details
+ * The window alignment is the one of MateRescue; the fallback seeds on all shards (see ShardedSeeding).
+ */
+class ShardedMateRescue : public libMS::Module<libMS::ContainerVector<std::shared_ptr<Alignment>>, false,
+                                               NucSeq, // Query of the mate that shall be aligned
+                                               libMS::ContainerVector<std::shared_ptr<Alignment>>, // other mate
+                                               ShardedFMIndex, Pack>
+{
+  public:
+    MateRescue xRescue;
+    ShardedSeeding xSeeding;
+
+    ShardedMateRescue( const ParameterSetManager& rParameters ) : xRescue( rParameters ), xSeeding( rParameters )
+    {} // constructor
+
+    // overload
+    virtual std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>> DLL_PORT( MA )
+        execute( std::shared_ptr<NucSeq> pQuery,
+                 std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>>
+                     pOtherAlignments,
+                 std::shared_ptr<ShardedFMIndex>
+                     pIndex,
+                 std::shared_ptr<Pack>
+                     pPack );
+}; // class
+} // namespace libMA
+
+#ifdef WITH_PYTHON
+/**
+ * @brief export the MateRescue and ShardedMateRescue @ref libMA::Module "modules" to python.
+ * @ingroup export
+ */
+void exportMateRescue( libMS::SubmoduleOrganizer& xOrganizer );
+#endif
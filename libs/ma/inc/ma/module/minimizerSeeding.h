@@ -37,12 +37,7 @@ class MinimizerSeeding : public libMS::Module<Seeds, false, minimizer::Index, Nu
     std::shared_ptr<Seeds> execute( std::shared_ptr<minimizer::Index> pMMIndex, std::shared_ptr<NucSeq> pQuery,
                                     std::shared_ptr<Pack> pPack )
     {
-        pQuery->vTranslateToCharacterForm( );
-        const char* sSeq = (const char*)pQuery->pxSequenceRef;
-        const int iSize = (int)pQuery->length( );
-        auto pRet = pMMIndex->seed_one( sSeq, iSize, bRectangular, pPack );
-        pQuery->vTranslateToNumericForm( );
-        return pRet;
+        return pMMIndex->seed_one( *pQuery, bRectangular, pPack );
     } // method
 }; // class
 
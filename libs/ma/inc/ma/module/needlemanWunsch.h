@@ -40,6 +40,43 @@ class Wrapper_ksw_extz_t
         free( ez->cigar ); // malloced in c code
         delete ez; // allocated by new in cpp code
     } // default constructor
+
+    Wrapper_ksw_extz_t( const Wrapper_ksw_extz_t& ) = delete; // the cigar would be freed twice
+}; // class
+
+/**
+ * @brief scratch memory of the DP modules that is reused across reads
+ * @details
+ * Holds the DP matrices and traceback of kswcpp, the CIGAR storage of the DPs and a buffer for the extracted
+ * reference window. Once the workspace has seen the largest DP of a run, aligning a read does not allocate DP memory
+ * anymore (see AlignedMemoryManager::uiNumAllocations). Exception: kswcpp buffers above the high-water mark
+ * (AlignedMemoryManager::uiMaxKeptBytes) are freed after each DP, so that a single huge DP does not pin its memory for
+ * the lifetime of the thread.
+ * The modules of a computational graph are executed by the (fixed) worker threads of the graph, so local() hands out
+ * one workspace per thread, which lives as long as that thread.
+ * A workspace must only be used by one DP at a time: ksw, ksw_dual_ext and dynPrg do not call each other while they
+ * hold the CIGAR storage.
+ */
+class DPWorkspace
+{
+  public:
+    AlignedMemoryManager xMemoryManager;
+    // CIGAR storage of the DPs; xEz2 is only required by ksw_dual_ext
+    Wrapper_ksw_extz_t xEz, xEz2;
+    // reference window of NeedlemanWunsch::execute_one and SmallInversions
+    std::shared_ptr<NucSeq> pRefWindow;
+
+    DPWorkspace( ) : pRefWindow( std::make_shared<NucSeq>( ) )
+    {} // default constructor
+
+    DPWorkspace( const DPWorkspace& ) = delete;
+
+    /// @brief the workspace of the calling thread
+    static DPWorkspace& local( )
+    {
+        static thread_local DPWorkspace xWorkspace;
+        return xWorkspace;
+    } // method
 }; // class
 
 /**
@@ -59,16 +96,16 @@ class NeedlemanWunsch : public libMS::Module<libMS::ContainerVector<std::shared_
         dynPrg( const std::shared_ptr<NucSeq> pQuery, const std::shared_ptr<NucSeq> pRef, const nucSeqIndex fromQuery,
                 const nucSeqIndex toQuery, const nucSeqIndex fromRef, const nucSeqIndex toRef,
                 std::shared_ptr<Alignment> pAlignment, // in & output
-                AlignedMemoryManager& rMemoryManager, const bool bLocalBeginning, const bool bLocalEnd );
+                DPWorkspace& rWorkspace, const bool bLocalBeginning, const bool bLocalEnd );
 
     void DLL_PORT( MA )
         ksw_dual_ext( std::shared_ptr<NucSeq> pQuery, std::shared_ptr<NucSeq> pRef, nucSeqIndex fromQuery,
                       nucSeqIndex toQuery, nucSeqIndex fromRef, nucSeqIndex toRef,
-                      std::shared_ptr<Alignment> pAlignment, AlignedMemoryManager& rMemoryManager );
+                      std::shared_ptr<Alignment> pAlignment, DPWorkspace& rWorkspace );
 
     void DLL_PORT( MA ) ksw( std::shared_ptr<NucSeq> pQuery, std::shared_ptr<NucSeq> pRef, nucSeqIndex fromQuery,
                              nucSeqIndex toQuery, nucSeqIndex fromRef, nucSeqIndex toRef,
-                             std::shared_ptr<Alignment> pAlignment, AlignedMemoryManager& rMemoryManager );
+                             std::shared_ptr<Alignment> pAlignment, DPWorkspace& rWorkspace );
 
   private:
     const KswCppParam<5> xKswParameters;
@@ -84,6 +121,20 @@ class NeedlemanWunsch : public libMS::Module<libMS::ContainerVector<std::shared_
     const int iMinBandwidthGapFilling;
     // bandwidth when extending the edge of an alignment
     const int iBandwidthDPExtension;
+    // maximal number of DP cells per read (0 = unlimited); see NucSeq::spendDPCells
+    const uint64_t uiDPCellBudget;
+    // number of threads that align the seed sets of one read concurrently (0 = sequential)
+    const size_t uiSoCThreads;
+    // the seed sets of queries shorter than this are aligned sequentially
+    const nucSeqIndex uiMinQueryLenSoCThreads;
+
+    /// @brief approximate number of cells of a banded DP over uiQ x uiR (the band is widened to the diagonal)
+    static inline uint64_t dpCells( nucSeqIndex uiQ, nucSeqIndex uiR, int iBandwidth )
+    {
+        const nucSeqIndex uiDiagonal = uiQ > uiR ? uiQ - uiR : uiR - uiQ;
+        const uint64_t uiBand = 2 * std::max( (nucSeqIndex)iBandwidth, uiDiagonal ) + 1;
+        return (uint64_t)uiQ * std::min( (uint64_t)uiR, uiBand );
+    } // method
 
   public:
     bool bLocal = false;
@@ -100,26 +151,47 @@ class NeedlemanWunsch : public libMS::Module<libMS::ContainerVector<std::shared_
           uiMissMatch( pGlobalParams->iMissMatch->get( ) ),
           uiZDrop( rParameters.getSelected( )->xZDrop->get( ) ),
           iMinBandwidthGapFilling( rParameters.getSelected( )->xMinBandwidthGapFilling->get( ) ),
-          iBandwidthDPExtension( rParameters.getSelected( )->xBandwidthDPExtension->get( ) ){ }; // default constructor
+          iBandwidthDPExtension( rParameters.getSelected( )->xBandwidthDPExtension->get( ) ),
+          uiDPCellBudget( rParameters.getSelected( )->xDPCellBudgetPerRead->get( ) ),
+          uiSoCThreads( rParameters.getSelected( )->xSoCThreads->get( ) ),
+          uiMinQueryLenSoCThreads( rParameters.getSelected( )->xMinQueryLenSoCThreads->get( ) )
+    {} // default constructor
 
 
     std::shared_ptr<Alignment> DLL_PORT( MA )
         execute_one( std::shared_ptr<Seeds> pSeeds, std::shared_ptr<NucSeq> pQuery, std::shared_ptr<Pack> pRefPack,
-                     AlignedMemoryManager& rMemoryManager );
+                     DPWorkspace& rWorkspace );
+
+    /**
+     * @brief aligns the seed sets concurrently on the shared SoC thread pool.
+     * @details
+     * Each task works on its own copy of the query, since dynPrg reverses parts of the query in place.
+     * The DP cells of all tasks are accounted to pQuery afterwards.
+     * Returns the alignments in the order of the seed sets (or none if the read exceeds its DP budget).
+     */
+    std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>> DLL_PORT( MA )
+        executeConcurrently( std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Seeds>>> pSeedSets,
+                             std::shared_ptr<NucSeq> pQuery, std::shared_ptr<Pack> pRefPack );
 
     // overload
     virtual std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>>
     execute( std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Seeds>>> pSeedSets, std::shared_ptr<NucSeq> pQuery,
              std::shared_ptr<Pack> pRefPack )
     {
-        AlignedMemoryManager xMemoryManager;
+        if( uiSoCThreads > 0 && pSeedSets->size( ) > 1 && pQuery->length( ) >= uiMinQueryLenSoCThreads )
+            return sortBestFirst( executeConcurrently( pSeedSets, pQuery, pRefPack ) );
+
+        DPWorkspace& rWorkspace = DPWorkspace::local( );
         auto pRet = std::make_shared<libMS::ContainerVector<std::shared_ptr<Alignment>>>( );
         for( auto pSeeds : *pSeedSets )
         {
             // if we have a seed set with an inversion we need to generate two alignments...
             // if( !pSeeds->mainStrandIsForward( ) )
             //    pSeeds->mirror( pRefPack->uiStartOfReverseStrand( ), pQuery->length( ) );
-            pRet->push_back( execute_one( pSeeds, pQuery, pRefPack, xMemoryManager ) );
+            pRet->push_back( execute_one( pSeeds, pQuery, pRefPack, rWorkspace ) );
+            // reads that exceed their DP budget are reported unmapped
+            if( pQuery->bOverBudget )
+                return std::make_shared<libMS::ContainerVector<std::shared_ptr<Alignment>>>( );
 
             // auto pRevSeeds = pSeeds->splitOnStrands( pRefPack->uiStartOfReverseStrand( ), pQuery->length() );
             // if( !pRevSeeds->empty( ) )
@@ -127,10 +199,16 @@ class NeedlemanWunsch : public libMS::Module<libMS::ContainerVector<std::shared_
             // if( !pSeeds->empty( ) )
             //    pRet->push_back( execute_one( pSeeds, pQuery, pRefPack, xMemoryManager ) );
         } // for
-        // we need to move the best alignment to the first spot
-        std::sort( pRet->begin( ), pRet->end( ),
+        return sortBestFirst( pRet );
+    } // function
+
+    // we need to move the best alignment to the first spot
+    static std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>>
+    sortBestFirst( std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>> pAlignments )
+    {
+        std::sort( pAlignments->begin( ), pAlignments->end( ),
                    []( std::shared_ptr<Alignment>& pA, std::shared_ptr<Alignment>& pB ) { return pA->larger( pB ); } );
-        return pRet;
+        return pAlignments;
     } // function
 
 }; // class
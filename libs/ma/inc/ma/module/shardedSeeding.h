@@ -0,0 +1,79 @@
+/**
+ * @file shardedSeeding.h
+ * @brief Seeding and harmonization on a ShardedFMIndex.
+ */
+#ifndef SHARDED_SEEDING_H
+#define SHARDED_SEEDING_H
+
+#include "ma/container/shardedFMIndex.h"
+#include "ma/module/binarySeeding.h"
+#include "ma/module/harmonization.h"
+#include "ma/module/stripOfConsideration.h"
+
+namespace libMA
+{
+
+/**
+ * @brief Computes the seeds of a query on all shards of a ShardedFMIndex.
+ * @details
+ * Seeds each shard with the BinarySeeding module and extracts the seeds like ExtractSeeds does.
+ * The seeds are translated into the coordinates of the genome's pack, so that the output can be fed into
+ * StripOfConsiderationSeeds.
+ * Seeds that bridge the end of a shard's forward strand are dropped.
+ * @note The maximal seed ambiguity is applied to each shard separately.
+ * @ingroup module
+ */
+class ShardedSeeding : public libMS::Module<Seeds, false, ShardedFMIndex, NucSeq, Pack>
+{
+    BinarySeeding xSeeding;
+    const unsigned int uiMaxAmbiguity;
+    const size_t uiMinSeedSize;
+    const bool bRectangular;
+
+  public:
+    ShardedSeeding( const ParameterSetManager& rParameters )
+        : xSeeding( rParameters ),
+          uiMaxAmbiguity( rParameters.getSelected( )->xMaximalSeedAmbiguity->get( ) ),
+          uiMinSeedSize( rParameters.getSelected( )->xMinSeedLength->get( ) ),
+          bRectangular( rParameters.getSelected( )->xRectangularSoc->get( ) )
+    {} // constructor
+
+    virtual std::shared_ptr<Seeds> DLL_PORT( MA ) execute( std::shared_ptr<ShardedFMIndex> pIndex,
+                                                           std::shared_ptr<NucSeq> pQuery,
+                                                           std::shared_ptr<Pack> pPack );
+}; // class
+
+/**
+ * @brief The Harmonization module for a ShardedFMIndex.
+ * @details
+ * The Harmonization merely requires the length of the reference from the index.
+ * @ingroup module
+ */
+class ShardedHarmonization
+    : public libMS::Module<libMS::ContainerVector<std::shared_ptr<Seeds>>, false, SoCPriorityQueue, NucSeq, ShardedFMIndex>
+{
+    Harmonization xHarmonization;
+
+  public:
+    ShardedHarmonization( const ParameterSetManager& rParameters ) : xHarmonization( rParameters )
+    {} // constructor
+
+    virtual std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Seeds>>>
+    execute( std::shared_ptr<SoCPriorityQueue> pSoCIn, std::shared_ptr<NucSeq> pQuery,
+             std::shared_ptr<ShardedFMIndex> pIndex )
+    {
+        return xHarmonization.harmonize( pSoCIn, pQuery, pIndex->getRefSeqLength( ) );
+    } // method
+}; // class
+
+} // namespace libMA
+
+#ifdef WITH_PYTHON
+/**
+ * @brief exports the ShardedSeeding and ShardedHarmonization @ref libMS::Module "modules" to python.
+ * @ingroup export
+ */
+void exportShardedSeeding( libMS::SubmoduleOrganizer& xOrganizer );
+#endif
+
+#endif
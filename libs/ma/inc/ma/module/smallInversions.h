@@ -121,12 +121,12 @@ class SmallInversions : public libMS::Module<libMS::ContainerVector<std::shared_
                                                                  pQuery,
                                                              std::shared_ptr<NucSeq>
                                                                  pRef,
-                                                             AlignedMemoryManager& rMemoryManager )
+                                                             DPWorkspace& rWorkspace )
     {
-        Wrapper_ksw_extz_t ez;
+        Wrapper_ksw_extz_t& ez = rWorkspace.xEz;
         kswcpp_dispatch( (int)uiQTo - (int)uiQFrom, pQuery->pGetSequenceRef( ) + uiQFrom, (int)pRef->length( ),
                          pRef->pGetSequenceRef( ), xKswParameters, (int)uiBandwidth, (int)uiZDrop, 0, ez.ez,
-                         rMemoryManager );
+                         rWorkspace.xMemoryManager );
         auto pRet = std::make_shared<Alignment>( );
 
         // std::cout << pQuery->length( ) - uiQFrom << " | " << pRef->length( ) << " | " << uiBandwidth << std::endl;
@@ -179,7 +179,7 @@ class SmallInversions : public libMS::Module<libMS::ContainerVector<std::shared_
     execute( std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>> pAlignments,
              std::shared_ptr<NucSeq> pQuery, std::shared_ptr<Pack> pRefPack )
     {
-        AlignedMemoryManager xMemoryManager;
+        DPWorkspace& rWorkspace = DPWorkspace::local( );
         // the container vector of alignments that is returned.
         auto pRet = std::make_shared<libMS::ContainerVector<std::shared_ptr<Alignment>>>( );
         for( std::shared_ptr<Alignment> pAlignment : *pAlignments )
@@ -189,8 +189,9 @@ class SmallInversions : public libMS::Module<libMS::ContainerVector<std::shared_
                 [&]( nucSeqIndex uiStartQ, nucSeqIndex uiStartR, nucSeqIndex uiEndQ, nucSeqIndex uiEndR ) {
                     auto uiStartRRevStr = pRefPack->uiPositionToReverseStrand( uiEndR );
                     auto uiEndRRevStr = pRefPack->uiPositionToReverseStrand( uiStartR );
-                    auto pRef = pRefPack->vExtract( uiStartRRevStr, uiEndRRevStr );
-                    auto pInvAlignment = tryInversionExtension( uiStartQ, uiEndQ, pQuery, pRef, xMemoryManager );
+                    auto pRef = rWorkspace.pRefWindow;
+                    pRefPack->vExtractSubsection( uiStartRRevStr, uiEndRRevStr, *pRef );
+                    auto pInvAlignment = tryInversionExtension( uiStartQ, uiEndQ, pQuery, pRef, rWorkspace );
                     if( bDisableHeuristics || pInvAlignment->score( ) > iHarmScoreMin * pGlobalParams->iMatch->get( ) )
                     {
                         pInvAlignment->uiBeginOnQuery += uiStartQ;
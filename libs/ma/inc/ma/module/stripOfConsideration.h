@@ -37,6 +37,8 @@ class StripOfConsiderationSeeds : public libMS::Module<SoCPriorityQueue, false,
 
     const size_t uiSoCWidth;
     const bool bRectangular;
+    /// @brief maximal number of seeds per read (0 = unlimited); see NucSeq::spendSeeds
+    const uint64_t uiSeedBudget;
 
     inline static nucSeqIndex getPositionForBucketing( nucSeqIndex uiQueryLength, const Seed& xS, Pack& rxRefSequence,
                                                        bool bSplitStrands )
@@ -67,7 +69,8 @@ class StripOfConsiderationSeeds : public libMS::Module<SoCPriorityQueue, false,
           uiCurrHarmScoreMin( rParameters.getSelected( )->xHarmScoreMin->get( ) ),
           uiMinGenomeSize( rParameters.getSelected( )->xGenomeSizeDisable->get( ) ),
           uiSoCWidth( rParameters.getSelected( )->xSoCWidth->get( ) ),
-          bRectangular( rParameters.getSelected( )->xRectangularSoc->get( ) )
+          bRectangular( rParameters.getSelected( )->xRectangularSoc->get( ) ),
+          uiSeedBudget( rParameters.getSelected( )->xSeedBudgetPerRead->get( ) )
     {} // default constructor
 
     virtual std::shared_ptr<SoCPriorityQueue> DLL_PORT( MA )
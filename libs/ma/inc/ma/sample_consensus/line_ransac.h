@@ -0,0 +1,110 @@
+/**
+ * @file line_ransac.h
+ * @brief RANSAC line fitting that is specialized for the 2D points of the harmonization.
+ */
+#ifndef LINE_RANSAC_H
+#define LINE_RANSAC_H
+
+#include "util/support.h"
+
+/// @cond DOXYGEN_SHOW_SYSTEM_INCLUDES
+#include <cstdint>
+#include <utility>
+#include <vector>
+/// @endcond
+
+namespace libMA
+{
+
+/**
+ * @brief RANSAC line fitting for 2D points.
+ * @details
+ * Does the same as run_ransac (sample_consensus::RANSAC with a SACModelLine followed by a linear regression on the
+ * inliers) but:
+ * - the points are kept as two float arrays relative to the first point,
+ *   so that the inlier counting loop can be vectorized by the compiler
+ * - the buffers are reused across calls (keep one instance per thread)
+ * - the random numbers come from an own generator that is reseeded by every fit,
+ *   so the result does not depend on other threads drawing from std::rand
+ * - the iterations stop as soon as all points are inliers
+ * - median and MAD are computed via selection instead of sorting copies
+ */
+class LineRansac
+{
+    /// @brief the points relative to (dOriginX, dOriginY)
+    std::vector<float> vX, vY;
+    double dOriginX = 0, dOriginY = 0;
+    /// @brief scratch space for the median computations
+    std::vector<float> vScratch;
+    uint64_t uiRngState = 1;
+
+    /// @brief xorshift64* generator
+    inline uint64_t nextRandom( )
+    {
+        uiRngState ^= uiRngState >> 12;
+        uiRngState ^= uiRngState << 25;
+        uiRngState ^= uiRngState >> 27;
+        return uiRngState * 2685821657736338717ull;
+    } // method
+
+    /// @brief uniform random number in [0, uiN)
+    inline size_t randomIndex( size_t uiN )
+    {
+        return (size_t)( ( ( nextRandom( ) >> 32 ) * (uint64_t)uiN ) >> 32 );
+    } // method
+
+    /// @brief median of vScratch (reorders vScratch)
+    float scratchMedian( );
+
+  public:
+    /// @brief desired probability of choosing at least one sample free from outliers
+    double dProbability = 0.99;
+    /// @brief maximum number of trials before we give up
+    unsigned int uiMaxIterations = 100;
+
+    /// @brief removes all points; (dOriginX, dOriginY) should be close to the points for precision
+    void reset( double dOriginX, double dOriginY )
+    {
+        vX.clear( );
+        vY.clear( );
+        this->dOriginX = dOriginX;
+        this->dOriginY = dOriginY;
+    } // method
+
+    void reserve( size_t uiSize )
+    {
+        vX.reserve( uiSize );
+        vY.reserve( uiSize );
+    } // method
+
+    inline void addPoint( double dX, double dY )
+    {
+        vX.push_back( (float)( dX - dOriginX ) );
+        vY.push_back( (float)( dY - dOriginY ) );
+    } // method
+
+    size_t size( ) const
+    {
+        return vX.size( );
+    } // method
+
+    /// @brief median absolute deviation of the y values of all points
+    double DLL_PORT( MA ) medianAbsoluteDeviationY( );
+
+    /**
+     * @brief number of points within sqrt(fSqrThreshold) of the line through (fX1, fY1) and (fX2, fY2)
+     */
+    size_t DLL_PORT( MA ) countInliers( float fX1, float fY1, float fX2, float fY2, float fSqrThreshold ) const;
+
+    /**
+     * @brief fits a line through the points
+     * @details
+     * Returns (angle, intersection of the line with y = 0) like run_ransac.
+     * Returns a pair of NaNs if no line with an angle in [20, 70] degrees is found.
+     */
+    std::pair<double, double> DLL_PORT( MA ) fit( double dThreshold, uint64_t uiSeed = 0x9E3779B97F4A7C15ull );
+}; // class
+
+} // namespace libMA
+
+#endif
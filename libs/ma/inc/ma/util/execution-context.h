@@ -18,6 +18,7 @@ class GenomeManager
   public:
     typedef decltype( makePledge<Pack>( std::string( ) ) ) PackPledgeType;
     typedef decltype( makePledge<FMIndex>( std::string( ) ) ) FMDIndexPledgeType;
+    typedef std::shared_ptr<Pledge<ShardedFMIndex>> ShardedFMDIndexPledgeType;
 
   private:
     // Genome-prefix initially empty (equal to no genome selected)
@@ -28,10 +29,17 @@ class GenomeManager
     PackPledgeType pxPackPledge;
     // shared pointer to FMD-index (pledge)
     FMDIndexPledgeType pxFMDIndexPledge;
+    // shared pointer to the sharded FMD-index (pledge); only set for genomes with a sharded index
+    ShardedFMDIndexPledgeType pxShardedFMDIndexPledge;
 
   public:
     /* Constructor */
-    GenomeManager( void ) : sPackPrefix( "" ), sGenomeName( "" ), pxPackPledge( nullptr ), pxFMDIndexPledge( nullptr )
+    GenomeManager( void )
+        : sPackPrefix( "" ),
+          sGenomeName( "" ),
+          pxPackPledge( nullptr ),
+          pxFMDIndexPledge( nullptr ),
+          pxShardedFMDIndexPledge( nullptr )
     {} // constructor
 
     /* Getter for pack pledge */
@@ -54,10 +62,30 @@ class GenomeManager
             throw std::runtime_error( "Genome undetermined (Missing FMD-Index)." );
     } // method
 
+    /* Getter for the sharded FMD-Index pledge */
+    ShardedFMDIndexPledgeType getShardedFMDIndexPledge( void )
+    {
+        if( this->pxShardedFMDIndexPledge )
+            return this->pxShardedFMDIndexPledge;
+        else
+            // Avoid null-pointer problems and throw exception
+            throw std::runtime_error( "Genome undetermined (Missing sharded FMD-Index)." );
+    } // method
+
+    /* True if the genome's FMD-index is split into shards */
+    bool isSharded( void )
+    {
+        return this->pxShardedFMDIndexPledge != nullptr;
+    } // method
+
     /* Loads genome using info given in JSON-file
+     * If bMapped is set, pack and FMD-index are memory mapped, so that processes loading the same genome share them.
+     * Sharded genomes are always mapped, so that the shards do not have to be resident at the same time
+     * (see ShardedFMIndex).
      * Returns empty string if loading went well
      */
-    std::string loadGenome( const fs::path& rsJsonFilePath ) // folder containing json, pack and fmd-index
+    std::string loadGenome( const fs::path& rsJsonFilePath, // folder containing json, pack and fmd-index
+                            bool bMapped = false )
     {
         // read a JSON file
         try
@@ -70,16 +98,29 @@ class GenomeManager
             // Check JSON for correctness
             if( xJSON[ "type" ] != "MA Genome" )
                 return ( "JSON file does not contain valid MA genome information." );
-            if( !( xJSON[ "version" ][ "major" ] == 1 && xJSON[ "version" ][ "minor" ] == 0 ) )
-                return ( "Wrong version of MA genome.\n(Expected major:1 minor:0)" );
+            // version 1.1 genomes have a sharded FMD-index
+            if( !( xJSON[ "version" ][ "major" ] == 1 &&
+                   ( xJSON[ "version" ][ "minor" ] == 0 || xJSON[ "version" ][ "minor" ] == 1 ) ) )
+                return ( "Wrong version of MA genome.\n(Expected major:1 minor:0 or minor:1)" );
 
             // Extract genome data from JSON ...
             this->sGenomeName = xJSON[ "name" ];
             this->sPackPrefix = ( rsJsonFilePath.parent_path( ) / std::string( xJSON[ "prefix" ] ) ).string( );
 
             // Get pledges for pack and FMD-index
-            this->pxPackPledge = makePledge<Pack>( sPackPrefix );
-            this->pxFMDIndexPledge = makePledge<FMIndex>( sPackPrefix );
+            const bool bSharded = xJSON.count( "shards" ) > 0;
+            this->pxPackPledge = makePledge<Pack>( sPackPrefix, bMapped || bSharded );
+            if( bSharded )
+            {
+                this->pxFMDIndexPledge = nullptr;
+                this->pxShardedFMDIndexPledge = makePledge<ShardedFMIndex>(
+                    *this->pxPackPledge->get( ), xJSON[ "shards" ].get<std::vector<size_t>>( ), sPackPrefix, true );
+            } // if
+            else
+            {
+                this->pxFMDIndexPledge = makePledge<FMIndex>( sPackPrefix, bMapped );
+                this->pxShardedFMDIndexPledge = nullptr;
+            } // else
             // (DEBUG) auto xDummyGenome = this->pxPackPledge->get( );
             // (DEBUG) xDummyGenome->printHoles( );
         } // try
@@ -101,15 +142,31 @@ class GenomeManager
                  { "prefix", rsGenomePrefix } };
     } // method
 
+    /* Create JSON that informs about a genome with a sharded FMD-index
+     * (vFirstContigs holds the first contig of every shard)
+     */
+    json createGenomeJSON( const std::string& rsGenomeTitle, const std::string& rsGenomePrefix,
+                           const std::vector<size_t>& vFirstContigs )
+    {
+        return { { "type", "MA Genome" },
+                 { "version", { { "major", 1 }, { "minor", 1 } } },
+                 { "name", rsGenomeTitle },
+                 { "prefix", rsGenomePrefix },
+                 { "shards", vFirstContigs } };
+    } // method
+
     // std::vector<json::json> findAllGenomesInFolder( const fs::path& sFolderPath )
     // {} // method
 
-    /* Computation of Pack and FM-Index for a genome in FASTA file */
+    /* Computation of Pack and FM-Index for a genome in FASTA file
+     * If uiMaxShardSize is not zero and the genome is larger, the FM-Index is split into shards of whole contigs.
+     */
     void makeIndexAndPackForGenome( const fs::path& rsGenomeFolderPath, // Folder for genome storage
                                     const fs::path& rsFastaFilePath, // Path to FASTA-file that contains genome
                                     const std::string& rsGenomeTitle, // Name of genome
                                     std::function<void( const std::string& )> // Feedback to the caller
-                                        fCallBack )
+                                        fCallBack,
+                                    uint64_t uiMaxShardSize = 0 ) // Maximal number of nucleotides per shard
     {
         // Genome prefix is always FASTA prefix
         auto sGenomePrefix = rsFastaFilePath.stem( );
@@ -122,17 +179,34 @@ class GenomeManager
         pxPack->vAppendFASTA( rsFastaFilePath.string( ) );
         pxPack->vStoreCollection( sGenomeFullPathPrefix.string( ) );
 
-        // Create and store FMD index
-        fCallBack( "Compute FMD-index...\nImportant note: This may take long time.\n" );
-        FMIndex xFMDIndex( pxPack );
-        fCallBack( "Write FMD-Index to file system.\n" );
-        xFMDIndex.vStoreFMIndex( sGenomeFullPathPrefix.string( ).c_str( ) );
+        if( uiMaxShardSize != 0 && pxPack->uiUnpackedSizeForwardStrand > uiMaxShardSize )
+        {
+            // Create and store the FMD index shard by shard
+            fCallBack( "Compute sharded FMD-index...\nImportant note: This may take long time.\n" );
+            auto vFirstContigs =
+                ShardedFMIndex::storeShards( *pxPack, uiMaxShardSize, sGenomeFullPathPrefix.string( ), fCallBack );
+
+            // Create JSON genome info
+            fCallBack( "Create JSON info.\n" );
+
+            std::ofstream xOutStream( ( fs::path( rsGenomeFolderPath ) /= rsGenomeTitle ) += ".json" );
+            xOutStream << std::setw( 4 ) << createGenomeJSON( rsGenomeTitle, sGenomePrefix.string( ), vFirstContigs )
+                       << std::endl;
+        } // if
+        else
+        {
+            // Create and store FMD index
+            fCallBack( "Compute FMD-index...\nImportant note: This may take long time.\n" );
+            FMIndex xFMDIndex( pxPack );
+            fCallBack( "Write FMD-Index to file system.\n" );
+            xFMDIndex.vStoreFMIndex( sGenomeFullPathPrefix.string( ).c_str( ) );
 
-        // Create JSON genome info
-        fCallBack( "Create JSON info.\n" );
+            // Create JSON genome info
+            fCallBack( "Create JSON info.\n" );
 
-        std::ofstream xOutStream( ( fs::path( rsGenomeFolderPath ) /= rsGenomeTitle ) += ".json" );
-        xOutStream << std::setw( 4 ) << createGenomeJSON( rsGenomeTitle, sGenomePrefix.string( ) ) << std::endl;
+            std::ofstream xOutStream( ( fs::path( rsGenomeFolderPath ) /= rsGenomeTitle ) += ".json" );
+            xOutStream << std::setw( 4 ) << createGenomeJSON( rsGenomeTitle, sGenomePrefix.string( ) ) << std::endl;
+        } // else
 
         fCallBack( "All done!\n" );
     } // method
@@ -145,7 +219,7 @@ class GenomeManager
 
     bool isReady( void )
     {
-        return this->pxPackPledge && this->pxFMDIndexPledge;
+        return this->pxPackPledge && ( this->pxFMDIndexPledge || this->pxShardedFMDIndexPledge );
     } // method
 }; // class
 
@@ -348,12 +422,22 @@ class ExecutionContext
 
             auto pxFileStreamQueuePledge = std::make_shared<Pledge<PairedFileStreamQueue>>( );
             pxFileStreamQueuePledge->set( pFileStreamQueue );
-            aGraphSinks = setUpCompGraphPaired( xParameterSetManager,
-                                                xGenomeManager.getPackPledge( ), // Pack
-                                                xGenomeManager.getFMDIndexPledge( ), // FMD index
-                                                pxFileStreamQueuePledge, // (for paired reads we require two queries!)
-                                                pxPairedWriter, // Output writer module(output of alignments)
-                                                (unsigned int)uiConcurency ); // Number of threads
+            if( xGenomeManager.isSharded( ) )
+                aGraphSinks = setUpCompGraphPairedSharded(
+                    xParameterSetManager,
+                    xGenomeManager.getPackPledge( ), // Pack
+                    xGenomeManager.getShardedFMDIndexPledge( ), // sharded FMD index
+                    pxFileStreamQueuePledge, // (for paired reads we require two queries!)
+                    pxPairedWriter, // Output writer module(output of alignments)
+                    (unsigned int)uiConcurency ); // Number of threads
+            else
+                aGraphSinks = setUpCompGraphPaired(
+                    xParameterSetManager,
+                    xGenomeManager.getPackPledge( ), // Pack
+                    xGenomeManager.getFMDIndexPledge( ), // FMD index
+                    pxFileStreamQueuePledge, // (for paired reads we require two queries!)
+                    pxPairedWriter, // Output writer module(output of alignments)
+                    (unsigned int)uiConcurency ); // Number of threads
         } // if
         else
         {
@@ -379,14 +463,26 @@ class ExecutionContext
                 pFileStreamQueue = std::make_shared<FileStreamQueue>( pInitVec );
             } // else
 
+            // align the reads of a window from the longest to the shortest one (if requested)
+            pFileStreamQueue = windowFileStreams(
+                pFileStreamQueue, (size_t)xParameterSetManager.pGeneralParameterSet->piReadWindowSize->get( ) );
+
             auto pxFileStreamQueuePledge = std::make_shared<Pledge<FileStreamQueue>>( );
             pxFileStreamQueuePledge->set( pFileStreamQueue );
-            aGraphSinks = setUpCompGraph( xParameterSetManager,
-                                          xGenomeManager.getPackPledge( ), // Pack
-                                          xGenomeManager.getFMDIndexPledge( ), // FMD index
-                                          pxFileStreamQueuePledge, // Queries
-                                          pxWriter, // Output writer module(output of alignments)
-                                          (unsigned int)uiConcurency ); // Number of threads
+            if( xGenomeManager.isSharded( ) )
+                aGraphSinks = setUpCompGraphSharded( xParameterSetManager,
+                                                     xGenomeManager.getPackPledge( ), // Pack
+                                                     xGenomeManager.getShardedFMDIndexPledge( ), // sharded FMD index
+                                                     pxFileStreamQueuePledge, // Queries
+                                                     pxWriter, // Output writer module(output of alignments)
+                                                     (unsigned int)uiConcurency ); // Number of threads
+            else
+                aGraphSinks = setUpCompGraph( xParameterSetManager,
+                                              xGenomeManager.getPackPledge( ), // Pack
+                                              xGenomeManager.getFMDIndexPledge( ), // FMD index
+                                              pxFileStreamQueuePledge, // Queries
+                                              pxWriter, // Output writer module(output of alignments)
+                                              (unsigned int)uiConcurency ); // Number of threads
         } // else
 
         // Compute the actual alignments.
@@ -144,6 +144,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #pragma once
 
+#include "ma/module/alignmentCache.h"
 #include "ma/module/binarySeeding.h"
 #include "ma/module/compare_alignments.h"
 #include "ma/module/fileReader.h"
@@ -151,11 +152,13 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "ma/module/harmonization.h"
 #include "ma/module/hashMapSeeding.h"
 #include "ma/module/mappingQuality.h"
+#include "ma/module/mateRescue.h"
 #include "ma/module/minimizerSeeding.h"
 #include "ma/module/needlemanWunsch.h"
 #include "ma/module/otherSeeding.h"
 #include "ma/module/pairedReads.h"
 #include "ma/module/sam_reader.h"
+#include "ma/module/shardedSeeding.h"
 #include "ma/module/smallInversions.h"
 #include "ma/module/splitter.h"
 #include "ma/module/stripOfConsideration.h"
@@ -192,5 +195,39 @@ std::vector<std::shared_ptr<libMS::BasePledge>> DLL_PORT( MA )
                               pWriter,
                           unsigned int uiThreads );
 
+/**
+ * @brief sets up the graph of setUpCompGraph for a ShardedFMIndex
+ * @details
+ * Seeds on all shards (see ShardedSeeding) instead of a single FMD-index.
+ */
+std::vector<std::shared_ptr<libMS::BasePledge>> DLL_PORT( MA )
+    setUpCompGraphSharded( const ParameterSetManager& rParameters,
+                           std::shared_ptr<libMS::Pledge<Pack>>
+                               pPack,
+                           std::shared_ptr<libMS::Pledge<ShardedFMIndex>>
+                               pShardedFMDIndex,
+                           std::shared_ptr<libMS::Pledge<libMA::FileStreamQueue, false>>
+                               pQueue,
+                           std::shared_ptr<TP_WRITER>
+                               pWriter,
+                           unsigned int uiThreads );
+
+/**
+ * @brief sets up the graph of setUpCompGraphPaired for a ShardedFMIndex
+ * @details
+ * Seeds on all shards (see ShardedSeeding) instead of a single FMD-index; mate rescue uses ShardedMateRescue.
+ */
+std::vector<std::shared_ptr<libMS::BasePledge>> DLL_PORT( MA )
+    setUpCompGraphPairedSharded( const ParameterSetManager& rParameters,
+                                 std::shared_ptr<libMS::Pledge<Pack>>
+                                     pPack,
+                                 std::shared_ptr<libMS::Pledge<ShardedFMIndex>>
+                                     pShardedFMDIndex,
+                                 std::shared_ptr<libMS::Pledge<libMA::PairedFileStreamQueue, false>>
+                                     pQueue,
+                                 std::shared_ptr<TP_PAIRED_WRITER>
+                                     pWriter,
+                                 unsigned int uiThreads );
+
 
 } // namespace libMA
\ No newline at end of file
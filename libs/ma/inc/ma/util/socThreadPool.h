@@ -0,0 +1,26 @@
+/**
+ * @file socThreadPool.h
+ * @brief Thread pool for processing the SoCs of a single read concurrently.
+ */
+#pragma once
+
+#include "util/exported.h"
+/// @cond DOXYGEN_SHOW_SYSTEM_INCLUDES
+#include <iostream>
+/// @endcond
+#include "util/threadPool.h"
+
+namespace libMA
+{
+
+/**
+ * @brief pool that is shared by all reads (and graph instances) for harmonizing and aligning SoCs concurrently.
+ * @details
+ * The pool is created with uiNumThreads threads by the first call; later calls return the same pool.
+ * The size of the pool cannot change afterwards: if a later call requests a different number of threads, a warning is
+ * printed (once) and the existing pool is returned.
+ * The tasks in the pool never wait for other tasks, so graph threads can block on the futures without deadlocking.
+ */
+DLL_PORT( MA ) ThreadPool& socThreadPool( size_t uiNumThreads );
+
+} // namespace libMA
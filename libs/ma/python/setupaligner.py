@@ -77,6 +77,8 @@ def quick_align(parameter_set, pack, fm_index, output_graph, file_queue, file_qu
         queue_picker = FilePicker(parameter_set)
         queue_placer = FileNucSeqPlacer(parameter_set)
         file_reader = FileReader(parameter_set)
+        # align the reads of a window from the longest to the shortest one (if requested)
+        combined_queue = window_file_streams(file_queue, parameter_set.by_name("Read Window Size").get())
     
     queue_pledge = Pledge()
     queue_pledge.set(combined_queue)
@@ -9,6 +9,13 @@
 */
 #define _CRT_SECURE_NO_DEPRECATE
 #include "ma/container/bwt_large.h"
+#include "util/debug.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#ifndef _MSC_VER
+#include <sys/resource.h>
+#endif
 
 
 #define ALPHABET_SIZE 4
@@ -75,6 +82,7 @@ typedef struct BWTInc
     unsigned int* packedText;
     unsigned char* textBuffer;
     unsigned int* packedShift;
+    unsigned int numThreads; // number of threads for sorting the buckets of the incremental build
 } BWTInc;
 
 static bgint_t TextLengthFromBytePacked( bgint_t bytePackedLength, unsigned int bitPerChar,
@@ -375,6 +383,7 @@ BWTInc* BWTIncCreate( const bgint_t textLength, bgint_t initialMaxBuildSize, bgi
 
     bwtInc = (BWTInc*)calloc( 1, sizeof( BWTInc ) );
     bwtInc->numberOfIterationDone = 0;
+    bwtInc->numThreads = 1;
     bwtInc->bwt = BWTCreate( textLength, NULL );
     bwtInc->initialMaxBuildSize = initialMaxBuildSize;
     bwtInc->incMaxBuildSize = incMaxBuildSize;
@@ -954,6 +963,28 @@ static void BWTIncSortKey( bgint_t* __restrict key, bgint_t* __restrict seq, con
 }
 
 
+// (key, seq, numItem) of a group for BWTIncSortKey()
+typedef std::tuple<bgint_t*, bgint_t*, bgint_t> KeyGroup;
+
+// The groups cover disjoint ranges of key and seq; so they can be sorted by several threads at once.
+static void BWTIncSortKeyGroups( std::vector<KeyGroup>& groups, const unsigned int numThreads )
+{
+    // largest groups first, so that all threads finish at about the same time
+    std::sort( groups.begin( ), groups.end( ),
+               []( const KeyGroup& a, const KeyGroup& b ) { return std::get<2>( a ) > std::get<2>( b ); } );
+    std::atomic<size_t> nextGroup( 0 );
+    auto sortGroups = [ & ]( ) {
+        for( size_t i = nextGroup++; i < groups.size( ); i = nextGroup++ )
+            BWTIncSortKey( std::get<0>( groups[ i ] ), std::get<1>( groups[ i ] ), std::get<2>( groups[ i ] ) );
+    };
+    std::vector<std::thread> threads;
+    for( size_t i = 1; i < std::min( (size_t)numThreads, groups.size( ) ); i++ )
+        threads.emplace_back( sortGroups );
+    sortGroups( );
+    for( auto& thread : threads )
+        thread.join( );
+}
+
 static void BWTIncBuildRelativeRank( bgint_t* __restrict sortedRank, bgint_t* __restrict seq,
                                      bgint_t* __restrict relativeRank, const bgint_t numItem, bgint_t oldInverseSa0,
                                      const bgint_t* cumulativeCount )
@@ -1569,32 +1600,35 @@ static void BWTIncConstruct( BWTInc* bwtInc, const bgint_t numChar )
 
         // Sort rank by ALPHABET_SIZE + 2 groups (or ALPHABET_SIZE + 1 groups when inverseSa0 sit on
         // the border of a group)
+        std::vector<KeyGroup> groups;
         for( i = 0; i < ALPHABET_SIZE; i++ )
         {
             if( bwtInc->cumulativeCountInCurrentBuild[ i ] > oldInverseSa0RelativeRank ||
                 bwtInc->cumulativeCountInCurrentBuild[ i + 1 ] <= oldInverseSa0RelativeRank )
             {
-                BWTIncSortKey( sortedRank + bwtInc->cumulativeCountInCurrentBuild[ i ],
-                               seq + bwtInc->cumulativeCountInCurrentBuild[ i ],
-                               bwtInc->cumulativeCountInCurrentBuild[ i + 1 ] -
-                                   bwtInc->cumulativeCountInCurrentBuild[ i ] );
+                groups.emplace_back( sortedRank + bwtInc->cumulativeCountInCurrentBuild[ i ],
+                                     seq + bwtInc->cumulativeCountInCurrentBuild[ i ],
+                                     bwtInc->cumulativeCountInCurrentBuild[ i + 1 ] -
+                                         bwtInc->cumulativeCountInCurrentBuild[ i ] );
             }
             else
             {
                 if( bwtInc->cumulativeCountInCurrentBuild[ i ] < oldInverseSa0RelativeRank )
                 {
-                    BWTIncSortKey( sortedRank + bwtInc->cumulativeCountInCurrentBuild[ i ],
-                                   seq + bwtInc->cumulativeCountInCurrentBuild[ i ],
-                                   oldInverseSa0RelativeRank - bwtInc->cumulativeCountInCurrentBuild[ i ] );
+                    groups.emplace_back( sortedRank + bwtInc->cumulativeCountInCurrentBuild[ i ],
+                                         seq + bwtInc->cumulativeCountInCurrentBuild[ i ],
+                                         oldInverseSa0RelativeRank - bwtInc->cumulativeCountInCurrentBuild[ i ] );
                 }
                 if( bwtInc->cumulativeCountInCurrentBuild[ i + 1 ] > oldInverseSa0RelativeRank + 1 )
                 {
-                    BWTIncSortKey( sortedRank + oldInverseSa0RelativeRank + 1,
-                                   seq + oldInverseSa0RelativeRank + 1,
-                                   bwtInc->cumulativeCountInCurrentBuild[ i + 1 ] - oldInverseSa0RelativeRank - 1 );
+                    groups.emplace_back( sortedRank + oldInverseSa0RelativeRank + 1,
+                                         seq + oldInverseSa0RelativeRank + 1,
+                                         bwtInc->cumulativeCountInCurrentBuild[ i + 1 ] - oldInverseSa0RelativeRank -
+                                             1 );
                 }
             }
         }
+        BWTIncSortKeyGroups( groups, bwtInc->numThreads );
 
         // build relative rank; sortedRank is updated for merging to cater for the fact that $ is
         // not encoded in bwt the cumulative freq information is used to make sure that inverseSa0
@@ -1654,13 +1688,71 @@ static void BWTIncConstruct( BWTInc* bwtInc, const bgint_t numChar )
     bwtInc->numberOfIterationDone++;
 }
 
+static BWTInc* BWTIncConstructFromSource( const bgint_t totalTextLength, const PackedTextSource& source,
+                                          bgint_t initialMaxBuildSize, bgint_t incMaxBuildSize,
+                                          unsigned int numThreads )
+{
+    bgint_t textToLoad, textSizeInByte;
+    bgint_t processedTextLength;
+    bgint_t firstByte; // first byte of the text block that is loaded next
+
+    BWTInc* bwtInc;
+
+    bwtInc = BWTIncCreate( totalTextLength, initialMaxBuildSize, incMaxBuildSize );
+    bwtInc->numThreads = numThreads;
+
+    BWTIncSetBuildSizeAndTextAddr( bwtInc );
+
+    if( bwtInc->buildSize > totalTextLength )
+    {
+        textToLoad = totalTextLength;
+    }
+    else
+    {
+        textToLoad = totalTextLength -
+                     ( ( totalTextLength - bwtInc->buildSize + CHAR_PER_WORD - 1 ) / CHAR_PER_WORD * CHAR_PER_WORD );
+    }
+    textSizeInByte = textToLoad / CHAR_PER_BYTE; // excluded the odd byte
+
+    // the last block of the text starts at a byte border; it is loaded together with its odd byte
+    firstByte = ( totalTextLength - textToLoad ) / CHAR_PER_BYTE;
+    source( firstByte, textSizeInByte + 1, bwtInc->textBuffer );
+
+    ConvertBytePackedToWordPacked( bwtInc->textBuffer, bwtInc->packedText, ALPHABET_SIZE, textToLoad );
+    BWTIncConstruct( bwtInc, textToLoad );
+
+    processedTextLength = textToLoad;
+
+    while( processedTextLength < totalTextLength )
+    {
+        textToLoad = bwtInc->buildSize / CHAR_PER_WORD * CHAR_PER_WORD;
+        if( textToLoad > totalTextLength - processedTextLength )
+        {
+            textToLoad = totalTextLength - processedTextLength;
+        }
+        textSizeInByte = textToLoad / CHAR_PER_BYTE;
+        firstByte -= textSizeInByte;
+        source( firstByte, textSizeInByte, bwtInc->textBuffer );
+        ConvertBytePackedToWordPacked( bwtInc->textBuffer, bwtInc->packedText, ALPHABET_SIZE, textToLoad );
+        BWTIncConstruct( bwtInc, textToLoad );
+        processedTextLength += textToLoad;
+#if DEBUG_LEVEL >= 1
+        if( bwtInc->numberOfIterationDone % 10 == 0 )
+        {
+            fprintf( stderr, "[BWTIncConstructFromSource] %lu iterations done. %lu characters processed.\n",
+                     (long)bwtInc->numberOfIterationDone, (long)processedTextLength );
+        }
+#endif
+    }
+
+    return bwtInc;
+}
+
 BWTInc* BWTIncConstructFromPacked( const char* inputFileName, bgint_t initialMaxBuildSize, bgint_t incMaxBuildSize )
 {
     FILE* packedFile;
     bgint_t packedFileLen;
     bgint_t totalTextLength;
-    bgint_t textToLoad, textSizeInByte;
-    bgint_t processedTextLength;
     unsigned char lastByteLength;
 
     BWTInc* bwtInc;
@@ -1693,78 +1785,23 @@ BWTInc* BWTIncConstructFromPacked( const char* inputFileName, bgint_t initialMax
     }
     totalTextLength = TextLengthFromBytePacked( packedFileLen, BIT_PER_CHAR, lastByteLength );
 
-    bwtInc = BWTIncCreate( totalTextLength, initialMaxBuildSize, incMaxBuildSize );
-
-    BWTIncSetBuildSizeAndTextAddr( bwtInc );
-
-    if( bwtInc->buildSize > totalTextLength )
-    {
-        textToLoad = totalTextLength;
-    }
-    else
-    {
-        textToLoad = totalTextLength -
-                     ( ( totalTextLength - bwtInc->buildSize + CHAR_PER_WORD - 1 ) / CHAR_PER_WORD * CHAR_PER_WORD );
-    }
-    textSizeInByte = textToLoad / CHAR_PER_BYTE; // excluded the odd byte
-
-    if( fseek( packedFile, -( (long)textSizeInByte + 2 ), SEEK_CUR ) != 0 )
-    {
-        fprintf( stderr, "BWTIncConstructFromPacked() : Can't seek on %s : %s\n", inputFileName, strerror( errno ) );
-        exit( 1 );
-    }
-    if( fread( bwtInc->textBuffer, sizeof( unsigned char ), textSizeInByte + 1, packedFile ) != textSizeInByte + 1 )
-    {
-        fprintf( stderr, "BWTIncConstructFromPacked() : Can't read from %s : %s\n", inputFileName,
-                 ferror( packedFile ) ? strerror( errno ) : "Unexpected end of file" );
-        exit( 1 );
-    }
-    if( fseek( packedFile, -( (long)textSizeInByte + 1 ), SEEK_CUR ) != 0 )
-    {
-        fprintf( stderr, "BWTIncConstructFromPacked() : Can't seek on %s : %s\n", inputFileName, strerror( errno ) );
-        exit( 1 );
-    }
-
-    ConvertBytePackedToWordPacked( bwtInc->textBuffer, bwtInc->packedText, ALPHABET_SIZE, textToLoad );
-    BWTIncConstruct( bwtInc, textToLoad );
-
-    processedTextLength = textToLoad;
-
-    while( processedTextLength < totalTextLength )
-    {
-        textToLoad = bwtInc->buildSize / CHAR_PER_WORD * CHAR_PER_WORD;
-        if( textToLoad > totalTextLength - processedTextLength )
-        {
-            textToLoad = totalTextLength - processedTextLength;
-        }
-        textSizeInByte = textToLoad / CHAR_PER_BYTE;
-        if( fseek( packedFile, -( (long)textSizeInByte ), SEEK_CUR ) != 0 )
+    // the .pac file holds the byte packed text (plus a zero byte if the text length is a multiple of 4)
+    auto fileSource = [ & ]( bgint_t firstByte, bgint_t numBytes, unsigned char* output ) {
+        if( fseek( packedFile, (long)firstByte, SEEK_SET ) != 0 )
         {
             fprintf( stderr, "BWTIncConstructFromPacked() : Can't seek on %s : %s\n", inputFileName,
                      strerror( errno ) );
             exit( 1 );
         }
-        if( fread( bwtInc->textBuffer, sizeof( unsigned char ), textSizeInByte, packedFile ) != textSizeInByte )
+        if( fread( output, sizeof( unsigned char ), numBytes, packedFile ) != numBytes )
         {
             fprintf( stderr, "BWTIncConstructFromPacked() : Can't read from %s : %s\n", inputFileName,
                      ferror( packedFile ) ? strerror( errno ) : "Unexpected end of file" );
             exit( 1 );
         }
-        if( fseek( packedFile, -( (long)textSizeInByte ), SEEK_CUR ) != 0 )
-        {
-            fprintf( stderr, "BWTIncConstructFromPacked() : Can't seek on %s : %s\n", inputFileName,
-                     strerror( errno ) );
-            exit( 1 );
-        }
-        ConvertBytePackedToWordPacked( bwtInc->textBuffer, bwtInc->packedText, ALPHABET_SIZE, textToLoad );
-        BWTIncConstruct( bwtInc, textToLoad );
-        processedTextLength += textToLoad;
-        if( bwtInc->numberOfIterationDone % 10 == 0 )
-        {
-            fprintf( stderr, "[BWTIncConstructFromPacked] %lu iterations done. %lu characters processed.\n",
-                     (long)bwtInc->numberOfIterationDone, (long)processedTextLength );
-        }
-    }
+    };
+    bwtInc = BWTIncConstructFromSource( totalTextLength, fileSource, initialMaxBuildSize, incMaxBuildSize, 1 );
+
     fclose( packedFile ); // close the pack file (so that we can later remove it)
 
     return bwtInc;
@@ -1829,16 +1866,9 @@ void BWTSaveBwtCodeAndOcc( const BWT* bwt, const char* bwtFileName, const char*
     }
 }
 
-/* New function for interfacing with the FMIndex class
- */
-std::tuple<bgint_t, bgint_t, std::vector<bgint_t>, std::vector<unsigned int>> bwtLarge( const char* pcFileNamePack )
+// Copies the BWT out of bwtInc and frees bwtInc
+static std::tuple<bgint_t, bgint_t, std::vector<bgint_t>, std::vector<unsigned int>> BWTIncToTuple( BWTInc* bwtInc )
 {
-    BWTInc* bwtInc;
-    bwtInc = BWTIncConstructFromPacked( pcFileNamePack, 10000000, 10000000 );
-
-    //// printf( "[bwt_gen] Finished constructing BWT in %u iterations.\n",
-    /// bwtInc->numberOfIterationDone );
-
     BWT* bwt = bwtInc->bwt;
     auto bwtLength = BWTFileSizeInWord( bwt->textLength ); // textLength expressed in words
     auto returnValue = std::tuple<bgint_t, bgint_t, std::vector<bgint_t>, std::vector<unsigned int>>(
@@ -1852,6 +1882,45 @@ std::tuple<bgint_t, bgint_t, std::vector<bgint_t>, std::vector<unsigned int>> bw
 
     BWTIncFree( bwtInc ); // we have to free all memory before we return to the caller!
     return returnValue;
+}
+
+/* New function for interfacing with the FMIndex class
+ */
+std::tuple<bgint_t, bgint_t, std::vector<bgint_t>, std::vector<unsigned int>> bwtLarge( const char* pcFileNamePack )
+{
+    BWTInc* bwtInc;
+    bwtInc = BWTIncConstructFromPacked( pcFileNamePack, 10000000, 10000000 );
+
+    //// printf( "[bwt_gen] Finished constructing BWT in %u iterations.\n",
+    /// bwtInc->numberOfIterationDone );
+
+    return BWTIncToTuple( bwtInc );
+} // function
+
+/* Interface for the FMIndex class that does not require a .pac file.
+ */
+std::tuple<bgint_t, bgint_t, std::vector<bgint_t>, std::vector<unsigned int>>
+bwtLarge( bgint_t uiTextLength, const PackedTextSource& fSource, unsigned int uiNumThreads,
+          bgint_t uiInitialMaxBuildSize, bgint_t uiIncMaxBuildSize, bool bVerbose )
+{
+    auto xStart = std::chrono::steady_clock::now( );
+    BWTInc* bwtInc =
+        BWTIncConstructFromSource( uiTextLength, fSource, uiInitialMaxBuildSize, uiIncMaxBuildSize, uiNumThreads );
+    if( bVerbose )
+    {
+        std::chrono::duration<double> xDuration = std::chrono::steady_clock::now( ) - xStart;
+#ifndef _MSC_VER
+        struct rusage xUsage;
+        getrusage( RUSAGE_SELF, &xUsage );
+        // ru_maxrss is in kilobytes on linux
+        fprintf( stderr, "[bwtLarge] built BWT of %lu characters in %u iterations (%.2f sec; peak RSS %.1f MB)\n",
+                 (long)uiTextLength, bwtInc->numberOfIterationDone, xDuration.count( ), xUsage.ru_maxrss / 1024.0 );
+#else
+        fprintf( stderr, "[bwtLarge] built BWT of %lu characters in %u iterations (%.2f sec)\n", (long)uiTextLength,
+                 bwtInc->numberOfIterationDone, xDuration.count( ) );
+#endif
+    } // if
+    return BWTIncToTuple( bwtInc );
 } // function
 
 /* BWT creation for more than 50,000,000 bp
@@ -5,6 +5,7 @@
 #include "ma/container/fMIndex.h"
 
 #include <cstdlib>
+#include <thread>
 using namespace libMA;
 
 #define complement( x ) ( uint8_t ) NucSeq::nucleotideComplement( x )
@@ -213,7 +214,7 @@ void FMIndex::bwt_bwtupdate_core_step2( )
     /* Create a temporary vector for storage of the BWT with injected Occ-counting blocks.
      */
     auto uiOccInjectedBWTExpectedSize = bwt.size( ) + n_occ * sizeof( bwtint_t );
-    std::vector<uint32_t> xVectorWithOccInjections( uiOccInjectedBWTExpectedSize );
+    decltype( bwt ) xVectorWithOccInjections( uiOccInjectedBWTExpectedSize );
 
     c[ 0 ] = c[ 1 ] = c[ 2 ] = c[ 3 ] = 0; // temporary uint_64 counter for A, C, G, T
 
@@ -340,49 +341,35 @@ void FMIndex::build_FMIndex( const Pack& rxSequenceCollection, // the pack for w
     {
         /*
          * In this case we build the BWT using the BWA C-code for large inputs.
-         * For delivering the pack to the BWA code we have to rely on an
-         * external file currently.
-         * FIX ME: The current solution is quite inefficient with respect to memory aspects.
+         * The BWA code reads the pack together with its reverse strand block by block directly from
+         * rxSequenceCollection. (Formerly, the pack was exported to a temporary .pac file for this purpose.)
          */
 
         // set seq_len, so that it represents the size of forward plus reverse strand
         uiRefSeqLength = rxSequenceCollection.uiUnpackedSizeForwardPlusReverse( );
 
-        std::string tempDir = ".tempdir";
-        // Check existence / create directory for storage of temporary data.
-        makeDir( tempDir );
-
-        // Create temporary filename for pack export.
-        const auto xTempFileName = tempDir.append(
-            std::to_string(
-                std::chrono::system_clock::to_time_t( std::chrono::system_clock::now( ) ) ) // current time as string
-                .append( "-" )
-                .append(
-                    std::to_string( rxSequenceCollection.uiUnpackedSizeForwardPlusReverse( ) ) ) // pack size as string
-        ); // temporary filename construction
-        // pac file construction adds a suffix
-        const auto sTempFileNameWithSuffix = std::string( xTempFileName ).append( ".pac" );
-
-        /* Store the dynamically created pack on the filesystem.
-         * The suffix .pac will be automatically added.
-         */
-        rxSequenceCollection.vCreateAndStorePackForBWTProcessing( xTempFileName );
-
         /* Start the BWT construction.
          */
-        auto xBWTAsTriple = bwtLarge( sTempFileNameWithSuffix.c_str( ) ); // construct the BWT using the old BWA code.
+        auto xBWTAsTriple = bwtLarge( // construct the BWT using the old BWA code.
+            rxSequenceCollection.uiUnpackedSizeForwardPlusReverse( ),
+            [ & ]( bgint_t uiFirstByte, bgint_t uiNumBytes, unsigned char* pOut ) {
+                rxSequenceCollection.vGetPackedForwardPlusReverse( uiFirstByte, uiNumBytes, pOut );
+            }, // lambda
+            std::max( 1u, std::thread::hardware_concurrency( ) ), 10000000, 10000000,
+            true ); // print a summary line, since this takes a while for large genomes
 
         /* Move the externally constructed BWT to this BWT-object.
          */
-        bwt = std::move( std::get<3>( xBWTAsTriple ) );
+        auto& rvExternalBWT = std::get<3>( xBWTAsTriple );
+        // bwt uses the IndexAllocator, so the BWT is copied (bwt is replaced by the version with injected occ
+        // values in step 2 anyways)
+        bwt.assign( rvExternalBWT.begin( ), rvExternalBWT.end( ) );
+        rvExternalBWT.clear( );
+        rvExternalBWT.shrink_to_fit( );
 
         this->primary = std::get<1>( xBWTAsTriple ); // copy the primary
         std::copy_n( std::get<2>( xBWTAsTriple ).begin( ), 4,
                      L2.begin( ) + 1 ); // copy the 4 cumulative counters
-
-        /* Remove the temporary file, because it is not needed any longer.
-         */
-        std::remove( sTempFileNameWithSuffix.c_str( ) );
     } // else
 
     /* Step 2 and step 3 of FM-index creation
@@ -409,7 +396,7 @@ void exportFM_index( libMS::SubmoduleOrganizer& xOrganizer )
         .def( py::init<>( ) ) // default constructor
         .def( py::init<std::shared_ptr<NucSeq>>( ) )
         .def( py::init<std::shared_ptr<Pack>>( ) )
-        .def( "load", &FMIndex::vLoadFMIndex )
+        .def( "load", &FMIndex::vLoadFMIndex, py::arg( "prefix" ), py::arg( "mapped" ) = false )
         .def_static( "exists", &FMIndex::packExistsOnFileSystem )
         .def( "store", &FMIndex::vStoreFMIndex )
         .def( "init_interval", &FMIndex::init_interval )
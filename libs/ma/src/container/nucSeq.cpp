@@ -51,7 +51,12 @@ void exportNucSeq( libMS::SubmoduleOrganizer& xOrganizer )
         .def( "equals", &NucSeq::isEqual )
         .def( "check", &NucSeq::check )
         .def_readwrite( "name", &NucSeq::sName )
-        .def_readwrite( "id", &NucSeq::iId );
+        .def_readwrite( "id", &NucSeq::iId )
+        .def_readonly( "stream_id", &NucSeq::uiStreamId )
+        .def_readonly( "index_in_stream", &NucSeq::uiIndexInStream )
+        .def_readonly( "seeds_processed", &NucSeq::uiSeedsProcessed )
+        .def_readonly( "dp_cells", &NucSeq::uiDPCells )
+        .def_readonly( "over_budget", &NucSeq::bOverBudget );
 
     // register return values of vectors of nucseqs
     py::bind_vector<std::vector<std::shared_ptr<NucSeq>>>( xOrganizer.container( ), "VecRetNuc", "docstr" )
@@ -554,7 +554,7 @@ void exportPack( libMS::SubmoduleOrganizer& xOrganizer )
 #endif
         .def( "store", &Pack::vStoreCollection )
         .def_static( "exists", &Pack::packExistsOnFileSystem )
-        .def( "load", &Pack::vLoadCollection )
+        .def( "load", &Pack::vLoadCollection, py::arg( "prefix" ), py::arg( "mapped" ) = false )
         .def( "extract_from_to", &Pack::vExtractPy )
         .def( "extract_complete", &Pack::vColletionAsNucSeq )
         .def( "extract_forward_strand", &Pack::vColletionWithoutReverseStrandAsNucSeq )
@@ -0,0 +1,111 @@
+/**
+ * @file shardedFMIndex.cpp
+ */
+#include "ma/container/shardedFMIndex.h"
+#include "ms/util/pybind11.h"
+#include <future>
+
+using namespace libMA;
+
+std::vector<size_t> ShardedFMIndex::groupContigs( const Pack& rPack, uint64_t uiMaxShardSize )
+{
+    std::vector<size_t> vRet;
+    uint64_t uiCurrSize = 0;
+    for( size_t uiI = 0; uiI < rPack.uiNumContigs( ); uiI++ )
+    {
+        const uint64_t uiLen = rPack.lengthOfSequenceWithId( uiI );
+        // start a new shard if the contig does not fit into the current one
+        if( vRet.empty( ) || ( uiMaxShardSize != 0 && uiCurrSize + uiLen > uiMaxShardSize ) )
+        {
+            vRet.push_back( uiI );
+            uiCurrSize = 0;
+        } // if
+        uiCurrSize += uiLen;
+    } // for
+    return vRet;
+} // method
+
+std::shared_ptr<Pack> ShardedFMIndex::shardPack( const Pack& rPack, size_t uiFirstContig, size_t uiNumContigs )
+{
+    auto pRet = std::make_shared<Pack>( );
+    for( size_t uiI = uiFirstContig; uiI < uiFirstContig + uiNumContigs; uiI++ )
+    {
+        NucSeq xContig;
+        rPack.vExtractSubsection( rPack.startOfSequenceWithId( uiI ), rPack.endOfSequenceWithId( uiI ), xContig );
+        pRet->vAppendSequence( rPack.xVectorOfSequenceDescriptors[ uiI ].sName,
+                               rPack.xVectorOfSequenceDescriptors[ uiI ].sComment, xContig );
+    } // for
+    return pRet;
+} // method
+
+void ShardedFMIndex::initShards( const Pack& rPack, const std::vector<size_t>& vFirstContigs )
+{
+    if( vFirstContigs.empty( ) || vFirstContigs.front( ) != 0 )
+        throw std::runtime_error( "The shards of an index must start with the first contig." );
+    for( size_t uiI = 0; uiI < vFirstContigs.size( ); uiI++ )
+    {
+        const size_t uiEnd = uiI + 1 < vFirstContigs.size( ) ? vFirstContigs[ uiI + 1 ] : rPack.uiNumContigs( );
+        if( uiEnd <= vFirstContigs[ uiI ] || uiEnd > rPack.uiNumContigs( ) )
+            throw std::runtime_error( "The shards of the index do not match the contigs of the pack." );
+        const uint64_t uiOffset = rPack.startOfSequenceWithId( vFirstContigs[ uiI ] );
+        vShards.push_back( Shard{ vFirstContigs[ uiI ], uiEnd - vFirstContigs[ uiI ], uiOffset,
+                                  rPack.endOfSequenceWithId( uiEnd - 1 ) - uiOffset, nullptr } );
+    } // for
+} // method
+
+std::vector<size_t> ShardedFMIndex::storeShards( const Pack& rPack, uint64_t uiMaxShardSize, const std::string& sPrefix,
+                                                 std::function<void( const std::string& )> fCallBack )
+{
+    auto vFirstContigs = groupContigs( rPack, uiMaxShardSize );
+    for( size_t uiI = 0; uiI < vFirstContigs.size( ); uiI++ )
+    {
+        const size_t uiEnd = uiI + 1 < vFirstContigs.size( ) ? vFirstContigs[ uiI + 1 ] : rPack.uiNumContigs( );
+        fCallBack( "Compute FMD-index of shard " + std::to_string( uiI + 1 ) + " of " +
+                   std::to_string( vFirstContigs.size( ) ) + "...\n" );
+        // the shard's pack and index are freed before the next shard is computed
+        FMIndex xShardIndex( shardPack( rPack, vFirstContigs[ uiI ], uiEnd - vFirstContigs[ uiI ] ) );
+        xShardIndex.vStoreFMIndex( shardPrefix( sPrefix, uiI ).c_str( ) );
+    } // for
+    return vFirstContigs;
+} // method
+
+ShardedFMIndex::ShardedFMIndex( const Pack& rPack, uint64_t uiMaxShardSize )
+    : uiRefSeqLength( rPack.uiUnpackedSizeForwardPlusReverse( ) )
+{
+    initShards( rPack, groupContigs( rPack, uiMaxShardSize ) );
+    for( auto& rShard : vShards )
+        rShard.pFMIndex = std::make_shared<FMIndex>( shardPack( rPack, rShard.uiFirstContig, rShard.uiNumContigs ) );
+} // constructor
+
+ShardedFMIndex::ShardedFMIndex( const Pack& rPack, const std::vector<size_t>& vFirstContigs,
+                                const std::string& sPrefix, bool bMapped )
+    : uiRefSeqLength( rPack.uiUnpackedSizeForwardPlusReverse( ) )
+{
+    initShards( rPack, vFirstContigs );
+    // loading is IO bound, so all shards are loaded concurrently (mapping them is cheap anyway)
+    std::vector<std::future<std::shared_ptr<FMIndex>>> vLoading;
+    for( size_t uiI = 0; uiI < vShards.size( ); uiI++ )
+        vLoading.push_back( std::async( std::launch::async, [ sShardPrefix = shardPrefix( sPrefix, uiI ), bMapped ]( ) {
+            return std::make_shared<FMIndex>( sShardPrefix, bMapped );
+        } ) );
+    for( size_t uiI = 0; uiI < vShards.size( ); uiI++ )
+    {
+        vShards[ uiI ].pFMIndex = vLoading[ uiI ].get( );
+        if( vShards[ uiI ].pFMIndex->getRefSeqLength( ) != 2 * vShards[ uiI ].uiLength )
+            throw std::runtime_error( "The index shard " + shardPrefix( sPrefix, uiI ) +
+                                      " does not match the contigs of the pack." );
+    } // for
+} // constructor
+
+#ifdef WITH_PYTHON
+void exportShardedFMIndex( libMS::SubmoduleOrganizer& xOrganizer )
+{
+    py::class_<ShardedFMIndex, libMS::Container, std::shared_ptr<ShardedFMIndex>>( xOrganizer.container( ),
+                                                                                   "ShardedFMIndex" )
+        .def( py::init<const Pack&, uint64_t>( ) )
+        .def( "num_shards", &ShardedFMIndex::numShards )
+        .def( "__len__", &ShardedFMIndex::getRefSeqLength );
+
+    py::implicitly_convertible<ShardedFMIndex, libMS::Container>( );
+} // function
+#endif
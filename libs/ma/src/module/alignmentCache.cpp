@@ -0,0 +1,56 @@
+/**
+ * @file alignmentCache.cpp
+ */
+#include "ma/module/alignmentCache.h"
+
+using namespace libMA;
+using namespace libMS;
+
+std::shared_ptr<ContainerVector<std::shared_ptr<Alignment>>>
+CachedAlignment::execute( std::shared_ptr<FMIndex> pFMIndex, std::shared_ptr<NucSeq> pQuery,
+                          std::shared_ptr<Pack> pPack )
+{
+    auto pRet = std::make_shared<ContainerVector<std::shared_ptr<Alignment>>>( );
+    if( xCache.get( *pQuery, pRet->vContent ) )
+        return pRet;
+
+    auto pSegments = xSeeding.execute( pFMIndex, pQuery );
+    auto pSoCs = xSoC.execute( pSegments, pQuery, pPack, pFMIndex );
+    auto pHarmonized = xHarmonization.execute( pSoCs, pQuery, pFMIndex );
+    pRet = xMappingQuality.execute( pQuery, xDP.execute( pHarmonized, pQuery, pPack ) );
+    xCache.put( *pQuery, pRet->vContent );
+    return pRet;
+} // method
+
+std::shared_ptr<ContainerVector<std::shared_ptr<Alignment>>>
+CachedShardedAlignment::execute( std::shared_ptr<ShardedFMIndex> pIndex, std::shared_ptr<NucSeq> pQuery,
+                                 std::shared_ptr<Pack> pPack )
+{
+    auto pRet = std::make_shared<ContainerVector<std::shared_ptr<Alignment>>>( );
+    if( xCache.get( *pQuery, pRet->vContent ) )
+        return pRet;
+
+    auto pSeeds = xSeeding.execute( pIndex, pQuery, pPack );
+    auto pSoCs = xSoC.execute( pSeeds, pQuery, pPack );
+    auto pHarmonized = xHarmonization.execute( pSoCs, pQuery, pIndex );
+    pRet = xMappingQuality.execute( pQuery, xDP.execute( pHarmonized, pQuery, pPack ) );
+    xCache.put( *pQuery, pRet->vContent );
+    return pRet;
+} // method
+
+#ifdef WITH_PYTHON
+
+void exportAlignmentCache( libMS::SubmoduleOrganizer& xOrganizer )
+{
+    exportModule<CachedAlignment>( xOrganizer, "CachedAlignment", []( auto&& x ) {
+        x.def( "hits", []( CachedAlignment& rThis ) { return rThis.xCache.uiHits.load( ); } )
+            .def( "misses", []( CachedAlignment& rThis ) { return rThis.xCache.uiMisses.load( ); } )
+            .def( "size", []( CachedAlignment& rThis ) { return rThis.xCache.size( ); } );
+    } );
+    exportModule<CachedShardedAlignment>( xOrganizer, "CachedShardedAlignment", []( auto&& x ) {
+        x.def( "hits", []( CachedShardedAlignment& rThis ) { return rThis.xCache.uiHits.load( ); } )
+            .def( "misses", []( CachedShardedAlignment& rThis ) { return rThis.xCache.uiMisses.load( ); } )
+            .def( "size", []( CachedShardedAlignment& rThis ) { return rThis.xCache.size( ); } );
+    } );
+} // function
+#endif
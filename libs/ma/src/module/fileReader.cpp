@@ -5,6 +5,8 @@
 #include "ma/module/fileReader.h"
 #include "ma/container/alignment.h"
 #include "ms/util/pybind11.h"
+#include <algorithm>
+#include <atomic>
 #include <cctype>
 
 using namespace libMA;
@@ -34,9 +36,56 @@ size_t lenq( std::string& sLine )
     return uiLineSize;
 } // function
 
+size_t FileStream::nextStreamId( )
+{
+    static std::atomic<size_t> uiNextId( 1 );
+    return uiNextId++;
+} // method
+
+std::shared_ptr<NucSeq> ReadWindowStream::next( FileReader& rReader )
+{
+    std::lock_guard<std::mutex> xLock( xMutex );
+    if( vWindow.empty( ) )
+    {
+        while( vWindow.size( ) < uiWindowSize )
+        {
+            auto pRead = rReader.execute( pStream );
+            if( pRead == nullptr )
+                break;
+            vWindow.push_back( pRead );
+        } // while
+        // longest read last, since we pop from the back;
+        // stable, so that reads of equal length are handed out in file order
+        std::stable_sort( vWindow.begin( ), vWindow.end( ),
+                          []( const std::shared_ptr<NucSeq>& pA, const std::shared_ptr<NucSeq>& pB ) {
+                              return pA->length( ) < pB->length( ) ||
+                                     ( pA->length( ) == pB->length( ) && pA->uiIndexInStream > pB->uiIndexInStream );
+                          } ); // stable_sort
+    } // if
+    if( vWindow.empty( ) )
+        return nullptr;
+    auto pRet = vWindow.back( );
+    vWindow.pop_back( );
+    return pRet;
+} // method
+
 std::shared_ptr<NucSeq> FileReader::execute( std::shared_ptr<FileStream> pStream )
 {
+    if( auto pWindow = std::dynamic_pointer_cast<ReadWindowStream>( pStream ) )
+        return pWindow->next( *this );
+
     std::lock_guard<std::mutex> xLock( pStream->xMutex );
+    auto pRet = read( pStream );
+    if( pRet != nullptr )
+    {
+        pRet->uiStreamId = pStream->uiStreamId;
+        pRet->uiIndexInStream = pStream->uiNumReadsRead++;
+    } // if
+    return pRet;
+} // method
+
+std::shared_ptr<NucSeq> FileReader::read( std::shared_ptr<FileStream> pStream )
+{
     pStream->peek( );
     if( pStream->eof( ) ) // eof case
         return nullptr;
@@ -219,6 +268,9 @@ void exportFileReader( libMS::SubmoduleOrganizer& xOrganizer )
         .def( py::init<std::string>( ) );
     py::class_<StringStream, FileStream, std::shared_ptr<StringStream>>( xOrganizer.container( ), "StringStream" )
         .def( py::init<std::string>( ) );
+    py::class_<ReadWindowStream, FileStream, std::shared_ptr<ReadWindowStream>>( xOrganizer.container( ),
+                                                                                 "ReadWindowStream" )
+        .def( py::init<std::shared_ptr<FileStream>, size_t>( ) );
 
     py::bind_vector_ext<PairedReadsContainer, Container, std::shared_ptr<PairedReadsContainer>>(
         xOrganizer.container( ), "ContainerVectorNucSeq", "docstr" );
@@ -235,5 +287,6 @@ void exportFileReader( libMS::SubmoduleOrganizer& xOrganizer )
     exportModule<ProgressPrinter<PairedFileStreamQueue>>( xOrganizer, "ProgressPrinterPairedFileStreamQueue" );
 
     xOrganizer.util( ).def( "combine_file_streams", &combineFileStreams );
+    xOrganizer.util( ).def( "window_file_streams", &windowFileStreams );
 } // function
 #endif
\ No newline at end of file
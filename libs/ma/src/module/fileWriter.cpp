@@ -8,13 +8,211 @@
 using namespace libMA;
 using namespace libMS;
 
+/// @brief marks reads that are unmapped because they exceeded their work budget (see NucSeq::bOverBudget)
+static void appendBudgetTag( std::string& sOut, const NucSeq& rQuery )
+{
+    if( rQuery.bOverBudget )
+        sOut.append( "\tZB:Z:budget" );
+} // function
+
+/// @brief nucleotide code -> character for the forward and the complement strand
+struct NucleotideCharTables
+{
+    char aForw[ 256 ];
+    char aComp[ 256 ];
+
+    NucleotideCharTables( )
+    {
+        for( size_t uiI = 0; uiI < 256; uiI++ )
+        {
+            aForw[ uiI ] = NucSeq::translateACGTCodeToCharacter( (uint8_t)uiI );
+            aComp[ uiI ] = uiI < 4 ? NucSeq::translateACGTCodeToCharacter( (uint8_t)( 3 - uiI ) ) : 'N';
+        } // for
+    } // constructor
+}; // struct
+static const NucleotideCharTables xNucleotideChars;
+
+const std::string& SamLineBuffer::seq( const NucSeq& rQuery, bool bRevComp )
+{
+    SeqCache* pCache = nullptr;
+    for( auto& rCache : aSeqCache )
+        if( rCache.pQuery == &rQuery )
+            pCache = &rCache;
+    if( pCache == nullptr )
+    {
+        pCache = aSeqCache[ 0 ].pQuery == nullptr ? &aSeqCache[ 0 ] : &aSeqCache[ 1 ];
+        pCache->pQuery = &rQuery;
+        pCache->bForwValid = false;
+        pCache->bRevCompValid = false;
+    } // if
+    const size_t uiLen = rQuery.length( );
+    if( bRevComp && !pCache->bRevCompValid )
+    {
+        pCache->sRevComp.resize( uiLen );
+        for( size_t uiI = 0; uiI < uiLen; uiI++ )
+            pCache->sRevComp[ uiI ] = xNucleotideChars.aComp[ rQuery.pxSequenceRef[ uiLen - 1 - uiI ] ];
+        pCache->bRevCompValid = true;
+    } // if
+    if( !bRevComp && !pCache->bForwValid )
+    {
+        pCache->sForw.resize( uiLen );
+        for( size_t uiI = 0; uiI < uiLen; uiI++ )
+            pCache->sForw[ uiI ] = xNucleotideChars.aForw[ rQuery.pxSequenceRef[ uiI ] ];
+        pCache->bForwValid = true;
+    } // if
+    return bRevComp ? pCache->sRevComp : pCache->sForw;
+} // method
+
+void SamLineBuffer::appendSeq( const NucSeq& rQuery, nucSeqIndex uiFrom, nucSeqIndex uiTo, bool bRevComp )
+{
+    const nucSeqIndex uiLen = rQuery.length( );
+    if( uiFrom > uiTo || uiTo > uiLen )
+        throw std::runtime_error( "Query section " + std::to_string( uiFrom ) + " to " + std::to_string( uiTo ) +
+                                  " is out of range for query " + rQuery.sName + " of length " +
+                                  std::to_string( uiLen ) );
+    // the reverse complement of [uiFrom, uiTo) is [uiLen - uiTo, uiLen - uiFrom) in the reverse complement string
+    sLines.append( seq( rQuery, bRevComp ), bRevComp ? uiLen - uiTo : uiFrom, uiTo - uiFrom );
+} // method
+
+void SamLineBuffer::appendQual( const NucSeq& rQuery, nucSeqIndex uiFrom, nucSeqIndex uiTo )
+{
+#if WITH_QUALITY
+    if( rQuery.bHasQuality( ) )
+    {
+        // qualities are stored as they were read (phred + 33)
+        uiTo = std::min( uiTo, (nucSeqIndex)rQuery.length( ) );
+        if( uiFrom < uiTo )
+            sLines.append( (const char*)rQuery.pxQualityRef + uiFrom, uiTo - uiFrom );
+        return;
+    } // if
+#endif
+    sLines.push_back( '*' );
+} // method
+
+void libMA::appendCigar( std::string& sOut, const Alignment& rAlignment, const Pack& rPack, size_t uiQuerySize,
+                         bool bSoftClip, bool bMInsteadOfXAndEqual )
+{
+    const char cClip = bSoftClip ? 'S' : 'H';
+    const bool bReverse = rPack.bPositionIsOnReversStrand( rAlignment.uiBeginOnRef );
+    // clipping in front
+    const nucSeqIndex uiFrontClip =
+        bReverse ? ( rAlignment.uiEndOnQuery < uiQuerySize ? uiQuerySize - rAlignment.uiEndOnQuery : 0 )
+                 : rAlignment.uiBeginOnQuery;
+    if( uiFrontClip > 0 )
+    {
+        appendNumber( sOut, uiFrontClip );
+        sOut.push_back( cClip );
+    } // if
+
+    // reverse strand alignments are printed back to front
+    const size_t uiNumOps = rAlignment.data.size( );
+    nucSeqIndex uiSequentialM = 0;
+    for( size_t uiI = 0; uiI < uiNumOps; uiI++ )
+    {
+        const auto& rSection = rAlignment.data[ bReverse ? uiNumOps - 1 - uiI : uiI ];
+        char cOperation;
+        switch( rSection.first )
+        {
+            case MatchType::seed:
+            case MatchType::match:
+                cOperation = '=';
+                break;
+            case MatchType::missmatch:
+                cOperation = 'X';
+                break;
+            case MatchType::insertion:
+                cOperation = 'I';
+                break;
+            case MatchType::deletion:
+                cOperation = 'D';
+                break;
+            default:
+                std::cerr << "WARNING invalid cigar symbol" << std::endl;
+                // cigarString outputs the length without a symbol
+                if( !bMInsteadOfXAndEqual )
+                    appendNumber( sOut, rSection.second );
+                continue;
+        } // switch
+        if( bMInsteadOfXAndEqual )
+        {
+            if( cOperation == '=' || cOperation == 'X' )
+            {
+                // add up sequential M's
+                uiSequentialM += rSection.second;
+                continue;
+            } // if
+            // output added up sequential M's
+            if( uiSequentialM > 0 )
+            {
+                appendNumber( sOut, uiSequentialM );
+                sOut.push_back( 'M' );
+                uiSequentialM = 0;
+            } // if
+        } // if
+        appendNumber( sOut, rSection.second );
+        sOut.push_back( cOperation );
+    } // for
+    // don't forget potential last M!
+    if( uiSequentialM > 0 )
+    {
+        appendNumber( sOut, uiSequentialM );
+        sOut.push_back( 'M' );
+    } // if
+
+    // clipping at the end
+    const nucSeqIndex uiBackClip =
+        bReverse ? rAlignment.uiBeginOnQuery
+                 : ( rAlignment.uiEndOnQuery < uiQuerySize ? uiQuerySize - rAlignment.uiEndOnQuery : 0 );
+    if( uiBackClip > 0 )
+    {
+        appendNumber( sOut, uiBackClip );
+        sOut.push_back( cClip );
+    } // if
+} // function
+
+#if DEBUG_LEVEL > 0
+/// @brief self check of the position that is written for an alignment
+static void checkSamPosition( Alignment& rAlignment, Pack& rPack, int64_t iContig, nucSeqIndex uiRefPos )
+{
+    bool bWrong = false;
+    if( rPack.bPositionIsOnReversStrand( rAlignment.uiBeginOnRef ) )
+    {
+        //@todo frill in this self check...
+    } // if
+    else
+    {
+        if( rAlignment.uiBeginOnRef != rPack.startOfSequenceWithId( iContig ) + uiRefPos - 1 )
+            bWrong = true;
+    } // else
+
+    if( bWrong )
+    {
+        std::cerr << "Error: Tried to write wrong index to file" << std::endl;
+        std::cerr << "Have: " << rPack.nameOfSequenceWithId( iContig ) << " (= " << rPack.startOfSequenceWithId( iContig )
+                  << ") " << uiRefPos << std::endl;
+        std::cerr << "Wanted: " << rAlignment.uiBeginOnRef << " " << uiRefPos << std::endl;
+        if( rPack.bPositionIsOnReversStrand( rAlignment.uiBeginOnRef ) )
+            std::cerr << "Begin is reverse: True" << std::endl;
+        else
+            std::cerr << "Begin is reverse: False" << std::endl;
+        if( rPack.bPositionIsOnReversStrand( rAlignment.uiEndOnRef ) )
+            std::cerr << "End is reverse: True" << std::endl;
+        else
+            std::cerr << "End is reverse: False" << std::endl;
+        throw std::runtime_error( "Error: Tried to write wrong index to file" );
+    } // if
+} // function
+#endif
+
 std::shared_ptr<libMS::Container> FileWriter::execute( std::shared_ptr<NucSeq> pQuery,
                                                        std::shared_ptr<ContainerVector<std::shared_ptr<Alignment>>>
                                                            pAlignments,
                                                        std::shared_ptr<Pack>
                                                            pPack )
 {
-    std::string sCombined = "";
+    SamLineBuffer& rBuffer = SamLineBuffer::local( );
+    rBuffer.startRead( );
+    std::string& sCombined = rBuffer.sLines;
     for( std::shared_ptr<Alignment> pAlignment : *pAlignments )
     {
         if( pAlignment->length( ) == 0 )
@@ -24,124 +222,76 @@ std::shared_ptr<libMS::Container> FileWriter::execute( std::shared_ptr<NucSeq> p
         if( bNoSupplementary && pAlignment->bSupplementary )
             continue;
 
-        if( bForcedConsistentConsequtiveInsertionDeletionOrder &&
-            pPack->bPositionIsOnReversStrand( pAlignment->uiBeginOnRef ) )
+        const bool bReverse = pPack->bPositionIsOnReversStrand( pAlignment->uiBeginOnRef );
+        if( bForcedConsistentConsequtiveInsertionDeletionOrder && bReverse )
         {
             pAlignment->invertSuccessiveInserionAndDeletion( );
         } // if
 
-        std::string sCigar;
-        if( bCGTag && pAlignment->data.size( ) >= uiMaxCigarLen )
-            sCigar = std::to_string( pAlignment->uiEndOnQuery - pAlignment->uiBeginOnQuery ).append( "S" );
-        else
-            sCigar = bOutputMInsteadOfXAndEqual
-                         ? pAlignment->cigarStringWithMInsteadOfXandEqual( *pPack, pQuery->length( ), bSoftClip )
-                         : pAlignment->cigarString( *pPack, pQuery->length( ), bSoftClip );
-
-        uint32_t flag = pAlignment->getSamFlag( *pPack );
-
-        std::string sContigOther = "*";
-        std::string sPosOther = "0";
-        std::string sName = pQuery->sName;
-        std::string sSegment;
-        if( bSoftClip )
-            if( pPack->bPositionIsOnReversStrand( pAlignment->uiBeginOnRef ) )
-                sSegment = pQuery->toStringComplement( );
-            else
-                sSegment = pQuery->toString( );
-        else
-            sSegment = pAlignment->getQuerySequence( *pQuery, *pPack );
-        std::string sQual = pAlignment->getQueryQuality( *pQuery );
-
-        std::string sRefName = pAlignment->getContig( *pPack );
+        const int64_t iContig = pPack->uiSequenceIdForPosition( pAlignment->uiBeginOnRef );
         // sam file format has 1-based indices bam 0-based...
         auto uiRefPos = pAlignment->getSamPosition( *pPack );
-
 #if DEBUG_LEVEL > 0
-        bool bWrong = false;
-        if( pPack->bPositionIsOnReversStrand( pAlignment->uiBeginOnRef ) )
-        {
-            //@todo frill in this self check...
-        } // if
-        else
-        {
-            if( pAlignment->uiBeginOnRef != pPack->startOfSequenceWithName( sRefName ) + uiRefPos - 1 )
-                bWrong = true;
-        } // else
-
-        if( bWrong )
-        {
-            std::cerr << "Error: Tried to write wrong index to file" << std::endl;
-            std::cerr << "Have: " << sRefName << " (= " << pPack->startOfSequenceWithName( sRefName ) << ") "
-                      << uiRefPos << std::endl;
-            std::cerr << "Wanted: " << pAlignment->uiBeginOnRef << " " << uiRefPos << std::endl;
-            if( pPack->bPositionIsOnReversStrand( pAlignment->uiBeginOnRef ) )
-                std::cerr << "Begin is reverse: True" << std::endl;
-            else
-                std::cerr << "Begin is reverse: False" << std::endl;
-            if( pPack->bPositionIsOnReversStrand( pAlignment->uiEndOnRef ) )
-                std::cerr << "End is reverse: True" << std::endl;
-            else
-                std::cerr << "End is reverse: False" << std::endl;
-            throw std::runtime_error( "Error: Tried to write wrong index to file" );
-        } // if
+        checkSamPosition( *pAlignment, *pPack, iContig, uiRefPos );
 #endif
 
-        std::string sTag = this->computeTag( pQuery, pAlignment, pPack, pAlignments );
-
-        std::string sMapQual;
+        // query name
+        sCombined.append( pQuery->sName ).push_back( '\t' );
+        // alignment flag
+        appendNumber( sCombined, pAlignment->getSamFlag( *pPack ) );
+        sCombined.push_back( '\t' );
+        // reference name
+        sCombined.append( pPack->nameOfSequenceWithId( iContig ) ).push_back( '\t' );
+        // pos
+        appendNumber( sCombined, uiRefPos );
+        sCombined.push_back( '\t' );
+        // mapping quality
         if( std::isnan( pAlignment->fMappingQuality ) )
-            sMapQual = "255";
+            sCombined.append( "255" );
+        else
+            appendNumber( sCombined, static_cast<int>( std::ceil( pAlignment->fMappingQuality * 254 ) ) );
+        sCombined.push_back( '\t' );
+        // cigar
+        if( bCGTag && pAlignment->data.size( ) >= uiMaxCigarLen )
+        {
+            appendNumber( sCombined, pAlignment->uiEndOnQuery - pAlignment->uiBeginOnQuery );
+            sCombined.push_back( 'S' );
+        } // if
         else
-            sMapQual = std::to_string( static_cast<int>( std::ceil( pAlignment->fMappingQuality * 254 ) ) );
-
-        assert( sTag.empty( ) || sTag[ 0 ] == '\t' );
-        sCombined +=
-            // query name
-            sName + "\t" +
-            // alignment flag
-            std::to_string( flag ) + "\t" +
-            // reference name
-            sRefName + "\t" +
-            // pos
-            std::to_string( uiRefPos ) + "\t" +
-            // mapping quality
-            sMapQual + "\t" +
-            // cigar
-            sCigar + "\t" +
-            // Ref. name of the mate/next read
-            sContigOther + "\t" +
-            // Position of the mate/next read
-            sPosOther + "\t" +
-            // observed Template length
-            "0\t" +
+            appendCigar( sCombined, *pAlignment, *pPack, pQuery->length( ), bSoftClip, bOutputMInsteadOfXAndEqual );
+        // Ref. name and position of the mate/next read; observed Template length
+        sCombined.append( "\t*\t0\t0\t" );
+        if( bOmitSecondarySeq && pAlignment->bSecondary )
+            sCombined.append( "*\t*" );
+        else
+        {
             // segment sequence
-            sSegment + "\t" +
+            if( bSoftClip )
+                rBuffer.appendSeq( *pQuery, 0, pQuery->length( ), bReverse );
+            else
+                rBuffer.appendSeq( *pQuery, pAlignment->uiBeginOnQuery, pAlignment->uiEndOnQuery, bReverse );
+            sCombined.push_back( '\t' );
             // ASCII of Phred-scaled base Quality+33
-            sQual + // \t is in sTag
-            // Tag
-            sTag + "\n";
+            rBuffer.appendQual( *pQuery, pAlignment->uiBeginOnQuery, pAlignment->uiEndOnQuery );
+        } // else
+        // Tag (\t is in the tag)
+        this->appendTag( sCombined, pQuery, pAlignment, pPack, pAlignments );
+        sCombined.push_back( '\n' );
     } // for
     // if we have not computed any alignment then we should still output the query as unaligned:
-    if( pAlignments->size( ) == 0 )
+    if( pAlignments->size( ) == 0 || sCombined.size( ) == 0 )
     {
-        sCombined +=
-            // query name
-            pQuery->sName + "\t" +
-            // alignment flag
-            std::to_string( SEGMENT_UNMAPPED ) + "\t*\t0\t255\t*\t*\t0\t0\t" +
-            // segment sequence
-            pQuery->toString( ) + "\t" + pQuery->toQualString( ) + "\n";
-    } // if
-    if( sCombined.size( ) == 0 )
-    {
-        sCombined +=
-            // query name
-            pQuery->sName + "\t" +
-            // alignment flag
-            std::to_string( SEGMENT_UNMAPPED ) + "\t*\t0\t0\t*\t*\t0\t0\t" +
-            // segment sequence
-            pQuery->toString( ) + "\t" + pQuery->toQualString( ) + "\n";
+        // query name
+        sCombined.append( pQuery->sName ).push_back( '\t' );
+        // alignment flag
+        appendNumber( sCombined, SEGMENT_UNMAPPED );
+        sCombined.append( pAlignments->size( ) == 0 ? "\t*\t0\t255\t*\t*\t0\t0\t" : "\t*\t0\t0\t*\t*\t0\t0\t" );
+        // segment sequence
+        rBuffer.appendSeq( *pQuery, 0, pQuery->length( ), false );
+        sCombined.push_back( '\t' );
+        rBuffer.appendQual( *pQuery, 0, pQuery->length( ) );
+        appendBudgetTag( sCombined, *pQuery );
+        sCombined.push_back( '\n' );
     } // if
 
     { // scope xGuard
@@ -150,11 +300,45 @@ std::shared_ptr<libMS::Container> FileWriter::execute( std::shared_ptr<NucSeq> p
 
         // print alignment
         // flushing will be done in the outstream class
-        *pOut << sCombined;
+        if( pReadOrder != nullptr )
+            pReadOrder->write( *pOut, *pQuery, std::move( sCombined ) );
+        else
+            *pOut << sCombined;
     } // scope xGuard
     return std::shared_ptr<libMS::Container>( new libMS::Container( ) );
 } // function
 
+/// @brief the SAM line of a read without alignment in a pair
+static void appendUnmappedMate( SamLineBuffer& rBuffer, const NucSeq& rQuery, uint32_t uiFlag,
+                                const char* sContigOther, const std::string& sPosOther, bool bWithQual )
+{
+    std::string& sCombined = rBuffer.sLines;
+    // query name
+    sCombined.append( rQuery.sName ).push_back( '\t' );
+    // alignment flag
+    appendNumber( sCombined, uiFlag );
+    sCombined.push_back( '\t' );
+    if( sContigOther == nullptr )
+        sCombined.append( "*\t0\t0\t*\t*\t0\t0\t" );
+    else
+        sCombined.append( sContigOther )
+            .append( "\t" )
+            .append( sPosOther )
+            .append( "\t0" ) // outputing mapq0 because bwa mem does that as well...
+            .append( "\t*\t=\t" )
+            .append( sPosOther )
+            .append( "\t0\t" );
+    // segment sequence
+    rBuffer.appendSeq( rQuery, 0, rQuery.length( ), false );
+    sCombined.push_back( '\t' );
+    if( bWithQual )
+        rBuffer.appendQual( rQuery, 0, rQuery.length( ) );
+    else
+        sCombined.push_back( '*' );
+    appendBudgetTag( sCombined, rQuery );
+    sCombined.push_back( '\n' );
+} // function
+
 std::shared_ptr<libMS::Container>
 PairedFileWriter::execute( std::shared_ptr<NucSeq> pQuery1,
                            std::shared_ptr<NucSeq>
@@ -164,7 +348,9 @@ PairedFileWriter::execute( std::shared_ptr<NucSeq> pQuery1,
                            std::shared_ptr<Pack>
                                pPack )
 {
-    std::string sCombined = "";
+    SamLineBuffer& rBuffer = SamLineBuffer::local( );
+    rBuffer.startRead( );
+    std::string& sCombined = rBuffer.sLines;
     bool bFirstQueryHasAlignment = false;
     bool bSecondQueryHasAlignment = false;
     for( std::shared_ptr<Alignment> pAlignment : *pAlignments )
@@ -176,8 +362,8 @@ PairedFileWriter::execute( std::shared_ptr<NucSeq> pQuery1,
         if( bNoSupplementary && pAlignment->bSupplementary )
             continue;
 
-        if( bForcedConsistentConsequtiveInsertionDeletionOrder &&
-            pPack->bPositionIsOnReversStrand( pAlignment->uiBeginOnRef ) )
+        const bool bReverse = pPack->bPositionIsOnReversStrand( pAlignment->uiBeginOnRef );
+        if( bForcedConsistentConsequtiveInsertionDeletionOrder && bReverse )
         {
             pAlignment->invertSuccessiveInserionAndDeletion( );
         } // if
@@ -186,58 +372,32 @@ PairedFileWriter::execute( std::shared_ptr<NucSeq> pQuery1,
             bFirstQueryHasAlignment = true;
         if( !pAlignment->xStats.bFirst )
             bSecondQueryHasAlignment = true;
-
-        std::string sCigar;
-        if( bCGTag && pAlignment->data.size( ) >= uiMaxCigarLen )
-            sCigar = std::to_string( pAlignment->uiEndOnQuery - pAlignment->uiBeginOnQuery ).append( "S" );
-        else
-            sCigar = bOutputMInsteadOfXAndEqual
-                         ? pAlignment->cigarStringWithMInsteadOfXandEqual( *pPack, pQuery1->length( ), bSoftClip )
-                         : pAlignment->cigarString( *pPack, pQuery1->length( ), bSoftClip );
+        std::shared_ptr<NucSeq> pQuery = pAlignment->xStats.bFirst ? pQuery1 : pQuery2;
 
         uint32_t flag = pAlignment->getSamFlag( *pPack );
-
-        std::string sContigOther = "*";
-        std::string sPosOther = "0";
-        std::string sName = pAlignment->xStats.bFirst ? pQuery1->sName : pQuery2->sName;
-        // DEBUG( std::cout << "Aligned: " << sName << std::endl; )
-
-        std::string sSegment;
-        if( bSoftClip )
-            if( pPack->bPositionIsOnReversStrand( pAlignment->uiBeginOnRef ) )
-                sSegment = ( pAlignment->xStats.bFirst ? pQuery1 : pQuery2 )->toStringComplement( );
-            else
-                sSegment = ( pAlignment->xStats.bFirst ? pQuery1 : pQuery2 )->toString( );
-        else
-            sSegment = pAlignment->getQuerySequence( pAlignment->xStats.bFirst ? *pQuery1 : *pQuery2, *pPack );
-
-        std::string sQual = pAlignment->getQueryQuality( pAlignment->xStats.bFirst ? *pQuery1 : *pQuery2 );
         // paired
         flag |= MULTIPLE_SEGMENTS_IN_TEMPLATE | SEGMENT_PROPERLY_ALIGNED;
         flag |= pAlignment->xStats.bFirst ? FIRST_IN_TEMPLATE : LAST_IN_TEMPLATE;
-        std::string sTlen = "0";
-        std::string sRefName = pAlignment->getContig( *pPack );
-        if( pAlignment->xStats.pOther.lock( ) != nullptr )
-        {
 
-            nucSeqIndex uiP1 = pAlignment->beginOnRef( );
-            // for illumina the reads are always on opposite strands
-            nucSeqIndex uiP2 = pPack->uiPositionToReverseStrand( pAlignment->xStats.pOther.lock( )->beginOnRef( ) );
-            // get the distance of the alignments on the reference
-            nucSeqIndex d = uiP1 < uiP2 ? uiP2 - uiP1 : uiP1 - uiP2;
-            // FIXED: std::llabs deleted
-            sTlen = ( pAlignment->xStats.bFirst ? "" : "-" ) + std::to_string( /* std::llabs( d ) */ d );
+        const int64_t iContig = pPack->uiSequenceIdForPosition( pAlignment->uiBeginOnRef );
+        const char* sContigOther = "*";
+        nucSeqIndex uiPosOther = 0;
+        auto pOther = pAlignment->xStats.pOther.lock( );
+        if( pOther != nullptr )
+        {
+            // @note the template length is not output for now; it would be the distance of the alignments on the
+            // reference (for illumina the reads are always on opposite strands):
+            // |beginOnRef - uiPositionToReverseStrand( pOther->beginOnRef )| (negative for the second read)
 
             // assert( pQuery2 != nullptr );
-            if( pPack->bPositionIsOnReversStrand( pAlignment->xStats.pOther.lock( )->uiBeginOnRef ) )
+            if( pPack->bPositionIsOnReversStrand( pOther->uiBeginOnRef ) )
                 flag |= NEXT_REVERSE_COMPLEMENTED;
 
-            sContigOther = pAlignment->xStats.pOther.lock( )->getContig( *pPack );
+            const int64_t iContigOther = pPack->uiSequenceIdForPosition( pOther->uiBeginOnRef );
             // SAM file specification:
             // This field is set as ‘*’ when the information is unavailable, and set as ‘=’ if RNEXT is identical RNAME
-            if( sContigOther == sRefName )
-                sContigOther = "=";
-            sPosOther = std::to_string( pAlignment->xStats.pOther.lock( )->getSamPosition( *pPack ) );
+            sContigOther = iContigOther == iContig ? "=" : pPack->nameOfSequenceWithId( iContigOther );
+            uiPosOther = pOther->getSamPosition( *pPack );
 
 #if DEBUG_LEVEL > 0
             if( pQuery1->uiFromLine != pQuery2->uiFromLine )
@@ -248,104 +408,74 @@ PairedFileWriter::execute( std::shared_ptr<NucSeq> pQuery1,
             } // if
 #endif
         } // if
-#if DEBUG_LEVEL > 0
-        //else if( !pAlignment->bSecondary && !pAlignment->bSupplementary )
-        //    std::cerr << "[Info] read " << pQuery1->sName << " is unpaired." << std::endl;
-#endif
 
         // sam file format has 1-based indices bam 0-based...
         auto uiRefPos = pAlignment->getSamPosition( *pPack );
-
 #if DEBUG_LEVEL > 0
-        bool bWrong = false;
-        if( pPack->bPositionIsOnReversStrand( pAlignment->uiBeginOnRef ) )
-        {
-            //@todo frill in this self check...
-        } // if
+        checkSamPosition( *pAlignment, *pPack, iContig, uiRefPos );
+#endif
+
+        // query name
+        sCombined.append( pQuery->sName ).push_back( '\t' );
+        // alignment flag
+        appendNumber( sCombined, flag );
+        sCombined.push_back( '\t' );
+        // reference name
+        sCombined.append( pPack->nameOfSequenceWithId( iContig ) ).push_back( '\t' );
+        // pos
+        appendNumber( sCombined, uiRefPos );
+        sCombined.push_back( '\t' );
+        // mapping quality
+        if( std::isnan( pAlignment->fMappingQuality ) )
+            sCombined.append( "255" );
         else
         {
-            if( pAlignment->uiBeginOnRef != pPack->startOfSequenceWithName( sRefName ) + uiRefPos - 1 )
-                bWrong = true;
+            assert( pAlignment->fMappingQuality >= 0 );
+            appendNumber( sCombined,
+                          std::min( static_cast<int>( std::ceil( pAlignment->fMappingQuality * 254 ) ), 255 ) );
         } // else
-
-        if( bWrong )
+        sCombined.push_back( '\t' );
+        // cigar
+        if( bCGTag && pAlignment->data.size( ) >= uiMaxCigarLen )
         {
-            std::cerr << "Error: Tried to write wrong index to file" << std::endl;
-            std::cerr << "Have: " << sRefName << " (= " << pPack->startOfSequenceWithName( sRefName ) << ") "
-                      << uiRefPos << std::endl;
-            std::cerr << "Wanted: " << pAlignment->uiBeginOnRef << " " << uiRefPos << std::endl;
-            if( pPack->bPositionIsOnReversStrand( pAlignment->uiBeginOnRef ) )
-                std::cerr << "Begin is reverse: True" << std::endl;
-            else
-                std::cerr << "Begin is reverse: False" << std::endl;
-            if( pPack->bPositionIsOnReversStrand( pAlignment->uiEndOnRef ) )
-                std::cerr << "End is reverse: True" << std::endl;
-            else
-                std::cerr << "End is reverse: False" << std::endl;
-            throw std::runtime_error( "Error: Tried to write wrong index to file" );
+            appendNumber( sCombined, pAlignment->uiEndOnQuery - pAlignment->uiBeginOnQuery );
+            sCombined.push_back( 'S' );
         } // if
-#endif
-        std::string sTag =
-            this->computeTag( pAlignment->xStats.bFirst ? pQuery1 : pQuery2, pAlignment, pPack, pAlignments );
-
-        std::string sMapQual;
-        if( std::isnan( pAlignment->fMappingQuality ) )
-            sMapQual = "255";
+        else
+            appendCigar( sCombined, *pAlignment, *pPack, pQuery1->length( ), bSoftClip, bOutputMInsteadOfXAndEqual );
+        sCombined.push_back( '\t' );
+        // Ref. name of the mate/next read
+        sCombined.append( sContigOther ).push_back( '\t' );
+        // Position of the mate/next read
+        appendNumber( sCombined, uiPosOther );
+        // observed Template length
+        sCombined.append( "\t0\t" ); // output information unavailable for now...
+        if( bOmitSecondarySeq && pAlignment->bSecondary )
+            sCombined.append( "*\t*" );
         else
         {
-            assert( pAlignment->fMappingQuality >= 0 );
-            sMapQual =
-                std::to_string( std::min( static_cast<int>( std::ceil( pAlignment->fMappingQuality * 254 ) ), 255 ) );
-        }
-
-        assert( sTag.empty( ) || sTag[ 0 ] == '\t' );
-        sCombined +=
-            // query name
-            sName + "\t" +
-            // alignment flag
-            std::to_string( flag ) + "\t" +
-            // reference name
-            sRefName + "\t" +
-            // pos
-            std::to_string( uiRefPos ) + "\t" +
-            // mapping quality
-            sMapQual + "\t" +
-            // cigar
-            sCigar + "\t" +
-            // Ref. name of the mate/next read
-            sContigOther + "\t" +
-            // Position of the mate/next read
-            sPosOther + "\t" +
-            // observed Template length
-            /*sTlen*/ "0" + "\t" + // output information unavailable for now...
             // segment sequence
-            sSegment + "\t" +
+            if( bSoftClip )
+                rBuffer.appendSeq( *pQuery, 0, pQuery->length( ), bReverse );
+            else
+                rBuffer.appendSeq( *pQuery, pAlignment->uiBeginOnQuery, pAlignment->uiEndOnQuery, bReverse );
+            sCombined.push_back( '\t' );
             // ASCII of Phred-scaled base Quality+33
-            sQual + // \t is in sTag
-            // Tag
-            sTag + "\n";
+            rBuffer.appendQual( *pQuery, pAlignment->uiBeginOnQuery, pAlignment->uiEndOnQuery );
+        } // else
+        // Tag (\t is in the tag)
+        this->appendTag( sCombined, pQuery, pAlignment, pPack, pAlignments );
+        sCombined.push_back( '\n' );
     } // for
     // if we have not computed any alignment then we should still output the query as unaligned:
     if( !bFirstQueryHasAlignment && !bSecondQueryHasAlignment )
     {
-        sCombined +=
-            // query name
-            pQuery1->sName + "\t" +
-            // alignment flag
-            std::to_string( SEGMENT_UNMAPPED | MULTIPLE_SEGMENTS_IN_TEMPLATE | FIRST_IN_TEMPLATE |
-                            NEXT_SEGMENT_UNMAPPED ) +
-            "\t*\t0\t0\t*\t*\t0\t0\t" +
-            // segment sequence
-            pQuery1->toString( ) + "\t" + pQuery1->toQualString( ) + "\n";
-        sCombined +=
-            // query name
-            pQuery2->sName + "\t" +
-            // alignment flag
-            std::to_string( SEGMENT_UNMAPPED | MULTIPLE_SEGMENTS_IN_TEMPLATE | LAST_IN_TEMPLATE |
-                            NEXT_SEGMENT_UNMAPPED ) +
-            "\t*\t0\t0\t*\t*\t0\t0\t" +
-            // segment sequence
-            pQuery2->toString( ) + "\t" + pQuery2->toQualString( ) + "\n";
+        appendUnmappedMate( rBuffer, *pQuery1,
+                            SEGMENT_UNMAPPED | MULTIPLE_SEGMENTS_IN_TEMPLATE | FIRST_IN_TEMPLATE | NEXT_SEGMENT_UNMAPPED,
+                            nullptr, "", true );
+        appendUnmappedMate( rBuffer, *pQuery2,
+                            SEGMENT_UNMAPPED | MULTIPLE_SEGMENTS_IN_TEMPLATE | LAST_IN_TEMPLATE | NEXT_SEGMENT_UNMAPPED,
+                            nullptr, "", true );
     } // if
     // if we have not computed an alignment for only one of the queries output the other one:
     else if( !bFirstQueryHasAlignment || !bSecondQueryHasAlignment )
@@ -354,30 +484,28 @@ PairedFileWriter::execute( std::shared_ptr<NucSeq> pQuery1,
         assert( pAlignments->size( ) > 0 );
         assert( ( *pAlignments )[ 0 ]->xStats.bFirst == ( !bFirstQueryHasAlignment ? false : true ) );
 
-        std::string sPosOther = std::to_string( ( *pAlignments )[ 0 ]->getSamPosition( *pPack ) );
-        std::string sContigOther = ( *pAlignments )[ 0 ]->getContig( *pPack );
-        sCombined +=
-            // query name
-            ( !bFirstQueryHasAlignment ? pQuery1->sName : pQuery2->sName ) + "\t" +
-            // alignment flag
-            std::to_string( SEGMENT_UNMAPPED | MULTIPLE_SEGMENTS_IN_TEMPLATE |
-                            ( !bFirstQueryHasAlignment ? FIRST_IN_TEMPLATE : LAST_IN_TEMPLATE ) ) +
-            "\t" + sContigOther + "\t" + sPosOther +
-            "\t0" // outputing mapq0 because bwa mem does that as well...
-            "\t*\t=\t" +
-            sPosOther + "\t0\t" +
-            // segment sequence
-            ( !bFirstQueryHasAlignment ? pQuery1->toString( ) : pQuery2->toString( ) ) + "\t*\n";
+        std::string sPosOther;
+        appendNumber( sPosOther, ( *pAlignments )[ 0 ]->getSamPosition( *pPack ) );
+        appendUnmappedMate( rBuffer, !bFirstQueryHasAlignment ? *pQuery1 : *pQuery2,
+                            SEGMENT_UNMAPPED | MULTIPLE_SEGMENTS_IN_TEMPLATE |
+                                ( !bFirstQueryHasAlignment ? FIRST_IN_TEMPLATE : LAST_IN_TEMPLATE ),
+                            pPack->nameOfSequenceWithId(
+                                pPack->uiSequenceIdForPosition( ( *pAlignments )[ 0 ]->uiBeginOnRef ) ),
+                            sPosOther, false );
     } // if
 
-    if( sCombined.size( ) > 0 )
+    // with restored read order, empty outputs must be reported as well, so that the following reads are written
+    if( sCombined.size( ) > 0 || pReadOrder != nullptr )
     { // scope xGuard
         // synchronize file output
         std::lock_guard<std::mutex> xGuard( *pLock );
 
         // print alignment
         // flushing will be done in the the outstream class
-        *pOut << sCombined;
+        if( pReadOrder != nullptr )
+            pReadOrder->write( *pOut, *pQuery1, std::move( sCombined ) );
+        else
+            *pOut << sCombined;
     } // if & scope xGuard
     return std::shared_ptr<libMS::Container>( new libMS::Container( ) );
 } // function
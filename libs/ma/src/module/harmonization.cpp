@@ -4,9 +4,12 @@
  */
 #include "ma/module/harmonization.h"
 #include "ma/module/stripOfConsideration.h"
+#include "ma/util/socThreadPool.h"
 #include "ms/util/pybind11.h"
+#include "util/radixSort.h"
+#include <deque>
 #if USE_RANSAC == 1
-#include "ma/sample_consensus/test_ransac.h"
+#include "ma/sample_consensus/line_ransac.h"
 #endif
 using namespace libMA;
 using namespace libMS;
@@ -184,19 +187,15 @@ Harmonization::linesweep( std::shared_ptr<std::vector<std::tuple<Seeds::iterator
                           const int64_t uiRStart, const double fAngle )
 {
     // sort shadows (increasingly) by start coordinate of the match
-    std::sort( pShadows->begin( ), pShadows->end( ),
-               []( std::tuple<Seeds::iterator, nucSeqIndex, nucSeqIndex> xA,
-                   std::tuple<Seeds::iterator, nucSeqIndex, nucSeqIndex>
-                       xB ) {
-                   /*
-                    * sort by the interval starts
-                    * if two intervals start at the same point the larger one shall be treated first
-                    */
-                   if( std::get<1>( xA ) == std::get<1>( xB ) )
-                       return ( std::get<2>( xA ) > std::get<2>( xB ) );
-                   return ( std::get<1>( xA ) < std::get<1>( xB ) );
-               } // lambda
-    ); // sort function call
+    /*
+     * sort by the interval starts
+     * if two intervals start at the same point the larger one shall be treated first
+     * (i.e. descending by the interval end; achieved by negating the key)
+     * radix::sort falls back to std::sort for large shadow sets, where the two radix keys are slower
+     */
+    radix::sort( pShadows->begin( ), pShadows->end( ),
+                 []( const std::tuple<Seeds::iterator, nucSeqIndex, nucSeqIndex>& xT ) { return std::get<1>( xT ); },
+                 []( const std::tuple<Seeds::iterator, nucSeqIndex, nucSeqIndex>& xT ) { return ~std::get<2>( xT ); } );
 
     // for(std::tuple<Seeds::iterator, nucSeqIndex, nucSeqIndex>& xTup : *pShadows)
     //{
@@ -256,24 +255,23 @@ std::shared_ptr<Seeds> Harmonization::harmonizeOne( std::shared_ptr<Seeds>& pSee
     if( pSeedsIn->size( ) > 1 )
     {
 #if USE_RANSAC == 1 // switch between ransac line angle + intercept estimation & 45deg median line
-        std::vector<double> vX, vY;
-        vX.reserve( pSeedsIn->size( ) );
-        vY.reserve( pSeedsIn->size( ) );
+        // one instance per thread, so that the point buffers are reused across SoCs
+        thread_local LineRansac xRansac;
+        xRansac.reset( (double)pSeedsIn->front( ).start_ref( ), (double)pSeedsIn->front( ).start( ) );
+        xRansac.reserve( pSeedsIn->size( ) * 3 );
         for( const auto& rSeed : *pSeedsIn )
         {
             // middlepoint of seed in plane
-            vX.push_back( (double)rSeed.start_ref( ) + rSeed.size( ) / 2.0 );
-            vY.push_back( (double)rSeed.start( ) + rSeed.size( ) / 2.0 );
+            xRansac.addPoint( (double)rSeed.start_ref( ) + rSeed.size( ) / 2.0,
+                              (double)rSeed.start( ) + rSeed.size( ) / 2.0 );
             // start point of seed in plane
-            vX.push_back( (double)rSeed.start_ref( ) );
-            vY.push_back( (double)rSeed.start( ) );
+            xRansac.addPoint( (double)rSeed.start_ref( ), (double)rSeed.start( ) );
             // end point of seed in plane
-            vX.push_back( (double)rSeed.start_ref( ) + rSeed.size( ) );
-            vY.push_back( (double)rSeed.start( ) + rSeed.size( ) );
+            xRansac.addPoint( (double)rSeed.start_ref( ) + rSeed.size( ), (double)rSeed.start( ) + rSeed.size( ) );
         } // for
         /* The Mean Absolute Deviation (MAD) is later required for the threshold t */
-        double fMAD = medianAbsoluteDeviation<double>( vY );
-        auto xSlopeIntercept = run_ransac( vX, vY, /*pSoCIn->vIngroup.back(),*/ fMAD );
+        double fMAD = xRansac.medianAbsoluteDeviationY( );
+        auto xSlopeIntercept = xRansac.fit( fMAD );
 
         /*
          * remove outliers
@@ -328,6 +326,7 @@ std::shared_ptr<Seeds> Harmonization::harmonizeOne( std::shared_ptr<Seeds>& pSee
         DEBUG( pSoCIn->vHarmSoCs.push_back( pSeeds ); ) // DEBUG
 
         // seeds need to be sorted for the following steps
+        // (std::sort instead of radix::sort, since the seeds are already roughly ordered by the right shadow linesweep)
         std::sort( pSeeds->begin( ), pSeeds->end( ),
                    []( const Seed& xA, const Seed& xB ) {
                        if( xA.start_ref( ) == xB.start_ref( ) )
@@ -371,9 +370,26 @@ std::shared_ptr<Seeds> Harmonization::harmonizeOne( std::shared_ptr<Seeds>& pSee
     } // else
     return pSeeds;
 }
+Harmonization::HarmonizedSoC Harmonization::harmonizeSoC( std::shared_ptr<Seeds> pSeedsIn,
+                                                         std::shared_ptr<NucSeq> pQuery,
+                                                         uint64_t uiRefSeqLength,
+                                                         std::shared_ptr<SoCPriorityQueue> pSoCIn )
+{
+    auto pUnharmSeedsRev = pSeedsIn->extractStrand( false );
+    for( auto& rSeed : *pUnharmSeedsRev )
+    {
+        assert( rSeed.end( ) <= pQuery->length( ) );
+        rSeed.uiPosOnReference = uiRefSeqLength - rSeed.uiPosOnReference - 1;
+    }
+
+    auto pSeedsForw = harmonizeOne( pSeedsIn, pQuery, pSoCIn );
+    auto pSeedsRev = harmonizeOne( pUnharmSeedsRev, pQuery, pSoCIn );
+    return std::make_pair( pSeedsForw, pSeedsRev );
+} // method
+
 std::shared_ptr<ContainerVector<std::shared_ptr<Seeds>>>
-Harmonization::execute( std::shared_ptr<SoCPriorityQueue> pSoCIn, std::shared_ptr<NucSeq> pQuery,
-                        std::shared_ptr<FMIndex> pFM_index )
+Harmonization::harmonize( std::shared_ptr<SoCPriorityQueue> pSoCIn, std::shared_ptr<NucSeq> pQuery,
+                          uint64_t uiRefSeqLength )
 {
 #define FILTER_1 ( 0 )
 #if FILTER_1
@@ -387,29 +403,83 @@ Harmonization::execute( std::shared_ptr<SoCPriorityQueue> pSoCIn, std::shared_pt
 
     auto pSoCs = std::make_shared<ContainerVector<std::shared_ptr<Seeds>>>( );
 
-    while( !pSoCIn->empty( ) )
+#if DEBUG_LEVEL > 0
+    // the debug bookkeeping in pSoCIn relies on the sequential order
+    const bool bParallel = false;
+#else
+    const bool bParallel = uiSoCThreads > 0 && pQuery->length( ) >= uiMinQueryLenSoCThreads;
+#endif
+    /*
+     * SoCs that were popped but not evaluated yet (in pop order).
+     * In parallel mode, a batch of SoCs is popped and harmonized concurrently on the shared pool.
+     * The break criteria below are still evaluated in pop order, so the output does not change;
+     * merely the harmonizations of SoCs after a break are wasted.
+     * In sequential mode, the harmonization is deferred until it is requested (i.e. nothing is wasted).
+     */
+    std::deque<PendingSoC> xPending;
+    // tasks in the pool use this module; so we must wait for all of them before returning
+    std::vector<std::shared_future<HarmonizedSoC>> vInPool;
+    auto fWaitForPool = [ & ]( ) {
+        for( auto& xFuture : vInPool )
+            xFuture.wait( );
+    }; // lambda
+
+    while( !xPending.empty( ) || !pSoCIn->empty( ) )
     {
         if( ++uiNumTries > uiMaxTries )
         {
             PRINT_BREAK_CRITERIA( std::cout << "break after " << uiNumTries << " tries." << std::endl; )
             break;
         }
-        auto pSeedsIn = pSoCIn->pop( );
+        if( xPending.empty( ) )
+        {
+            // never pop more SoCs than the remaining tries
+            const size_t uiBatchSize = bParallel ? std::min( uiSoCThreads, uiMaxTries - uiNumTries + 1 ) : 1;
+            for( size_t uiI = 0; uiI < uiBatchSize && !pSoCIn->empty( ); uiI++ )
+            {
+                auto pSeedsIn = pSoCIn->pop( );
 
-        DEBUG( pSoCIn->vExtractOrder.push_back( SoCPriorityQueue::blub( ) );
-               pSoCIn->vExtractOrder.back( ).rStartSoC = pSeedsIn->front( ).start_ref( );
-               pSoCIn->vExtractOrder.back( ).rEndSoC = pSeedsIn->front( ).end_ref( ); ) // DEBUG
+                DEBUG( pSoCIn->vExtractOrder.push_back( SoCPriorityQueue::blub( ) );
+                       pSoCIn->vExtractOrder.back( ).rStartSoC = pSeedsIn->front( ).start_ref( );
+                       pSoCIn->vExtractOrder.back( ).rEndSoC = pSeedsIn->front( ).end_ref( ); ) // DEBUG
 
-        assert( !pSeedsIn->empty( ) );
-        nucSeqIndex uiCurrSoCScore = 0;
-        for( const auto& rSeed : *pSeedsIn )
+                assert( !pSeedsIn->empty( ) );
+                nucSeqIndex uiSoCScore = 0;
+                for( const auto& rSeed : *pSeedsIn )
+                {
+                    uiSoCScore += rSeed.size( );
+                    DEBUG( pSoCIn->vExtractOrder.back( ).rStartSoC =
+                               std::min( pSoCIn->vExtractOrder.back( ).rStartSoC, rSeed.start_ref( ) );
+                           pSoCIn->vExtractOrder.back( ).rEndSoC = std::max( pSoCIn->vExtractOrder.back( ).rEndSoC,
+                                                                             rSeed.end_ref( ) ); ) // DEBUG
+                } // for
+
+                auto fHarmonize = [ this, pSeedsIn, pQuery, uiRefSeqLength, pSoCIn ]( ) {
+                    return harmonizeSoC( pSeedsIn, pQuery, uiRefSeqLength, pSoCIn );
+                }; // lambda
+                if( bParallel )
+                {
+                    vInPool.push_back( socThreadPool( uiSoCThreads )
+                                           .enqueue( [ fHarmonize ]( size_t ) { return fHarmonize( ); } )
+                                           .share( ) );
+                    xPending.push_back( PendingSoC{ pSeedsIn->size( ), uiSoCScore, vInPool.back( ) } );
+                } // if
+                else
+                    xPending.push_back( PendingSoC{ pSeedsIn->size( ), uiSoCScore,
+                                                    std::async( std::launch::deferred, fHarmonize ).share( ) } );
+            } // for
+        } // if
+        PendingSoC xCurr = std::move( xPending.front( ) );
+        xPending.pop_front( );
+
+        // give up on reads that exceed their budget; the read is reported unmapped
+        if( !pQuery->spendSeeds( xCurr.uiNumSeeds, uiSeedBudget ) )
         {
-            uiCurrSoCScore += rSeed.size( );
-            DEBUG( pSoCIn->vExtractOrder.back( ).rStartSoC =
-                       std::min( pSoCIn->vExtractOrder.back( ).rStartSoC, rSeed.start_ref( ) );
-                   pSoCIn->vExtractOrder.back( ).rEndSoC = std::max( pSoCIn->vExtractOrder.back( ).rEndSoC,
-                                                                     rSeed.end_ref( ) ); ) // DEBUG
-        } // for
+            PRINT_BREAK_CRITERIA( std::cout << "give up because of the seed budget" << std::endl; )
+            fWaitForPool( );
+            return std::make_shared<ContainerVector<std::shared_ptr<Seeds>>>( );
+        } // if
+        const nucSeqIndex uiCurrSoCScore = xCurr.uiSoCScore;
 
         // Prof. Kutzners filter:
         // this merely checks weather we actually do have to do the harmonization at all
@@ -434,15 +504,9 @@ Harmonization::execute( std::shared_ptr<SoCPriorityQueue> pSoCIn, std::shared_pt
         DEBUG( pSoCIn->vExtractOrder.back( ).first = uiCurrSoCScore;
                pSoCIn->vIngroup.push_back( std::make_shared<Seeds>( ) ); )
 
-        auto pUnharmSeedsRev = pSeedsIn->extractStrand( false );
-        for( auto& rSeed : *pUnharmSeedsRev )
-        {
-            assert( rSeed.end( ) <= pQuery->length( ) );
-            rSeed.uiPosOnReference = pFM_index->getRefSeqLength( ) - rSeed.uiPosOnReference - 1;
-        }
-
-        auto pSeedsForw = harmonizeOne( pSeedsIn, pQuery, pSoCIn );
-        auto pSeedsRev = harmonizeOne( pUnharmSeedsRev, pQuery, pSoCIn );
+        HarmonizedSoC xHarmonized = xCurr.xHarmonized.get( );
+        auto pSeedsForw = xHarmonized.first;
+        auto pSeedsRev = xHarmonized.second;
 
         PRINT_BREAK_CRITERIA( if( pSoCIn->empty( ) ) std::cout << "exhausted all SoCs" << std::endl; )
 
@@ -542,6 +606,7 @@ Harmonization::execute( std::shared_ptr<SoCPriorityQueue> pSoCIn, std::shared_pt
         // FILTER END
 
     } // while
+    fWaitForPool( );
 
     if( bDoHeuristics )
     {
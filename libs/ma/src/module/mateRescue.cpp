@@ -0,0 +1,186 @@
+/**
+ * @file mateRescue.cpp
+ */
+#include "ma/module/mateRescue.h"
+#include <limits>
+
+using namespace libMA;
+using namespace libMS;
+
+/**
+ * @brief calls fDo( uiKMer, uiPos ) for all k-mers of rSeq that do not contain an N.
+ * @details
+ * The k-mers are 2 bit packed and computed in a rolling fashion; uiK must be at most 32.
+ */
+template <typename F> void forEachKMer( const NucSeq& rSeq, nucSeqIndex uiK, F&& fDo )
+{
+    const uint64_t uiMask = uiK >= 32 ? ~(uint64_t)0 : ( (uint64_t)1 << ( 2 * uiK ) ) - 1;
+    uint64_t uiKMer = 0;
+    nucSeqIndex uiValid = 0; // number of valid nucleotides at the end of uiKMer
+    for( nucSeqIndex uiI = 0; uiI < rSeq.length( ); uiI++ )
+    {
+        const uint8_t uiNuc = rSeq.pxSequenceRef[ uiI ];
+        if( uiNuc > 3 )
+        {
+            uiValid = 0;
+            continue;
+        } // if
+        uiKMer = ( ( uiKMer << 2 ) | uiNuc ) & uiMask;
+        if( ++uiValid >= uiK )
+            fDo( uiKMer, uiI + 1 - uiK );
+    } // for
+} // function
+
+std::shared_ptr<Seeds> MateRescue::windowSeeds( std::shared_ptr<NucSeq> pQuery, std::shared_ptr<Alignment> pAlignment,
+                                                std::shared_ptr<Pack> pPack )
+{
+    auto pRet = std::make_shared<Seeds>( );
+    pRet->xStats.sName = pQuery->sName;
+    if( pAlignment->length( ) == 0 || pQuery->length( ) < uiSeedSize )
+        return pRet;
+
+    /*
+     * PairedReads pairs two alignments if |begin_1 - reverse(begin_2)| <= mean + 3*std.
+     * So the second mate begins within reverse(begin_1) +- (mean + 3*std) on the opposite strand of the first mate.
+     */
+    const int64_t iCenter = (int64_t)pPack->uiPositionToReverseStrand( pAlignment->beginOnRef( ) );
+    const int64_t iMaxDist = ( int64_t )( dMean + 3 * dStd );
+    int64_t iBegin = std::max( (int64_t)0, iCenter - iMaxDist );
+    int64_t iEnd = std::min( (int64_t)pPack->uiUnpackedSizeForwardPlusReverse( ),
+                             iCenter + iMaxDist + (int64_t)pQuery->length( ) );
+    // clip the window to the contig (this also makes sure that we do not bridge the forward / reverse strand border)
+    pPack->vAlignPositions( iBegin, iCenter, iEnd );
+    if( iEnd - iBegin < (int64_t)uiSeedSize )
+        return pRet;
+    auto pWindow = pPack->vExtract( iBegin, iEnd );
+
+    // k-mers of the query in an open addressing hash table (linear probing; size: power of two >= 2 * |Q|)
+    size_t uiTableSize = 64;
+    while( uiTableSize < 2 * pQuery->length( ) )
+        uiTableSize *= 2;
+    const nucSeqIndex uiEmpty = std::numeric_limits<nucSeqIndex>::max( );
+    std::vector<std::pair<uint64_t, nucSeqIndex>> vTable( uiTableSize, std::make_pair( 0, uiEmpty ) );
+    auto fSlot = [ & ]( uint64_t uiKMer ) { return ( uiKMer * 0x9E3779B97F4A7C15ull ) >> 32 & ( uiTableSize - 1 ); };
+    forEachKMer( *pQuery, uiSeedSize, [ & ]( uint64_t uiKMer, nucSeqIndex uiPos ) {
+        size_t uiSlot = fSlot( uiKMer );
+        while( vTable[ uiSlot ].second != uiEmpty )
+            uiSlot = ( uiSlot + 1 ) & ( uiTableSize - 1 );
+        vTable[ uiSlot ] = std::make_pair( uiKMer, uiPos );
+    } ); // lambda
+
+    // k-mer hits between the query and the window as (diagonal, query position, window position)
+    std::vector<std::tuple<int64_t, nucSeqIndex, nucSeqIndex>> vHits;
+    forEachKMer( *pWindow, uiSeedSize, [ & ]( uint64_t uiKMer, nucSeqIndex uiPos ) {
+        for( size_t uiSlot = fSlot( uiKMer ); vTable[ uiSlot ].second != uiEmpty;
+             uiSlot = ( uiSlot + 1 ) & ( uiTableSize - 1 ) )
+            if( vTable[ uiSlot ].first == uiKMer )
+                vHits.emplace_back( (int64_t)uiPos - (int64_t)vTable[ uiSlot ].second, vTable[ uiSlot ].second,
+                                    uiPos );
+    } ); // lambda
+    std::sort( vHits.begin( ), vHits.end( ) );
+
+    // merge consecutive hits on the same diagonal into maximal seeds
+    // & convert the seeds to the format of ExtractSeeds
+    const bool bOnReverseStrand = pPack->bPositionIsOnReversStrand( iBegin );
+    for( size_t uiI = 0; uiI < vHits.size( ); )
+    {
+        size_t uiJ = uiI + 1;
+        while( uiJ < vHits.size( ) && std::get<0>( vHits[ uiJ ] ) == std::get<0>( vHits[ uiI ] ) &&
+               std::get<1>( vHits[ uiJ ] ) == std::get<1>( vHits[ uiJ - 1 ] ) + 1 )
+            uiJ++;
+        pRet->emplace_back( std::get<1>( vHits[ uiI ] ), uiSeedSize + ( uiJ - uiI - 1 ),
+                            std::get<2>( vHits[ uiI ] ) + iBegin, true );
+        Seed& rSeed = pRet->back( );
+        if( bOnReverseStrand )
+        {
+            // mirror seed on the x coordinate (same as Segment::forEachSeed)
+            rSeed.uiPosOnReference = pPack->uiPositionToReverseStrand( rSeed.uiPosOnReference );
+            rSeed.bOnForwStrand = false;
+        } // if
+        ExtractSeeds::setDeltaOfSeed( rSeed, pQuery->length( ), *pPack, bSplitStrands );
+        uiI = uiJ;
+    } // for
+    return pRet;
+} // method
+
+std::shared_ptr<ContainerVector<std::shared_ptr<Alignment>>>
+MateRescue::fullAlignment( std::shared_ptr<NucSeq> pQuery, std::shared_ptr<FMIndex> pFMIndex,
+                           std::shared_ptr<Pack> pPack )
+{
+    auto pSegments = xSeeding.execute( pFMIndex, pQuery );
+    auto pSoCs = xSoC.execute( pSegments, pQuery, pPack, pFMIndex );
+    auto pHarmonized = xHarmonization.execute( pSoCs, pQuery, pFMIndex );
+    return xMappingQuality.execute( pQuery, xDP.execute( pHarmonized, pQuery, pPack ) );
+} // method
+
+std::shared_ptr<ContainerVector<std::shared_ptr<Alignment>>>
+MateRescue::rescue( std::shared_ptr<NucSeq> pQuery,
+                    std::shared_ptr<ContainerVector<std::shared_ptr<Alignment>>>
+                        pOtherAlignments,
+                    uint64_t uiRefSeqLength,
+                    std::shared_ptr<Pack>
+                        pPack )
+{
+    if( pOtherAlignments->empty( ) || pOtherAlignments->front( )->fMappingQuality < fMinMapQ )
+        return nullptr;
+    auto pOther = pOtherAlignments->front( );
+    auto pSeeds = windowSeeds( pQuery, pOther, pPack );
+    if( pSeeds->empty( ) )
+        return nullptr;
+    auto pSoCs = xSoCSeeds.execute( pSeeds, pQuery, pPack );
+    auto pHarmonized = xHarmonization.harmonize( pSoCs, pQuery, uiRefSeqLength );
+    auto pAlignments = xMappingQuality.execute( pQuery, xDP.execute( pHarmonized, pQuery, pPack ) );
+    if( pAlignments->empty( ) ||
+        pAlignments->front( )->score( ) < fMinScore * pGlobalParams->iMatch->get( ) * pQuery->length( ) )
+        return nullptr;
+    // the mapping quality was computed within the window only;
+    // so the rescued mate cannot be more confident than the mate that rescued it.
+    pAlignments->front( )->fMappingQuality =
+        std::min( pAlignments->front( )->fMappingQuality, pOther->fMappingQuality );
+    return pAlignments;
+} // method
+
+std::shared_ptr<ContainerVector<std::shared_ptr<Alignment>>>
+MateRescue::execute( std::shared_ptr<NucSeq> pQuery,
+                     std::shared_ptr<ContainerVector<std::shared_ptr<Alignment>>>
+                         pOtherAlignments,
+                     std::shared_ptr<FMIndex>
+                         pFMIndex,
+                     std::shared_ptr<Pack>
+                         pPack )
+{
+    auto pAlignments = rescue( pQuery, pOtherAlignments, pFMIndex->getRefSeqLength( ), pPack );
+    if( pAlignments != nullptr )
+        return pAlignments;
+    // rescue not possible or failed: fall back to seeding on the whole genome
+    return fullAlignment( pQuery, pFMIndex, pPack );
+} // method
+
+std::shared_ptr<ContainerVector<std::shared_ptr<Alignment>>>
+ShardedMateRescue::execute( std::shared_ptr<NucSeq> pQuery,
+                            std::shared_ptr<ContainerVector<std::shared_ptr<Alignment>>>
+                                pOtherAlignments,
+                            std::shared_ptr<ShardedFMIndex>
+                                pIndex,
+                            std::shared_ptr<Pack>
+                                pPack )
+{
+    auto pAlignments = xRescue.rescue( pQuery, pOtherAlignments, pIndex->getRefSeqLength( ), pPack );
+    if( pAlignments != nullptr )
+        return pAlignments;
+    // rescue not possible or failed: fall back to seeding on all shards
+    auto pSeeds = xSeeding.execute( pIndex, pQuery, pPack );
+    auto pSoCs = xRescue.xSoCSeeds.execute( pSeeds, pQuery, pPack );
+    auto pHarmonized = xRescue.xHarmonization.harmonize( pSoCs, pQuery, pIndex->getRefSeqLength( ) );
+    return xRescue.xMappingQuality.execute( pQuery, xRescue.xDP.execute( pHarmonized, pQuery, pPack ) );
+} // method
+
+#ifdef WITH_PYTHON
+
+void exportMateRescue( libMS::SubmoduleOrganizer& xOrganizer )
+{
+    // export the MateRescue class
+    exportModule<MateRescue>( xOrganizer, "MateRescue" );
+    exportModule<ShardedMateRescue>( xOrganizer, "ShardedMateRescue" );
+} // function
+#endif
@@ -9,6 +9,7 @@
 #endif
 
 #include "kswcpp_mem.h"
+#include "ma/util/socThreadPool.h"
 #include <algorithm>
 #include <bitset>
 #include <cassert>
@@ -81,7 +82,7 @@ inline void ksw_simplified( int qlen, const uint8_t* query, int tlen, const uint
 // banded global NW
 void NeedlemanWunsch::ksw( std::shared_ptr<NucSeq> pQuery, std::shared_ptr<NucSeq> pRef, nucSeqIndex fromQuery,
                            nucSeqIndex toQuery, nucSeqIndex fromRef, nucSeqIndex toRef,
-                           std::shared_ptr<Alignment> pAlignment, AlignedMemoryManager& rMemoryManager )
+                           std::shared_ptr<Alignment> pAlignment, DPWorkspace& rWorkspace )
 {
     // sanity checks
     if( toRef <= fromRef )
@@ -98,14 +99,14 @@ void NeedlemanWunsch::ksw( std::shared_ptr<NucSeq> pQuery, std::shared_ptr<NucSe
         return;
     } // if
 
-    Wrapper_ksw_extz_t ez;
+    Wrapper_ksw_extz_t& ez = rWorkspace.xEz;
 
     assert( toQuery < pQuery->length( ) );
     assert( toRef < pRef->length( ) );
     ksw_simplified( (int)( toQuery - fromQuery ), pQuery->pGetSequenceRef( ) + fromQuery, (int)( toRef - fromRef ),
                     pRef->pGetSequenceRef( ) + fromRef, xKswParameters, iMinBandwidthGapFilling,
                     ez.ez, // return value
-                    rMemoryManager );
+                    rWorkspace.xMemoryManager );
 
     nucSeqIndex qPos = fromQuery;
     nucSeqIndex rPos = fromRef;
@@ -238,23 +239,23 @@ class MyPrinterMemory
  */
 void NeedlemanWunsch::ksw_dual_ext( std::shared_ptr<NucSeq> pQuery, std::shared_ptr<NucSeq> pRef, nucSeqIndex fromQuery,
                                     nucSeqIndex toQuery, nucSeqIndex fromRef, nucSeqIndex toRef,
-                                    std::shared_ptr<Alignment> pAlignment, AlignedMemoryManager& rMemoryManager )
+                                    std::shared_ptr<Alignment> pAlignment, DPWorkspace& rWorkspace )
 {
-    Wrapper_ksw_extz_t ez_left;
-    Wrapper_ksw_extz_t ez_right;
+    Wrapper_ksw_extz_t& ez_left = rWorkspace.xEz;
+    Wrapper_ksw_extz_t& ez_right = rWorkspace.xEz2;
 
     // perform both extensions
     ksw_ext( (int)( toQuery - fromQuery ), pQuery->pGetSequenceRef( ) + fromQuery, (int)( toRef - fromRef ),
              pRef->pGetSequenceRef( ) + fromRef, xKswParameters, iBandwidthDPExtension, uiZDrop,
              ez_left.ez, // return value
-             rMemoryManager, false );
+             rWorkspace.xMemoryManager, false );
 
     pQuery->vReverse( fromQuery, toQuery );
     pRef->vReverse( fromRef, toRef );
     ksw_ext( (int)( toQuery - fromQuery ), pQuery->pGetSequenceRef( ) + fromQuery, (int)( toRef - fromRef ),
              pRef->pGetSequenceRef( ) + fromRef, xKswParameters, iBandwidthDPExtension, uiZDrop,
              ez_right.ez, // return value
-             rMemoryManager, true );
+             rWorkspace.xMemoryManager, true );
     pQuery->vReverse( fromQuery, toQuery );
     pRef->vReverse( fromRef, toRef );
 
@@ -500,7 +501,7 @@ void NeedlemanWunsch::dynPrg( const std::shared_ptr<NucSeq> pQuery, const std::s
                               const nucSeqIndex fromQuery, const nucSeqIndex toQuery, const nucSeqIndex fromRef,
                               const nucSeqIndex toRef,
                               std::shared_ptr<Alignment> pAlignment, // in & output
-                              AlignedMemoryManager& rMemoryManager, const bool bLocalBeginning, const bool bLocalEnd )
+                              DPWorkspace& rWorkspace, const bool bLocalBeginning, const bool bLocalEnd )
 {
     // do some checking for empty sequences
     if( toRef <= fromRef )
@@ -523,15 +524,23 @@ void NeedlemanWunsch::dynPrg( const std::shared_ptr<NucSeq> pQuery, const std::s
     } // if
 
     DEBUG_3( std::cout << "dynProg begin" << std::endl; )
+    // cooperative per read budget: the caller discards the alignment once the read is over budget
+    const bool bDualExtension = toQuery - fromQuery > uiMaxGapArea || toRef - fromRef > uiMaxGapArea;
+    if( !pQuery->spendDPCells( dpCells( toQuery - fromQuery, toRef - fromRef,
+                                        bLocalBeginning || bLocalEnd || bDualExtension ? iBandwidthDPExtension
+                                                                                       : iMinBandwidthGapFilling ),
+                               uiDPCellBudget ) )
+        return;
+
     if( !bLocalBeginning && !bLocalEnd )
     {
 #if 1
         // do not actually compute through gaps that are larger than a set maximum
-        if( toQuery - fromQuery > uiMaxGapArea || toRef - fromRef > uiMaxGapArea )
-            ksw_dual_ext( pQuery, pRef, fromQuery, toQuery, fromRef, toRef, pAlignment, rMemoryManager );
+        if( bDualExtension )
+            ksw_dual_ext( pQuery, pRef, fromQuery, toQuery, fromRef, toRef, pAlignment, rWorkspace );
         else
 #endif
-            ksw( pQuery, pRef, fromQuery, toQuery, fromRef, toRef, pAlignment, rMemoryManager );
+            ksw( pQuery, pRef, fromQuery, toQuery, fromRef, toRef, pAlignment, rWorkspace );
         DEBUG_3( std::cout << "dynProg end" << std::endl; )
         return;
     } // if
@@ -551,7 +560,7 @@ void NeedlemanWunsch::dynPrg( const std::shared_ptr<NucSeq> pQuery, const std::s
      * do the NW alignment
      */
 
-    Wrapper_ksw_extz_t ez;
+    Wrapper_ksw_extz_t& ez = rWorkspace.xEz;
 
     assert( toQuery < pQuery->length( ) );
     assert( toRef < pRef->length( ) );
@@ -563,7 +572,7 @@ void NeedlemanWunsch::dynPrg( const std::shared_ptr<NucSeq> pQuery, const std::s
     ksw_ext( (int)( toQuery - fromQuery ), pQuery->pGetSequenceRef( ) + fromQuery, (int)( toRef - fromRef ),
              pRef->pGetSequenceRef( ) + fromRef, xKswParameters, iBandwidthDPExtension, uiZDrop,
              ez.ez, // return value
-             rMemoryManager, bReverse );
+             rWorkspace.xMemoryManager, bReverse );
     if( bReverse )
     {
         pQuery->vReverse( fromQuery, toQuery );
@@ -624,7 +633,7 @@ void NeedlemanWunsch::dynPrg( const std::shared_ptr<NucSeq> pQuery, const std::s
 
 std::shared_ptr<Alignment> NeedlemanWunsch::execute_one( std::shared_ptr<Seeds> pSeeds, std::shared_ptr<NucSeq> pQuery,
                                                          std::shared_ptr<Pack> pRefPack,
-                                                         AlignedMemoryManager& rMemoryManager )
+                                                         DPWorkspace& rWorkspace )
 {
 
     if( pSeeds == nullptr )
@@ -768,14 +777,18 @@ std::shared_ptr<Alignment> NeedlemanWunsch::execute_one( std::shared_ptr<Seeds>
     pRet->xStats.sName = pQuery->sName;
 
     DEBUG_2( std::cout << beginRef << " " << endRef << std::endl; )
-    std::shared_ptr<NucSeq> pRef = pRefPack->vExtract( beginRef, endRef );
+    // extract into the reference window of the workspace, so that its memory is reused across seed sets
+    std::shared_ptr<NucSeq> pRef = rWorkspace.pRefWindow;
+    pRefPack->vExtractSubsection( beginRef, endRef, *pRef );
 
     // create the actual alignment
 
     if( !bLocal )
     {
         dynPrg( pQuery, pRef, 0, pSeeds->front( ).start( ), 0, pSeeds->front( ).start_ref( ) - beginRef, pRet,
-                rMemoryManager, true, false );
+                rWorkspace, true, false );
+        if( pQuery->bOverBudget )
+            return std::make_shared<Alignment>( );
     } // if
 
     nucSeqIndex endOfLastSeedQuery = pSeeds->front( ).end( );
@@ -823,7 +836,9 @@ std::shared_ptr<Alignment> NeedlemanWunsch::execute_one( std::shared_ptr<Seeds>
         if( len > overlap )
         {
             dynPrg( pQuery, pRef, endOfLastSeedQuery, rSeed.start( ), endOfLastSeedReference,
-                    rSeed.start_ref( ) - beginRef, pRet, rMemoryManager, false, false );
+                    rSeed.start_ref( ) - beginRef, pRet, rWorkspace, false, false );
+            if( pQuery->bOverBudget )
+                return std::make_shared<Alignment>( );
             DEBUG(
                 // std::cout << pRet->vGapsScatter.size() << std::endl;
                 pRet->vGapsScatter.push_back(
@@ -862,7 +877,9 @@ std::shared_ptr<Alignment> NeedlemanWunsch::execute_one( std::shared_ptr<Seeds>
     else
     {
         dynPrg( pQuery, pRef, endOfLastSeedQuery, endQuery - 1, endOfLastSeedReference, endRef - beginRef - 1, pRet,
-                rMemoryManager, false, true );
+                rWorkspace, false, true );
+        if( pQuery->bOverBudget )
+            return std::make_shared<Alignment>( );
         // there should never be dangeling deletions with libGaba
         pRet->removeDangeling( );
     } // else
@@ -877,6 +894,39 @@ std::shared_ptr<Alignment> NeedlemanWunsch::execute_one( std::shared_ptr<Seeds>
 } // function
 
 
+std::shared_ptr<ContainerVector<std::shared_ptr<Alignment>>>
+NeedlemanWunsch::executeConcurrently( std::shared_ptr<ContainerVector<std::shared_ptr<Seeds>>> pSeedSets,
+                                      std::shared_ptr<NucSeq> pQuery, std::shared_ptr<Pack> pRefPack )
+{
+    const uint64_t uiDPCellsBefore = pQuery->uiDPCells;
+    std::vector<std::shared_ptr<NucSeq>> vQueries;
+    std::vector<std::future<std::shared_ptr<Alignment>>> vFutures;
+    for( auto pSeeds : *pSeedSets )
+    {
+        auto pCopy = std::make_shared<NucSeq>( *pQuery );
+        pCopy->sName = pQuery->sName;
+        // each task may use up the remaining budget of the read on its own
+        pCopy->uiDPCells = uiDPCellsBefore;
+        vQueries.push_back( pCopy );
+        vFutures.push_back( socThreadPool( uiSoCThreads ).enqueue( [ this, pSeeds, pCopy, pRefPack ]( size_t ) {
+            return execute_one( pSeeds, pCopy, pRefPack, DPWorkspace::local( ) );
+        } ) ); // lambda
+    } // for
+    // the tasks use this module; so wait for all of them before an exception can leave this function
+    for( auto& xFuture : vFutures )
+        xFuture.wait( );
+
+    auto pRet = std::make_shared<ContainerVector<std::shared_ptr<Alignment>>>( );
+    for( auto& xFuture : vFutures )
+        pRet->push_back( xFuture.get( ) );
+    for( auto pCopy : vQueries )
+        pQuery->spendDPCells( pCopy->uiDPCells - uiDPCellsBefore, uiDPCellBudget );
+    // reads that exceed their DP budget are reported unmapped
+    if( pQuery->bOverBudget )
+        return std::make_shared<ContainerVector<std::shared_ptr<Alignment>>>( );
+    return pRet;
+} // function
+
 /* Random nucleotide sequence of length uiLen, represented as codes.
  */
 std::vector<char> randomNucSeq( const size_t uiLen )
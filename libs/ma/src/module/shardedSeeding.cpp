@@ -0,0 +1,44 @@
+/**
+ * @file shardedSeeding.cpp
+ */
+#include "ma/module/shardedSeeding.h"
+#include "ms/util/pybind11.h"
+
+using namespace libMA;
+using namespace libMS;
+
+std::shared_ptr<Seeds> ShardedSeeding::execute( std::shared_ptr<ShardedFMIndex> pIndex, std::shared_ptr<NucSeq> pQuery,
+                                                std::shared_ptr<Pack> pPack )
+{
+    const nucSeqIndex uiQLen = pQuery->length( );
+    auto pSeeds = std::make_shared<Seeds>( );
+    pSeeds->xStats.sName = pQuery->sName;
+
+    for( auto& rShard : pIndex->vShards )
+    {
+        auto pSegments = xSeeding.execute( rShard.pFMIndex, pQuery );
+        pSeeds->xStats.bSetMappingQualityToZero |= pSegments->bSetMappingQualityToZero;
+        pSeeds->reserve( pSeeds->size( ) + pSegments->size( ) * 3 );
+
+        pSegments->forEachSeed( *rShard.pFMIndex, uiQLen, uiMaxAmbiguity, uiMinSeedSize, true, [ & ]( Seed& rSeed ) {
+            // seeds that run from the forward into the reverse strand of the shard do not exist on the genome
+            if( rSeed.bOnForwStrand && rSeed.end_ref( ) > rShard.uiLength )
+                return true;
+            // the seed is on the forward strand coordinates of the shard; move it to the ones of the genome
+            rSeed.uiPosOnReference += rShard.uiOffset;
+            pSeeds->push_back( rSeed );
+            ExtractSeeds::setDeltaOfSeed( pSeeds->back( ), uiQLen, *pPack, !bRectangular );
+            return true;
+        } ); // forEachSeed
+    } // for
+
+    return pSeeds;
+} // method
+
+#ifdef WITH_PYTHON
+void exportShardedSeeding( libMS::SubmoduleOrganizer& xOrganizer )
+{
+    exportModule<ShardedSeeding>( xOrganizer, "ShardedSeeding" );
+    exportModule<ShardedHarmonization>( xOrganizer, "ShardedHarmonization" );
+} // function
+#endif
@@ -4,6 +4,7 @@
  * @author Markus Schmidt
  */
 #include "ma/module/stripOfConsideration.h"
+#include "util/radixSort.h"
 #include "util/system.h"
 using namespace libMA;
 using namespace libMS;
@@ -16,6 +17,11 @@ std::shared_ptr<SoCPriorityQueue> StripOfConsiderationSeeds::execute(
     if( pSeeds->empty( ) )
         return std::make_shared<SoCPriorityQueue>( pSeeds );
 
+    // reads with huge seed sets (e.g. repetitive long reads) are given up instead of blocking the thread;
+    // an empty SoC queue makes the following modules report the read as unmapped
+    if( !pQuerySeq->spendSeeds( pSeeds->size( ), uiSeedBudget ) )
+        return std::make_shared<SoCPriorityQueue>( std::make_shared<Seeds>( ) );
+
     const nucSeqIndex uiQLen = pQuerySeq->length( );
 
     double fMinLen = std::max( (double)fGiveUp * uiQLen, (double)this->uiCurrHarmScoreMin );
@@ -29,42 +35,46 @@ std::shared_ptr<SoCPriorityQueue> StripOfConsiderationSeeds::execute(
     const nucSeqIndex uiStripSize = this->getStripSize( uiQLen, pGlobalParams->iMatch->get( ),
                                                         pGlobalParams->iExtend->get( ), pGlobalParams->iGap->get( ) );
 
+    // positions to remember the maxima
+    auto pSoCs = std::make_shared<SoCPriorityQueue>( pSeeds );
+    DEBUG( pSoCs->uiQLen = uiQLen; ) // DEBUG
+
+    // the sort and the linesweep work on the compact 32 byte PackedSeeds instead of the Seeds
+    // (so that twice as many seeds fit into a cacheline); Seeds are materialized once a SoC is popped.
+    std::vector<PackedSeed>& rvPacked = pSoCs->vPackedSeeds;
+    pSeeds->pack( rvPacked );
+
     // sort the seeds according to their initial positions
-    std::sort( pSeeds->begin( ), pSeeds->end( ),
-               [ & ]( const Seed& a, const Seed& b ) { return a.uiDelta < b.uiDelta; } // lambda
-    ); // sort function call
+    // (radix sort on a key/index array; avoids moving the seeds around during the sort)
+    radix::sort( rvPacked.begin( ), rvPacked.end( ), []( const PackedSeed& rS ) { return rS.uiDelta; } );
 
 #if DEBUG_LEVEL > 0
     // check order of seeds to make sure optimization is valid
     if( !bRectangular )
     {
         bool bNotSeedRevStrandYet = true;
-        for( size_t uiI = 0; uiI < pSeeds->size( ); uiI++ )
+        for( size_t uiI = 0; uiI < rvPacked.size( ); uiI++ )
         {
-            if( !bNotSeedRevStrandYet && ( *pSeeds )[ uiI ].bOnForwStrand )
+            if( !bNotSeedRevStrandYet && rvPacked[ uiI ].bOnForwStrand )
             {
                 std::cerr << "seeds from forward and reverse strand are intermangled!" << std::endl;
                 assert( false );
             } // if
-            if( bNotSeedRevStrandYet && !( *pSeeds )[ uiI ].bOnForwStrand )
+            if( bNotSeedRevStrandYet && !rvPacked[ uiI ].bOnForwStrand )
                 bNotSeedRevStrandYet = false;
         } // for
     } // if
 #endif
 
-    // positions to remember the maxima
-    auto pSoCs = std::make_shared<SoCPriorityQueue>( pSeeds );
-    DEBUG( pSoCs->uiQLen = uiQLen; ) // DEBUG
-
     // find the SOC maxima
     SoCOrder xCurrScore;
-    std::vector<Seed>::iterator xStripStart = pSeeds->begin( );
-    std::vector<Seed>::iterator xStripEnd = pSeeds->begin( );
+    std::vector<PackedSeed>::iterator xStripStart = rvPacked.begin( );
+    std::vector<PackedSeed>::iterator xStripEnd = rvPacked.begin( );
     size_t uiContigIdStart = pRefSeq->uiSequenceIdForPosition( xStripStart->start_ref( ) );
     size_t uiContigIdEnd = pRefSeq->uiSequenceIdForPosition( xStripEnd->start_ref( ) );
     assert( pRefSeq->isForwPositionInSequenceWithId( uiContigIdStart, xStripStart->start_ref( ) ) );
     assert( pRefSeq->isForwPositionInSequenceWithId( uiContigIdEnd, xStripEnd->start_ref( ) ) );
-    while( xStripEnd != pSeeds->end( ) && xStripStart != pSeeds->end( ) )
+    while( xStripEnd != rvPacked.end( ) && xStripStart != rvPacked.end( ) )
     {
         // xStripStart might have moved forward so adjust uiContigIdStart.
         if( bRectangular || xStripStart->bOnForwStrand )
@@ -78,7 +88,7 @@ std::shared_ptr<SoCPriorityQueue> StripOfConsiderationSeeds::execute(
             uiContigIdStart += ( bRectangular || xStripStart->bOnForwStrand ) ? 1 : -1;
 
         // move xStripEnd forwards while it is closer to xStripStart than uiStripSize
-        while( xStripEnd != pSeeds->end( ) && xStripStart->uiDelta + uiStripSize >= xStripEnd->uiDelta &&
+        while( xStripEnd != rvPacked.end( ) && xStripStart->uiDelta + uiStripSize >= xStripEnd->uiDelta &&
                uiContigIdStart == uiContigIdEnd &&
                ( bRectangular || ( xStripStart->bOnForwStrand == xStripEnd->bOnForwStrand ) ) )
         {
@@ -86,7 +96,7 @@ std::shared_ptr<SoCPriorityQueue> StripOfConsiderationSeeds::execute(
             xCurrScore += *xStripEnd;
             // move the iterator forward
             xStripEnd++;
-            if( xStripEnd != pSeeds->end( ) )
+            if( xStripEnd != rvPacked.end( ) )
             {
                 /* if we have a non rectangular SoC where we just moved xStripEnd from the forward to the reverse strand
                  * then we have to set uiContigIdEnd to the largest contig id.
@@ -131,7 +141,8 @@ std::shared_ptr<SoCPriorityQueue> StripOfConsiderationSeeds::execute(
          * if the SoC quality is lower than fGiveUp * uiQLen we do not consider this SoC at
          */
         if( xCurrScore.uiAccumulativeLength >= fMinLen )
-            pSoCs->push_back_no_overlap( xCurrScore, xStripStart, xStripEnd, (nucSeqIndex)fMinLen );
+            pSoCs->push_back_no_overlap( xCurrScore, xStripStart - rvPacked.begin( ), xStripEnd - rvPacked.begin( ),
+                                         (nucSeqIndex)fMinLen );
         // move xStripStart one to the right (this will cause xStripEnd to be adjusted)
         bool bLastOnForw = xStripStart->bOnForwStrand;
         xCurrScore -= *( xStripStart++ );
@@ -142,7 +153,7 @@ std::shared_ptr<SoCPriorityQueue> StripOfConsiderationSeeds::execute(
          * reverse strand. In this case the uiContigIdStart would have to be counted upwards...
          * We avoid this by forcing uiContigIdStart to be the highest possible number.
          */
-        if( !bRectangular && xStripStart != pSeeds->end( ) && xStripEnd != pSeeds->end( ) &&
+        if( !bRectangular && xStripStart != rvPacked.end( ) && xStripEnd != rvPacked.end( ) &&
             !xStripStart->bOnForwStrand && bLastOnForw )
             uiContigIdStart = pRefSeq->uiNumContigs( ) - 1; // force to last contig so that we can count backwards
     } // while
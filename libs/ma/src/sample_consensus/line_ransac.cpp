@@ -0,0 +1,147 @@
+/**
+ * @file line_ransac.cpp
+ */
+#include "ma/sample_consensus/line_ransac.h"
+
+/// @cond DOXYGEN_SHOW_SYSTEM_INCLUDES
+#include <algorithm>
+#include <cmath>
+#include <limits>
+/// @endcond
+
+using namespace libMA;
+
+float LineRansac::scratchMedian( )
+{
+    if( vScratch.empty( ) )
+        return 0; // Undefined, really.
+    auto itMid = vScratch.begin( ) + vScratch.size( ) / 2;
+    std::nth_element( vScratch.begin( ), itMid, vScratch.end( ) );
+    if( vScratch.size( ) % 2 == 1 )
+        return *itMid;
+    // nth_element leaves the lower half in front of itMid
+    return ( *std::max_element( vScratch.begin( ), itMid ) + *itMid ) / 2;
+} // method
+
+double LineRansac::medianAbsoluteDeviationY( )
+{
+    // Python: np.median(np.abs(y - np.median(y)))
+    vScratch.assign( vY.begin( ), vY.end( ) );
+    const float fMedian = scratchMedian( );
+    for( size_t uiI = 0; uiI < vY.size( ); uiI++ )
+        vScratch[ uiI ] = std::abs( vY[ uiI ] - fMedian );
+    return scratchMedian( );
+} // method
+
+size_t LineRansac::countInliers( float fX1, float fY1, float fX2, float fY2, float fSqrThreshold ) const
+{
+    const float* __restrict pX = vX.data( );
+    const float* __restrict pY = vY.data( );
+    const size_t uiSize = vX.size( );
+    const float fDx = fX2 - fX1;
+    const float fDy = fY2 - fY1;
+    // distance^2 = cross^2 / |P2-P1|^2; the division is moved to the other side of the comparison
+    const float fBound = fSqrThreshold * ( fDx * fDx + fDy * fDy );
+    // branch free so that the loop gets vectorized
+    uint32_t uiRet = 0;
+    for( size_t uiI = 0; uiI < uiSize; uiI++ )
+    {
+        const float fCross = ( pX[ uiI ] - fX2 ) * fDy - ( pY[ uiI ] - fY2 ) * fDx;
+        uiRet += fCross * fCross < fBound ? 1 : 0;
+    } // for
+    return uiRet;
+} // method
+
+std::pair<double, double> LineRansac::fit( double dThreshold, uint64_t uiSeed )
+{
+    const auto xFailed = std::make_pair( std::nan( "" ), std::nan( "" ) );
+    const size_t uiSize = vX.size( );
+    if( uiSize < 2 )
+        return xFailed;
+    uiRngState = uiSeed == 0 ? 1 : uiSeed;
+    const float fSqrThreshold = (float)( dThreshold * dThreshold );
+    const double dDegPerRad = 180 / std::acos( -1 );
+
+    bool bFoundModel = false;
+    size_t uiBestInliers = 0, uiBest1 = 0, uiBest2 = 0;
+    double dK = 1.0;
+    unsigned int uiIterations = 0;
+    // samples with a bad angle do not count as iterations; make sure we terminate anyways
+    size_t uiDrawsLeft = 100 * ( (size_t)uiMaxIterations + 1 );
+    while( uiIterations < dK && uiDrawsLeft-- > 0 )
+    {
+        // two distinct random points
+        const size_t uiI1 = randomIndex( uiSize );
+        size_t uiI2 = randomIndex( uiSize - 1 );
+        if( uiI2 >= uiI1 )
+            uiI2++;
+
+        // angle acceptable?
+        float fHorizontalDist = vX[ uiI1 ] - vX[ uiI2 ];
+        float fVerticalDist = vY[ uiI1 ] - vY[ uiI2 ];
+        if( fHorizontalDist <= 0 && fVerticalDist <= 0 )
+        {
+            fHorizontalDist *= -1;
+            fVerticalDist *= -1;
+        } // if
+        if( fHorizontalDist <= 0 || fVerticalDist <= 0 )
+            continue;
+        const double dAngle = std::atan( fVerticalDist / fHorizontalDist ) * dDegPerRad;
+        if( dAngle < 20 || dAngle > 70 )
+            continue;
+
+        const size_t uiInliers = countInliers( vX[ uiI1 ], vY[ uiI1 ], vX[ uiI2 ], vY[ uiI2 ], fSqrThreshold );
+        if( !bFoundModel || uiInliers > uiBestInliers )
+        {
+            bFoundModel = true;
+            uiBestInliers = uiInliers;
+            uiBest1 = uiI1;
+            uiBest2 = uiI2;
+
+            // Compute the k parameter (k=log(z)/log(1-w^n))
+            const double dW = (double)uiInliers / (double)uiSize;
+            double dPNoOutliers = 1 - dW * dW;
+            dPNoOutliers = std::max( std::numeric_limits<double>::epsilon( ), dPNoOutliers );
+            dPNoOutliers = std::min( 1 - std::numeric_limits<double>::epsilon( ), dPNoOutliers );
+            dK = std::log( 1 - dProbability ) / std::log( dPNoOutliers );
+        } // if
+
+        if( ++uiIterations > uiMaxIterations )
+            break;
+    } // while
+
+    if( !bFoundModel || uiBestInliers == 0 )
+        return xFailed;
+
+    // linear regression on the inliers of the best model (in double precision)
+    const float fX1 = vX[ uiBest1 ], fY1 = vY[ uiBest1 ];
+    const float fX2 = vX[ uiBest2 ], fY2 = vY[ uiBest2 ];
+    const float fDx = fX2 - fX1;
+    const float fDy = fY2 - fY1;
+    const float fBound = fSqrThreshold * ( fDx * fDx + fDy * fDy );
+    auto fIsInlier = [ & ]( size_t uiI ) {
+        const float fCross = ( vX[ uiI ] - fX2 ) * fDy - ( vY[ uiI ] - fY2 ) * fDx;
+        return fCross * fCross < fBound;
+    }; // lambda
+    double dSumX = 0, dSumY = 0;
+    for( size_t uiI = 0; uiI < uiSize; uiI++ )
+        if( fIsInlier( uiI ) )
+        {
+            dSumX += vX[ uiI ];
+            dSumY += vY[ uiI ];
+        } // if
+    const double dMeanX = dSumX / uiBestInliers;
+    const double dMeanY = dSumY / uiBestInliers;
+    double dSxx = 0, dSxy = 0;
+    for( size_t uiI = 0; uiI < uiSize; uiI++ )
+        if( fIsInlier( uiI ) )
+        {
+            dSxx += ( vX[ uiI ] - dMeanX ) * ( vX[ uiI ] - dMeanX );
+            dSxy += ( vX[ uiI ] - dMeanX ) * ( vY[ uiI ] - dMeanY );
+        } // if
+    const double dSlope = dSxy / dSxx;
+    // intercept in the coordinates relative to the origin, then move it back
+    const double dIntercept = dMeanY - dSlope * dMeanX + dOriginY - dSlope * dOriginX;
+
+    return std::make_pair( std::atan( dSlope ), -dIntercept / dSlope );
+} // method
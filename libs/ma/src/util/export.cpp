@@ -9,6 +9,7 @@
 #include "ms/module/splitter.h"
 #include "ms/util/export.h"
 #include "ms/util/parameter.h"
+#include "util/indexMemory.h"
 
 using namespace libMA;
 using namespace libMS;
@@ -19,7 +20,7 @@ using namespace libMS;
 void exportExecutionContext( libMS::SubmoduleOrganizer& xOrganizer )
 {
     py::class_<GenomeManager>( xOrganizer.util( ), "GenomeManager" ) //
-        .def( "load_genome", &GenomeManager::loadGenome );
+        .def( "load_genome", &GenomeManager::loadGenome, py::arg( "json_file" ), py::arg( "mapped" ) = false );
     py::class_<ReadsManager>( xOrganizer.util( ), "ReadsManager" ) //
         .def_readwrite( "primary_queries", &ReadsManager::vsPrimaryQueryFullFileName ) //
         .def_readwrite( "mate_queries", &ReadsManager::vsMateQueryFullFileName );
@@ -33,6 +34,15 @@ void exportExecutionContext( libMS::SubmoduleOrganizer& xOrganizer )
         .def_readwrite( "genome_manager", &ExecutionContext::xGenomeManager ) //
         .def_readwrite( "reads_manager", &ExecutionContext::xReadsManager ) //
         .def_readwrite( "output_manager", &ExecutionContext::xOutputManager );
+
+    // placement of the index arrays; applies to all indices that are loaded or created afterwards
+    xOrganizer.util( ).def(
+        "set_index_memory_policy",
+        []( bool bHugePages, bool bInterleave ) {
+            IndexMemory::bHugePages = bHugePages;
+            IndexMemory::bInterleave = bInterleave;
+        },
+        py::arg( "huge_pages" ), py::arg( "interleave" ) );
 } // function
 
 PYBIND11_MODULE( libMA, libMaModule )
@@ -54,6 +64,7 @@ PYBIND11_MODULE( libMA, libMaModule )
     exportFileWriter( xOrganizer );
     exportMappingQuality( xOrganizer );
     exportPairedReads( xOrganizer );
+    exportMateRescue( xOrganizer );
     exportSplitter( xOrganizer );
     exportSmallInversions( xOrganizer );
     exportSoC( xOrganizer );
@@ -64,34 +75,33 @@ PYBIND11_MODULE( libMA, libMaModule )
     exportSamFileReader( xOrganizer );
     exportCompareAlignments( xOrganizer );
     exportMinimizerSeeding( xOrganizer );
+    exportShardedFMIndex( xOrganizer );
+    exportShardedSeeding( xOrganizer );
+    exportAlignmentCache( xOrganizer );
 } // function
 
 #endif
 
 
-std::vector<std::shared_ptr<BasePledge>> libMA::setUpCompGraph( const ParameterSetManager& rParameters,
-                                                                std::shared_ptr<Pledge<Pack>>
-                                                                    pPack,
-                                                                std::shared_ptr<Pledge<FMIndex>>
-                                                                    pFMDIndex,
-                                                                std::shared_ptr<Pledge<FileStreamQueue, false>>
-                                                                    pQueue,
-                                                                std::shared_ptr<TP_WRITER>
-                                                                    pWriter,
-                                                                unsigned int uiThreads )
+/**
+ * @brief sets up the reader and writer of the single-end graph around fAlign
+ * @details
+ * fAlign( pQuery, fCont ) creates the "query -> alignments" sub-chain of a thread and calls fCont with the pledge of
+ * the alignments.
+ * (fAlign and fCont are generic lambdas since the pledge types depend on the index and the alignment cache setting)
+ */
+template <typename TP_ALIGN>
+static std::vector<std::shared_ptr<BasePledge>>
+setUpCompGraphAround( const ParameterSetManager& rParameters, std::shared_ptr<Pledge<Pack>> pPack,
+                      std::shared_ptr<Pledge<FileStreamQueue, false>> pQueue, std::shared_ptr<TP_WRITER> pWriter,
+                      unsigned int uiThreads, TP_ALIGN fAlign )
 {
     // set up the modules
     auto pFileStreamPicker = std::make_shared<QueuePicker<FileStream>>( rParameters );
     auto pLock = std::make_shared<Lock<FileStream>>( rParameters );
     auto pFileReader = std::make_shared<FileReader>( rParameters );
     auto pFileStreamPlacer = std::make_shared<QueuePlacer<NucSeq, FileStream>>( rParameters );
-    auto pSeeding = std::make_shared<BinarySeeding>( rParameters );
-    auto pSOC = std::make_shared<StripOfConsideration>( rParameters );
-    auto pHarmonization = std::make_shared<Harmonization>( rParameters );
-    auto pDP = std::make_shared<NeedlemanWunsch>( rParameters );
-    auto pMappingQual = std::make_shared<MappingQuality>( rParameters );
     auto pSmallInversions = std::make_shared<SmallInversions>( rParameters );
-    auto pCast = std::make_shared<Cast<SuffixArrayInterface, FMIndex>>( rParameters );
     auto pProgressPrinter = std::make_shared<ProgressPrinter<FileStreamQueue>>( rParameters );
 
     // create the graph
@@ -101,43 +111,44 @@ std::vector<std::shared_ptr<BasePledge>> libMA::setUpCompGraph( const ParameterS
         auto pLockedFile = promiseMe( pLock, pPickedFile );
         auto pQuery_ = promiseMe( pFileReader, pLockedFile );
         auto pQuery = promiseMe( pFileStreamPlacer, pQuery_, pLockedFile, pQueue );
-        auto pSeeds = promiseMe( pSeeding, promiseMe( pCast, pFMDIndex ), pQuery );
-        auto pSOCs = promiseMe( pSOC, pSeeds, pQuery, pPack, pFMDIndex );
-        auto pHarmonized = promiseMe( pHarmonization, pSOCs, pQuery, pFMDIndex );
-        auto pAlignments = promiseMe( pDP, pHarmonized, pQuery, pPack );
-        auto pAlignmentsWQuality = promiseMe( pMappingQual, pQuery, pAlignments );
-        if( rParameters.getSelected( )->xSearchInversions->get( ) )
-        {
-            auto pAlignmentsWInv = promiseMe( pSmallInversions, pAlignmentsWQuality, pQuery, pPack );
-            auto pEmptyContainer = promiseMe( pWriter, pQuery, pAlignmentsWInv, pPack );
-            auto pEmptyContainer_ = promiseMe( pProgressPrinter, pEmptyContainer, pQueue );
-            auto pUnlockResult =
-                promiseMe( std::make_shared<UnLock<libMS::Container>>( rParameters, pQuery ), pEmptyContainer_ );
-            aRet.push_back( pUnlockResult );
-        } // if
-        else
-        {
-            auto pEmptyContainer = promiseMe( pWriter, pQuery, pAlignmentsWQuality, pPack );
-            auto pEmptyContainer_ = promiseMe( pProgressPrinter, pEmptyContainer, pQueue );
-            auto pUnlockResult =
-                promiseMe( std::make_shared<UnLock<libMS::Container>>( rParameters, pLockedFile ), pEmptyContainer_ );
-            aRet.push_back( pUnlockResult );
-        } // else
+        // writes the alignments
+        auto fWrite = [ & ]( auto pAlignmentsWQuality ) {
+            if( rParameters.getSelected( )->xSearchInversions->get( ) )
+            {
+                auto pAlignmentsWInv = promiseMe( pSmallInversions, pAlignmentsWQuality, pQuery, pPack );
+                auto pEmptyContainer = promiseMe( pWriter, pQuery, pAlignmentsWInv, pPack );
+                auto pEmptyContainer_ = promiseMe( pProgressPrinter, pEmptyContainer, pQueue );
+                auto pUnlockResult = promiseMe( std::make_shared<UnLock<libMS::Container>>( rParameters, pLockedFile ),
+                                                pEmptyContainer_ );
+                aRet.push_back( pUnlockResult );
+            } // if
+            else
+            {
+                auto pEmptyContainer = promiseMe( pWriter, pQuery, pAlignmentsWQuality, pPack );
+                auto pEmptyContainer_ = promiseMe( pProgressPrinter, pEmptyContainer, pQueue );
+                auto pUnlockResult = promiseMe( std::make_shared<UnLock<libMS::Container>>( rParameters, pLockedFile ),
+                                                pEmptyContainer_ );
+                aRet.push_back( pUnlockResult );
+            } // else
+        }; // lambda
+        fAlign( pQuery, fWrite );
     } ); // parallelGraph
     return aRet;
 } // function
 
-std::vector<std::shared_ptr<BasePledge>>
-libMA::setUpCompGraphPaired( const ParameterSetManager& rParameters,
-                             std::shared_ptr<Pledge<Pack>>
-                                 pPack,
-                             std::shared_ptr<Pledge<FMIndex>>
-                                 pFMDIndex,
-                             std::shared_ptr<Pledge<PairedFileStreamQueue, false>>
-                                 pQueue,
-                             std::shared_ptr<TP_PAIRED_WRITER>
-                                 pWriter,
-                             unsigned int uiThreads )
+/**
+ * @brief sets up the reader, the pairing and the writer of the paired graph around fAlign and fRescue
+ * @details
+ * fAlign( pQuery, fCont ) is the one of setUpCompGraphAround; it aligns the first mate and, without mate rescue, the
+ * second one.
+ * fRescue( pQueryB, pAlignmentsA, fCont ) aligns the second mate using the alignments of the first one.
+ */
+template <typename TP_ALIGN, typename TP_RESCUE>
+static std::vector<std::shared_ptr<BasePledge>>
+setUpCompGraphPairedAround( const ParameterSetManager& rParameters, std::shared_ptr<Pledge<Pack>> pPack,
+                            std::shared_ptr<Pledge<PairedFileStreamQueue, false>> pQueue,
+                            std::shared_ptr<TP_PAIRED_WRITER> pWriter, unsigned int uiThreads, TP_ALIGN fAlign,
+                            TP_RESCUE fRescue )
 {
     // set up the modules
     auto pFileStreamPicker = std::make_shared<QueuePicker<PairedFileStream>>( rParameters );
@@ -146,14 +157,8 @@ libMA::setUpCompGraphPaired( const ParameterSetManager& rParameters,
     auto pFileStreamPlacer = std::make_shared<QueuePlacer<PairedReadsContainer, PairedFileStream>>( rParameters );
     auto pGetFirst = std::make_shared<TupleGet<PairedReadsContainer, 0>>( rParameters );
     auto pGetSecond = std::make_shared<TupleGet<PairedReadsContainer, 1>>( rParameters );
-    auto pSeeding = std::make_shared<BinarySeeding>( rParameters );
-    auto pSOC = std::make_shared<StripOfConsideration>( rParameters );
-    auto pHarmonization = std::make_shared<Harmonization>( rParameters );
-    auto pDP = std::make_shared<NeedlemanWunsch>( rParameters );
-    auto pMappingQual = std::make_shared<MappingQuality>( rParameters );
     auto pSmallInversions = std::make_shared<SmallInversions>( rParameters );
     auto pPairedReads = std::make_shared<PairedReads>( rParameters );
-    auto pCast = std::make_shared<Cast<SuffixArrayInterface, FMIndex>>( rParameters );
     auto pProgressPrinter = std::make_shared<ProgressPrinter<PairedFileStreamQueue>>( rParameters );
 
     // create the graph
@@ -165,38 +170,172 @@ libMA::setUpCompGraphPaired( const ParameterSetManager& rParameters,
         auto pQueryTuple = promiseMe( pFileStreamPlacer, pQueryTuple_, pLockedFile, pQueue );
         auto pQueryA = promiseMe( pGetFirst, pQueryTuple );
         auto pQueryB = promiseMe( pGetSecond, pQueryTuple );
-        auto pSeedsA = promiseMe( pSeeding, promiseMe( pCast, pFMDIndex ), pQueryA );
-        auto pSeedsB = promiseMe( pSeeding, promiseMe( pCast, pFMDIndex ), pQueryB );
-        auto pSOCsA = promiseMe( pSOC, pSeedsA, pQueryA, pPack, pFMDIndex );
-        auto pSOCsB = promiseMe( pSOC, pSeedsB, pQueryB, pPack, pFMDIndex );
-        auto pHarmonizedA = promiseMe( pHarmonization, pSOCsA, pQueryA, pFMDIndex );
-        auto pHarmonizedB = promiseMe( pHarmonization, pSOCsB, pQueryB, pFMDIndex );
-        auto pAlignmentsA = promiseMe( pDP, pHarmonizedA, pQueryA, pPack );
-        auto pAlignmentsB = promiseMe( pDP, pHarmonizedB, pQueryB, pPack );
-        auto pAlignmentsWQualityA = promiseMe( pMappingQual, pQueryA, pAlignmentsA );
-        auto pAlignmentsWQualityB = promiseMe( pMappingQual, pQueryB, pAlignmentsB );
-        if( rParameters.getSelected( )->xSearchInversions->get( ) )
+        // aligns the second mate, pairs the alignments of both mates and writes them
+        auto fMateBAndWrite = [ & ]( auto pAlignmentsWQualityA ) {
+            // pairs the alignments of both mates and writes them
+            auto fPairAndWrite = [ & ]( auto pAlignmentsWQualityB ) {
+                if( rParameters.getSelected( )->xSearchInversions->get( ) )
+                {
+                    auto pAlignmentsWInvA = promiseMe( pSmallInversions, pAlignmentsWQualityA, pQueryA, pPack );
+                    auto pAlignmentsWInvB = promiseMe( pSmallInversions, pAlignmentsWQualityB, pQueryB, pPack );
+                    auto pAlignmentsWQuality =
+                        promiseMe( pPairedReads, pQueryA, pQueryB, pAlignmentsWInvA, pAlignmentsWInvB, pPack );
+                    auto pEmptyContainer = promiseMe( pWriter, pQueryA, pQueryB, pAlignmentsWQuality, pPack );
+                    auto pEmptyContainer_ = promiseMe( pProgressPrinter, pEmptyContainer, pQueue );
+                    auto pUnlockResult = promiseMe(
+                        std::make_shared<UnLock<libMS::Container>>( rParameters, pLockedFile ), pEmptyContainer_ );
+                    aRet.push_back( pUnlockResult );
+                } // if
+                else
+                {
+                    auto pAlignmentsWQuality =
+                        promiseMe( pPairedReads, pQueryA, pQueryB, pAlignmentsWQualityA, pAlignmentsWQualityB, pPack );
+                    auto pEmptyContainer = promiseMe( pWriter, pQueryA, pQueryB, pAlignmentsWQuality, pPack );
+                    auto pEmptyContainer_ = promiseMe( pProgressPrinter, pEmptyContainer, pQueue );
+                    auto pUnlockResult = promiseMe(
+                        std::make_shared<UnLock<libMS::Container>>( rParameters, pLockedFile ), pEmptyContainer_ );
+                    aRet.push_back( pUnlockResult );
+                } // else
+            }; // lambda
+            if( rParameters.getSelected( )->xMateRescue->get( ) )
+                // align the second mate within a window around the first one (seeds the whole genome on failure)
+                fRescue( pQueryB, pAlignmentsWQualityA, fPairAndWrite );
+            else
+                fAlign( pQueryB, fPairAndWrite );
+        }; // lambda
+        fAlign( pQueryA, fMateBAndWrite );
+    } ); // parallelGraph
+    return aRet;
+} // function
+
+/**
+ * @brief the "query -> alignments" sub-chain for an FMD-index
+ * @details
+ * Uses one alignment cache for all threads (and both mates), if the cache is enabled.
+ */
+static auto alignOnFMDIndex( const ParameterSetManager& rParameters, std::shared_ptr<Pledge<Pack>> pPack,
+                             std::shared_ptr<Pledge<FMIndex>> pFMDIndex )
+{
+    auto pSeeding = std::make_shared<BinarySeeding>( rParameters );
+    auto pSOC = std::make_shared<StripOfConsideration>( rParameters );
+    auto pHarmonization = std::make_shared<Harmonization>( rParameters );
+    auto pDP = std::make_shared<NeedlemanWunsch>( rParameters );
+    auto pMappingQual = std::make_shared<MappingQuality>( rParameters );
+    auto pCast = std::make_shared<Cast<SuffixArrayInterface, FMIndex>>( rParameters );
+    auto pCachedAlignment = rParameters.pGeneralParameterSet->piAlignmentCacheSize->get( ) > 0
+                                ? std::make_shared<CachedAlignment>( rParameters )
+                                : nullptr;
+    return [ = ]( auto pQuery, auto fCont ) {
+        if( pCachedAlignment != nullptr )
+            fCont( promiseMe( pCachedAlignment, pFMDIndex, pQuery, pPack ) );
+        else
         {
-            auto pAlignmentsWInvA = promiseMe( pSmallInversions, pAlignmentsWQualityA, pQueryA, pPack );
-            auto pAlignmentsWInvB = promiseMe( pSmallInversions, pAlignmentsWQualityB, pQueryB, pPack );
-            auto pAlignmentsWQuality =
-                promiseMe( pPairedReads, pQueryA, pQueryB, pAlignmentsWInvA, pAlignmentsWInvB, pPack );
-            auto pEmptyContainer = promiseMe( pWriter, pQueryA, pQueryB, pAlignmentsWQuality, pPack );
-            auto pEmptyContainer_ = promiseMe( pProgressPrinter, pEmptyContainer, pQueue );
-            auto pUnlockResult =
-                promiseMe( std::make_shared<UnLock<libMS::Container>>( rParameters, pLockedFile ), pEmptyContainer_ );
-            aRet.push_back( pUnlockResult );
-        } // if
+            auto pSeeds = promiseMe( pSeeding, promiseMe( pCast, pFMDIndex ), pQuery );
+            auto pSOCs = promiseMe( pSOC, pSeeds, pQuery, pPack, pFMDIndex );
+            auto pHarmonized = promiseMe( pHarmonization, pSOCs, pQuery, pFMDIndex );
+            auto pAlignments = promiseMe( pDP, pHarmonized, pQuery, pPack );
+            fCont( promiseMe( pMappingQual, pQuery, pAlignments ) );
+        } // else
+    }; // lambda
+} // function
+
+/**
+ * @brief the "query -> alignments" sub-chain for a ShardedFMIndex
+ * @details
+ * Seeds on all shards (see ShardedSeeding) instead of a single FMD-index.
+ */
+static auto alignOnShardedFMDIndex( const ParameterSetManager& rParameters, std::shared_ptr<Pledge<Pack>> pPack,
+                                    std::shared_ptr<Pledge<ShardedFMIndex>> pShardedFMDIndex )
+{
+    auto pSeeding = std::make_shared<ShardedSeeding>( rParameters );
+    auto pSOC = std::make_shared<StripOfConsiderationSeeds>( rParameters );
+    auto pHarmonization = std::make_shared<ShardedHarmonization>( rParameters );
+    auto pDP = std::make_shared<NeedlemanWunsch>( rParameters );
+    auto pMappingQual = std::make_shared<MappingQuality>( rParameters );
+    auto pCachedAlignment = rParameters.pGeneralParameterSet->piAlignmentCacheSize->get( ) > 0
+                                ? std::make_shared<CachedShardedAlignment>( rParameters )
+                                : nullptr;
+    return [ = ]( auto pQuery, auto fCont ) {
+        if( pCachedAlignment != nullptr )
+            fCont( promiseMe( pCachedAlignment, pShardedFMDIndex, pQuery, pPack ) );
         else
         {
-            auto pAlignmentsWQuality =
-                promiseMe( pPairedReads, pQueryA, pQueryB, pAlignmentsWQualityA, pAlignmentsWQualityB, pPack );
-            auto pEmptyContainer = promiseMe( pWriter, pQueryA, pQueryB, pAlignmentsWQuality, pPack );
-            auto pEmptyContainer_ = promiseMe( pProgressPrinter, pEmptyContainer, pQueue );
-            auto pUnlockResult =
-                promiseMe( std::make_shared<UnLock<libMS::Container>>( rParameters, pLockedFile ), pEmptyContainer_ );
-            aRet.push_back( pUnlockResult );
+            auto pSeeds = promiseMe( pSeeding, pShardedFMDIndex, pQuery, pPack );
+            auto pSOCs = promiseMe( pSOC, pSeeds, pQuery, pPack );
+            auto pHarmonized = promiseMe( pHarmonization, pSOCs, pQuery, pShardedFMDIndex );
+            auto pAlignments = promiseMe( pDP, pHarmonized, pQuery, pPack );
+            fCont( promiseMe( pMappingQual, pQuery, pAlignments ) );
         } // else
-    } ); // parallelGraph
-    return aRet;
+    }; // lambda
+} // function
+
+std::vector<std::shared_ptr<BasePledge>> libMA::setUpCompGraph( const ParameterSetManager& rParameters,
+                                                                std::shared_ptr<Pledge<Pack>>
+                                                                    pPack,
+                                                                std::shared_ptr<Pledge<FMIndex>>
+                                                                    pFMDIndex,
+                                                                std::shared_ptr<Pledge<FileStreamQueue, false>>
+                                                                    pQueue,
+                                                                std::shared_ptr<TP_WRITER>
+                                                                    pWriter,
+                                                                unsigned int uiThreads )
+{
+    return setUpCompGraphAround( rParameters, pPack, pQueue, pWriter, uiThreads,
+                                 alignOnFMDIndex( rParameters, pPack, pFMDIndex ) );
+} // function
+
+std::vector<std::shared_ptr<BasePledge>>
+libMA::setUpCompGraphSharded( const ParameterSetManager& rParameters,
+                              std::shared_ptr<Pledge<Pack>>
+                                  pPack,
+                              std::shared_ptr<Pledge<ShardedFMIndex>>
+                                  pShardedFMDIndex,
+                              std::shared_ptr<Pledge<FileStreamQueue, false>>
+                                  pQueue,
+                              std::shared_ptr<TP_WRITER>
+                                  pWriter,
+                              unsigned int uiThreads )
+{
+    return setUpCompGraphAround( rParameters, pPack, pQueue, pWriter, uiThreads,
+                                 alignOnShardedFMDIndex( rParameters, pPack, pShardedFMDIndex ) );
+} // function
+
+std::vector<std::shared_ptr<BasePledge>>
+libMA::setUpCompGraphPaired( const ParameterSetManager& rParameters,
+                             std::shared_ptr<Pledge<Pack>>
+                                 pPack,
+                             std::shared_ptr<Pledge<FMIndex>>
+                                 pFMDIndex,
+                             std::shared_ptr<Pledge<PairedFileStreamQueue, false>>
+                                 pQueue,
+                             std::shared_ptr<TP_PAIRED_WRITER>
+                                 pWriter,
+                             unsigned int uiThreads )
+{
+    auto pMateRescue = std::make_shared<MateRescue>( rParameters );
+    return setUpCompGraphPairedAround(
+        rParameters, pPack, pQueue, pWriter, uiThreads, alignOnFMDIndex( rParameters, pPack, pFMDIndex ),
+        [ = ]( auto pQueryB, auto pAlignmentsA, auto fCont ) {
+            fCont( promiseMe( pMateRescue, pQueryB, pAlignmentsA, pFMDIndex, pPack ) );
+        } );
+} // function
+
+std::vector<std::shared_ptr<BasePledge>>
+libMA::setUpCompGraphPairedSharded( const ParameterSetManager& rParameters,
+                                    std::shared_ptr<Pledge<Pack>>
+                                        pPack,
+                                    std::shared_ptr<Pledge<ShardedFMIndex>>
+                                        pShardedFMDIndex,
+                                    std::shared_ptr<Pledge<PairedFileStreamQueue, false>>
+                                        pQueue,
+                                    std::shared_ptr<TP_PAIRED_WRITER>
+                                        pWriter,
+                                    unsigned int uiThreads )
+{
+    auto pMateRescue = std::make_shared<ShardedMateRescue>( rParameters );
+    return setUpCompGraphPairedAround(
+        rParameters, pPack, pQueue, pWriter, uiThreads, alignOnShardedFMDIndex( rParameters, pPack, pShardedFMDIndex ),
+        [ = ]( auto pQueryB, auto pAlignmentsA, auto fCont ) {
+            fCont( promiseMe( pMateRescue, pQueryB, pAlignmentsA, pShardedFMDIndex, pPack ) );
+        } );
 } // function
@@ -0,0 +1,20 @@
+/**
+ * @file socThreadPool.cpp
+ */
+#include "ma/util/socThreadPool.h"
+/// @cond DOXYGEN_SHOW_SYSTEM_INCLUDES
+#include <atomic>
+/// @endcond
+
+using namespace libMA;
+
+ThreadPool& libMA::socThreadPool( size_t uiNumThreads )
+{
+    static const size_t uiPoolSize = uiNumThreads;
+    static ThreadPool xPool( uiPoolSize );
+    static std::atomic<bool> bWarned( false );
+    if( uiNumThreads != uiPoolSize && !bWarned.exchange( true ) )
+        std::cerr << "[socThreadPool] WARNING: the pool was created with " << uiPoolSize
+                  << " threads; the requested size of " << uiNumThreads << " threads is ignored." << std::endl;
+    return xPool;
+} // function
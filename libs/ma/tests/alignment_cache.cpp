@@ -0,0 +1,171 @@
+#define EXIT_SUCCESS 0
+#define EXIT_FAILURE 1
+
+#include "ma/module/fileWriter.h"
+#include "ma/util/export.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+using namespace libMA;
+using namespace libMS;
+
+/*
+ * Checks the alignment cache ("Alignment Cache Size"):
+ * - the aligner graph writes the same SAM output with and without the cache
+ * - reads with identical sequences are aligned once and get their own names
+ * - the cache evicts the least recently used sequences once it is full
+ * - duplicates of reads that exceed their work budget are reported as over budget as well (ZB tag)
+ */
+
+std::shared_ptr<NucSeq> randomNucSeq( size_t uiLen )
+{
+    auto pRet = std::make_shared<NucSeq>( );
+    pRet->vReserveMemory( uiLen );
+    for( size_t i = 0; i < uiLen; i++ )
+        pRet->push_back( ( uint8_t )( std::rand( ) % 4 ) );
+    return pRet;
+} // function
+
+/// @brief collects the output of a FileWriter
+class StringOutStream : public OutStream
+{
+  public:
+    std::string sContent;
+
+    StringOutStream& operator<<( const std::string& s )
+    {
+        sContent += s;
+        return *this;
+    } // function
+}; // class
+
+std::string align( const std::string& rsFasta, std::shared_ptr<Pack> pPack, std::shared_ptr<FMIndex> pFMIndex,
+                   uint64_t uiCacheSize, uint64_t uiDPCellBudget = 0 )
+{
+    ParameterSetManager xParameters;
+    xParameters.getSelected( )->xDPCellBudgetPerRead->set( uiDPCellBudget );
+    xParameters.pGeneralParameterSet->pbRestoreReadOrder->set( true );
+    xParameters.pGeneralParameterSet->piAlignmentCacheSize->set( uiCacheSize );
+    auto pOut = std::make_shared<StringOutStream>( );
+    auto pWriter = std::make_shared<FileWriter>( xParameters, pOut, pPack );
+
+    auto pInitVec = std::make_shared<ContainerVector<std::shared_ptr<FileStream>>>( );
+    pInitVec->push_back( std::make_shared<StringStream>( rsFasta ) );
+    auto pQueuePledge = std::make_shared<Pledge<FileStreamQueue>>( );
+    pQueuePledge->set( std::make_shared<FileStreamQueue>( pInitVec ) );
+    auto pPackPledge = std::make_shared<Pledge<Pack>>( );
+    pPackPledge->set( pPack );
+    auto pFMIndexPledge = std::make_shared<Pledge<FMIndex>>( );
+    pFMIndexPledge->set( pFMIndex );
+    BasePledge::simultaneousGet( setUpCompGraph( xParameters, pPackPledge, pFMIndexPledge, pQueuePledge, pWriter, 4 ) );
+    return pOut->sContent;
+} // function
+
+int main( void )
+{
+    std::srand( 42 );
+    auto pPack = std::make_shared<Pack>( );
+    pPack->vAppendSequence( "chr1", "chr1-desc", *randomNucSeq( 100000 ) );
+    auto pFMIndex = std::make_shared<FMIndex>( pPack );
+
+    // amplicon like reads: few distinct sequences (with some mutations) that occur many times each
+    const size_t uiNumDistinct = 20;
+    const size_t uiNumReads = 400;
+    std::vector<std::shared_ptr<NucSeq>> vDistinct;
+    for( size_t uiI = 0; uiI < uiNumDistinct; uiI++ )
+    {
+        nucSeqIndex uiLen = 150 + std::rand( ) % 150;
+        nucSeqIndex uiFrom = std::rand( ) % ( pPack->uiUnpackedSizeForwardStrand - uiLen );
+        auto pRead = pPack->vExtract( uiFrom, uiFrom + uiLen );
+        for( size_t uiJ = 0; uiJ < 5; uiJ++ )
+            pRead->pxSequenceRef[ std::rand( ) % uiLen ] = ( uint8_t )( std::rand( ) % 4 );
+        vDistinct.push_back( pRead );
+    } // for
+    std::string sFasta;
+    for( size_t uiI = 0; uiI < uiNumReads; uiI++ )
+        sFasta += ">read" + std::to_string( uiI ) + "\n" + vDistinct[ std::rand( ) % uiNumDistinct ]->toString( ) +
+                  "\n";
+
+    // same output with and without cache
+    std::string sUncached = align( sFasta, pPack, pFMIndex, 0 );
+    std::string sCached = align( sFasta, pPack, pFMIndex, 1000 );
+    if( sUncached != sCached )
+    {
+        std::cerr << "the alignment cache changes the output" << std::endl;
+        return EXIT_FAILURE;
+    } // if
+    if( sCached.find( "read" + std::to_string( uiNumReads - 1 ) + "\t" ) == std::string::npos )
+    {
+        std::cerr << "the last read was not written" << std::endl;
+        return EXIT_FAILURE;
+    } // if
+
+    // over budget reads: some reads exceed the budget, others do not
+    {
+        ParameterSetManager xParameters;
+        std::vector<uint64_t> vCells;
+        for( auto pRead : vDistinct )
+        {
+            auto pCopy = std::make_shared<NucSeq>( *pRead );
+            CachedAlignment( xParameters ).execute( pFMIndex, pCopy, pPack );
+            vCells.push_back( pCopy->uiDPCells );
+        } // for
+        std::sort( vCells.begin( ), vCells.end( ) );
+        const uint64_t uiBudget = vCells[ uiNumDistinct / 2 ];
+
+        std::string sUncachedBudget = align( sFasta, pPack, pFMIndex, 0, uiBudget );
+        std::string sCachedBudget = align( sFasta, pPack, pFMIndex, 1000, uiBudget );
+        if( sUncachedBudget.find( "\tZB:Z:budget" ) == std::string::npos )
+        {
+            std::cerr << "no read exceeds the budget of " << uiBudget << " DP cells" << std::endl;
+            return EXIT_FAILURE;
+        } // if
+        if( sUncachedBudget != sCachedBudget )
+        {
+            std::cerr << "the alignment cache changes the output of over budget reads" << std::endl;
+            return EXIT_FAILURE;
+        } // if
+    } // scope
+
+    // hits and eviction
+    {
+        ParameterSetManager xParameters;
+        // two reads per shard
+        xParameters.pGeneralParameterSet->piAlignmentCacheSize->set( 128 );
+        CachedAlignment xCached( xParameters );
+        for( size_t uiI = 0; uiI < uiNumReads; uiI++ )
+        {
+            auto pQuery = std::make_shared<NucSeq>( vDistinct[ uiI % 2 ]->toString( ) );
+            pQuery->sName = "read" + std::to_string( uiI );
+            auto pAlignments = xCached.execute( pFMIndex, pQuery, pPack );
+            for( auto& pAlignment : *pAlignments )
+                if( pAlignment->xStats.sName != pQuery->sName )
+                {
+                    std::cerr << "cached alignment has the name " << pAlignment->xStats.sName << " instead of "
+                              << pQuery->sName << std::endl;
+                    return EXIT_FAILURE;
+                } // if
+        } // for
+        if( xCached.xCache.uiMisses != 2 || xCached.xCache.uiHits != uiNumReads - 2 || xCached.xCache.size( ) != 2 )
+        {
+            std::cerr << "unexpected cache statistics: " << xCached.xCache.uiHits << " hits, "
+                      << xCached.xCache.uiMisses << " misses, " << xCached.xCache.size( ) << " entries" << std::endl;
+            return EXIT_FAILURE;
+        } // if
+
+        // fill the cache with random sequences, so that both entries are evicted
+        for( size_t uiI = 0; uiI < 5000; uiI++ )
+            xCached.xCache.put( *randomNucSeq( 100 ), {} );
+        const size_t uiMissesBefore = xCached.xCache.uiMisses;
+        AlignmentCache::Alignments vOut;
+        if( xCached.xCache.get( *vDistinct[ 0 ], vOut ) || xCached.xCache.get( *vDistinct[ 1 ], vOut ) ||
+            xCached.xCache.uiMisses != uiMissesBefore + 2 || xCached.xCache.size( ) > 128 )
+        {
+            std::cerr << "the cache did not evict the least recently used sequences" << std::endl;
+            return EXIT_FAILURE;
+        } // if
+    } // scope
+
+    return EXIT_SUCCESS;
+} /// main function
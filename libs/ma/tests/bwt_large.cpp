@@ -0,0 +1,76 @@
+#define EXIT_SUCCESS 0
+#define EXIT_FAILURE 1
+
+#include "ma/container/fMIndex.h"
+#include "util/system.h"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+using namespace libMA;
+
+/*
+ * Checks that bwtLarge delivers the same BWT if it reads the pack directly from memory (with several blocks and
+ * threads) as if it reads the pack from a .pac file.
+ */
+
+// own generator, since FMIndex::test reseeds std::rand
+std::mt19937 xRng( 42 );
+
+std::shared_ptr<NucSeq> randomNucSeq( size_t uiLen )
+{
+    auto pRet = std::make_shared<NucSeq>( );
+    pRet->vReserveMemory( uiLen );
+    for( size_t i = 0; i < uiLen; i++ )
+        pRet->push_back( ( uint8_t )( xRng( ) % 4 ) );
+    return pRet;
+} // function
+
+int main( void )
+{
+    const std::string sFileName = "bwt_large_test";
+    for( size_t uiRound = 0; uiRound < 5; uiRound++ )
+    {
+        Pack xPack;
+        const size_t uiNumContigs = 1 + xRng( ) % 5;
+        for( size_t i = 0; i < uiNumContigs; i++ )
+            xPack.vAppendSequence( "chr" + std::to_string( i ), "desc", *randomNucSeq( xRng( ) % 100000 + 1 ) );
+        const bgint_t uiTextLength = xPack.uiUnpackedSizeForwardPlusReverse( );
+        auto fSource = [ & ]( bgint_t uiFirstByte, bgint_t uiNumBytes, unsigned char* pOut ) {
+            xPack.vGetPackedForwardPlusReverse( uiFirstByte, uiNumBytes, pOut );
+        }; // lambda
+
+        xPack.vCreateAndStorePackForBWTProcessing( sFileName );
+        auto xFromFile = bwtLarge( ( sFileName + ".pac" ).c_str( ) );
+        std::remove( ( sFileName + ".pac" ).c_str( ) );
+
+        auto xFromMemory = bwtLarge( uiTextLength, fSource );
+        // small blocks so that the incremental build and merge is exercised
+        decltype( xFromMemory ) xFromMemoryBlocks;
+        double dTime = metaMeasureDuration( [ & ]( ) {
+                           xFromMemoryBlocks = bwtLarge( uiTextLength, fSource, 1 + uiRound % 4, 4096, 4096 );
+                       } ).count( );
+        std::cout << "round " << uiRound << ": " << uiTextLength << " nt; " << 1 + uiRound % 4 << " threads; "
+                  << dTime * 1000 << " ms" << std::endl;
+
+        if( xFromFile != xFromMemory || xFromFile != xFromMemoryBlocks )
+        {
+            std::cerr << "round " << uiRound << ": bwtLarge from memory differs from bwtLarge from file" << std::endl;
+            return EXIT_FAILURE;
+        } // if
+
+        FMIndex xLarge( xPack, 1 );
+        FMIndex xSmall( xPack, 0 );
+        if( !xLarge.test( xPack, 1000 ) )
+            return EXIT_FAILURE;
+        for( bgint_t uiI = 0; uiI < uiTextLength; uiI += 997 )
+            if( xLarge.bwt_sa( uiI ) != xSmall.bwt_sa( uiI ) )
+            {
+                std::cerr << "round " << uiRound << ": suffix arrays differ at " << uiI << std::endl;
+                return EXIT_FAILURE;
+            } // if
+    } // for
+
+    return EXIT_SUCCESS;
+} /// main function
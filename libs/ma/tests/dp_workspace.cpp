@@ -0,0 +1,175 @@
+#define EXIT_SUCCESS 0
+#define EXIT_FAILURE 1
+
+#include "ma/module/needlemanWunsch.h"
+#include "ma/module/smallInversions.h"
+#include "util/system.h"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+using namespace libMA;
+
+/*
+ * Aligns reads with a small inversion via NeedlemanWunsch and SmallInversions and checks the DPWorkspace:
+ * - the alignments with a reused workspace equal the ones with a fresh workspace per read
+ * - once the workspace has seen all reads, aligning them again does not allocate DP memory
+ * - DPs that exceed the high-water mark of the workspace (AlignedMemoryManager::uiMaxKeptBytes) do not pin their memory
+ * Reports the runtime of NeedlemanWunsch with a fresh workspace per read and with the reused one.
+ */
+
+// own generator, so that the reads do not depend on the use of std::rand within the library
+std::mt19937_64 xGen( 42 );
+
+size_t randomIndex( size_t uiMax )
+{
+    return std::uniform_int_distribution<size_t>( 0, uiMax - 1 )( xGen );
+} // function
+
+std::shared_ptr<NucSeq> randomNucSeq( size_t uiLen )
+{
+    auto pRet = std::make_shared<NucSeq>( );
+    pRet->vReserveMemory( uiLen );
+    for( size_t i = 0; i < uiLen; i++ )
+        pRet->push_back( ( uint8_t )( randomIndex( 4 ) ) );
+    return pRet;
+} // function
+
+struct Read
+{
+    std::shared_ptr<NucSeq> pQuery;
+    std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Seeds>>> pSeedSets;
+}; // struct
+
+/**
+ * @brief extracts a read of length uiLen starting at uiFrom, inverts 300nt in its center and adds some mismatches.
+ * @details
+ * The seeds flank the inversion (they are free of mismatches).
+ */
+Read simulateRead( Pack& rPack, nucSeqIndex uiFrom, nucSeqIndex uiLen )
+{
+    auto pRef = rPack.vExtract( uiFrom, uiFrom + uiLen );
+    const nucSeqIndex uiInvStart = uiLen / 2 - 150, uiInvEnd = uiLen / 2 + 150;
+    Read xRet;
+    xRet.pQuery = std::make_shared<NucSeq>( );
+    for( nucSeqIndex uiI = 0; uiI < uiLen; uiI++ )
+    {
+        uint8_t uiNuc = uiI >= uiInvStart && uiI < uiInvEnd ? 3 - ( *pRef )[ uiInvEnd - 1 - ( uiI - uiInvStart ) ]
+                                                            : ( *pRef )[ uiI ];
+        const bool bInSeed =
+            ( uiI + 50 >= uiInvStart && uiI < uiInvStart ) || ( uiI >= uiInvEnd && uiI < uiInvEnd + 50 );
+        if( !bInSeed && randomIndex( 30 ) == 0 )
+            uiNuc = ( uiNuc + 1 ) % 4;
+        xRet.pQuery->push_back( uiNuc );
+    } // for
+    auto pSeeds = std::make_shared<Seeds>( );
+    pSeeds->emplace_back( uiInvStart - 50, 50, uiFrom + uiInvStart - 50, true );
+    pSeeds->emplace_back( uiInvEnd, 50, uiFrom + uiInvEnd, true );
+    xRet.pSeedSets = std::make_shared<libMS::ContainerVector<std::shared_ptr<Seeds>>>( );
+    xRet.pSeedSets->push_back( pSeeds );
+    return xRet;
+} // function
+
+bool equal( std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>> pA,
+            std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>> pB )
+{
+    if( pA->size( ) != pB->size( ) )
+        return false;
+    for( size_t uiI = 0; uiI < pA->size( ); uiI++ )
+        if( ( *pA )[ uiI ]->data != ( *pB )[ uiI ]->data ||
+            ( *pA )[ uiI ]->uiBeginOnRef != ( *pB )[ uiI ]->uiBeginOnRef ||
+            ( *pA )[ uiI ]->uiBeginOnQuery != ( *pB )[ uiI ]->uiBeginOnQuery )
+            return false;
+    return true;
+} // function
+
+int main( void )
+{
+    auto pPack = std::make_shared<Pack>( );
+    pPack->vAppendSequence( "chr1", "chr1-desc", *randomNucSeq( 1000000 ) );
+
+    std::vector<Read> vReads;
+    for( size_t uiI = 0; uiI < 100; uiI++ )
+    {
+        const nucSeqIndex uiLen = 1000 + randomIndex( 4000 );
+        vReads.push_back(
+            simulateRead( *pPack, randomIndex( pPack->uiUnpackedSizeForwardStrand - uiLen ), uiLen ) );
+    } // for
+
+    ParameterSetManager xParameters;
+    NeedlemanWunsch xNW( xParameters );
+    SmallInversions xSI( xParameters );
+
+    // reference: a fresh workspace for each read
+    std::vector<std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>>> vFresh;
+    size_t uiNumInversions = 0;
+    double dFresh = metaMeasureDuration( [ & ]( ) {
+                        for( auto& rRead : vReads )
+                        {
+                            DPWorkspace xWorkspace;
+                            auto pAlignments = std::make_shared<libMS::ContainerVector<std::shared_ptr<Alignment>>>( );
+                            pAlignments->push_back(
+                                xNW.execute_one( rRead.pSeedSets->front( ), rRead.pQuery, pPack, xWorkspace ) );
+                            vFresh.push_back( pAlignments );
+                        } // for
+                    } ).count( );
+
+    size_t uiNumAllocationsFirstPass = 0;
+    double dReused = 0;
+    for( size_t uiPass = 0; uiPass < 2; uiPass++ )
+    {
+        dReused = 0;
+        for( size_t uiI = 0; uiI < vReads.size( ); uiI++ )
+        {
+            std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>> pAlignments;
+            dReused += metaMeasureDuration( [ & ]( ) {
+                           pAlignments = xNW.execute( vReads[ uiI ].pSeedSets, vReads[ uiI ].pQuery, pPack );
+                       } ).count( );
+            if( !equal( pAlignments, vFresh[ uiI ] ) )
+            {
+                std::cerr << "alignment with reused workspace differs for read " << uiI << std::endl;
+                return EXIT_FAILURE;
+            } // if
+            auto pWithInversions = xSI.execute( pAlignments, vReads[ uiI ].pQuery, pPack );
+            if( uiPass == 0 )
+                uiNumInversions += pWithInversions->size( ) - pAlignments->size( );
+        } // for
+        if( uiPass == 0 )
+            uiNumAllocationsFirstPass = DPWorkspace::local( ).xMemoryManager.uiNumAllocations;
+    } // for
+    const size_t uiNumAllocationsSecondPass =
+        DPWorkspace::local( ).xMemoryManager.uiNumAllocations - uiNumAllocationsFirstPass;
+
+    std::cout << "inversions found: " << uiNumInversions << " (of " << vReads.size( ) << ")" << std::endl;
+    std::cout << "allocations: first pass " << uiNumAllocationsFirstPass << "; second pass "
+              << uiNumAllocationsSecondPass << std::endl;
+    std::cout << "fresh workspace per read: " << dFresh * 1000 << " ms; reused workspace: " << dReused * 1000
+              << " ms" << std::endl;
+
+    if( uiNumAllocationsSecondPass != 0 || uiNumInversions == 0 )
+        return EXIT_FAILURE;
+
+    // lower the high-water mark below the memory that the reads require: the oversized buffers must be freed after
+    // each DP, while the alignments stay the same
+    auto& rMemoryManager = DPWorkspace::local( ).xMemoryManager;
+    const size_t uiCapacityBefore = rMemoryManager.capacity( );
+    rMemoryManager.uiMaxKeptBytes = uiCapacityBefore / 8;
+    size_t uiMaxCapacityAfterRead = 0;
+    for( size_t uiI = 0; uiI < vReads.size( ); uiI++ )
+    {
+        auto pAlignments = xNW.execute( vReads[ uiI ].pSeedSets, vReads[ uiI ].pQuery, pPack );
+        if( !equal( pAlignments, vFresh[ uiI ] ) )
+        {
+            std::cerr << "alignment with shrinking workspace differs for read " << uiI << std::endl;
+            return EXIT_FAILURE;
+        } // if
+        uiMaxCapacityAfterRead = std::max( uiMaxCapacityAfterRead, rMemoryManager.capacity( ) );
+    } // for
+    std::cout << "workspace memory: " << uiCapacityBefore << " bytes with the default limit; at most "
+              << uiMaxCapacityAfterRead << " bytes after a read with a limit of " << rMemoryManager.uiMaxKeptBytes
+              << " bytes per buffer" << std::endl;
+    // three buffers: matrix, H vector and traceback
+    if( uiMaxCapacityAfterRead > 3 * rMemoryManager.uiMaxKeptBytes )
+        return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+} /// main function
@@ -0,0 +1,109 @@
+#define EXIT_SUCCESS 0
+#define EXIT_FAILURE 1
+
+#include "ma/container/fMIndex.h"
+#include "util/indexMemory.h"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+using namespace libMA;
+
+/*
+ * Checks the placement policy of the index arrays (IndexMemory):
+ * - vectors that use huge pages / interleaving keep their content when growing and shrinking
+ * - an index that is loaded with the policy enabled delivers the same SA intervals as one loaded without
+ * The placement itself is a hint to the OS and not checked here.
+ */
+
+std::shared_ptr<NucSeq> randomNucSeq( size_t uiLen )
+{
+    auto pRet = std::make_shared<NucSeq>( );
+    pRet->vReserveMemory( uiLen );
+    for( size_t i = 0; i < uiLen; i++ )
+        pRet->push_back( ( uint8_t )( std::rand( ) % 4 ) );
+    return pRet;
+} // function
+
+bool checkVector( )
+{
+    IndexVector<uint64_t> vA;
+    // crosses uiMinBytes, so both allocation paths are used
+    for( uint64_t uiI = 0; uiI < IndexMemory::uiMinBytes; uiI++ )
+        vA.push_back( uiI * 7 );
+    IndexVector<uint64_t> vB( vA );
+    vA.resize( 10 );
+    vA.shrink_to_fit( );
+    for( uint64_t uiI = 0; uiI < vB.size( ); uiI++ )
+        if( vB[ uiI ] != uiI * 7 || ( uiI < vA.size( ) && vA[ uiI ] != uiI * 7 ) )
+            return false;
+    IndexVector<uint8_t> vZero( IndexMemory::uiMinBytes * 3 );
+    for( auto uiVal : vZero )
+        if( uiVal != 0 )
+            return false;
+    return true;
+} // function
+
+int main( void )
+{
+    std::srand( 42 );
+    const std::string sPrefix = "index_memory_test";
+    bool bSuccess = true;
+
+    for( bool bHugePages : { false, true } )
+        for( bool bInterleave : { false, true } )
+        {
+            IndexMemory::bHugePages = bHugePages;
+            IndexMemory::bInterleave = bInterleave;
+            if( !checkVector( ) )
+            {
+                std::cerr << "vector content differs for huge pages " << bHugePages << " and interleave "
+                          << bInterleave << std::endl;
+                bSuccess = false;
+            } // if
+        } // for
+
+    IndexMemory::bHugePages = false;
+    IndexMemory::bInterleave = false;
+    {
+        Pack xPack;
+        for( size_t uiI = 0; uiI < 2; uiI++ )
+            xPack.vAppendSequence( "chr" + std::to_string( uiI ), "desc", *randomNucSeq( 1000000 ) );
+        xPack.vStoreCollection( sPrefix );
+        FMIndex( xPack ).vStoreFMIndex( sPrefix.c_str( ) );
+    } // scope
+
+    {
+        FMIndex xDefaultIndex( sPrefix );
+        IndexMemory::bHugePages = true;
+        IndexMemory::bInterleave = true;
+        Pack xPlacedPack( sPrefix );
+        FMIndex xPlacedIndex( sPrefix );
+        IndexMemory::bHugePages = false;
+        IndexMemory::bInterleave = false;
+
+        for( size_t uiI = 0; uiI < 200 && bSuccess; uiI++ )
+        {
+            const nucSeqIndex uiLen = 10 + std::rand( ) % 20;
+            const nucSeqIndex uiFrom = std::rand( ) % ( xPlacedPack.uiUnpackedSizeForwardPlusReverse( ) - uiLen );
+            auto pQuery = xPlacedPack.vExtract( uiFrom, uiFrom + uiLen );
+            auto xDefault = xDefaultIndex.getInterval( pQuery );
+            auto xPlaced = xPlacedIndex.getInterval( pQuery );
+            if( xDefault.start( ) != xPlaced.start( ) || xDefault.size( ) != xPlaced.size( ) )
+            {
+                std::cerr << "placed index delivers a different SA interval" << std::endl;
+                bSuccess = false;
+            } // if
+            for( auto iPos = xDefault.start( ); iPos < xDefault.end( ) && bSuccess; iPos++ )
+                if( xDefaultIndex.bwt_sa( iPos ) != xPlacedIndex.bwt_sa( iPos ) )
+                {
+                    std::cerr << "placed index delivers a different suffix array entry" << std::endl;
+                    bSuccess = false;
+                } // if
+        } // for
+    } // scope
+
+    for( auto sSuffix : { ".pac", ".ann", ".amb", ".bwt", ".sa" } )
+        std::remove( ( sPrefix + sSuffix ).c_str( ) );
+    return bSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+} /// main function
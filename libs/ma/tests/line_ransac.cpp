@@ -0,0 +1,138 @@
+#define EXIT_SUCCESS 0
+#define EXIT_FAILURE 1
+
+#include "ma/sample_consensus/line_ransac.h"
+#include "ma/sample_consensus/test_ransac.h"
+#include "util/system.h"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+using namespace libMA;
+
+/*
+ * Checks LineRansac against run_ransac (the SACModelLine based implementation used by the harmonization before):
+ * - the median absolute deviations match
+ * - both find the diagonal line of a SoC with outliers
+ * - LineRansac is deterministic for a given seed and keeps its precision at the coordinates of a human sized genome
+ * Reports the runtime of both implementations.
+ */
+
+struct Points
+{
+    std::vector<double> vX, vY;
+}; // struct
+
+/// @brief points of a SoC on the diagonal starting at dRefStart with 25% outliers (like harmonizeOne creates them)
+Points randomSoC( size_t uiNumSeeds, double dRefStart, std::mt19937_64& xGen )
+{
+    std::uniform_real_distribution<double> xQueryPos( 0, 10000 );
+    std::uniform_real_distribution<double> xNoise( -3, 3 );
+    std::uniform_real_distribution<double> xOutlier( -20000, 20000 );
+    std::uniform_int_distribution<int> xSize( 16, 50 );
+    std::bernoulli_distribution xIsOutlier( 0.25 );
+    Points xRet;
+    for( size_t uiI = 0; uiI < uiNumSeeds; uiI++ )
+    {
+        const double dQ = std::floor( xQueryPos( xGen ) );
+        const double dR = std::floor( dRefStart + dQ + ( xIsOutlier( xGen ) ? xOutlier( xGen ) : xNoise( xGen ) ) );
+        const double dSize = xSize( xGen );
+        for( double dOffset : {dSize / 2, 0.0, dSize} )
+        {
+            xRet.vX.push_back( dR + dOffset );
+            xRet.vY.push_back( dQ + dOffset );
+        } // for
+    } // for
+    return xRet;
+} // function
+
+void fill( LineRansac& rRansac, const Points& rPoints )
+{
+    rRansac.reset( rPoints.vX.front( ), rPoints.vY.front( ) );
+    for( size_t uiI = 0; uiI < rPoints.vX.size( ); uiI++ )
+        rRansac.addPoint( rPoints.vX[ uiI ], rPoints.vY[ uiI ] );
+} // function
+
+/// @note the threshold (MAD of the query positions) lets some outliers into the regression, so the fit is not exact
+bool isDiagonal( std::pair<double, double> xSlopeIntercept, double dRefStart )
+{
+    return std::abs( xSlopeIntercept.first - std::atan( 1 ) ) < 0.1 &&
+           std::abs( xSlopeIntercept.second - dRefStart ) < 1000;
+} // function
+
+int main( void )
+{
+    std::mt19937_64 xGen( 42 );
+    LineRansac xRansac;
+    double dOld = 0, dNew = 0;
+    size_t uiNumOldDiagonal = 0, uiNumNewDiagonal = 0, uiNumFits = 0;
+    for( size_t uiNumSeeds : {10, 100, 1000, 10000} )
+        for( size_t uiRep = 0; uiRep < 20; uiRep++ )
+        {
+            // run_ransac stores the points as floats, so compare on small coordinates
+            const double dRefStart = 100000;
+            auto xPoints = randomSoC( uiNumSeeds, dRefStart, xGen );
+
+            std::pair<double, double> xOld, xNew;
+            double dMADOld = 0, dMADNew = 0;
+            dOld += metaMeasureDuration( [ & ]( ) {
+                        dMADOld = medianAbsoluteDeviation<double>( xPoints.vY );
+                        xOld = run_ransac( xPoints.vX, xPoints.vY, dMADOld );
+                    } ).count( );
+            dNew += metaMeasureDuration( [ & ]( ) {
+                        fill( xRansac, xPoints );
+                        dMADNew = xRansac.medianAbsoluteDeviationY( );
+                        xNew = xRansac.fit( dMADNew );
+                    } ).count( );
+            if( dMADOld != dMADNew )
+            {
+                std::cerr << "MAD differs: " << dMADOld << " != " << dMADNew << std::endl;
+                return EXIT_FAILURE;
+            } // if
+            uiNumFits++;
+            if( isDiagonal( xOld, dRefStart ) )
+                uiNumOldDiagonal++;
+            if( isDiagonal( xNew, dRefStart ) )
+                uiNumNewDiagonal++;
+
+            // same seed same result
+            auto xAgain = xRansac.fit( dMADNew );
+            if( xAgain != xNew )
+            {
+                std::cerr << "fit is not deterministic" << std::endl;
+                return EXIT_FAILURE;
+            } // if
+        } // for
+
+    // coordinates of a human sized genome
+    size_t uiNumLargeDiagonal = 0;
+    for( size_t uiRep = 0; uiRep < 20; uiRep++ )
+    {
+        const double dRefStart = 5000000000.0 + uiRep * 1000003;
+        auto xPoints = randomSoC( 1000, dRefStart, xGen );
+        fill( xRansac, xPoints );
+        if( isDiagonal( xRansac.fit( xRansac.medianAbsoluteDeviationY( ) ), dRefStart ) )
+            uiNumLargeDiagonal++;
+    } // for
+
+    // no line with an acceptable angle -> nan like run_ransac
+    xRansac.reset( 0, 0 );
+    for( size_t uiI = 0; uiI < 100; uiI++ )
+        xRansac.addPoint( (double)uiI, 7 );
+    if( !std::isnan( xRansac.fit( 1 ).first ) )
+    {
+        std::cerr << "horizontal points must not deliver a line" << std::endl;
+        return EXIT_FAILURE;
+    } // if
+
+    std::cout << "diagonal found: run_ransac " << uiNumOldDiagonal << "/" << uiNumFits << " LineRansac "
+              << uiNumNewDiagonal << "/" << uiNumFits << std::endl;
+    std::cout << "diagonal found on large coordinates: LineRansac " << uiNumLargeDiagonal << "/20" << std::endl;
+    std::cout << "runtime: run_ransac " << dOld * 1000 << "ms LineRansac " << dNew * 1000 << "ms" << std::endl;
+    // the random samples differ, so allow for a little deviation
+    if( uiNumNewDiagonal + uiNumFits / 20 < uiNumOldDiagonal ||
+        uiNumLargeDiagonal + 2 < 20 * uiNumNewDiagonal / uiNumFits )
+        return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+} /// main function
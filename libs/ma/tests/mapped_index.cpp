@@ -0,0 +1,131 @@
+#define EXIT_SUCCESS 0
+#define EXIT_FAILURE 1
+
+#include "ma/container/fMIndex.h"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+using namespace libMA;
+
+/*
+ * Checks memory mapped packs and FMD-indices ("Map Index"):
+ * - a mapped pack delivers the same sequence as a loaded one
+ * - a mapped index delivers the same SA intervals and suffix array entries as a loaded one
+ * - mapped packs and indices cannot be modified or stored
+ */
+
+std::shared_ptr<NucSeq> randomNucSeq( size_t uiLen )
+{
+    auto pRet = std::make_shared<NucSeq>( );
+    pRet->vReserveMemory( uiLen );
+    for( size_t i = 0; i < uiLen; i++ )
+        pRet->push_back( ( uint8_t )( std::rand( ) % 4 ) );
+    return pRet;
+} // function
+
+bool equal( const NucSeq& rA, const NucSeq& rB )
+{
+    if( rA.length( ) != rB.length( ) )
+        return false;
+    for( size_t uiI = 0; uiI < rA.length( ); uiI++ )
+        if( rA[ uiI ] != rB[ uiI ] )
+            return false;
+    return true;
+} // function
+
+template <typename F> bool throws( F&& f )
+{
+    try
+    {
+        f( );
+    } // try
+    catch( const std::runtime_error& )
+    {
+        return true;
+    } // catch
+    return false;
+} // function
+
+int main( void )
+{
+    std::srand( 42 );
+    const std::string sPrefix = "mapped_index_test";
+    {
+        Pack xPack;
+        // 4 contigs, so that all checksums of the .pac file (length % 4) are covered
+        for( size_t uiI = 0; uiI < 4; uiI++ )
+            xPack.vAppendSequence( "chr" + std::to_string( uiI ), "desc", *randomNucSeq( 30000 + uiI ) );
+        xPack.vStoreCollection( sPrefix );
+        FMIndex( xPack ).vStoreFMIndex( sPrefix.c_str( ) );
+    } // scope
+
+    bool bSuccess = true;
+    {
+        auto pLoadedPack = std::make_shared<Pack>( sPrefix );
+        auto pMappedPack = std::make_shared<Pack>( sPrefix, true );
+        if( !equal( *pLoadedPack->vColletionAsNucSeq( ), *pMappedPack->vColletionAsNucSeq( ) ) )
+        {
+            std::cerr << "mapped pack differs from loaded pack" << std::endl;
+            bSuccess = false;
+        } // if
+        if( !throws( [ & ]( ) { pMappedPack->vAppendSequence( "chr", "desc", *randomNucSeq( 100 ) ); } ) )
+        {
+            std::cerr << "appending to a mapped pack did not throw" << std::endl;
+            bSuccess = false;
+        } // if
+
+        FMIndex xLoadedIndex( sPrefix );
+        FMIndex xMappedIndex( sPrefix, true );
+        if( xLoadedIndex.getRefSeqLength( ) != xMappedIndex.getRefSeqLength( ) )
+        {
+            std::cerr << "mapped index has a different reference length" << std::endl;
+            bSuccess = false;
+        } // if
+        size_t uiNumSaEntries = 0;
+        for( size_t uiI = 0; uiI < 200 && bSuccess; uiI++ )
+        {
+            const nucSeqIndex uiLen = 10 + std::rand( ) % 20;
+            const nucSeqIndex uiFrom = std::rand( ) % ( pLoadedPack->uiUnpackedSizeForwardPlusReverse( ) - uiLen );
+            // queries that span two contigs are not found; that is fine as long as both indices agree
+            auto pQuery = pLoadedPack->vExtract( uiFrom, uiFrom + uiLen );
+            auto xLoaded = xLoadedIndex.getInterval( pQuery );
+            auto xMapped = xMappedIndex.getInterval( pQuery );
+            if( xLoaded.start( ) != xMapped.start( ) || xLoaded.size( ) != xMapped.size( ) )
+            {
+                std::cerr << "mapped index delivers a different SA interval" << std::endl;
+                bSuccess = false;
+            } // if
+            for( auto iPos = xLoaded.start( ); iPos < xLoaded.end( ) && bSuccess; iPos++ )
+            {
+                uiNumSaEntries++;
+                if( xLoadedIndex.bwt_sa( iPos ) != xMappedIndex.bwt_sa( iPos ) )
+                {
+                    std::cerr << "mapped index delivers a different suffix array entry" << std::endl;
+                    bSuccess = false;
+                } // if
+            } // for
+        } // for
+        if( uiNumSaEntries == 0 )
+        {
+            std::cerr << "no query was found in the index" << std::endl;
+            bSuccess = false;
+        } // if
+        if( !throws( [ & ]( ) { xMappedIndex.vStoreFMIndex( ( sPrefix + "_copy" ).c_str( ) ); } ) )
+        {
+            std::cerr << "storing a mapped index did not throw" << std::endl;
+            bSuccess = false;
+        } // if
+        std::cout << "compared " << uiNumSaEntries << " suffix array entries" << std::endl;
+    } // scope
+
+    if( !throws( [ & ]( ) { Pack( sPrefix + "_missing", true ); } ) )
+    {
+        std::cerr << "mapping a missing pack did not throw" << std::endl;
+        bSuccess = false;
+    } // if
+
+    for( auto sSuffix : { ".pac", ".ann", ".amb", ".bwt", ".sa" } )
+        std::remove( ( sPrefix + sSuffix ).c_str( ) );
+    return bSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+} /// main function
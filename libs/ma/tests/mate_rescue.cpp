@@ -0,0 +1,98 @@
+#define EXIT_SUCCESS 0
+#define EXIT_FAILURE 1
+
+#include "ma/module/mateRescue.h"
+#include "util/system.h"
+#include <cstdlib>
+#include <iostream>
+
+using namespace libMA;
+
+/*
+ * Simulates read pairs on a random genome and checks that the mates aligned via mate rescue end up at the same
+ * positions as the mates aligned on the whole genome.
+ * Reports the runtime of both approaches.
+ */
+
+std::shared_ptr<NucSeq> randomNucSeq( size_t uiLen )
+{
+    auto pRet = std::make_shared<NucSeq>( );
+    pRet->vReserveMemory( uiLen );
+    for( size_t i = 0; i < uiLen; i++ )
+        pRet->push_back( ( uint8_t )( std::rand( ) % 4 ) );
+    return pRet;
+} // function
+
+/// @brief extracts [uiFrom, uiTo) of the forward strand (or its reverse complement) and adds some mismatches.
+std::shared_ptr<NucSeq> simulateRead( Pack& rPack, nucSeqIndex uiFrom, nucSeqIndex uiTo, bool bReverse )
+{
+    auto pRet = bReverse ? rPack.vExtract( rPack.uiPositionToReverseStrand( uiTo - 1 ),
+                                           rPack.uiPositionToReverseStrand( uiFrom ) + 1 )
+                         : rPack.vExtract( uiFrom, uiTo );
+    for( size_t uiI = 0; uiI < pRet->length( ); uiI++ )
+        if( std::rand( ) % 50 == 0 )
+            pRet->pxSequenceRef[ uiI ] = ( pRet->pxSequenceRef[ uiI ] + 1 ) % 4;
+    return pRet;
+} // function
+
+int main( void )
+{
+    std::srand( 42 );
+    auto pPack = std::make_shared<Pack>( );
+    pPack->vAppendSequence( "chr1", "chr1-desc", *randomNucSeq( 200000 ) );
+    pPack->vAppendSequence( "chr2", "chr2-desc", *randomNucSeq( 100000 ) );
+    auto pFMIndex = std::make_shared<FMIndex>( pPack );
+
+    ParameterSetManager xParameters;
+    xParameters.getSelected( )->xUsePairedReads->set( true );
+    xParameters.getSelected( )->xMateRescue->set( true );
+    MateRescue xRescue( xParameters );
+
+    const nucSeqIndex uiReadLen = 150;
+    const size_t uiNumPairs = 200;
+    size_t uiNumRescueAttempts = 0;
+    size_t uiNumDifferent = 0;
+    double dFull = 0, dRescue = 0;
+    for( size_t uiI = 0; uiI < uiNumPairs; uiI++ )
+    {
+        // fragment on chr1 with an insert size of roughly 400
+        nucSeqIndex uiFragmentSize = 350 + std::rand( ) % 100;
+        nucSeqIndex uiFrom = std::rand( ) % ( 200000 - uiFragmentSize );
+        bool bFirstReverse = std::rand( ) % 2 == 0;
+        auto pA = simulateRead( *pPack, uiFrom, uiFrom + uiReadLen, bFirstReverse );
+        auto pB = simulateRead( *pPack, uiFrom + uiFragmentSize - uiReadLen, uiFrom + uiFragmentSize, !bFirstReverse );
+        if( bFirstReverse )
+            std::swap( pA, pB );
+
+        auto pAlignmentsA = xRescue.fullAlignment( pA, pFMIndex, pPack );
+        if( pAlignmentsA->empty( ) )
+            continue;
+
+        std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>> pFullB, pRescuedB;
+        dFull += metaMeasureDuration( [ & ]( ) { pFullB = xRescue.fullAlignment( pB, pFMIndex, pPack ); } ).count( );
+        dRescue += metaMeasureDuration( [ & ]( ) {
+                       pRescuedB = xRescue.execute( pB, pAlignmentsA, pFMIndex, pPack );
+                   } ).count( );
+
+        if( !xRescue.windowSeeds( pB, pAlignmentsA->front( ), pPack )->empty( ) )
+            uiNumRescueAttempts++;
+
+        if( pFullB->empty( ) != pRescuedB->empty( ) )
+        {
+            std::cerr << "pair " << uiI << ": only one of the approaches found an alignment" << std::endl;
+            return EXIT_FAILURE;
+        } // if
+        if( !pFullB->empty( ) && ( pFullB->front( )->beginOnRef( ) != pRescuedB->front( )->beginOnRef( ) ||
+                                   pFullB->front( )->endOnRef( ) != pRescuedB->front( )->endOnRef( ) ) )
+            uiNumDifferent++;
+    } // for
+
+    std::cout << "rescue attempted for " << uiNumRescueAttempts << " of " << uiNumPairs << " pairs; "
+              << uiNumDifferent << " rescued alignments differ from the whole genome alignment." << std::endl;
+    std::cout << "whole genome: " << dFull * 1000 << " ms; mate rescue: " << dRescue * 1000 << " ms" << std::endl;
+
+    // the rescue must actually be used and it must find the same alignments (up to some DP ambiguity)
+    if( uiNumRescueAttempts < uiNumPairs / 2 || uiNumDifferent > uiNumPairs / 20 )
+        return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+} /// main function
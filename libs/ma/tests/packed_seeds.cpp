@@ -0,0 +1,108 @@
+#define EXIT_SUCCESS 0
+#define EXIT_FAILURE 1
+
+#include "ma/container/seed.h"
+#include "util/radixSort.h"
+#include "util/system.h"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+using namespace libMA;
+
+/*
+ * Checks the conversion Seed -> PackedSeed and compares the runtime of the SoC sort + linesweep on Seeds (64 bytes) and
+ * PackedSeeds (32 bytes).
+ */
+
+std::vector<Seed> randomSeeds( size_t uiNum, std::mt19937_64& xGen )
+{
+    std::uniform_int_distribution<nucSeqIndex> xRefPos( 0, 6000000000ull );
+    std::uniform_int_distribution<nucSeqIndex> xQueryPos( 0, 100000 );
+    std::uniform_int_distribution<nucSeqIndex> xSize( 16, 50 );
+    std::vector<Seed> vRet;
+    vRet.reserve( uiNum );
+    for( size_t uiI = 0; uiI < uiNum; uiI++ )
+    {
+        nucSeqIndex uiRefPos = xRefPos( xGen );
+        vRet.emplace_back( xQueryPos( xGen ), xSize( xGen ), uiRefPos, uiI % 3 != 0 );
+        vRet.back( ).uiDelta = uiRefPos + 100000 - vRet.back( ).start( );
+        vRet.back( ).uiAmbiguity = uiI % 17;
+    } // for
+    return vRet;
+} // function
+
+/// @brief mimics the SoC linesweep: sums up the seed values within a window of delta values
+template <typename TP_SEEDS> nucSeqIndex sweep( const TP_SEEDS& rvSeeds, nucSeqIndex uiStripSize )
+{
+    nucSeqIndex uiBest = 0, uiCurr = 0;
+    size_t uiEnd = 0;
+    for( size_t uiStart = 0; uiStart < rvSeeds.size( ); uiStart++ )
+    {
+        while( uiEnd < rvSeeds.size( ) && rvSeeds[ uiStart ].uiDelta + uiStripSize >= rvSeeds[ uiEnd ].uiDelta &&
+               rvSeeds[ uiStart ].bOnForwStrand == rvSeeds[ uiEnd ].bOnForwStrand )
+            uiCurr += rvSeeds[ uiEnd++ ].getValue( );
+        uiBest = std::max( uiBest, uiCurr );
+        uiCurr -= rvSeeds[ uiStart ].getValue( );
+    } // for
+    return uiBest;
+} // function
+
+int main( void )
+{
+    std::mt19937_64 xGen( 42 );
+
+    // check conversion
+    auto vSeeds = randomSeeds( 1000, xGen );
+    Seeds xSeeds( vSeeds.begin( ), vSeeds.end( ) );
+    std::vector<PackedSeed> vPacked;
+    xSeeds.pack( vPacked );
+    if( vPacked.size( ) != xSeeds.size( ) )
+        return EXIT_FAILURE;
+    for( size_t uiI = 0; uiI < xSeeds.size( ); uiI++ )
+    {
+        const Seed& rS = xSeeds[ uiI ];
+        const PackedSeed& rP = vPacked[ uiI ];
+        if( rP.start( ) != rS.start( ) || rP.size( ) != rS.size( ) || rP.end( ) != rS.end( ) ||
+            rP.start_ref( ) != rS.start_ref( ) || rP.end_ref( ) != rS.end_ref( ) || rP.uiDelta != rS.uiDelta ||
+            rP.bOnForwStrand != rS.bOnForwStrand || rP.uiAmbiguity != rS.uiAmbiguity ||
+            rP.getValue( ) != rS.getValue( ) || rP.uiIndex != uiI )
+        {
+            std::cerr << "packed seed " << uiI << " differs from its seed" << std::endl;
+            return EXIT_FAILURE;
+        } // if
+    } // for
+
+    for( size_t uiNum : {1000, 10000, 100000, 1000000} )
+    {
+        const size_t uiNumReps = 10;
+        double dSeeds = 0, dPacked = 0;
+        for( size_t uiRep = 0; uiRep < uiNumReps; uiRep++ )
+        {
+            auto vSeeds = randomSeeds( uiNum, xGen );
+            Seeds xA( vSeeds.begin( ), vSeeds.end( ) );
+            std::vector<PackedSeed> vB;
+            nucSeqIndex uiScoreA = 0, uiScoreB = 0;
+            dSeeds += metaMeasureDuration( [ & ]( ) {
+                          radix::sort( xA.begin( ), xA.end( ), []( const Seed& rS ) { return rS.uiDelta; } );
+                          uiScoreA = sweep( xA, 1000000 );
+                      } ).count( );
+            // conversion is part of the measurement
+            dPacked += metaMeasureDuration( [ & ]( ) {
+                           xA.pack( vB );
+                           radix::sort( vB.begin( ), vB.end( ), []( const PackedSeed& rS ) { return rS.uiDelta; } );
+                           uiScoreB = sweep( vB, 1000000 );
+                       } ).count( );
+            if( uiScoreA != uiScoreB )
+            {
+                std::cerr << "sweep results differ for " << uiNum << " seeds" << std::endl;
+                return EXIT_FAILURE;
+            } // if
+        } // for
+        const double dFac = 1000.0 / uiNumReps;
+        std::cout << uiNum << " seeds: sort + sweep: Seed " << dSeeds * dFac << " ms; PackedSeed " << dPacked * dFac
+                  << " ms" << std::endl;
+    } // for
+
+    return EXIT_SUCCESS;
+} /// main function
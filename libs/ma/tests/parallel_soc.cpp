@@ -0,0 +1,115 @@
+#define EXIT_SUCCESS 0
+#define EXIT_FAILURE 1
+
+#include "ma/module/mateRescue.h"
+#include "util/system.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+using namespace libMA;
+
+/*
+ * Aligns long reads on a genome with segmental duplications once with sequential and once with concurrent SoC
+ * processing ("SoC Threads") and checks that both place the reads at their origin equally often.
+ * (The alignments are not compared directly: RANSAC draws from the global random generator, so even two sequential
+ * runs can differ.)
+ * Reports the runtime of both approaches.
+ */
+
+std::shared_ptr<NucSeq> randomNucSeq( size_t uiLen )
+{
+    auto pRet = std::make_shared<NucSeq>( );
+    pRet->vReserveMemory( uiLen );
+    for( size_t i = 0; i < uiLen; i++ )
+        pRet->push_back( ( uint8_t )( std::rand( ) % 4 ) );
+    return pRet;
+} // function
+
+/// @brief extracts a read of length uiLen starting at uiFrom and adds some mismatches and small indels.
+std::shared_ptr<NucSeq> simulateRead( Pack& rPack, nucSeqIndex uiFrom, nucSeqIndex uiLen )
+{
+    auto pRef = rPack.vExtract( uiFrom, uiFrom + uiLen );
+    auto pRet = std::make_shared<NucSeq>( );
+    for( size_t uiI = 0; uiI < pRef->length( ); uiI++ )
+    {
+        if( std::rand( ) % 50 == 0 ) // deletion
+            continue;
+        if( std::rand( ) % 50 == 0 ) // insertion
+            pRet->push_back( ( uint8_t )( std::rand( ) % 4 ) );
+        if( std::rand( ) % 30 == 0 ) // mismatch
+            pRet->push_back( ( ( *pRef )[ uiI ] + 1 ) % 4 );
+        else
+            pRet->push_back( ( *pRef )[ uiI ] );
+    } // for
+    return pRet;
+} // function
+
+int main( void )
+{
+    std::srand( 42 );
+    // genome with many copies of a few segments, so that the reads have several SoCs
+    auto pSegment = randomNucSeq( 5000 );
+    auto pGenome = std::make_shared<NucSeq>( );
+    for( size_t uiI = 0; uiI < 40; uiI++ )
+    {
+        auto pUnique = randomNucSeq( 5000 + std::rand( ) % 5000 );
+        pGenome->vAppend( pUnique->pGetSequenceRef( ), pUnique->length( ) );
+        pGenome->vAppend( pSegment->pGetSequenceRef( ), pSegment->length( ) );
+    } // for
+    auto pPack = std::make_shared<Pack>( );
+    pPack->vAppendSequence( "chr1", "chr1-desc", *pGenome );
+    auto pFMIndex = std::make_shared<FMIndex>( pPack );
+
+    std::vector<std::shared_ptr<NucSeq>> vReads;
+    std::vector<nucSeqIndex> vOrigins;
+    for( size_t uiI = 0; uiI < 20; uiI++ )
+    {
+        vOrigins.push_back( std::rand( ) % ( pPack->uiUnpackedSizeForwardStrand - 15000 ) );
+        vReads.push_back( simulateRead( *pPack, vOrigins.back( ), 15000 ) );
+    } // for
+    // the primary alignment must cover most of the origin of the read
+    // (reads that start in a duplicated segment can be extended into the preceding copy of the segment)
+    auto fAtOrigin = [ & ]( std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>> pAlignments,
+                            size_t uiI ) {
+        if( pAlignments->empty( ) )
+            return false;
+        const nucSeqIndex uiBegin = std::max( pAlignments->front( )->beginOnRef( ), vOrigins[ uiI ] );
+        const nucSeqIndex uiEnd = std::min( pAlignments->front( )->endOnRef( ), vOrigins[ uiI ] + 15000 );
+        return uiEnd > uiBegin + 10000;
+    }; // lambda
+
+    ParameterSetManager xSequentialParameters;
+    xSequentialParameters.getSelected( )->xMaxNumSoC->set( 50 );
+    MateRescue xSequential( xSequentialParameters );
+
+    ParameterSetManager xParallelParameters;
+    xParallelParameters.getSelected( )->xMaxNumSoC->set( 50 );
+    xParallelParameters.getSelected( )->xSoCThreads->set( 4 );
+    xParallelParameters.getSelected( )->xMinQueryLenSoCThreads->set( 1000 );
+    MateRescue xParallel( xParallelParameters );
+
+    size_t uiNumSequentialAtOrigin = 0, uiNumParallelAtOrigin = 0;
+    double dSequential = 0, dParallel = 0;
+    for( size_t uiI = 0; uiI < vReads.size( ); uiI++ )
+    {
+        std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>> pSequential, pParallel;
+        dSequential += metaMeasureDuration( [ & ]( ) {
+                           pSequential = xSequential.fullAlignment( vReads[ uiI ], pFMIndex, pPack );
+                       } ).count( );
+        dParallel += metaMeasureDuration( [ & ]( ) {
+                         pParallel = xParallel.fullAlignment( vReads[ uiI ], pFMIndex, pPack );
+                     } ).count( );
+        uiNumSequentialAtOrigin += fAtOrigin( pSequential, uiI ) ? 1 : 0;
+        uiNumParallelAtOrigin += fAtOrigin( pParallel, uiI ) ? 1 : 0;
+    } // for
+
+    std::cout << "reads aligned at their origin: sequential " << uiNumSequentialAtOrigin << "; concurrent "
+              << uiNumParallelAtOrigin << " (of " << vReads.size( ) << ")" << std::endl;
+    std::cout << "sequential: " << dSequential * 1000 << " ms; concurrent: " << dParallel * 1000 << " ms"
+              << std::endl;
+
+    if( uiNumParallelAtOrigin + 1 < uiNumSequentialAtOrigin || uiNumParallelAtOrigin < vReads.size( ) * 9 / 10 )
+        return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+} /// main function
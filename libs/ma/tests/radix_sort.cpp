@@ -0,0 +1,115 @@
+#define EXIT_SUCCESS 0
+#define EXIT_FAILURE 1
+
+#include "ma/container/seed.h"
+#include "util/radixSort.h"
+#include "util/system.h"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+using namespace libMA;
+
+/*
+ * Checks radix::sort against std::sort / std::stable_sort and reports the runtime of std::sort (the previous
+ * implementation) and radix::sort.
+ * The seed sets mimic the ones of repetitive long reads (tens of thousands of seeds spread over a human sized genome).
+ */
+
+std::vector<Seed> randomSeeds( size_t uiNum, std::mt19937_64& xGen )
+{
+    // positions of a human sized genome (forward + reverse strand)
+    std::uniform_int_distribution<nucSeqIndex> xRefPos( 0, 6000000000ull );
+    std::uniform_int_distribution<nucSeqIndex> xQueryPos( 0, 100000 );
+    std::uniform_int_distribution<nucSeqIndex> xSize( 16, 50 );
+    std::vector<Seed> vRet;
+    vRet.reserve( uiNum );
+    for( size_t uiI = 0; uiI < uiNum; uiI++ )
+    {
+        // create some repeats, so that there are ties in the first key
+        nucSeqIndex uiRefPos = uiI % 7 == 0 && uiI > 0 ? vRet[ uiI - 1 ].start_ref( ) : xRefPos( xGen );
+        vRet.emplace_back( xQueryPos( xGen ), xSize( xGen ), uiRefPos, true );
+        vRet.back( ).uiDelta = uiRefPos + 100000 - vRet.back( ).start( );
+    } // for
+    return vRet;
+} // function
+
+bool sameOrder( const std::vector<Seed>& rvA, const std::vector<Seed>& rvB )
+{
+    if( rvA.size( ) != rvB.size( ) )
+        return false;
+    for( size_t uiI = 0; uiI < rvA.size( ); uiI++ )
+        if( rvA[ uiI ].start( ) != rvB[ uiI ].start( ) || rvA[ uiI ].start_ref( ) != rvB[ uiI ].start_ref( ) ||
+            rvA[ uiI ].size( ) != rvB[ uiI ].size( ) || rvA[ uiI ].uiDelta != rvB[ uiI ].uiDelta )
+            return false;
+    return true;
+} // function
+
+int main( void )
+{
+    std::mt19937_64 xGen( 42 );
+    for( size_t uiNum : {10, 100, 1000, 10000, 100000} )
+    {
+        const size_t uiNumReps = 20;
+        // runtimes of the SoC (delta) sort and the linesweep (ref/query) sort
+        double dStdDelta = 0, dRadixDelta = 0, dStdRefQuery = 0, dRadixRefQuery = 0;
+        for( size_t uiRep = 0; uiRep < uiNumReps; uiRep++ )
+        {
+            auto vA = randomSeeds( uiNum, xGen );
+            auto vB = vA;
+            // SoC sort: delta values
+            dStdDelta += metaMeasureDuration( [ & ]( ) {
+                             std::sort( vA.begin( ), vA.end( ),
+                                        []( const Seed& rA, const Seed& rB ) { return rA.uiDelta < rB.uiDelta; } );
+                         } ).count( );
+            dRadixDelta += metaMeasureDuration( [ & ]( ) {
+                               radix::sort( vB.begin( ), vB.end( ), []( const Seed& rS ) { return rS.uiDelta; } );
+                           } ).count( );
+            for( size_t uiI = 0; uiI < uiNum; uiI++ )
+                if( vA[ uiI ].uiDelta != vB[ uiI ].uiDelta )
+                {
+                    std::cerr << "delta order differs for " << uiNum << " seeds" << std::endl;
+                    return EXIT_FAILURE;
+                } // if
+
+            // linesweep sort: ref position ascending, query position descending
+            // (the linesweep receives the seeds in an order unrelated to the reference positions)
+            std::shuffle( vB.begin( ), vB.end( ), xGen );
+            vA = vB;
+            auto fRefQueryOrder = []( const Seed& rA, const Seed& rB ) {
+                if( rA.start_ref( ) == rB.start_ref( ) )
+                    return rA.start( ) > rB.start( );
+                return rA.start_ref( ) < rB.start_ref( );
+            }; // lambda
+            auto vC = vB;
+            dStdRefQuery +=
+                metaMeasureDuration( [ & ]( ) { std::sort( vA.begin( ), vA.end( ), fRefQueryOrder ); } ).count( );
+            std::stable_sort( vC.begin( ), vC.end( ), fRefQueryOrder );
+            dRadixRefQuery += metaMeasureDuration( [ & ]( ) {
+                                  radix::sort( vB.begin( ), vB.end( ), []( const Seed& rS ) { return rS.start_ref( ); },
+                                               []( const Seed& rS ) { return ~rS.start( ); } );
+                              } ).count( );
+            // the radix sort is stable, so the orders must match exactly if the range is radix sorted
+            if( uiNum >= RADIX_SORT_MIN_SIZE && uiNum <= RADIX_SORT_MAX_SIZE_MULTI_KEY && !sameOrder( vC, vB ) )
+            {
+                std::cerr << "ref/query order differs for " << uiNum << " seeds" << std::endl;
+                return EXIT_FAILURE;
+            } // if
+            for( size_t uiI = 1; uiI < uiNum; uiI++ )
+                if( vB[ uiI - 1 ].start_ref( ) > vB[ uiI ].start_ref( ) ||
+                    ( vB[ uiI - 1 ].start_ref( ) == vB[ uiI ].start_ref( ) &&
+                      vB[ uiI - 1 ].start( ) < vB[ uiI ].start( ) ) )
+                {
+                    std::cerr << "ref/query order is wrong for " << uiNum << " seeds" << std::endl;
+                    return EXIT_FAILURE;
+                } // if
+        } // for
+        // report average milliseconds per sort
+        const double dFac = 1000.0 / uiNumReps;
+        std::cout << uiNum << " seeds: delta sort: std::sort " << dStdDelta * dFac << " ms; radix::sort "
+                  << dRadixDelta * dFac << " ms. linesweep sort: std::sort " << dStdRefQuery * dFac
+                  << " ms; radix::sort " << dRadixRefQuery * dFac << " ms" << std::endl;
+    } // for
+
+    return EXIT_SUCCESS;
+} /// main function
@@ -0,0 +1,168 @@
+#define EXIT_SUCCESS 0
+#define EXIT_FAILURE 1
+
+#include "ma/module/fileWriter.h"
+#include "ma/util/export.h"
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+using namespace libMA;
+using namespace libMS;
+
+/*
+ * Checks the read windows ("Read Window Size") and the restored read order ("Restore Read Order"):
+ * - within each window the FileReader must return the reads from the longest to the shortest one
+ * - every read must be returned exactly once
+ * - the aligner graph must write the reads of a windowed file in file order if requested
+ * - reads that are still held back when the output is closed must be written in read order
+ */
+
+std::shared_ptr<NucSeq> randomNucSeq( size_t uiLen )
+{
+    auto pRet = std::make_shared<NucSeq>( );
+    pRet->vReserveMemory( uiLen );
+    for( size_t i = 0; i < uiLen; i++ )
+        pRet->push_back( ( uint8_t )( std::rand( ) % 4 ) );
+    return pRet;
+} // function
+
+/// @brief collects the output of a FileWriter
+class StringOutStream : public OutStream
+{
+  public:
+    std::string sContent;
+
+    StringOutStream& operator<<( const std::string& s )
+    {
+        sContent += s;
+        return *this;
+    } // function
+}; // class
+
+int main( void )
+{
+    std::srand( 42 );
+    auto pPack = std::make_shared<Pack>( );
+    pPack->vAppendSequence( "chr1", "chr1-desc", *randomNucSeq( 100000 ) );
+    auto pFMIndex = std::make_shared<FMIndex>( pPack );
+
+    // fasta file with reads of mixed lengths
+    const size_t uiNumReads = 100;
+    const size_t uiWindowSize = 16;
+    std::string sFasta;
+    for( size_t uiI = 0; uiI < uiNumReads; uiI++ )
+    {
+        nucSeqIndex uiLen = std::rand( ) % 10 == 0 ? 2000 + std::rand( ) % 3000 : 100 + std::rand( ) % 200;
+        nucSeqIndex uiFrom = std::rand( ) % ( pPack->uiUnpackedSizeForwardStrand - uiLen );
+        sFasta += ">read" + std::to_string( uiI ) + "\n" + pPack->vExtract( uiFrom, uiFrom + uiLen )->toString( ) + "\n";
+    } // for
+
+    // window order
+    {
+        ParameterSetManager xParameters;
+        FileReader xReader( xParameters );
+        auto pInitVec = std::make_shared<ContainerVector<std::shared_ptr<FileStream>>>( );
+        pInitVec->push_back( std::make_shared<StringStream>( sFasta ) );
+        auto pQueue = windowFileStreams( std::make_shared<FileStreamQueue>( pInitVec ), uiWindowSize );
+        auto pStream = pQueue->pop( );
+        std::vector<bool> vSeen( uiNumReads, false );
+        size_t uiNumRead = 0;
+        nucSeqIndex uiLastLen = 0;
+        while( !pStream->eof( ) )
+        {
+            auto pRead = xReader.execute( pStream );
+            if( pRead == nullptr )
+                break;
+            if( pRead->sName != "read" + std::to_string( pRead->uiIndexInStream ) || vSeen[ pRead->uiIndexInStream ] )
+            {
+                std::cerr << "unexpected read " << pRead->sName << std::endl;
+                return EXIT_FAILURE;
+            } // if
+            vSeen[ pRead->uiIndexInStream ] = true;
+            if( uiNumRead % uiWindowSize != 0 && pRead->length( ) > uiLastLen )
+            {
+                std::cerr << "read " << pRead->sName << " is longer than its predecessor in the window" << std::endl;
+                return EXIT_FAILURE;
+            } // if
+            uiLastLen = pRead->length( );
+            uiNumRead++;
+        } // while
+        if( uiNumRead != uiNumReads )
+        {
+            std::cerr << "read " << uiNumRead << " of " << uiNumReads << " reads" << std::endl;
+            return EXIT_FAILURE;
+        } // if
+    } // scope
+
+    // restored order with several threads
+    {
+        ParameterSetManager xParameters;
+        xParameters.pGeneralParameterSet->pbRestoreReadOrder->set( true );
+        auto pOut = std::make_shared<StringOutStream>( );
+        auto pWriter = std::make_shared<FileWriter>( xParameters, pOut, pPack );
+
+        auto pInitVec = std::make_shared<ContainerVector<std::shared_ptr<FileStream>>>( );
+        pInitVec->push_back( std::make_shared<StringStream>( sFasta ) );
+        auto pQueuePledge = std::make_shared<Pledge<FileStreamQueue>>( );
+        pQueuePledge->set( windowFileStreams( std::make_shared<FileStreamQueue>( pInitVec ), uiWindowSize ) );
+        auto pPackPledge = std::make_shared<Pledge<Pack>>( );
+        pPackPledge->set( pPack );
+        auto pFMIndexPledge = std::make_shared<Pledge<FMIndex>>( );
+        pFMIndexPledge->set( pFMIndex );
+        BasePledge::simultaneousGet( setUpCompGraph( xParameters, pPackPledge, pFMIndexPledge, pQueuePledge, pWriter, 4 ) );
+
+        if( pWriter->pReadOrder->numHeldBack( ) != 0 )
+        {
+            std::cerr << "reads are held back after the alignment" << std::endl;
+            return EXIT_FAILURE;
+        } // if
+        // the first occurrence of each read name must be in file order
+        std::stringstream xLines( pOut->sContent );
+        std::string sLine;
+        size_t uiNext = 0;
+        while( std::getline( xLines, sLine ) )
+        {
+            if( sLine.empty( ) || sLine[ 0 ] == '@' )
+                continue;
+            std::string sName = sLine.substr( 0, sLine.find( '\t' ) );
+            if( uiNext < uiNumReads && sName == "read" + std::to_string( uiNext ) )
+                uiNext++;
+            else if( uiNext == 0 || sName != "read" + std::to_string( uiNext - 1 ) )
+            {
+                std::cerr << "read " << sName << " is out of order; expected read" << uiNext << std::endl;
+                return EXIT_FAILURE;
+            } // else if
+        } // while
+        if( uiNext != uiNumReads )
+        {
+            std::cerr << "wrote " << uiNext << " of " << uiNumReads << " reads" << std::endl;
+            return EXIT_FAILURE;
+        } // if
+    } // scope
+
+    // reads that are held back when the writer is closed are written in read order
+    {
+        ReadOrderBuffer xBuffer;
+        StringOutStream xOut;
+        NucSeq xRead;
+        xRead.uiStreamId = 1;
+        for( uint64_t uiIndex : { 3, 1, 0 } )
+        {
+            xRead.uiIndexInStream = uiIndex;
+            xBuffer.write( xOut, xRead, std::to_string( uiIndex ) );
+        } // for
+        if( xOut.sContent != "01" || xBuffer.numHeldBack( ) != 1 )
+        {
+            std::cerr << "wrote '" << xOut.sContent << "' before the flush" << std::endl;
+            return EXIT_FAILURE;
+        } // if
+        if( xBuffer.flush( xOut ) != 1 || xOut.sContent != "013" || xBuffer.numHeldBack( ) != 0 )
+        {
+            std::cerr << "wrote '" << xOut.sContent << "' after the flush" << std::endl;
+            return EXIT_FAILURE;
+        } // if
+    } // scope
+
+    return EXIT_SUCCESS;
+} /// main function
@@ -0,0 +1,273 @@
+#define EXIT_SUCCESS 0
+#define EXIT_FAILURE 1
+
+#include "ma/module/fileWriter.h"
+#include "ma/module/mateRescue.h"
+#include "util/system.h"
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+using namespace libMA;
+
+/*
+ * Checks the SAM formatting of the FileWriter (SamLineBuffer and appendCigar):
+ * - CIGARs, SEQ and QUAL match the ones of Alignment::cigarString, NucSeq::fromTo etc.
+ * - the records match the ones that are obtained by concatenating the strings of these functions
+ *   (the way the FileWriter formatted records before)
+ * - "Omit SEQ of Secondary Alignments" replaces SEQ and QUAL of secondary alignments by '*' only
+ * Reports the runtime of both ways of formatting.
+ */
+
+std::shared_ptr<NucSeq> randomNucSeq( size_t uiLen )
+{
+    auto pRet = std::make_shared<NucSeq>( );
+    pRet->vReserveMemory( uiLen );
+    for( size_t i = 0; i < uiLen; i++ )
+        pRet->push_back( ( uint8_t )( std::rand( ) % 4 ) );
+    return pRet;
+} // function
+
+/// @brief extracts a read from either strand, adds some mismatches, N's and qualities.
+std::shared_ptr<NucSeq> simulateRead( Pack& rPack, nucSeqIndex uiLen, size_t uiId )
+{
+    nucSeqIndex uiFrom = std::rand( ) % ( rPack.uiUnpackedSizeForwardStrand - uiLen );
+    if( std::rand( ) % 2 == 0 )
+        uiFrom = rPack.uiPositionToReverseStrand( uiFrom + uiLen ) + 1;
+    auto pRef = rPack.vExtract( uiFrom, uiFrom + uiLen );
+    std::string sSeq;
+    std::vector<uint8_t> vQual;
+    for( size_t uiI = 0; uiI < pRef->length( ); uiI++ )
+    {
+        if( std::rand( ) % 200 == 0 )
+            sSeq.push_back( 'N' );
+        else if( std::rand( ) % 20 == 0 )
+            sSeq.push_back( NucSeq::translateACGTCodeToCharacter( ( ( *pRef )[ uiI ] + 1 ) % 4 ) );
+        else
+            sSeq.push_back( NucSeq::translateACGTCodeToCharacter( ( *pRef )[ uiI ] ) );
+        vQual.push_back( ( uint8_t )( 33 + std::rand( ) % 40 ) );
+    } // for
+    auto pRet = std::make_shared<NucSeq>( sSeq, vQual.data( ) );
+    pRet->sName = "read" + std::to_string( uiId );
+    return pRet;
+} // function
+
+/// @brief collects the output of a FileWriter
+class StringOutStream : public OutStream
+{
+  public:
+    std::string sContent;
+
+    StringOutStream& operator<<( const std::string& s )
+    {
+        sContent += s;
+        return *this;
+    } // function
+}; // class
+
+/// @brief formats the records of a read by concatenating strings (the way the FileWriter did before)
+std::string referenceRecords( std::shared_ptr<NucSeq> pQuery,
+                              std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>> pAlignments,
+                              std::shared_ptr<Pack> pPack, bool bSoftClip, bool bMCigar )
+{
+    std::string sCombined = "";
+    for( std::shared_ptr<Alignment> pAlignment : *pAlignments )
+    {
+        if( pAlignment->length( ) == 0 )
+            continue;
+        std::string sCigar = bMCigar ? pAlignment->cigarStringWithMInsteadOfXandEqual( *pPack, pQuery->length( ),
+                                                                                       bSoftClip )
+                                     : pAlignment->cigarString( *pPack, pQuery->length( ), bSoftClip );
+        std::string sSegment;
+        if( bSoftClip )
+            if( pPack->bPositionIsOnReversStrand( pAlignment->uiBeginOnRef ) )
+                sSegment = pQuery->toStringComplement( );
+            else
+                sSegment = pQuery->toString( );
+        else
+            sSegment = pAlignment->getQuerySequence( *pQuery, *pPack );
+        std::string sMapQual;
+        if( std::isnan( pAlignment->fMappingQuality ) )
+            sMapQual = "255";
+        else
+            sMapQual = std::to_string( static_cast<int>( std::ceil( pAlignment->fMappingQuality * 254 ) ) );
+        sCombined += pQuery->sName + "\t" + std::to_string( pAlignment->getSamFlag( *pPack ) ) + "\t" +
+                     pAlignment->getContig( *pPack ) + "\t" + std::to_string( pAlignment->getSamPosition( *pPack ) ) +
+                     "\t" + sMapQual + "\t" + sCigar + "\t*\t0\t0\t" + sSegment + "\t" +
+                     pAlignment->getQueryQuality( *pQuery ) + "\n";
+    } // for
+    if( sCombined.size( ) == 0 )
+        sCombined += pQuery->sName + "\t" + std::to_string( SEGMENT_UNMAPPED ) + "\t*\t0\t255\t*\t*\t0\t0\t" +
+                     pQuery->toString( ) + "\t" + pQuery->toQualString( ) + "\n";
+    return sCombined;
+} // function
+
+std::vector<std::string> splitFields( const std::string& sLine )
+{
+    std::vector<std::string> vRet;
+    std::stringstream xStream( sLine );
+    std::string sField;
+    while( std::getline( xStream, sField, '\t' ) )
+        vRet.push_back( sField );
+    return vRet;
+} // function
+
+int main( void )
+{
+    std::srand( 42 );
+    auto pPack = std::make_shared<Pack>( );
+    auto pChr1 = randomNucSeq( 100000 );
+    pPack->vAppendSequence( "chr1", "chr1-desc", *pChr1 );
+    // a copy of a part of chr1 so that there are secondary alignments
+    auto pChr2 = randomNucSeq( 50000 );
+    NucSeq xRepeat( *pChr1, 10000, 30000 );
+    pChr2->vAppend( xRepeat.pxSequenceRef, xRepeat.length( ) );
+    pPack->vAppendSequence( "chr2", "chr2-desc", *pChr2 );
+    auto pFMIndex = std::make_shared<FMIndex>( pPack );
+
+    ParameterSetManager xParameters;
+    MateRescue xAligner( xParameters );
+    std::vector<std::shared_ptr<NucSeq>> vReads;
+    std::vector<std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>>> vAlignments;
+    size_t uiNumSecondary = 0;
+    for( size_t uiI = 0; uiI < 200; uiI++ )
+    {
+        vReads.push_back( simulateRead( *pPack, 200 + std::rand( ) % 3000, uiI ) );
+        vAlignments.push_back( xAligner.fullAlignment( vReads.back( ), pFMIndex, pPack ) );
+        for( auto pAlignment : *vAlignments.back( ) )
+            uiNumSecondary += pAlignment->bSecondary ? 1 : 0;
+    } // for
+    // a read without alignments
+    vReads.push_back( simulateRead( *pPack, 100, 200 ) );
+    vAlignments.push_back( std::make_shared<libMS::ContainerVector<std::shared_ptr<Alignment>>>( ) );
+    if( uiNumSecondary == 0 )
+    {
+        std::cerr << "expected some secondary alignments" << std::endl;
+        return EXIT_FAILURE;
+    } // if
+
+    // building blocks
+    SamLineBuffer xBuffer;
+    for( size_t uiI = 0; uiI < vReads.size( ); uiI++ )
+    {
+        auto pRead = vReads[ uiI ];
+        xBuffer.startRead( );
+        for( size_t uiRep = 0; uiRep < 4; uiRep++ )
+        {
+            nucSeqIndex uiFrom = std::rand( ) % pRead->length( );
+            nucSeqIndex uiTo = uiFrom + std::rand( ) % ( pRead->length( ) - uiFrom + 1 );
+            for( bool bRevComp : {false, true} )
+            {
+                xBuffer.sLines.clear( );
+                xBuffer.appendSeq( *pRead, uiFrom, uiTo, bRevComp );
+                if( xBuffer.sLines !=
+                    ( bRevComp ? pRead->fromToComplement( uiFrom, uiTo ) : pRead->fromTo( uiFrom, uiTo ) ) )
+                {
+                    std::cerr << "SEQ differs for " << pRead->sName << std::endl;
+                    return EXIT_FAILURE;
+                } // if
+            } // for
+            xBuffer.sLines.clear( );
+            xBuffer.appendQual( *pRead, uiFrom, uiTo );
+            if( xBuffer.sLines != pRead->fromToQual( uiFrom, uiTo ) )
+            {
+                std::cerr << "QUAL differs for " << pRead->sName << std::endl;
+                return EXIT_FAILURE;
+            } // if
+        } // for
+        for( auto pAlignment : *vAlignments[ uiI ] )
+            for( bool bSoftClip : {false, true} )
+                for( bool bMCigar : {false, true} )
+                {
+                    std::string sCigar;
+                    appendCigar( sCigar, *pAlignment, *pPack, pRead->length( ), bSoftClip, bMCigar );
+                    if( sCigar != ( bMCigar ? pAlignment->cigarStringWithMInsteadOfXandEqual(
+                                                  *pPack, pRead->length( ), bSoftClip )
+                                            : pAlignment->cigarString( *pPack, pRead->length( ), bSoftClip ) ) )
+                    {
+                        std::cerr << "CIGAR differs for " << pRead->sName << std::endl;
+                        return EXIT_FAILURE;
+                    } // if
+                } // for
+    } // for
+
+    // complete records
+    for( bool bSoftClip : {false, true} )
+        for( bool bMCigar : {false, true} )
+        {
+            ParameterSetManager xWriterParameters;
+            xWriterParameters.getSelected( )->xSoftClip->set( bSoftClip );
+            xWriterParameters.getSelected( )->xOutputMCigar->set( bMCigar );
+            FileWriter xWriter( xWriterParameters, "stdout", pPack );
+            auto pOut = std::make_shared<StringOutStream>( );
+            xWriter.pOut = pOut;
+
+            std::string sExpected;
+            double dOld = 0, dNew = 0;
+            for( size_t uiRep = 0; uiRep < 5; uiRep++ )
+            {
+                sExpected.clear( );
+                pOut->sContent.clear( );
+                dOld += metaMeasureDuration( [ & ]( ) {
+                            for( size_t uiI = 0; uiI < vReads.size( ); uiI++ )
+                                sExpected += referenceRecords( vReads[ uiI ], vAlignments[ uiI ], pPack, bSoftClip,
+                                                               bMCigar );
+                        } ).count( );
+                dNew += metaMeasureDuration( [ & ]( ) {
+                            for( size_t uiI = 0; uiI < vReads.size( ); uiI++ )
+                                xWriter.execute( vReads[ uiI ], vAlignments[ uiI ], pPack );
+                        } ).count( );
+            } // for
+            if( pOut->sContent != sExpected )
+            {
+                std::cerr << "records differ with soft clip = " << bSoftClip << " and M cigar = " << bMCigar
+                          << std::endl;
+                return EXIT_FAILURE;
+            } // if
+            std::cout << "soft clip = " << bSoftClip << " M cigar = " << bMCigar << ": concatenation " << dOld * 1000
+                      << "ms SamLineBuffer " << dNew * 1000 << "ms" << std::endl;
+        } // for
+
+    // omitting SEQ and QUAL of secondary alignments
+    ParameterSetManager xOmitParameters;
+    xOmitParameters.getSelected( )->xOmitSecondarySeq->set( true );
+    FileWriter xOmitWriter( xOmitParameters, "stdout", pPack );
+    auto pOut = std::make_shared<StringOutStream>( );
+    xOmitWriter.pOut = pOut;
+    std::string sExpected;
+    for( size_t uiI = 0; uiI < vReads.size( ); uiI++ )
+    {
+        xOmitWriter.execute( vReads[ uiI ], vAlignments[ uiI ], pPack );
+        sExpected += referenceRecords( vReads[ uiI ], vAlignments[ uiI ], pPack, false, true );
+    } // for
+    std::stringstream xOmitted( pOut->sContent );
+    std::stringstream xFull( sExpected );
+    std::string sOmitted, sFull;
+    size_t uiNumOmitted = 0;
+    while( std::getline( xOmitted, sOmitted ) )
+    {
+        std::getline( xFull, sFull );
+        auto vOmitted = splitFields( sOmitted );
+        auto vFull = splitFields( sFull );
+        const bool bSecondary = ( std::stoul( vFull[ 1 ] ) & SECONDARY_ALIGNMENT ) != 0;
+        if( bSecondary )
+        {
+            vFull[ 9 ] = "*";
+            vFull[ 10 ] = "*";
+            uiNumOmitted++;
+        } // if
+        if( vOmitted != vFull )
+        {
+            std::cerr << "unexpected record with omitted SEQ: " << sOmitted << std::endl;
+            return EXIT_FAILURE;
+        } // if
+    } // while
+    if( uiNumOmitted != uiNumSecondary )
+    {
+        std::cerr << "omitted the SEQ of " << uiNumOmitted << " records but there are " << uiNumSecondary
+                  << " secondary alignments" << std::endl;
+        return EXIT_FAILURE;
+    } // if
+
+    return EXIT_SUCCESS;
+} /// main function
@@ -0,0 +1,133 @@
+#define EXIT_SUCCESS 0
+#define EXIT_FAILURE 1
+
+#include "ma/module/mateRescue.h"
+#include "ma/module/shardedSeeding.h"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+using namespace libMA;
+
+/*
+ * Checks the sharded FMD-index ("Index Shard Size"):
+ * - the contigs are grouped into shards of the requested size
+ * - shards that are stored and loaded again (copied or memory mapped) match the shards that are computed in memory
+ * - reads from both strands of all contigs are placed at the same positions by the sharded modules as by the
+ *   modules on a single FMD-index
+ */
+
+std::shared_ptr<NucSeq> randomNucSeq( size_t uiLen )
+{
+    auto pRet = std::make_shared<NucSeq>( );
+    pRet->vReserveMemory( uiLen );
+    for( size_t i = 0; i < uiLen; i++ )
+        pRet->push_back( ( uint8_t )( std::rand( ) % 4 ) );
+    return pRet;
+} // function
+
+/// @brief extracts a read of length uiLen starting at uiFrom and adds some mismatches.
+std::shared_ptr<NucSeq> simulateRead( Pack& rPack, nucSeqIndex uiFrom, nucSeqIndex uiLen )
+{
+    auto pRet = rPack.vExtract( uiFrom, uiFrom + uiLen );
+    for( size_t uiI = 0; uiI < pRet->length( ); uiI++ )
+        if( std::rand( ) % 30 == 0 )
+            ( *pRet )[ uiI ] = ( ( *pRet )[ uiI ] + 1 ) % 4;
+    return pRet;
+} // function
+
+int main( void )
+{
+    std::srand( 42 );
+    const uint64_t uiMaxShardSize = 60000;
+    auto pPack = std::make_shared<Pack>( );
+    for( size_t uiI = 0; uiI < 8; uiI++ )
+        pPack->vAppendSequence( "chr" + std::to_string( uiI ), "desc", *randomNucSeq( 20000 + std::rand( ) % 20000 ) );
+    // a contig that is larger than a shard
+    pPack->vAppendSequence( "chr_large", "desc", *randomNucSeq( uiMaxShardSize + 5000 ) );
+
+    // grouping
+    auto vFirstContigs = ShardedFMIndex::groupContigs( *pPack, uiMaxShardSize );
+    for( size_t uiI = 0; uiI < vFirstContigs.size( ); uiI++ )
+    {
+        const size_t uiEnd = uiI + 1 < vFirstContigs.size( ) ? vFirstContigs[ uiI + 1 ] : pPack->uiNumContigs( );
+        const uint64_t uiSize =
+            pPack->endOfSequenceWithId( uiEnd - 1 ) - pPack->startOfSequenceWithId( vFirstContigs[ uiI ] );
+        if( uiSize > uiMaxShardSize && uiEnd - vFirstContigs[ uiI ] > 1 )
+        {
+            std::cerr << "shard " << uiI << " is too large: " << uiSize << std::endl;
+            return EXIT_FAILURE;
+        } // if
+    } // for
+    if( vFirstContigs.size( ) < 4 )
+    {
+        std::cerr << "expected at least 4 shards; got " << vFirstContigs.size( ) << std::endl;
+        return EXIT_FAILURE;
+    } // if
+
+    auto pSharded = std::make_shared<ShardedFMIndex>( *pPack, uiMaxShardSize );
+    auto pFMIndex = std::make_shared<FMIndex>( pPack );
+
+    // store and load
+    const std::string sPrefix = "sharded_index_test";
+    if( ShardedFMIndex::storeShards( *pPack, uiMaxShardSize, sPrefix ) != vFirstContigs )
+    {
+        std::cerr << "stored shards do not match the grouping" << std::endl;
+        return EXIT_FAILURE;
+    } // if
+    auto pLoaded = std::make_shared<ShardedFMIndex>( *pPack, vFirstContigs, sPrefix, false );
+    auto pMapped = std::make_shared<ShardedFMIndex>( *pPack, vFirstContigs, sPrefix );
+
+    ParameterSetManager xParameters;
+    MateRescue xSingle( xParameters );
+    ShardedSeeding xSeeding( xParameters );
+    StripOfConsiderationSeeds xSoC( xParameters );
+    ShardedHarmonization xHarmonization( xParameters );
+    NeedlemanWunsch xDP( xParameters );
+
+    size_t uiNumReads = 0, uiNumEqual = 0;
+    for( size_t uiContig = 0; uiContig < pPack->uiNumContigs( ); uiContig++ )
+        for( bool bForw : { true, false } )
+            for( size_t uiRep = 0; uiRep < 3; uiRep++ )
+            {
+                const nucSeqIndex uiLen = 1000;
+                nucSeqIndex uiFrom = pPack->startOfSequenceWithId( uiContig ) +
+                                     std::rand( ) % ( pPack->lengthOfSequenceWithId( uiContig ) - uiLen );
+                if( !bForw )
+                    uiFrom = pPack->uiPositionToReverseStrand( uiFrom + uiLen ) + 1;
+                auto pRead = simulateRead( *pPack, uiFrom, uiLen );
+
+                auto pSeedsMem = xSeeding.execute( pSharded, pRead, pPack );
+                auto pSeedsLoaded = xSeeding.execute( pLoaded, pRead, pPack );
+                auto pSeedsMapped = xSeeding.execute( pMapped, pRead, pPack );
+                if( pSeedsMem->size( ) != pSeedsLoaded->size( ) || pSeedsMem->size( ) != pSeedsMapped->size( ) )
+                {
+                    std::cerr << "loaded shards deliver different seeds" << std::endl;
+                    return EXIT_FAILURE;
+                } // if
+
+                auto pSharded_ = xDP.execute( xHarmonization.execute( xSoC.execute( pSeedsMem, pRead, pPack ), pRead,
+                                                                      pSharded ),
+                                              pRead, pPack );
+                auto pSingle = xSingle.fullAlignment( pRead, pFMIndex, pPack );
+                uiNumReads++;
+                if( !pSharded_->empty( ) && !pSingle->empty( ) &&
+                    pSharded_->front( )->beginOnRef( ) == pSingle->front( )->beginOnRef( ) &&
+                    pSharded_->front( )->endOnRef( ) == pSingle->front( )->endOnRef( ) )
+                    uiNumEqual++;
+            } // for
+
+    // the mapped shards must be released before their files are removed
+    pMapped.reset( );
+    for( size_t uiI = 0; uiI < vFirstContigs.size( ); uiI++ )
+    {
+        std::remove( ( ShardedFMIndex::shardPrefix( sPrefix, uiI ) + ".bwt" ).c_str( ) );
+        std::remove( ( ShardedFMIndex::shardPrefix( sPrefix, uiI ) + ".sa" ).c_str( ) );
+    } // for
+
+    std::cout << uiNumEqual << " of " << uiNumReads << " reads are placed equally on " << pSharded->numShards( )
+              << " shards and on a single index" << std::endl;
+    if( uiNumEqual < uiNumReads * 95 / 100 )
+        return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+} /// main function
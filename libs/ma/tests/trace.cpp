@@ -0,0 +1,78 @@
+#define EXIT_SUCCESS 0
+#define EXIT_FAILURE 1
+
+#include "ma/container/nucSeq.h"
+#include "ms/module/module.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+using namespace libMA;
+using namespace libMS;
+
+/*
+ * Checks that the Tracer records every module execution of a computational graph if (and only if) it is enabled.
+ */
+
+class ReverseQuery : public Module<NucSeq, false, NucSeq>
+{
+  public:
+    std::shared_ptr<NucSeq> execute( std::shared_ptr<NucSeq> pQuery )
+    {
+        auto pRet = std::make_shared<NucSeq>( *pQuery );
+        pRet->vReverse( );
+        return pRet;
+    } // method
+}; // class
+
+/// @brief executes the graph uiNumTimes with fresh input
+void run( std::shared_ptr<Pledge<NucSeq>> pIn, std::shared_ptr<BasePledge> pOut, size_t uiNumTimes )
+{
+    for( size_t uiI = 0; uiI < uiNumTimes; uiI++ )
+    {
+        pIn->set( std::make_shared<NucSeq>( "ACGTACGT" ) );
+        pOut->getAsBaseType( );
+    } // for
+} // function
+
+int main( void )
+{
+    auto pIn = std::make_shared<Pledge<NucSeq>>( );
+    auto pOut = promiseMe( std::make_shared<ReverseQuery>( ), pIn );
+
+    run( pIn, pOut, 10 ); // not recorded
+    Tracer::enable( );
+    run( pIn, pOut, 100 );
+    Tracer::disable( );
+    run( pIn, pOut, 10 ); // not recorded
+
+    auto vHistograms = Tracer::histograms( );
+    if( vHistograms.size( ) != 1 || vHistograms[ 0 ].second.uiCount != 100 ||
+        vHistograms[ 0 ].first.find( "ReverseQuery" ) == std::string::npos )
+    {
+        std::cerr << "unexpected histograms:" << std::endl << Tracer::summary( ) << std::endl;
+        return EXIT_FAILURE;
+    } // if
+    std::cout << Tracer::summary( );
+
+    const std::string sFileName = "trace_test.json";
+    Tracer::writeChromeTrace( sFileName );
+    size_t uiNumEvents = 0;
+    {
+        std::ifstream xIn( sFileName );
+        for( std::string sLine; std::getline( xIn, sLine ); )
+            uiNumEvents += sLine.find( "\"ph\": \"X\"" ) != std::string::npos ? 1 : 0;
+    } // scope for xIn
+    std::remove( sFileName.c_str( ) );
+    if( uiNumEvents != 100 )
+    {
+        std::cerr << "expected 100 events in the chrome trace but found " << uiNumEvents << std::endl;
+        return EXIT_FAILURE;
+    } // if
+
+    Tracer::clear( );
+    if( !Tracer::histograms( ).empty( ) )
+        return EXIT_FAILURE;
+
+    return EXIT_SUCCESS;
+} /// main function
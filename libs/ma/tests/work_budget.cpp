@@ -0,0 +1,143 @@
+#define EXIT_SUCCESS 0
+#define EXIT_FAILURE 1
+
+#include "ma/module/fileWriter.h"
+#include "ma/module/mateRescue.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+using namespace libMA;
+
+/*
+ * Checks the per read work budgets:
+ * A read must be given up (and reported unmapped with the ZB tag) if and only if the work that is spent on it without
+ * budget exceeds the budget. Reads within the budget must be aligned exactly as without budget.
+ */
+
+std::shared_ptr<NucSeq> randomNucSeq( size_t uiLen )
+{
+    auto pRet = std::make_shared<NucSeq>( );
+    pRet->vReserveMemory( uiLen );
+    for( size_t i = 0; i < uiLen; i++ )
+        pRet->push_back( ( uint8_t )( std::rand( ) % 4 ) );
+    return pRet;
+} // function
+
+/// @brief extracts a read of length uiLen and adds some mismatches and small indels.
+std::shared_ptr<NucSeq> simulateRead( Pack& rPack, nucSeqIndex uiLen )
+{
+    nucSeqIndex uiFrom = std::rand( ) % ( rPack.uiUnpackedSizeForwardStrand - uiLen );
+    auto pRef = rPack.vExtract( uiFrom, uiFrom + uiLen );
+    auto pRet = std::make_shared<NucSeq>( );
+    for( size_t uiI = 0; uiI < pRef->length( ); uiI++ )
+    {
+        if( std::rand( ) % 30 == 0 ) // deletion
+            continue;
+        if( std::rand( ) % 30 == 0 ) // insertion
+            pRet->push_back( ( uint8_t )( std::rand( ) % 4 ) );
+        if( std::rand( ) % 20 == 0 ) // mismatch
+            pRet->push_back( ( ( *pRef )[ uiI ] + 1 ) % 4 );
+        else
+            pRet->push_back( ( *pRef )[ uiI ] );
+    } // for
+    pRet->sName = "read";
+    return pRet;
+} // function
+
+/// @brief collects the output of a FileWriter
+class StringOutStream : public OutStream
+{
+  public:
+    std::string sContent;
+
+    StringOutStream& operator<<( const std::string& s )
+    {
+        sContent += s;
+        return *this;
+    } // function
+}; // class
+
+int main( void )
+{
+    std::srand( 42 );
+    auto pPack = std::make_shared<Pack>( );
+    pPack->vAppendSequence( "chr1", "chr1-desc", *randomNucSeq( 200000 ) );
+    auto pFMIndex = std::make_shared<FMIndex>( pPack );
+
+    std::vector<std::shared_ptr<NucSeq>> vReads;
+    for( size_t uiI = 0; uiI < 50; uiI++ )
+        vReads.push_back( simulateRead( *pPack, 500 + std::rand( ) % 2000 ) );
+
+    // align without budget
+    ParameterSetManager xParameters;
+    MateRescue xUnlimited( xParameters );
+    std::vector<std::shared_ptr<libMS::ContainerVector<std::shared_ptr<Alignment>>>> vUnlimited;
+    std::vector<uint64_t> vSeeds, vCells;
+    for( auto pRead : vReads )
+    {
+        auto pCopy = std::make_shared<NucSeq>( *pRead );
+        vUnlimited.push_back( xUnlimited.fullAlignment( pCopy, pFMIndex, pPack ) );
+        if( pCopy->bOverBudget || vUnlimited.back( )->empty( ) )
+        {
+            std::cerr << "read not aligned without budget" << std::endl;
+            return EXIT_FAILURE;
+        } // if
+        vSeeds.push_back( pCopy->uiSeedsProcessed );
+        vCells.push_back( pCopy->uiDPCells );
+    } // for
+
+    // use the medians as budgets so that roughly half of the reads exceed them
+    std::vector<uint64_t> vSortedSeeds = vSeeds, vSortedCells = vCells;
+    std::sort( vSortedSeeds.begin( ), vSortedSeeds.end( ) );
+    std::sort( vSortedCells.begin( ), vSortedCells.end( ) );
+    for( bool bSeedBudget : { true, false } )
+    {
+        ParameterSetManager xBudgetParameters;
+        const uint64_t uiBudget = bSeedBudget ? vSortedSeeds[ vReads.size( ) / 2 ] : vSortedCells[ vReads.size( ) / 2 ];
+        if( bSeedBudget )
+            xBudgetParameters.getSelected( )->xSeedBudgetPerRead->set( uiBudget );
+        else
+            xBudgetParameters.getSelected( )->xDPCellBudgetPerRead->set( uiBudget );
+        MateRescue xLimited( xBudgetParameters );
+        FileWriter xWriter( xBudgetParameters, "stdout", pPack );
+        auto pOut = std::make_shared<StringOutStream>( );
+        xWriter.pOut = pOut;
+
+        size_t uiNumOverBudget = 0;
+        for( size_t uiI = 0; uiI < vReads.size( ); uiI++ )
+        {
+            auto pCopy = std::make_shared<NucSeq>( *vReads[ uiI ] );
+            pCopy->sName = "read";
+            auto pAlignments = xLimited.fullAlignment( pCopy, pFMIndex, pPack );
+            const bool bExpectOverBudget = ( bSeedBudget ? vSeeds[ uiI ] : vCells[ uiI ] ) > uiBudget;
+            if( pCopy->bOverBudget != bExpectOverBudget || pAlignments->empty( ) != bExpectOverBudget )
+            {
+                std::cerr << ( bSeedBudget ? "seed" : "DP cell" ) << " budget: read " << uiI
+                          << " is not treated according to its budget" << std::endl;
+                return EXIT_FAILURE;
+            } // if
+            auto pExpected = vUnlimited[ uiI ];
+            if( !bExpectOverBudget && ( pAlignments->front( )->beginOnRef( ) != pExpected->front( )->beginOnRef( ) ||
+                                        pAlignments->front( )->score( ) != pExpected->front( )->score( ) ) )
+            {
+                std::cerr << "read " << uiI << " is aligned differently within its budget" << std::endl;
+                return EXIT_FAILURE;
+            } // if
+            pOut->sContent.clear( );
+            xWriter.execute( pCopy, pAlignments, pPack );
+            if( ( pOut->sContent.find( "\tZB:Z:budget" ) != std::string::npos ) != bExpectOverBudget )
+            {
+                std::cerr << "read " << uiI << " has an unexpected sam line: " << pOut->sContent << std::endl;
+                return EXIT_FAILURE;
+            } // if
+            uiNumOverBudget += bExpectOverBudget ? 1 : 0;
+        } // for
+        std::cout << ( bSeedBudget ? "seed" : "DP cell" ) << " budget " << uiBudget << ": " << uiNumOverBudget
+                  << " of " << vReads.size( ) << " reads given up." << std::endl;
+        if( uiNumOverBudget == 0 )
+            return EXIT_FAILURE;
+    } // for
+
+    return EXIT_SUCCESS;
+} /// main function
@@ -273,6 +273,23 @@ mm128_t* collect_seeds( const mm_idx_t* mi, int n_segs, const int* qlens, const
                         const mm_mapopt_t* opt, const char* qname, int64_t* n_a,
                         void ( *mm_filter )( mm128_t*, size_t&, void* ), void* pFilterArg );
 
+/** *
+ * by markus: collect_seeds for many (single segment) queries at once.
+ * The minimizers of all queries are looked up in one pass that prefetches the hash table slots of upcoming minimizers.
+ *
+ * @param mi         minimap2 index
+ * @param n_reads    num of query sequences
+ * @param qlens      lengths of the query sequences
+ * @param seqs       the query sequences
+ * @param b          thread-local buffer; two mm_map() calls shall not use one buffer at the same time!
+ * @param opt        mapping parameters
+ * @param mm_consume called with ( query id, seeds a, length of a, pConsumeArg ) for each query in order;
+ *                   a is allocated from b->km and must be kfree'd by mm_consume (NULL for empty queries)
+ */
+void collect_seeds_batch( const mm_idx_t* mi, int n_reads, const int* qlens, const char** seqs, mm_tbuf_t* b,
+                          const mm_mapopt_t* opt, void ( *mm_filter )( mm128_t*, size_t&, void* ), void* pFilterArg,
+                          void ( *mm_consume )( int, mm128_t*, int64_t, void* ), void* pConsumeArg );
+
 #ifdef __cplusplus
 }
 #endif
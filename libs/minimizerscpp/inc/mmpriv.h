@@ -65,6 +65,8 @@ void mm_sketch( void* km, const char* str, int len, int w, int k, uint32_t rid,
 
 
 const uint64_t* mm_idx_get( const mm_idx_t* mi, uint64_t minier, int* n );
+// markus: prefetches the hash table slot of minier (so that a later mm_idx_get does not stall)
+void mm_idx_prefetch( const mm_idx_t* mi, uint64_t minier );
 int32_t mm_idx_cal_max_occ( const mm_idx_t* mi, float f );
 mm128_t* mm_chain_dp( int max_dist_x, int max_dist_y, int bw, int max_skip, int min_cnt, int min_sc, int is_cdna,
                       int n_segs, int64_t n, mm128_t* a, int* n_u_, uint64_t** _u, void* km );
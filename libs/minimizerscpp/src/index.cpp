@@ -101,6 +101,21 @@ const uint64_t* mm_idx_get( const mm_idx_t* mi, uint64_t minier, int* n )
     }
 }
 
+void mm_idx_prefetch( const mm_idx_t* mi, uint64_t minier )
+{
+#ifdef __GNUC__
+    int mask = ( 1 << mi->b ) - 1;
+    const idxhash_t* h = (const idxhash_t*)mi->B[ minier & mask ].h;
+    if( h == 0 || h->n_buckets == 0 )
+        return;
+    // first slot that kh_get probes for this minimizer
+    khint_t i = (khint_t)idx_hash( minier >> mi->b << 1 ) & ( h->n_buckets - 1 );
+    __builtin_prefetch( &h->flags[ i >> 4 ] );
+    __builtin_prefetch( &h->keys[ i ] );
+    __builtin_prefetch( &h->vals[ i ] );
+#endif
+}
+
 void mm_idx_stat( const mm_idx_t* mi )
 {
     int n = 0, n1 = 0;
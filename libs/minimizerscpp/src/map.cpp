@@ -83,14 +83,48 @@ typedef struct
     const uint64_t* cr;
 } mm_match_t;
 
+/*
+ * by markus: result of an index lookup
+ */
+typedef struct
+{
+    const uint64_t* cr;
+    int n;
+} mm_lookup_t;
+
+// by markus: distance (in minimizers) of the prefetch during the index lookups
+#define MM_PREFETCH_DIST 16
+
+/**
+ * by markus
+ * Looks up the minimizers a[0, n) in the index.
+ * The hash table slots of upcoming minimizers are prefetched, as are the position arrays of found minimizers,
+ * so that the lookups do not stall on DRAM one after the other.
+ */
+static void lookup_minimizers( const mm_idx_t* mi, size_t n, const mm128_t* a, mm_lookup_t* l )
+{
+    for( size_t i = 0; i < n; ++i )
+    {
+        if( i + MM_PREFETCH_DIST < n )
+            mm_idx_prefetch( mi, a[ i + MM_PREFETCH_DIST ].x >> 8 );
+        l[ i ].cr = mm_idx_get( mi, a[ i ].x >> 8, &l[ i ].n );
+#ifdef __GNUC__
+        if( l[ i ].n > 1 )
+            __builtin_prefetch( l[ i ].cr );
+#endif
+    }
+}
+
 size_t uiXSkipped = 0;
 size_t uiXRetrived = 0;
 /**
  *
  * @param rep_len returns the number of nucleotides that are not covered by minimizers
+ * @param l       results of lookup_minimizers for mv (by markus); if NULL the lookups are performed here
  */
 static mm_match_t* collect_matches( void* km, int* _n_m, int max_occ, const mm_idx_t* mi, const mm128_v* mv,
-                                    int64_t* n_a, int* rep_len, int* n_mini_pos, uint64_t** mini_pos )
+                                    int64_t* n_a, int* rep_len, int* n_mini_pos, uint64_t** mini_pos,
+                                    const mm_lookup_t* l )
 {
     int rep_st = 0;
     int rep_en = 0;
@@ -108,7 +142,14 @@ static mm_match_t* collect_matches( void* km, int* _n_m, int max_occ, const mm_i
         mm128_t* p = &mv->a[ i ];
         uint32_t q_pos = (uint32_t)p->y, q_span = p->x & 0xff;
         int t;
-        cr = mm_idx_get( mi, p->x >> 8, &t );
+        if( l != NULL )
+            cr = l[ i ].cr, t = l[ i ].n;
+        else
+        {
+            if( i + MM_PREFETCH_DIST < mv->n )
+                mm_idx_prefetch( mi, mv->a[ i + MM_PREFETCH_DIST ].x >> 8 );
+            cr = mm_idx_get( mi, p->x >> 8, &t );
+        }
         // fprintf(stdout, "t: %d max_occ: %d\n", t, max_occ);
         if( t >= max_occ )
         {
@@ -340,14 +381,14 @@ static inline int skip_seed( int flag, uint64_t r, const mm_match_t* q, const ch
 
 static mm128_t* collect_seed_hits_heap( void* km, const mm_mapopt_t* opt, int max_occ, const mm_idx_t* mi,
                                         const char* qname, const mm128_v* mv, int qlen, int64_t* n_a, int* rep_len,
-                                        int* n_mini_pos, uint64_t** mini_pos )
+                                        int* n_mini_pos, uint64_t** mini_pos, const mm_lookup_t* l )
 {
     int i, n_m, heap_size = 0;
     int64_t j, n_for = 0, n_rev = 0;
     mm_match_t* m;
     mm128_t *a, *heap;
 
-    m = collect_matches( km, &n_m, max_occ, mi, mv, n_a, rep_len, n_mini_pos, mini_pos );
+    m = collect_matches( km, &n_m, max_occ, mi, mv, n_a, rep_len, n_mini_pos, mini_pos, l );
 
     heap = (mm128_t*)kmalloc( km, n_m * sizeof( mm128_t ) );
     a = (mm128_t*)kmalloc( km, *n_a * sizeof( mm128_t ) );
@@ -421,12 +462,12 @@ static mm128_t* collect_seed_hits_heap( void* km, const mm_mapopt_t* opt, int ma
 
 static mm128_t* collect_seed_hits( void* km, const mm_mapopt_t* opt, int max_occ, const mm_idx_t* mi, const char* qname,
                                    const mm128_v* mv, int qlen, int64_t* n_a, int* rep_len, int* n_mini_pos,
-                                   uint64_t** mini_pos )
+                                   uint64_t** mini_pos, const mm_lookup_t* l )
 {
     int i, n_m;
     mm_match_t* m;
     mm128_t* a;
-    m = collect_matches( km, &n_m, max_occ, mi, mv, n_a, rep_len, n_mini_pos, mini_pos );
+    m = collect_matches( km, &n_m, max_occ, mi, mv, n_a, rep_len, n_mini_pos, mini_pos, l );
     a = (mm128_t*)kmalloc( km, *n_a * sizeof( mm128_t ) ); // result vector holding seeds
     for( i = 0, *n_a = 0; i < n_m; ++i )
     {
@@ -490,10 +531,10 @@ mm128_t* collect_seeds( const mm_idx_t* mi, int n_segs, const int* qlens, const
     // fprintf(stderr, "n=%lu m=%lu\n", mv.n, mv.m);
     if( opt->flag & MM_F_HEAP_SORT )
         a = collect_seed_hits_heap( b->km, opt, opt->mid_occ, mi, qname, &mv, qlen_sum, n_a, &rep_len, &n_mini_pos,
-                                    &mini_pos );
+                                    &mini_pos, NULL );
     else
         a = collect_seed_hits( b->km, opt, opt->mid_occ, mi, qname, &mv, qlen_sum, n_a, &rep_len, &n_mini_pos,
-                               &mini_pos );
+                               &mini_pos, NULL );
 #if 0
     if(rep_len != 0)
         fprintf( stderr, "RS\t%d\n", rep_len );
@@ -508,3 +549,62 @@ mm128_t* collect_seeds( const mm_idx_t* mi, int n_segs, const int* qlens, const
     kfree( b->km, mini_pos );
     return a;
 }
+
+/**
+ * by markus
+ */
+void collect_seeds_batch( const mm_idx_t* mi, int n_reads, const int* qlens, const char** seqs, mm_tbuf_t* b,
+                          const mm_mapopt_t* opt, void ( *mm_filter )( mm128_t*, size_t&, void* ), void* pFilterArg,
+                          void ( *mm_consume )( int, mm128_t*, int64_t, void* ), void* pConsumeArg )
+{
+    int r, rep_len, n_mini_pos;
+    uint64_t* mini_pos;
+    mm128_v mv = {0, 0, 0};
+    size_t* offs = (size_t*)kmalloc( b->km, ( n_reads + 1 ) * sizeof( size_t ) );
+
+    // sketch all reads into one minimizer array
+    for( r = 0; r < n_reads; ++r )
+    {
+        size_t n = mv.n;
+        offs[ r ] = n;
+        if( qlens[ r ] == 0 )
+            continue;
+        mm_sketch( b->km, seqs[ r ], qlens[ r ], mi->w, mi->k, 0, mi->flag & MM_I_HPC, &mv );
+
+        // let mm_filter filter the last mv.n - n minimizers in the array mv.a
+        mv.n -= n;
+        ( *mm_filter )( &mv.a[ n ], mv.n, pFilterArg );
+        mv.n += n;
+
+        if( opt->sdust_thres > 0 ) // mask low-complexity minimizers
+            mv.n = n + mm_dust_minier( b->km, mv.n - n, mv.a + n, qlens[ r ], seqs[ r ], opt->sdust_thres );
+    }
+    offs[ n_reads ] = mv.n;
+
+    // look up the minimizers of all reads at once (so that the prefetching does not stop at read boundaries)
+    mm_lookup_t* l = (mm_lookup_t*)kmalloc( b->km, ( mv.n + 1 ) * sizeof( mm_lookup_t ) );
+    lookup_minimizers( mi, mv.n, mv.a, l );
+
+    // turn the lookups into seeds read by read
+    // (each seed array is consumed right away, so that the arena does not fill up with the arrays of all reads)
+    for( r = 0; r < n_reads; ++r )
+    {
+        mm128_v mv_r = {offs[ r + 1 ] - offs[ r ], offs[ r + 1 ] - offs[ r ], mv.a + offs[ r ]};
+        mm128_t* a = NULL;
+        int64_t n_a = 0;
+        if( qlens[ r ] > 0 )
+        {
+            if( opt->flag & MM_F_HEAP_SORT )
+                a = collect_seed_hits_heap( b->km, opt, opt->mid_occ, mi, 0, &mv_r, qlens[ r ], &n_a, &rep_len,
+                                            &n_mini_pos, &mini_pos, l + offs[ r ] );
+            else
+                a = collect_seed_hits( b->km, opt, opt->mid_occ, mi, 0, &mv_r, qlens[ r ], &n_a, &rep_len,
+                                       &n_mini_pos, &mini_pos, l + offs[ r ] );
+            kfree( b->km, mini_pos );
+        }
+        ( *mm_consume )( r, a, n_a, pConsumeArg );
+    }
+    kfree( b->km, l );
+    kfree( b->km, offs );
+    kfree( b->km, mv.a );
+}
@@ -7,12 +7,14 @@
 #define MODULE_H
 
 #include "ms/container/container.h"
+#include "ms/module/trace.h"
 #include "ms/util/export.h"
 #include "ms/util/parameter.h"
 #include "util/threadPool.h"
 
 /// @cond DOXYGEN_SHOW_SYSTEM_INCLUDES
 #include <algorithm>
+#include <atomic>
 #include <bitset>
 #include <chrono>
 #include <ctime>
@@ -116,6 +118,16 @@ template <typename TP_RETURN_, bool IS_VOLATILE_, typename... TP_ARGUMENTS> clas
         return false;
     } // method
 
+    /**
+     * @brief true for modules that are implemented in python.
+     * @details
+     * These have to hold the GIL while executing, so they are executed by one graph thread at a time.
+     */
+    virtual bool isPythonModule( ) const
+    {
+        return false;
+    } // method
+
     /* Clang requires a virtual destructor for classes comprising virtual methods */
     virtual ~Module( )
     {} // destructor
@@ -218,15 +230,24 @@ class BasePledge
 #ifdef USE_DLL_EXPORT
     __declspec(dllexport) static const size_t uiDefaultGraphThread;
     __declspec(dllexport) static size_t uiThreadCurrentlyBuildingGraph;
+    __declspec(dllexport) static std::atomic<int64_t> iGilWaitNanoSec;
 #else
     __declspec(dllimport) static const size_t uiDefaultGraphThread;
     __declspec(dllimport) static size_t uiThreadCurrentlyBuildingGraph;
+    __declspec(dllimport) static std::atomic<int64_t> iGilWaitNanoSec;
 #endif
 #else
       static const size_t uiDefaultGraphThread;
       static size_t uiThreadCurrentlyBuildingGraph;
+      // total time that python modules waited for the GIL (see ModuleWrapperPyToCpp)
+      static std::atomic<int64_t> iGilWaitNanoSec;
 #endif
 
+    /**
+     * @brief warn if python modules waited for the GIL for more than this fraction of the runtime of all graph threads
+     */
+    static constexpr double dGilWaitWarningFraction = 0.05;
+
     /**
      * @brief Reset the pledge
      */
@@ -257,6 +278,12 @@ class BasePledge
         return false;
     } // method
 
+    virtual bool hasPythonPledger( ) const
+    {
+        throw std::runtime_error( type_name( this ) + " did not implement hasPythonPledger" );
+        return false;
+    } // method
+
     /**
      * @brief Gets the given pledges simultaneously.
      * @details
@@ -274,20 +301,21 @@ class BasePledge
             numThreads = (unsigned int)( vPledges.size( ) );
 
         /*
-         * If there is a python module in the comp. graph we can only use one single thread.
-         * This is due to a limitation in the Python interpreter. There can only ever be one
-         * active Python thread.
-         * So, here we check if there is such a module and set the number of threads to one if
-         * necessary. @todo
+         * The C++ modules run without the GIL (the python bindings release it before calling into the graph).
+         * Python modules reacquire the GIL while they execute, so there is only ever one active python module.
+         * We keep all threads nevertheless, but measure how long the python modules waited for the GIL,
+         * so that we can warn if they turned into a serialization point.
          */
-        // if( numThreads > 1 )
-        //     for( std::shared_ptr<BasePledge> pPledge : vPledges )
-        //         if( pPledge->hasPythonPledger( ) )
-        //         {
-        //             numThreads = 1;
-        //             DEBUG( std::cout << "Detected python module. Cannot use more than one thread." << std::endl; )
-        //             break;
-        //         } // if
+        bool bHasPythonModule = false;
+        if( numThreads > 1 )
+            for( std::shared_ptr<BasePledge> pPledge : vPledges )
+                if( pPledge->hasPythonPledger( ) )
+                {
+                    bHasPythonModule = true;
+                    break;
+                } // if
+        const int64_t iGilWaitNanoSecBefore = iGilWaitNanoSec.load( );
+        const auto xStartTime = std::chrono::steady_clock::now( );
 
         std::mutex xExceptionMutex;
         std::string sExceptionMessageFromWorker;
@@ -370,6 +398,17 @@ class BasePledge
             // wait for the pool to finish it's work
         } // scope xPool
 
+        if( bHasPythonModule )
+        {
+            const std::chrono::duration<double> xDuration = std::chrono::steady_clock::now( ) - xStartTime;
+            const double dGilWait = ( iGilWaitNanoSec.load( ) - iGilWaitNanoSecBefore ) / 1e9;
+            if( dGilWait > dGilWaitWarningFraction * xDuration.count( ) * numThreads )
+                std::cerr << "WARNING: the python modules in the computational graph waited " << dGilWait
+                          << " seconds for the GIL (" << numThreads << " threads ran for " << xDuration.count( )
+                          << " seconds). They serialize the graph threads; consider implementing them in C++."
+                          << std::endl;
+        } // if
+
         if( !sExceptionMessageFromWorker.empty( ) )
         {
             std::cerr << "Throw exception" << std::endl;
@@ -436,6 +475,8 @@ template <class TP_TYPE, bool IS_VOLATILE = false, typename... TP_DEPENDENCIES>
 
   protected:
     std::shared_ptr<TP_PLEDGER> pPledger;
+    // name of pPledger for the Tracer
+    uint32_t uiTraceNameId = 0;
     // all pledges that have this pledge as predecessor
     std::vector<BasePledge*> vSuccessors;
     std::set<size_t> vThreadsAccessing;
@@ -518,6 +559,19 @@ template <class TP_TYPE, bool IS_VOLATILE = false, typename... TP_DEPENDENCIES>
         } // operator
     }; // struct
 
+    /**
+     * @brief calls the hasPythonPledger function of the predecessor IDX.
+     * @details
+     * Can be used with template loops.
+     */
+    template <size_t IDX> struct NonPythonCaller
+    {
+        bool operator( )( const TP_PREDECESSORS& tPredecessors )
+        {
+            return !std::get<IDX>( tPredecessors )->hasPythonPledger( );
+        } // operator
+    }; // struct
+
     /**
      * @brief calls the addSuccessor function of the predecessor IDX.
      * @details
@@ -583,7 +637,10 @@ template <class TP_TYPE, bool IS_VOLATILE = false, typename... TP_DEPENDENCIES>
      * This means that this Pledge can be automatically fullfilled by the given module.
      */
     Pledge( std::shared_ptr<TP_PLEDGER> pPledger, std::shared_ptr<TP_DEPENDENCIES>... tPredecessors )
-        : pPledger( pPledger ), tPredecessors( tPredecessors... ), pMutex( new std::mutex )
+        : pPledger( pPledger ),
+          uiTraceNameId( Tracer::nameId( type_name( pPledger, true ) ) ),
+          tPredecessors( tPredecessors... ),
+          pMutex( new std::mutex )
     {
         // create a variable so that we can take a reference of it.
         Pledge* pThis = this;
@@ -664,6 +721,17 @@ template <class TP_TYPE, bool IS_VOLATILE = false, typename... TP_DEPENDENCIES>
         return !TemplateLoop<sizeof...( TP_DEPENDENCIES ), NonVolatileCaller>::iterate( tPredecessors );
     } // method
 
+    /**
+     * @brief checks wether there is a module implemented in python upstream in the comp. graph.
+     */
+    virtual bool hasPythonPledger( ) const
+    {
+        if( pPledger != nullptr && pPledger->isPythonModule( ) )
+            return true;
+        // see hasVolatile for the double negation
+        return !TemplateLoop<sizeof...( TP_DEPENDENCIES ), NonPythonCaller>::iterate( tPredecessors );
+    } // method
+
     /**
      * @brief Get the promised container.
      * @details
@@ -696,6 +764,8 @@ template <class TP_TYPE, bool IS_VOLATILE = false, typename... TP_DEPENDENCIES>
             decltype( pContent ) pRet = nullptr;
 
             auto timeStamp = std::chrono::system_clock::now( );
+            // negative if tracing is disabled
+            const int64_t iTraceStart = Tracer::isEnabled( ) ? Tracer::now( ) : -1;
 
             // actually execute the module
             pRet = pPledger->executeTup( tInput );
@@ -707,6 +777,8 @@ template <class TP_TYPE, bool IS_VOLATILE = false, typename... TP_DEPENDENCIES>
             std::chrono::duration<double> duration = std::chrono::system_clock::now( ) - timeStamp;
             // increase the total executing time for this pledge
             xExecTime += duration;
+            if( iTraceStart >= 0 )
+                Tracer::record( uiTraceNameId, iTraceStart, Tracer::now( ) );
 
             // safety check
             if( pRet == nullptr && !IS_VOLATILE )
@@ -798,11 +870,22 @@ template <bool IS_VOLATILE> class ModuleWrapperPyToCpp : public PyModule<IS_VOLA
      */
     std::shared_ptr<Container> execute( std::shared_ptr<PyContainerVector> pArgs ) override
     {
+        // the graph threads do not hold the GIL (see BasePledge::simultaneousGet); reacquire it for python code
+        const auto xTimeStamp = std::chrono::steady_clock::now( );
+        py::gil_scoped_acquire xGil;
+        BasePledge::iGilWaitNanoSec += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                           std::chrono::steady_clock::now( ) - xTimeStamp )
+                                           .count( );
         PYBIND11_OVERLOAD( PYBIND11_TYPE( std::shared_ptr<Container> ),
                            PYBIND11_TYPE( PyModule<IS_VOLATILE> ),
                            execute,
                            pArgs ); // PYBIND11_OVERLOAD
     } // method
+
+    bool isPythonModule( ) const override
+    {
+        return true;
+    } // method
 }; // class
 #endif
 
@@ -872,6 +955,19 @@ class PyPledgeVector : public Pledge<PyContainerVector>
         return false;
     } // method
 
+    /**
+     * @brief checks wether there is a module implemented in python upstream in the comp. graph.
+     * @details
+     * overrides the base function
+     */
+    virtual bool hasPythonPledger( ) const
+    {
+        for( std::shared_ptr<BasePledge> pPledge : vPledges )
+            if( pPledge->hasPythonPledger( ) )
+                return true;
+        return false;
+    } // method
+
     inline void simultaneousGetPy( unsigned int numThreads = 0 )
     {
         BasePledge::simultaneousGet(
@@ -0,0 +1,163 @@
+/**
+ * @file trace.h
+ * @brief Opt-in recording of module executions: latency histograms and Chrome trace export.
+ */
+#pragma once
+
+#include "ms/util/export.h"
+#include "util/exported.h"
+
+/// @cond DOXYGEN_SHOW_SYSTEM_INCLUDES
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+/// @endcond
+
+namespace libMS
+{
+
+/**
+ * @brief Latency histogram with logarithmic buckets.
+ * @details
+ * Bucket 0 holds all latencies below 1 microsecond;
+ * bucket i > 0 holds the latencies in [2^(i-1), 2^i) microseconds.
+ * The last bucket also holds all larger latencies.
+ */
+class LatencyHistogram
+{
+  public:
+    static const size_t NUM_BUCKETS = 40;
+
+    std::array<uint64_t, NUM_BUCKETS> aBuckets;
+    uint64_t uiCount;
+    /// @brief sum of all latencies in nanoseconds
+    int64_t iTotal;
+    /// @brief largest latency in nanoseconds
+    int64_t iMax;
+
+    LatencyHistogram( ) : aBuckets{ }, uiCount( 0 ), iTotal( 0 ), iMax( 0 )
+    {} // default constructor
+
+    static size_t bucket( int64_t iNanoSeconds )
+    {
+        size_t uiBucket = 0;
+        for( int64_t iMicroSeconds = iNanoSeconds / 1000; iMicroSeconds > 0 && uiBucket + 1 < NUM_BUCKETS;
+             iMicroSeconds >>= 1 )
+            uiBucket++;
+        return uiBucket;
+    } // method
+
+    /// @brief upper bound of the latencies in uiBucket in seconds
+    static double bucketUpperBound( size_t uiBucket )
+    {
+        return ( 1ull << uiBucket ) / 1000000.0;
+    } // method
+
+    inline void add( int64_t iNanoSeconds )
+    {
+        aBuckets[ bucket( iNanoSeconds ) ]++;
+        uiCount++;
+        iTotal += iNanoSeconds;
+        iMax = std::max( iMax, iNanoSeconds );
+    } // method
+
+    void merge( const LatencyHistogram& rOther )
+    {
+        for( size_t uiI = 0; uiI < NUM_BUCKETS; uiI++ )
+            aBuckets[ uiI ] += rOther.aBuckets[ uiI ];
+        uiCount += rOther.uiCount;
+        iTotal += rOther.iTotal;
+        iMax = std::max( iMax, rOther.iMax );
+    } // method
+
+    /// @brief total latency in seconds
+    double total( ) const
+    {
+        return iTotal / 1e9;
+    } // method
+
+    /// @brief largest latency in seconds
+    double max( ) const
+    {
+        return iMax / 1e9;
+    } // method
+
+    /**
+     * @brief approximates the dQ quantile (0 <= dQ <= 1) of the latencies in seconds.
+     * @details
+     * Returns the upper bound of the bucket that contains the quantile (at most the largest latency).
+     */
+    double quantile( double dQ ) const
+    {
+        if( uiCount == 0 )
+            return 0;
+        uint64_t uiRank = (uint64_t)( dQ * ( uiCount - 1 ) );
+        for( size_t uiI = 0; uiI < NUM_BUCKETS; uiI++ )
+        {
+            if( uiRank < aBuckets[ uiI ] )
+                return std::min( bucketUpperBound( uiI ), max( ) );
+            uiRank -= aBuckets[ uiI ];
+        } // for
+        return max( );
+    } // method
+}; // class
+
+/**
+ * @brief Records the executions of the modules in computational graphs.
+ * @details
+ * Tracing is disabled by default; then Pledge::get only checks a flag.
+ * If tracing is enabled, each thread records into its own buffer:
+ * a list of (module, start, end) events and a latency histogram per module.
+ * The buffers are merged only when the histograms are requested or the trace is exported.
+ * Once a thread recorded uiMaxEventsPerThread events, further executions only update the histograms.
+ */
+class DLL_PORT( MS ) Tracer
+{
+  public:
+    /// @brief starts recording; keeps already recorded data
+    static void enable( size_t uiMaxEventsPerThread = 1000000 );
+
+    /// @brief stops recording; keeps already recorded data
+    static void disable( );
+
+    static bool isEnabled( );
+
+    /// @brief removes all recorded data
+    static void clear( );
+
+    /**
+     * @brief id of the module name for record.
+     * @details
+     * Strips the python wrapper from modules that are called via python.
+     */
+    static uint32_t nameId( std::string sModuleName );
+
+    /// @brief nanoseconds since libMS was loaded (steady clock)
+    static int64_t now( );
+
+    /// @brief records one execution of module uiNameId by the calling thread
+    static void record( uint32_t uiNameId, int64_t iStart, int64_t iEnd );
+
+    /// @brief latency histograms of all modules that were executed at least once
+    static std::vector<std::pair<std::string, LatencyHistogram>> histograms( );
+
+    /// @brief table with count, total, mean, median, p99 and max latency per module
+    static std::string summary( );
+
+    /**
+     * @brief writes all recorded events in the Chrome trace event format.
+     * @details
+     * The file can be opened via chrome://tracing or https://ui.perfetto.dev.
+     * Each thread of the computational graph becomes one track.
+     */
+    static void writeChromeTrace( const std::string& sFileName );
+}; // class
+
+} // namespace libMS
+
+#ifdef WITH_PYTHON
+void exportTrace( libMS::SubmoduleOrganizer& xOrganizer );
+#endif
@@ -535,6 +535,9 @@ class Presetting : public ParameterSetBase
     AlignerParameterPointer<double> xMeanPairedReadDistance; // Mean distance of paired reads
     AlignerParameterPointer<double> xStdPairedReadDistance; // Standard deviation of paired reads
     AlignerParameterPointer<double> xPairedBonus; // Score factor for paired reads
+    AlignerParameterPointer<bool> xMateRescue; // Align the second mate in a window around the first one
+    AlignerParameterPointer<double> xMateRescueMinMapQ; // Minimal mapping quality of the first mate for rescue
+    AlignerParameterPointer<double> xMateRescueMinScore; // Minimal relative score of a rescued alignment
 
     // Seeding options:
     AlignerParameterPointer<AlignerParameterBase::ChoicesType> xSeedingTechnique; // Seeding Technique
@@ -550,6 +553,8 @@ class Presetting : public ParameterSetBase
     AlignerParameterPointer<int> xMinNumSoC; // Min Number SoCs
     AlignerParameterPointer<int> xSoCWidth; // Fixed SoC Width
     AlignerParameterPointer<bool> xRectangularSoc; // Rectangular SoC
+    AlignerParameterPointer<int> xSoCThreads; // SoC Threads
+    AlignerParameterPointer<int> xMinQueryLenSoCThreads; // Min Query Length for SoC Threads
 
     // SAM Options:
     AlignerParameterPointer<int> xReportN; // Maximal number of Reported alignments
@@ -562,6 +567,7 @@ class Presetting : public ParameterSetBase
     AlignerParameterPointer<bool> xOutputMCigar; // Output M symbol in cigar
     AlignerParameterPointer<bool> xCGTag; // Output long CIGARS in CG tag
     AlignerParameterPointer<bool> xSoftClip; // use soft clipping in alignments
+    AlignerParameterPointer<bool> xOmitSecondarySeq; // output '*' as SEQ and QUAL of secondary alignments
 
     // SV caller options
     // @todo depre start
@@ -600,6 +606,8 @@ class Presetting : public ParameterSetBase
     AlignerParameterPointer<int> xMaxGapArea; //
     AlignerParameterPointer<int> xGenomeSizeDisable; //
     AlignerParameterPointer<bool> xDisableHeuristics; //
+    AlignerParameterPointer<uint64_t> xSeedBudgetPerRead; // Seed Budget Per Read
+    AlignerParameterPointer<uint64_t> xDPCellBudgetPerRead; // DP Cell Budget Per Read
 
     // Minimizer parameters:
     AlignerParameterPointer<short> xMinimizerK;
@@ -666,6 +674,19 @@ class Presetting : public ParameterSetBase
                         "the computation of the mapping quality and for picking optimal alignment pairs. <val> < 1 "
                         "results in penalty; <val> > 1 results in bonus.",
                         PAIRED_PARAMETERS, 1.25, checkPositiveDoubleValue ),
+          xMateRescue( this, "Mate Rescue",
+                       "If the first mate has a confident alignment, the second mate is aligned within a window of "
+                       "mean + 3 * (standard deviation) around it, instead of seeding it on the whole genome. "
+                       "Full seeding is used as fallback, if the rescue fails.",
+                       PAIRED_PARAMETERS, false ),
+          xMateRescueMinMapQ( this, "Mate Rescue Minimal Mapping Quality",
+                              "Mate rescue is attempted only if the mapping quality of the first mate is at least "
+                              "<val>.",
+                              PAIRED_PARAMETERS, 0.5, checkPositiveDoubleValue ),
+          xMateRescueMinScore( this, "Mate Rescue Minimal Score",
+                               "A rescued alignment is accepted only if its score is at least <val> * (maximal "
+                               "possible score for the mate). Otherwise the mate is seeded on the whole genome.",
+                               PAIRED_PARAMETERS, 0.5, checkPositiveDoubleValue ),
 
           // Seeding:
           xSeedingTechnique( this, "Seeding Technique", 's',
@@ -716,6 +737,13 @@ class Presetting : public ParameterSetBase
                            "Is the SoC Rectangular shape or parallelogram shape. A rectangular shape can help with "
                            "finding inversions, but struggles more with seed-noise.",
                            SOC_PARAMETERS, true ),
+          xSoCThreads( this, "SoC Threads",
+                       "Number of threads that harmonize and align the SoCs of a single read concurrently. The "
+                       "threads are shared by all reads. 0 = process the SoCs of a read sequentially.",
+                       SOC_PARAMETERS, 0, checkPositiveValue ),
+          xMinQueryLenSoCThreads( this, "Min Query Length for SoC Threads",
+                                  "The SoCs of queries shorter than <val> are always processed sequentially.",
+                                  SOC_PARAMETERS, 10000, checkPositiveValue ),
 
           // SAM
           xReportN( this, "Maximal Number of Reported Alignments", 'n',
@@ -752,6 +780,10 @@ class Presetting : public ParameterSetBase
                      "Output the full query for each alignment, instead of omitting the sequence before and after the "
                      "alignment.",
                      SAM_PARAMETERS, false ),
+          xOmitSecondarySeq( this, "Omit SEQ of Secondary Alignments",
+                             "Output '*' instead of the query sequence and quality for secondary alignments. This is "
+                             "allowed by the SAM specification and reduces the size of the output file.",
+                             SAM_PARAMETERS, false ),
 
           // SV
           xMaxDeltaDistanceInCLuster( this, "Maximal distance between clusters",
@@ -878,6 +910,14 @@ class Presetting : public ParameterSetBase
           xDisableHeuristics( this, "Disable All Heuristics",
                               "Disables all runtime heuristics. (For debugging purposes)", HEURISTIC_PARAMETERS,
                               false ),
+          xSeedBudgetPerRead( this, "Seed Budget Per Read",
+                              "Reads for which the SoC and harmonization modules process more than <val> seeds are "
+                              "given up and reported unmapped with the tag ZB:Z:budget. 0 = unlimited.",
+                              HEURISTIC_PARAMETERS, 0 ),
+          xDPCellBudgetPerRead( this, "DP Cell Budget Per Read",
+                                "Reads for which the dynamic programming computes more than <val> cells are given up "
+                                "and reported unmapped with the tag ZB:Z:budget. 0 = unlimited.",
+                                HEURISTIC_PARAMETERS, 0 ),
           xMinimizerK( this, "Minimizers - k", "Sequence size of minimizers", MINIMIZER_PARAMETERS, 15 ),
           xMinimizerW( this, "Minimizers - w", "Window size of minimizers", MINIMIZER_PARAMETERS, 10 ),
           xMinimizerFlag( this, "Minimizers - flag", "Flags for minimizers", MINIMIZER_PARAMETERS, 0 ),
@@ -888,6 +928,13 @@ class Presetting : public ParameterSetBase
         xMeanPairedReadDistance->fEnabled = [ this ]( void ) { return this->xUsePairedReads->get( ) == true; };
         xStdPairedReadDistance->fEnabled = [ this ]( void ) { return this->xUsePairedReads->get( ) == true; };
         xPairedBonus->fEnabled = [ this ]( void ) { return this->xUsePairedReads->get( ) == true; };
+        xMateRescue->fEnabled = [ this ]( void ) { return this->xUsePairedReads->get( ) == true; };
+        xMateRescueMinMapQ->fEnabled = [ this ]( void ) {
+            return this->xUsePairedReads->get( ) == true && this->xMateRescue->get( ) == true;
+        };
+        xMateRescueMinScore->fEnabled = [ this ]( void ) {
+            return this->xUsePairedReads->get( ) == true && this->xMateRescue->get( ) == true;
+        };
         xZDropInversion->fEnabled = [ this ]( void ) { return this->xSearchInversions->get( ) == true; };
     } // constructor
 
@@ -941,6 +988,13 @@ class GeneralParameter : public ParameterSetBase
     AlignerParameterPointer<fs::path> xSAMOutputFileName; // folder path
     AlignerParameterPointer<bool> pbUseMaxHardareConcurrency; // Exploit all cores
     AlignerParameterPointer<int> piNumberOfThreads; // selected number of threads
+    AlignerParameterPointer<int> piReadWindowSize; // number of reads that are sorted by length before aligning
+    AlignerParameterPointer<bool> pbRestoreReadOrder; // write the alignments in the order of the reads
+    AlignerParameterPointer<uint64_t> piIndexShardSize; // maximal number of nucleotides per FMD-index shard
+    AlignerParameterPointer<bool> pbMapIndex; // memory map pack and FMD-index instead of reading them
+    AlignerParameterPointer<bool> pbIndexHugePages; // back the index arrays by huge pages
+    AlignerParameterPointer<bool> pbInterleaveIndex; // interleave the index arrays over all NUMA nodes
+    AlignerParameterPointer<uint64_t> piAlignmentCacheSize; // number of reads whose alignments are reused
     AlignerParameterPointer<bool> pbPrintHelpMessage; // Print the help message to stdout
 
     /* Constructor */
@@ -963,6 +1017,42 @@ class GeneralParameter : public ParameterSetBase
                              "Number of threads used in the context of alignments. This options is only available, if "
                              "'use all processor cores' is off.",
                              GENERAL_PARAMETER, 1, checkPositiveValue ),
+          piReadWindowSize( this, "Read Window Size",
+                            "Read <val> reads of an input file ahead and align them from the longest to the shortest "
+                            "one. This balances the work of the threads for reads of mixed lengths. Not used for "
+                            "paired reads. Set to zero in order to align the reads in file order.",
+                            GENERAL_PARAMETER, 0, checkPositiveValue ),
+          pbRestoreReadOrder( this, "Restore Read Order",
+                              "Write the alignments of each input file in the order of its reads. Otherwise, the "
+                              "alignments are written in the order in which the threads finish them.",
+                              GENERAL_PARAMETER, false ),
+          piIndexShardSize( this, "Index Shard Size",
+                            "Split the FMD-index into shards of whole contigs with at most <val> nucleotides each. "
+                            "Only one shard is held in memory during index creation. Sharded indices are memory mapped "
+                            "when aligning (see 'Map Index'). Must be set before --Create_Index. Sharded indices do "
+                            "not support paired reads. 0 = a single index.",
+                            GENERAL_PARAMETER, 0 ),
+          pbMapIndex( this, "Map Index",
+                      "Map the pack and FMD-index files into memory read-only instead of reading them. All processes "
+                      "on a node that use the same genome then share one copy of it and start without loading the "
+                      "index. Must be set before --Index.",
+                      GENERAL_PARAMETER, false ),
+          pbIndexHugePages( this, "Index Huge Pages",
+                            "Back the BWT, suffix array and packed sequence by transparent huge pages. This reduces "
+                            "the TLB misses of the random index accesses. Not used for mapped indices. Must be set "
+                            "before --Index.",
+                            GENERAL_PARAMETER, false ),
+          pbInterleaveIndex( this, "Interleave Index",
+                             "Interleave the pages of the BWT, suffix array and packed sequence over all NUMA nodes, "
+                             "so that all threads see the same memory latency on multi-socket machines. Not used for "
+                             "mapped indices. Must be set before --Index.",
+                             GENERAL_PARAMETER, false ),
+          piAlignmentCacheSize( this, "Alignment Cache Size",
+                                "Keep the alignments of the last <val> distinct read sequences and reuse them for "
+                                "reads with an identical sequence instead of aligning them again. Speeds up amplicon "
+                                "and high duplicate libraries. Not used for sharded indices; with mate rescue only the "
+                                "first mate is cached. 0 = no cache.",
+                                GENERAL_PARAMETER, 0 ),
           pbPrintHelpMessage( this, "Help", 'h', "Print the complete help text.", GENERAL_PARAMETER, false )
     {
         xSAMOutputPath->fEnabled = [ this ]( void ) { return this->xSAMOutputTypeChoice->uiSelection == 1; };
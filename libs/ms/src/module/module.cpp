@@ -9,15 +9,23 @@ using namespace libMS;
 #ifdef _MSC_VER
 __declspec(dllexport) const size_t BasePledge::uiDefaultGraphThread = 0;
 __declspec(dllexport) size_t BasePledge::uiThreadCurrentlyBuildingGraph = uiDefaultGraphThread;
+__declspec(dllexport) std::atomic<int64_t> BasePledge::iGilWaitNanoSec( 0 );
 #else
 const size_t BasePledge::uiDefaultGraphThread = 0;
 size_t BasePledge::uiThreadCurrentlyBuildingGraph = uiDefaultGraphThread;
+std::atomic<int64_t> BasePledge::iGilWaitNanoSec( 0 );
 #endif
 
 #ifdef WITH_PYTHON
 
 void exportModuleClass( SubmoduleOrganizer& xOrganizer )
 {
+    /*
+     * All functions that execute the comp. graph release the GIL, so that the C++ modules run in parallel.
+     * Python modules reacquire it (see ModuleWrapperPyToCpp).
+     */
+    typedef py::call_guard<py::gil_scoped_release> TP_NO_GIL;
+
     /*
      * Module and VolatileModule can be extended by python and execute can be overloaded
      * HOWEVER: the default constructor of Module and VolatileModule MUST be calles otherwise the programm segfaults
@@ -39,9 +47,9 @@ void exportModuleClass( SubmoduleOrganizer& xOrganizer )
     py::class_<PyPledgeVector, std::shared_ptr<PyPledgeVector>>( xOrganizer.util( ), "VectorPledge" )
         .def( py::init<>( ) ) // default constructor
         .def( "append", &PyPledgeVector::append )
-        .def( "get", &PyPledgeVector::get )
+        .def( "get", &PyPledgeVector::get, TP_NO_GIL( ) )
         .def( "clear", &PyPledgeVector::clear )
-        .def( "simultaneous_get", &PyPledgeVector::simultaneousGetPy );
+        .def( "simultaneous_get", &PyPledgeVector::simultaneousGetPy, TP_NO_GIL( ) );
 
     py::implicitly_convertible<PyPledgeVector, BasePledge>( );
 
@@ -50,7 +58,7 @@ void exportModuleClass( SubmoduleOrganizer& xOrganizer )
     py::class_<TP_MODULE_PLEDGE, BasePledge, std::shared_ptr<TP_MODULE_PLEDGE>>( xOrganizer._util( ), "ModulePledge" )
         .def( py::init<std::shared_ptr<PyModule<false>>, std::shared_ptr<PyPledgeVector>>( ) )
         .def( "exec_time", &TP_MODULE_PLEDGE::execTime )
-        .def( "get", &TP_MODULE_PLEDGE::get );
+        .def( "get", &TP_MODULE_PLEDGE::get, TP_NO_GIL( ) );
 
     py::implicitly_convertible<TP_MODULE_PLEDGE, BasePledge>( );
 
@@ -60,7 +68,7 @@ void exportModuleClass( SubmoduleOrganizer& xOrganizer )
                                                                                      "VolatileModulePledge" )
         .def( py::init<std::shared_ptr<PyModule<true>>, std::shared_ptr<PyPledgeVector>>( ) )
         .def( "exec_time", &TP_VOLATILE_PLEDGE::execTime )
-        .def( "get", &TP_VOLATILE_PLEDGE::get );
+        .def( "get", &TP_VOLATILE_PLEDGE::get, TP_NO_GIL( ) );
 
     py::implicitly_convertible<TP_VOLATILE_PLEDGE, BasePledge>( );
 
@@ -71,7 +79,7 @@ void exportModuleClass( SubmoduleOrganizer& xOrganizer )
         .def( "exec_time", &TP_PLEDGE::execTime )
         .def( "wait_on_lock_time", &TP_PLEDGE::waitTime )
         .def( "set", &TP_PLEDGE::set )
-        .def( "get", &TP_PLEDGE::get );
+        .def( "get", &TP_PLEDGE::get, TP_NO_GIL( ) );
     py::implicitly_convertible<TP_PLEDGE, BasePledge>( );
 
 #if 0 // @todo needs it's own class that holds a python object
@@ -0,0 +1,245 @@
+/**
+ * @file trace.cpp
+ */
+#include "ms/module/trace.h"
+
+/// @cond DOXYGEN_SHOW_SYSTEM_INCLUDES
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+/// @endcond
+
+using namespace libMS;
+
+namespace
+{
+/// @brief one execution of a module; times in nanoseconds (Tracer::now)
+struct TraceEvent
+{
+    uint32_t uiNameId;
+    int64_t iStart;
+    int64_t iEnd;
+}; // struct
+
+/**
+ * @brief the recorded data of a single thread.
+ * @details
+ * Only the owning thread records into the buffer; xMutex is therefore (almost) never contended.
+ * It protects the buffer from concurrent reads via Tracer::histograms and Tracer::writeChromeTrace.
+ */
+struct ThreadBuffer
+{
+    std::mutex xMutex;
+    const uint32_t uiThreadId;
+    const uint64_t uiGeneration;
+    std::vector<TraceEvent> vEvents;
+    /// @brief latency histogram for each name id
+    std::vector<LatencyHistogram> vHistograms;
+
+    ThreadBuffer( uint32_t uiThreadId, uint64_t uiGeneration ) : uiThreadId( uiThreadId ), uiGeneration( uiGeneration )
+    {} // constructor
+}; // struct
+
+std::atomic<bool> bTraceEnabled( false );
+std::atomic<size_t> uiMaxEventsPerThread( 1000000 );
+/// @brief incremented by clear; buffers of older generations are not used for recording any more
+std::atomic<uint64_t> uiCurrentGeneration( 0 );
+const std::chrono::steady_clock::time_point xEpoch = std::chrono::steady_clock::now( );
+
+/// @brief protects vBuffers, vNames and xNameIds
+std::mutex xGlobalMutex;
+std::vector<std::shared_ptr<ThreadBuffer>> vBuffers;
+std::vector<std::string> vNames;
+std::map<std::string, uint32_t> xNameIds;
+
+thread_local std::shared_ptr<ThreadBuffer> pThreadBuffer;
+
+ThreadBuffer& threadBuffer( )
+{
+    const uint64_t uiGeneration = uiCurrentGeneration.load( );
+    if( pThreadBuffer == nullptr || pThreadBuffer->uiGeneration != uiGeneration )
+    {
+        std::lock_guard<std::mutex> xGuard( xGlobalMutex );
+        pThreadBuffer = std::make_shared<ThreadBuffer>( (uint32_t)vBuffers.size( ), uiGeneration );
+        vBuffers.push_back( pThreadBuffer );
+    } // if
+    return *pThreadBuffer;
+} // function
+
+/// @brief escapes a string for json
+std::string jsonString( const std::string& sIn )
+{
+    std::string sOut = "\"";
+    for( char c : sIn )
+    {
+        if( c == '"' || c == '\\' )
+            sOut += '\\';
+        sOut += c;
+    } // for
+    return sOut + "\"";
+} // function
+} // namespace
+
+void Tracer::enable( size_t uiMaxEvents )
+{
+    uiMaxEventsPerThread = uiMaxEvents;
+    bTraceEnabled = true;
+} // method
+
+void Tracer::disable( )
+{
+    bTraceEnabled = false;
+} // method
+
+bool Tracer::isEnabled( )
+{
+    return bTraceEnabled.load( std::memory_order_relaxed );
+} // method
+
+void Tracer::clear( )
+{
+    std::lock_guard<std::mutex> xGuard( xGlobalMutex );
+    // threads that still hold a buffer of the previous generation replace it with their next record call
+    uiCurrentGeneration++;
+    vBuffers.clear( );
+} // method
+
+uint32_t Tracer::nameId( std::string sModuleName )
+{
+    // modules that are called via python are wrapped: ModuleWrapperCppToPy<Module, Parameters...>
+    const std::string sWrapper = "libMS::ModuleWrapperCppToPy<";
+    if( sModuleName.compare( 0, sWrapper.size( ), sWrapper ) == 0 )
+    {
+        size_t uiEnd = sWrapper.size( );
+        for( int iDepth = 0; uiEnd < sModuleName.size( ); uiEnd++ )
+        {
+            if( sModuleName[ uiEnd ] == '<' )
+                iDepth++;
+            else if( sModuleName[ uiEnd ] == '>' )
+                iDepth--;
+            if( iDepth == 0 && ( sModuleName[ uiEnd ] == ',' || sModuleName[ uiEnd ] == '>' ) )
+                break;
+        } // for
+        sModuleName = sModuleName.substr( sWrapper.size( ), uiEnd - sWrapper.size( ) );
+    } // if
+
+    std::lock_guard<std::mutex> xGuard( xGlobalMutex );
+    auto xEmplaced = xNameIds.emplace( sModuleName, (uint32_t)vNames.size( ) );
+    if( xEmplaced.second )
+        vNames.push_back( sModuleName );
+    return xEmplaced.first->second;
+} // method
+
+int64_t Tracer::now( )
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now( ) - xEpoch )
+        .count( );
+} // method
+
+void Tracer::record( uint32_t uiNameId, int64_t iStart, int64_t iEnd )
+{
+    ThreadBuffer& rBuffer = threadBuffer( );
+    std::lock_guard<std::mutex> xGuard( rBuffer.xMutex );
+    if( rBuffer.vHistograms.size( ) <= uiNameId )
+        rBuffer.vHistograms.resize( uiNameId + 1 );
+    rBuffer.vHistograms[ uiNameId ].add( iEnd - iStart );
+    if( rBuffer.vEvents.size( ) < uiMaxEventsPerThread.load( std::memory_order_relaxed ) )
+        rBuffer.vEvents.push_back( TraceEvent{ uiNameId, iStart, iEnd } );
+} // method
+
+std::vector<std::pair<std::string, LatencyHistogram>> Tracer::histograms( )
+{
+    std::lock_guard<std::mutex> xGuard( xGlobalMutex );
+    std::vector<LatencyHistogram> vMerged( vNames.size( ) );
+    for( auto pBuffer : vBuffers )
+    {
+        std::lock_guard<std::mutex> xBufferGuard( pBuffer->xMutex );
+        for( size_t uiI = 0; uiI < pBuffer->vHistograms.size( ); uiI++ )
+            vMerged[ uiI ].merge( pBuffer->vHistograms[ uiI ] );
+    } // for
+    std::vector<std::pair<std::string, LatencyHistogram>> vRet;
+    for( size_t uiI = 0; uiI < vMerged.size( ); uiI++ )
+        if( vMerged[ uiI ].uiCount > 0 )
+            vRet.emplace_back( vNames[ uiI ], vMerged[ uiI ] );
+    return vRet;
+} // method
+
+std::string Tracer::summary( )
+{
+    auto vHistograms = histograms( );
+    size_t uiNameWidth = 6;
+    for( auto& rPair : vHistograms )
+        uiNameWidth = std::max( uiNameWidth, rPair.first.size( ) );
+
+    std::stringstream xStream;
+    xStream << std::left << std::setw( uiNameWidth ) << "module" << std::right << std::setw( 12 ) << "count"
+            << std::setw( 12 ) << "total [s]" << std::setw( 12 ) << "mean [ms]" << std::setw( 12 ) << "p50 [ms]"
+            << std::setw( 12 ) << "p99 [ms]" << std::setw( 12 ) << "max [ms]" << std::endl;
+    xStream << std::fixed;
+    for( auto& rPair : vHistograms )
+        xStream << std::left << std::setw( uiNameWidth ) << rPair.first << std::right << std::setw( 12 )
+                << rPair.second.uiCount << std::setw( 12 ) << std::setprecision( 3 ) << rPair.second.total( )
+                << std::setw( 12 ) << rPair.second.total( ) * 1000 / rPair.second.uiCount << std::setw( 12 )
+                << rPair.second.quantile( 0.5 ) * 1000 << std::setw( 12 ) << rPair.second.quantile( 0.99 ) * 1000
+                << std::setw( 12 ) << rPair.second.max( ) * 1000 << std::endl;
+    return xStream.str( );
+} // method
+
+void Tracer::writeChromeTrace( const std::string& sFileName )
+{
+    std::ofstream xOut( sFileName );
+    if( !xOut.is_open( ) )
+        throw std::runtime_error( "could not open " + sFileName + " for writing" );
+
+    std::lock_guard<std::mutex> xGuard( xGlobalMutex );
+    // complete events ("ph": "X") with timestamps and durations in microseconds
+    xOut << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [" << std::endl;
+    xOut << std::fixed << std::setprecision( 3 );
+    bool bFirst = true;
+    for( auto pBuffer : vBuffers )
+    {
+        std::lock_guard<std::mutex> xBufferGuard( pBuffer->xMutex );
+        for( const TraceEvent& rEvent : pBuffer->vEvents )
+        {
+            if( !bFirst )
+                xOut << "," << std::endl;
+            bFirst = false;
+            xOut << "{\"name\": " << jsonString( vNames[ rEvent.uiNameId ] ) << ", \"ph\": \"X\", \"pid\": 0, \"tid\": "
+                 << pBuffer->uiThreadId << ", \"ts\": " << rEvent.iStart / 1000.0
+                 << ", \"dur\": " << ( rEvent.iEnd - rEvent.iStart ) / 1000.0 << "}";
+        } // for
+    } // for
+    xOut << std::endl << "]}" << std::endl;
+    if( xOut.fail( ) )
+        throw std::runtime_error( "could not write " + sFileName );
+} // method
+
+#ifdef WITH_PYTHON
+#include <pybind11/stl.h>
+
+void exportTrace( SubmoduleOrganizer& xOrganizer )
+{
+    py::class_<LatencyHistogram>( xOrganizer.util( ), "LatencyHistogram" )
+        .def_readonly( "buckets", &LatencyHistogram::aBuckets )
+        .def_readonly( "count", &LatencyHistogram::uiCount )
+        .def_static( "bucket_upper_bound", &LatencyHistogram::bucketUpperBound )
+        .def( "total", &LatencyHistogram::total )
+        .def( "max", &LatencyHistogram::max )
+        .def( "quantile", &LatencyHistogram::quantile );
+
+    py::class_<Tracer>( xOrganizer.util( ), "Tracer" )
+        .def_static( "enable", &Tracer::enable, py::arg( "max_events_per_thread" ) = 1000000 )
+        .def_static( "disable", &Tracer::disable )
+        .def_static( "is_enabled", &Tracer::isEnabled )
+        .def_static( "clear", &Tracer::clear )
+        .def_static( "histograms", &Tracer::histograms )
+        .def_static( "summary", &Tracer::summary )
+        .def_static( "write_chrome_trace", &Tracer::writeChromeTrace );
+} // function
+#endif
@@ -98,6 +98,7 @@ PYBIND11_MODULE( libMS, libMsModule )
     exportParameter( xOrganizer );
     exportContainer( xOrganizer );
     exportModuleClass( xOrganizer );
+    exportTrace( xOrganizer );
 #ifdef WITH_DB
     exportPoolContainer( xOrganizer );
 #endif
@@ -50,6 +50,8 @@ class SvJump : public libMS::Container
     nucSeqIndex uiNumSupportingNt;
     int64_t iId;
     int64_t iReadId;
+    /// @brief number of reads that support this jump; > 1 for jumps merged by CompactingJumpInserterContainer
+    uint32_t uiNumReads;
 
 
 #if DEBUG_LEVEL > 0
@@ -66,7 +68,8 @@ class SvJump : public libMS::Container
           bToForward( rOther.bToForward ),
           uiNumSupportingNt( rOther.uiNumSupportingNt ),
           iId( rOther.iId ),
-          iReadId( rOther.iReadId )
+          iReadId( rOther.iReadId ),
+          uiNumReads( rOther.uiNumReads )
     {}
 
     /**
@@ -83,7 +86,8 @@ class SvJump : public libMS::Container
             const bool bWasMirrored,
             const nucSeqIndex uiNumSupportingNt,
             int64_t iId = -1, /* -1 == no id obtained */
-            int64_t iReadId = -1 /* -1 == no id obtained */ )
+            int64_t iReadId = -1, /* -1 == no id obtained */
+            uint32_t uiNumReads = 1 )
         : bWasMirrored( bWasMirrored ),
           uiFrom( uiFrom ),
           uiTo( uiTo ),
@@ -93,7 +97,8 @@ class SvJump : public libMS::Container
           bToForward( bToForward ),
           uiNumSupportingNt( uiNumSupportingNt ),
           iId( iId ),
-          iReadId( iReadId )
+          iReadId( iReadId ),
+          uiNumReads( uiNumReads )
     {
         assert( uiQueryFrom <= uiQueryTo );
         // necessary for mapping switch strand jumps rightwards
@@ -119,7 +124,8 @@ class SvJump : public libMS::Container
           bToForward( bWasMirrored ? !bFromForward : bToForward ),
           uiNumSupportingNt( uiNumSupportingNt ),
           iId( iId ),
-          iReadId( iReadId )
+          iReadId( iReadId ),
+          uiNumReads( 1 )
     {
         assert( uiQueryFrom <= uiQueryTo );
         // necessary for mapping switch strand jumps rightwards
@@ -381,7 +387,7 @@ inline std::ostream& operator<<( std::ostream& os, const SvJump& rJ )
     os << "bWasMirrored= " << rJ.bWasMirrored << " uiFrom= " << rJ.uiFrom << " uiTo= " << rJ.uiTo
        << " uiQueryFrom= " << rJ.uiQueryFrom << " uiQueryTo= " << rJ.uiQueryTo << " bFromForward= " << rJ.bFromForward
        << " bToForward= " << rJ.bToForward << " uiNumSupportingNt= " << rJ.uiNumSupportingNt << " iId= " << rJ.iId
-       << " iReadId= " << rJ.iReadId;
+       << " iReadId= " << rJ.iReadId << " uiNumReads= " << rJ.uiNumReads;
     return os;
 }
 
@@ -560,7 +566,7 @@ class SvCall : public libMS::Container, public geom::Rectangle<nucSeqIndex>
                   pJump->to_size( ),
                   pJump->bFromForward,
                   pJump->bToForward,
-                  1,
+                  pJump->uiNumReads,
                   pJump->uiNumSupportingNt,
                   std::vector<int64_t>{ pJump->iId },
                   -1,
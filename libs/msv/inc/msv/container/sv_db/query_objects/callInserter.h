@@ -90,9 +90,13 @@ class SvCallInserterContainerTmpl : public BulkOrNot<DBCon, AbstractInserterCont
             rCall.bMirrored, // mirrored
             xRectangle );
         rCall.iId = iCallId;
-        for( int64_t iId : rCall.vSupportingJumpIds )
+        // jumps merged by a CompactingJumpInserterContainer occur once per read; link them only once
+        std::vector<int64_t> vJumpIds( rCall.vSupportingJumpIds );
+        std::sort( vJumpIds.begin( ), vJumpIds.end( ) );
+        vJumpIds.erase( std::unique( vJumpIds.begin( ), vJumpIds.end( ) ), vJumpIds.end( ) );
+        for( int64_t iId : vJumpIds )
             pSupportInserter->insert( iCallId, iId );
-        return 1 + rCall.vSupportingJumpIds.size( );
+        return 1 + vJumpIds.size( );
     } // method
   protected:
     virtual size_t insert_override( std::shared_ptr<SvCall> pCall )
@@ -108,10 +112,16 @@ class SvCallInserterContainerTmpl : public BulkOrNot<DBCon, AbstractInserterCont
         return uiTotal;
     } // method
   public:
+    /// @brief flushes the inserters and marks the calls of the run as changed (see SvCallVersionTable)
     virtual void close( std::shared_ptr<PoolContainer<DBCon>> pPool )
     {
         pSupportInserter.reset( );
+        const int iConId = ParentType::iConnectionId;
+        const int64_t iRunId = ParentType::iId;
         ParentType::close( pPool );
+        pPool->xPool.run( iConId, [ iRunId ]( auto pConnection ) {
+            SvCallVersionTable<DBCon>( pConnection ).bump( iRunId );
+        } );
     } // method
 }; // class
 
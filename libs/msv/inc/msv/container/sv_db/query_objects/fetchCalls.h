@@ -8,7 +8,9 @@
 #include "ms/util/parameter.h"
 #include "msv/container/sv_db/tables/svCall.h"
 #include "msv/container/sv_db/tables/svCallSupport.h"
+#include "msv/util/callSetEvaluation.h"
 #include <bitset>
+#include <thread>
 
 namespace libMSV
 {
@@ -30,6 +32,8 @@ template <typename DBCon> class SvCallsFromDb
     SQLQuery<typename DBCon::SlaveType, uint32_t, uint32_t, uint32_t, uint32_t, bool, bool, bool, uint32_t,
              PriKeyDefaultType, PriKeyDefaultType>
         xQuerySupport;
+    SQLQuery<DBCon, PriKeyDefaultType, uint32_t, uint32_t, uint32_t, uint32_t, bool, bool, double>
+        xQueryEvaluationCalls;
 
     enum ConfigFlags
     {
@@ -89,7 +93,10 @@ template <typename DBCon> class SvCallsFromDb
                 ( !xConfiguration[ ConfigFlags::ExcludeSpecificID ] ? "" : "AND id != ? " ) + //
                 ( !xConfiguration[ ConfigFlags::MinQueryDist ]
                       ? ""
-                      : "AND ? <= (SELECT AVG(sv_jump_table.query_to - sv_jump_table.query_from) "
+                      // weighted by the number of reads of merged jumps (see CompactingJumpInserterContainer)
+                      : "AND ? <= (SELECT SUM( ( sv_jump_table.query_to - sv_jump_table.query_from ) * "
+                        "                      sv_jump_table.num_reads ) / "
+                        "                 SUM( sv_jump_table.num_reads * 1.0 ) "
                         "          FROM sv_jump_table "
                         "          JOIN sv_call_support_table ON sv_call_support_table.jump_id = sv_jump_table.id "
                         "          WHERE sv_call_support_table.call_id = inner_table.id "
@@ -181,12 +188,25 @@ template <typename DBCon> class SvCallsFromDb
         : pConnection( pConnection ),
           pSvCallTable( std::make_shared<SvCallTable<DBCon>>( pConnection ) ),
           pSvCallSupportTable( std::make_shared<SvCallSupportTable<DBCon>>( pConnection ) ),
+          // the second part fetches the additional reads of merged jumps (see CompactingJumpInserterContainer)
           xQuerySupport( pConnection->getSlave( ),
                          "SELECT from_pos, to_pos, query_from, query_to, from_forward, to_forward, was_mirrored, "
                          "       num_supporting_nt, sv_jump_table.id, read_id "
                          "FROM sv_call_support_table "
                          "JOIN sv_jump_table ON sv_call_support_table.jump_id = sv_jump_table.id "
-                         "WHERE sv_call_support_table.call_id = ? " )
+                         "WHERE sv_call_support_table.call_id = ? "
+                         "UNION ALL "
+                         "SELECT from_pos, to_pos, sv_jump_read_table.query_from, sv_jump_read_table.query_to, "
+                         "       from_forward, to_forward, was_mirrored, sv_jump_read_table.num_supporting_nt, "
+                         "       sv_jump_table.id, sv_jump_read_table.read_id "
+                         "FROM sv_call_support_table "
+                         "JOIN sv_jump_table ON sv_call_support_table.jump_id = sv_jump_table.id "
+                         "JOIN sv_jump_read_table ON sv_jump_read_table.jump_id = sv_jump_table.id "
+                         "WHERE sv_call_support_table.call_id = ? " ),
+          xQueryEvaluationCalls( pConnection,
+                                 "SELECT id, from_pos, to_pos, from_size, to_size, from_forward, to_forward, score "
+                                 "FROM sv_call_table "
+                                 "WHERE sv_caller_run_id = ? " )
     {}
 
     void initFetchQuery( int64_t iSvCallerIdA, int64_t iX, int64_t iY, int64_t iW, int64_t iH,
@@ -316,7 +336,7 @@ template <typename DBCon> class SvCallsFromDb
 
         if( bWithSupport )
         {
-            xQuerySupport.execAndFetch( std::get<0>( xTup ) );
+            xQuerySupport.execAndFetch( std::get<0>( xTup ), std::get<0>( xTup ) );
             while( !xQuerySupport.eof( ) )
             {
                 auto xTup = xQuerySupport.get( );
@@ -382,8 +402,9 @@ ORDER BY data_score DESC
     */
 
     // pair(list(tuple(x, calls with score > x, true positives with score > x)), |gt|)
+    // computed via the correlated subqueries above; slow, kept for cross checking libMSV::SvCallsFromDb::count
     std::pair<std::vector<std::tuple<double, uint32_t, uint32_t>>, uint32_t>
-    count( int64_t iSvCallerIdA, int64_t iSvCallerIdB, int64_t iAllowedDist )
+    countViaSql( int64_t iSvCallerIdA, int64_t iSvCallerIdB, int64_t iAllowedDist )
     {
         std::vector<std::tuple<double, uint32_t, uint32_t>> vRet;
         std::bitset<ConfigFlags::DUMMY_FOR_COUNT> xConfig;
@@ -412,6 +433,40 @@ ORDER BY data_score DESC
         return std::pair<std::vector<std::tuple<double, uint32_t, uint32_t>>, uint32_t>( vRet, uiNumGT );
     } // method
 
+    /// @brief fetches all calls of the given caller run for libMSV::evaluateCallSet
+    std::vector<EvaluationCall> evaluationCalls( int64_t iSvCallerId )
+    {
+        std::vector<EvaluationCall> vRet;
+        xQueryEvaluationCalls.execAndForAll(
+            [ & ]( PriKeyDefaultType iId, uint32_t uiFromPos, uint32_t uiToPos, uint32_t uiFromSize, uint32_t uiToSize,
+                   bool bFromForward, bool bToForward, double dScore ) {
+                vRet.emplace_back( iId, uiFromPos, uiToPos, uiFromSize, uiToSize, bFromForward, bToForward, dScore );
+            },
+            iSvCallerId );
+        return vRet;
+    } // method
+
+    /**
+     * @brief pair(list(tuple(x, calls with score >= x, true positives with score >= x)), |gt|)
+     * @details
+     * Same result as libMSV::SvCallsFromDb::countViaSql, but both call sets are fetched once and matched in memory
+     * (see libMSV::evaluateCallSet).
+     */
+    std::pair<std::vector<std::tuple<double, uint32_t, uint32_t>>, uint32_t>
+    count( int64_t iSvCallerIdA, int64_t iSvCallerIdB, int64_t iAllowedDist, size_t uiNumThreads )
+    {
+        return evaluateCallSet( evaluationCalls( iSvCallerIdA ), evaluationCalls( iSvCallerIdB ), iAllowedDist,
+                                uiNumThreads );
+    } // method
+
+    /// @brief overload that uses one thread per hardware thread
+    std::pair<std::vector<std::tuple<double, uint32_t, uint32_t>>, uint32_t>
+    count( int64_t iSvCallerIdA, int64_t iSvCallerIdB, int64_t iAllowedDist )
+    {
+        return count( iSvCallerIdA, iSvCallerIdB, iAllowedDist,
+                      std::max( (size_t)1, (size_t)std::thread::hardware_concurrency( ) ) );
+    } // method
+
 }; // namespace libMSV
 
 } // namespace libMSV
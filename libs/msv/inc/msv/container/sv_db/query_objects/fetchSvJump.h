@@ -8,7 +8,9 @@
 
 #include "msv/container/svJump.h"
 #include "msv/container/sv_db/tables/svJump.h"
+#include "msv/container/sv_db/tables/svJumpRead.h"
 #include "util/geom.h"
+#include <unordered_map>
 
 namespace libMSV
 {
@@ -31,10 +33,10 @@ template <typename DBCon> class SortedSvJumpFromSql
     std::shared_ptr<SvJumpTable<DBCon>> pSvJumpTable;
 
     SQLQuery<DBCon, int64_t, uint32_t, uint32_t, uint32_t, uint32_t, bool, bool, bool, uint32_t, PriKeyDefaultType,
-             PriKeyDefaultType>
+             PriKeyDefaultType, uint32_t>
         xQueryStart;
     SQLQuery<typename DBCon::SlaveType, int64_t, uint32_t, uint32_t, uint32_t, uint32_t, bool, bool, bool, uint32_t,
-             PriKeyDefaultType, PriKeyDefaultType>
+             PriKeyDefaultType, PriKeyDefaultType, uint32_t>
         xQueryEnd;
 
     /// @brief called from the other constructors of this class only
@@ -53,11 +55,11 @@ template <typename DBCon> class SortedSvJumpFromSql
               pConnection,
               iSvCallerRunId,
               "SELECT sort_pos_start, from_pos, to_pos, query_from, query_to, from_forward, to_forward, "
-              "       was_mirrored, num_supporting_nt, id, read_id "
+              "       was_mirrored, num_supporting_nt, id, read_id, num_reads "
               "FROM sv_jump_table WHERE sv_jump_run_id = ? "
               "ORDER BY sort_pos_start",
               "SELECT sort_pos_end, from_pos, to_pos, query_from, query_to, from_forward, to_forward, "
-              "       was_mirrored, num_supporting_nt, id, read_id "
+              "       was_mirrored, num_supporting_nt, id, read_id, num_reads "
               "FROM sv_jump_table WHERE sv_jump_run_id = ? "
               "ORDER BY sort_pos_end" )
     {
@@ -78,14 +80,14 @@ template <typename DBCon> class SortedSvJumpFromSql
               pConnection,
               iSvCallerRunId,
               "SELECT sort_pos_start, from_pos, to_pos, query_from, query_to, from_forward, to_forward, "
-              "       was_mirrored, num_supporting_nt, id, read_id "
+              "       was_mirrored, num_supporting_nt, id, read_id, num_reads "
               "FROM sv_jump_table "
               "WHERE sv_jump_run_id = ? "
               "AND sort_pos_start >= ? "
               "AND sort_pos_start <= ? "
               "ORDER BY sort_pos_start",
               "SELECT sort_pos_end, from_pos, to_pos, query_from, query_to, from_forward, to_forward, "
-              "      was_mirrored, num_supporting_nt, id, read_id "
+              "      was_mirrored, num_supporting_nt, id, read_id, num_reads "
               "FROM sv_jump_table "
               "WHERE sv_jump_run_id = ? "
               "AND sort_pos_end >= ? "
@@ -131,7 +133,8 @@ template <typename DBCon> class SortedSvJumpFromSql
         xQueryStart.next( );
         return std::make_shared<SvJump>(
             std::get<1>( xTup ), std::get<2>( xTup ), std::get<3>( xTup ), std::get<4>( xTup ), std::get<5>( xTup ),
-            std::get<6>( xTup ), std::get<7>( xTup ), std::get<8>( xTup ), std::get<9>( xTup ), std::get<10>( xTup ) );
+            std::get<6>( xTup ), std::get<7>( xTup ), std::get<8>( xTup ), std::get<9>( xTup ), std::get<10>( xTup ),
+            std::get<11>( xTup ) );
     } // method
 
     /// @brief returns the next end-sorted jump and increases the iterator
@@ -143,7 +146,8 @@ template <typename DBCon> class SortedSvJumpFromSql
         xQueryEnd.next( );
         return std::make_shared<SvJump>(
             std::get<1>( xTup ), std::get<2>( xTup ), std::get<3>( xTup ), std::get<4>( xTup ), std::get<5>( xTup ),
-            std::get<6>( xTup ), std::get<7>( xTup ), std::get<8>( xTup ), std::get<9>( xTup ), std::get<10>( xTup ) );
+            std::get<6>( xTup ), std::get<7>( xTup ), std::get<8>( xTup ), std::get<9>( xTup ), std::get<10>( xTup ),
+            std::get<11>( xTup ) );
     } // method
 }; // class
 
@@ -155,7 +159,7 @@ template <typename DBCon> class SvJumpFromSql
     std::shared_ptr<SvJumpTable<DBCon>> pSvJumpTable;
 
     SQLQuery<DBCon, int64_t, uint32_t, uint32_t, uint32_t, uint32_t, bool, bool, bool, uint32_t, PriKeyDefaultType,
-             PriKeyDefaultType>
+             PriKeyDefaultType, uint32_t>
         xQuery;
 
   public:
@@ -173,7 +177,7 @@ template <typename DBCon> class SvJumpFromSql
           pSvJumpTable( std::make_shared<SvJumpTable<DBCon>>( pConnection ) ),
           xQuery( pConnection,
                   "SELECT sort_pos_start, from_pos, to_pos, query_from, query_to, from_forward, to_forward, "
-                  "       was_mirrored, num_supporting_nt, id, read_id "
+                  "       was_mirrored, num_supporting_nt, id, read_id, num_reads "
                   "FROM sv_jump_table "
                   "WHERE sv_jump_run_id = ? "
                   "AND " ST_INTERSCTS "(rectangle, ST_GeomFromWKB(?, 0)) " )
@@ -188,7 +192,7 @@ template <typename DBCon> class SvJumpFromSql
           pSvJumpTable( std::make_shared<SvJumpTable<DBCon>>( pConnection ) ),
           xQuery( pConnection,
                   "SELECT sort_pos_start, from_pos, to_pos, query_from, query_to, from_forward, to_forward, "
-                  "       was_mirrored, num_supporting_nt, id, read_id "
+                  "       was_mirrored, num_supporting_nt, id, read_id, num_reads "
                   "FROM sv_jump_table "
                   "WHERE sv_jump_run_id = ? "
                   "AND " ST_INTERSCTS "(rectangle, ST_GeomFromWKB(?, 0)) "
@@ -215,11 +219,91 @@ template <typename DBCon> class SvJumpFromSql
         xQuery.next( );
         return std::make_shared<SvJump>(
             std::get<1>( xTup ), std::get<2>( xTup ), std::get<3>( xTup ), std::get<4>( xTup ), std::get<5>( xTup ),
-            std::get<6>( xTup ), std::get<7>( xTup ), std::get<8>( xTup ), std::get<9>( xTup ), std::get<10>( xTup ) );
+            std::get<6>( xTup ), std::get<7>( xTup ), std::get<8>( xTup ), std::get<9>( xTup ), std::get<10>( xTup ),
+            std::get<11>( xTup ) );
     } // method
 
 }; // class
 
+/**
+ * @brief fetches the additional reads of merged jumps (see CompactingJumpInserterContainer) from the DB.
+ * @details
+ * The reads of all merged jumps in a section are fetched with a single query in the constructor, so that expand does
+ * not need to access the DB.
+ */
+template <typename DBCon> class SvJumpReadsFromSql
+{
+    // table object is not used. However its constructor guarantees its existence and the correctness of rows
+    std::shared_ptr<SvJumpReadTable<DBCon>> pSvJumpReadTable;
+
+    // read_id, query_from, query_to, num_supporting_nt
+    typedef std::tuple<PriKeyDefaultType, uint32_t, uint32_t, uint32_t> ReadOfJump;
+    // jump_id -> reads
+    std::unordered_map<int64_t, std::vector<ReadOfJump>> xReadsOfJumps;
+
+  public:
+    /**
+     * @brief fetches the reads of the merged jumps of the given jump run with iS <= sort_pos_start <= iE.
+     * @details
+     * Same section as SortedSvJumpFromSql( pConnection, iSvJumpRunId, iS, iE ).
+     */
+    SvJumpReadsFromSql( std::shared_ptr<DBCon> pConnection, int64_t iSvJumpRunId, int64_t iS, int64_t iE )
+        : pSvJumpReadTable( std::make_shared<SvJumpReadTable<DBCon>>( pConnection ) )
+    {
+        SQLQuery<DBCon, PriKeyDefaultType, PriKeyDefaultType, uint32_t, uint32_t, uint32_t> xQuery(
+            pConnection,
+            "SELECT sv_jump_read_table.jump_id, sv_jump_read_table.read_id, sv_jump_read_table.query_from, "
+            "       sv_jump_read_table.query_to, sv_jump_read_table.num_supporting_nt "
+            "FROM sv_jump_read_table "
+            "JOIN sv_jump_table ON sv_jump_table.id = sv_jump_read_table.jump_id "
+            "WHERE sv_jump_table.sv_jump_run_id = ? "
+            "AND sv_jump_table.sort_pos_start >= ? "
+            "AND sv_jump_table.sort_pos_start <= ? "
+            "AND sv_jump_table.num_reads > 1 " );
+        xQuery.execAndForAll(
+            [ & ]( PriKeyDefaultType iJumpId, PriKeyDefaultType iReadId, uint32_t uiQueryFrom, uint32_t uiQueryTo,
+                   uint32_t uiNumSuppNt ) {
+                xReadsOfJumps[ iJumpId ].emplace_back( iReadId, uiQueryFrom, uiQueryTo, uiNumSuppNt );
+            },
+            iSvJumpRunId, iS, iE );
+    } // constructor
+
+    /**
+     * @brief replaces the merged jumps of rCall by one jump per read
+     * @details
+     * Afterwards, rCall is the same as if it was created from jumps that were not merged.
+     * The jumps of the additional reads keep the id of the merged jump, so vSupportingJumpIds can contain an id
+     * several times.
+     * All jumps of rCall must be in the section given to the constructor.
+     */
+    void expand( SvCall& rCall )
+    {
+        const size_t uiNumJumps = rCall.vSupportingJumps.size( );
+        for( size_t uiI = 0; uiI < uiNumJumps; uiI++ )
+        {
+            std::shared_ptr<SvJump> pJump = rCall.vSupportingJumps[ uiI ];
+            if( pJump->uiNumReads <= 1 )
+                continue;
+            pJump->uiNumReads = 1;
+            auto xIt = xReadsOfJumps.find( pJump->iId );
+            if( xIt == xReadsOfJumps.end( ) )
+                continue;
+            for( auto& xRead : xIt->second )
+            {
+                auto pReadJump = std::make_shared<SvJump>( *pJump );
+                pReadJump->iReadId = std::get<0>( xRead );
+                pReadJump->uiQueryFrom = std::get<1>( xRead );
+                pReadJump->uiQueryTo = std::get<2>( xRead );
+                pReadJump->uiNumSupportingNt = std::get<3>( xRead );
+                rCall.vSupportingJumpIds.push_back( pReadJump->iId );
+                rCall.vSupportingJumps.push_back( pReadJump );
+                rCall.uiSuppNt += pReadJump->uiNumSupportingNt;
+                rCall.addJumpToEstimateClusterSize( pReadJump );
+            } // for
+        } // for
+    } // method
+}; // class
+
 } // namespace libMSV
 
 #ifdef WITH_PYTHON
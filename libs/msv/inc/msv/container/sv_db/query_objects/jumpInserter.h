@@ -1,6 +1,7 @@
 /**
  * @file jumpInserter.h
- * @brief implements libMSV::SvJumpInserter that inserts libMSV::SvJump objects into the DB.
+ * @brief implements libMSV::JumpInserterContainer and libMSV::CompactingJumpInserterContainer that insert
+ * libMSV::SvJump objects into the DB.
  * @author Markus Schmidt
  */
 #pragma once
@@ -9,8 +10,14 @@
 #include "msv/container/svJump.h"
 #include "msv/container/sv_db/tables/nameDesc.h"
 #include "msv/container/sv_db/tables/svJump.h"
+#include "msv/container/sv_db/tables/svJumpRead.h"
 #include "util/geom.h"
 
+/// @cond DOXYGEN_SHOW_SYSTEM_INCLUDES
+#include <map>
+#include <tuple>
+/// @endcond
+
 using namespace libMA;
 using namespace libMS;
 
@@ -39,10 +46,11 @@ class JumpInserterContainer
 #endif
 
   protected:
-    virtual size_t insert_override( std::shared_ptr<ContainerVector<SvJump>> pJumps, std::shared_ptr<NucSeq> pRead )
+    /// @brief sets the read id of all jumps to the id of pRead
+    void setReadIds( ContainerVector<SvJump>& rJumps, NucSeq& rRead )
     {
-        const int64_t iReadId = pRead->iId;
-        for( SvJump& rJump : *pJumps )
+        const int64_t iReadId = rRead.iId;
+        for( SvJump& rJump : rJumps )
         {
             // make sure the read id matches the read context
             if( rJump.iReadId == -1 ) // if there is no read id given yet add it
@@ -51,19 +59,128 @@ class JumpInserterContainer
                 assert( rJump.iReadId == iReadId );
 
             assert( rJump.iReadId != -1 );
-
-            auto xRectangle = WKBUint64Rectangle( geom::Rectangle<nucSeqIndex>(
-                rJump.from_start_same_strand( ), rJump.to_start( ), rJump.from_size( ), rJump.to_size( ) ) );
-            rJump.iId = ParentType::pInserter->insert(
-                ParentType::iId /* <- id of the sv jump run */, rJump.iReadId, rJump.from_start( ), rJump.from_end( ),
-                (uint32_t)rJump.uiFrom, (uint32_t)rJump.uiTo, (uint32_t)rJump.uiQueryFrom, (uint32_t)rJump.uiQueryTo,
-                (uint32_t)rJump.uiNumSupportingNt, rJump.bFromForward, rJump.bToForward, rJump.bWasMirrored,
-                xRectangle );
         } // for
+    } // method
+
+    /// @brief inserts a single jump and sets its id
+    void insertJump( SvJump& rJump )
+    {
+        auto xRectangle = WKBUint64Rectangle( geom::Rectangle<nucSeqIndex>(
+            rJump.from_start_same_strand( ), rJump.to_start( ), rJump.from_size( ), rJump.to_size( ) ) );
+        rJump.iId = ParentType::pInserter->insert(
+            ParentType::iId /* <- id of the sv jump run */, rJump.iReadId, rJump.from_start( ), rJump.from_end( ),
+            (uint32_t)rJump.uiFrom, (uint32_t)rJump.uiTo, (uint32_t)rJump.uiQueryFrom, (uint32_t)rJump.uiQueryTo,
+            (uint32_t)rJump.uiNumSupportingNt, rJump.uiNumReads, rJump.bFromForward, rJump.bToForward,
+            rJump.bWasMirrored, xRectangle );
+    } // method
+
+    virtual size_t insert_override( std::shared_ptr<ContainerVector<SvJump>> pJumps, std::shared_ptr<NucSeq> pRead )
+    {
+        setReadIds( *pJumps, *pRead );
+        for( SvJump& rJump : *pJumps )
+            insertJump( rJump );
         return pJumps->size( );
     } // method
 }; // class
 
+/**
+ * @brief Insertion of libMSV::SvJump into the database; merges the jumps of different reads, if they are equal.
+ * @details
+ * At high coverage, each breakpoint is reported by many reads, via jumps that are identical except for their read and
+ * their position on the read. Jumps with equal from & to positions, strands and query distance have equal
+ * rectangles, so the sweeps can treat them as one jump that is supported by several reads.
+ * This container buffers the jumps in memory and inserts one row per set of equal jumps into the sv_jump_table.
+ * The row's num_reads column holds the number of merged jumps; the read ids, query positions and supporting nt of all
+ * but the first jump are kept in the sv_jump_read_table.
+ * CompleteBipartiteSubgraphSweep expands the merged jumps of its clusters again, so the calls do not change.
+ *
+ * The reads are not sorted by their position on the genome, so there is no genomic window after which a jump cannot
+ * occur anymore. Instead, if the buffer exceeds uiMaxBufferedJumps different jumps, the jumps that are supported by a
+ * single read (mostly noise) are written. If that does not free half of the buffer, all jumps are written.
+ * In both cases, jumps that occur afterwards are merged again, but into a new row.
+ */
+template <typename DBCon> class CompactingJumpInserterContainer : public JumpInserterContainer<DBCon>
+{
+  public:
+    using ParentType = JumpInserterContainer<DBCon>;
+
+    /// @brief the jumps with equal keys are merged (from, to, query distance, from forward, to forward, mirrored)
+    using KeyType = std::tuple<nucSeqIndex, nucSeqIndex, nucSeqIndex, bool, bool, bool>;
+
+    const size_t uiMaxBufferedJumps = 1000000;
+
+    std::shared_ptr<BulkInserterType<SvJumpReadTable<DBCon>>> pReadInserter;
+
+  private:
+    std::map<KeyType, std::vector<SvJump>> xBuffer;
+
+    /// @brief writes all buffered jumps with at most uiMaxNumReads reads; returns the number of inserted rows
+    size_t flush( size_t uiMaxNumReads )
+    {
+        size_t uiNumRows = 0;
+        for( auto xIt = xBuffer.begin( ); xIt != xBuffer.end( ); )
+        {
+            std::vector<SvJump>& rJumps = xIt->second;
+            if( rJumps.size( ) > uiMaxNumReads )
+            {
+                ++xIt;
+                continue;
+            } // if
+            SvJump& rFirst = rJumps.front( );
+            rFirst.uiNumReads = (uint32_t)rJumps.size( );
+            this->insertJump( rFirst );
+            for( size_t uiI = 1; uiI < rJumps.size( ); uiI++ )
+                pReadInserter->insert( rFirst.iId, rJumps[ uiI ].iReadId, (uint32_t)rJumps[ uiI ].uiQueryFrom,
+                                       (uint32_t)rJumps[ uiI ].uiQueryTo, (uint32_t)rJumps[ uiI ].uiNumSupportingNt );
+            uiNumRows += rJumps.size( );
+            xIt = xBuffer.erase( xIt );
+        } // for
+        return uiNumRows;
+    } // method
+
+  public:
+    CompactingJumpInserterContainer( std::shared_ptr<PoolContainer<DBCon>> pPool, int64_t iId,
+                                     std::shared_ptr<SharedInserterProfiler> pSharedProfiler )
+        : ParentType( pPool, iId, pSharedProfiler ),
+          pReadInserter( pPool->xPool.run( ParentType::iConnectionId, []( auto pConnection ) {
+              return SvJumpReadTable<DBCon>( pConnection )
+                  .template getBulkInserter<SvJumpReadTable<DBCon>::uiBulkInsertSize::value>( );
+          } ) )
+    {} // constructor
+
+    /// @brief the buffered jumps are written by close only; destroying a container with buffered jumps loses them
+    ~CompactingJumpInserterContainer( )
+    {
+        if( !xBuffer.empty( ) )
+            std::cerr << "ERROR: CompactingJumpInserterContainer destroyed without calling close; "
+                      << xBuffer.size( ) << " buffered jumps are lost" << std::endl;
+    } // destructor
+
+  protected:
+    virtual size_t insert_override( std::shared_ptr<ContainerVector<SvJump>> pJumps, std::shared_ptr<NucSeq> pRead )
+    {
+        this->setReadIds( *pJumps, *pRead );
+        for( SvJump& rJump : *pJumps )
+            xBuffer[ KeyType( rJump.uiFrom, rJump.uiTo, rJump.query_distance( ), rJump.bFromForward,
+                              rJump.bToForward, rJump.bWasMirrored ) ]
+                .push_back( rJump );
+        if( xBuffer.size( ) <= uiMaxBufferedJumps )
+            return 0;
+        size_t uiNumRows = flush( 1 );
+        if( xBuffer.size( ) > uiMaxBufferedJumps / 2 )
+            uiNumRows += flush( std::numeric_limits<size_t>::max( ) );
+        return uiNumRows;
+    } // method
+
+  public:
+    virtual void close( std::shared_ptr<PoolContainer<DBCon>> pPool )
+    {
+        flush( std::numeric_limits<size_t>::max( ) );
+        pReadInserter.reset( );
+        ParentType::close( pPool );
+    } // method
+}; // class
+
 template <typename DBCon, typename DBConInit>
 using GetJumpInserterContainerModule =
     GetInserterContainerModule<JumpInserterContainer, DBCon, DBConInit, SvJumpRunTable>;
@@ -71,10 +188,17 @@ using GetJumpInserterContainerModule =
 
 template <typename DBCon> using JumpInserterModule = InserterModule<JumpInserterContainer<DBCon>>;
 
+template <typename DBCon, typename DBConInit>
+using GetCompactingJumpInserterContainerModule =
+    GetInserterContainerModule<CompactingJumpInserterContainer, DBCon, DBConInit, SvJumpRunTable>;
+
+template <typename DBCon>
+using CompactingJumpInserterModule = InserterModule<CompactingJumpInserterContainer<DBCon>>;
+
 
 } // namespace libMSV
 
 #ifdef WITH_PYTHON
-/// @brief used to expose libMSV::SvJumpInserter to python
+/// @brief used to expose libMSV::JumpInserterContainer and libMSV::CompactingJumpInserterContainer to python
 void exportSvJumpInserter( libMS::SubmoduleOrganizer& xOrganizer );
 #endif
@@ -0,0 +1,304 @@
+/**
+ * @file readImporter.h
+ * @brief implements libMSV::importReads that streams reads from files into the DB.
+ */
+#pragma once
+
+#include "ma/module/fileReader.h"
+#include "msv/container/sv_db/tables/kMerFilter.h"
+#include "msv/container/sv_db/tables/pairedRead.h"
+#include "msv/container/sv_db/tables/read.h"
+#include "msv/container/sv_db/tables/sequencer.h"
+#include "msv/module/count_k_mers.h"
+#include "util/threadPool.h"
+
+/// @cond DOXYGEN_SHOW_SYSTEM_INCLUDES
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <type_traits>
+/// @endcond
+
+using namespace libMA;
+using namespace libMS;
+
+namespace libMSV
+{
+
+/**
+ * @brief compressed reads that are handed from a parsing thread to the writer
+ * @details
+ * For paired reads the mate of vReads[ i ] is vMates[ i ]; vMates is empty for unpaired reads.
+ */
+struct ImportBatch
+{
+    std::vector<std::pair<std::string, std::shared_ptr<CompressedNucSeq>>> vReads, vMates;
+}; // struct
+
+/**
+ * @brief bounded queue between the parsing threads and the single DB writer
+ * @details
+ * push blocks while the queue is full, so that the parsers cannot run away from the writer.
+ * pop returns nullptr once all producers are finished and the queue is empty.
+ * After abort, push drops its batch and returns false, so that the producers stop if the writer failed.
+ */
+class ImportBatchQueue
+{
+    std::mutex xMutex;
+    std::condition_variable xNotFull, xNotEmpty;
+    std::deque<std::unique_ptr<ImportBatch>> xBatches;
+    const size_t uiCapacity;
+    size_t uiNumProducers;
+    bool bAborted = false;
+
+  public:
+    ImportBatchQueue( size_t uiCapacity, size_t uiNumProducers )
+        : uiCapacity( uiCapacity ), uiNumProducers( uiNumProducers )
+    {} // constructor
+
+    bool push( std::unique_ptr<ImportBatch> pBatch )
+    {
+        std::unique_lock<std::mutex> xLock( xMutex );
+        while( xBatches.size( ) >= uiCapacity && !bAborted )
+            xNotFull.wait( xLock );
+        if( bAborted )
+            return false;
+        xBatches.push_back( std::move( pBatch ) );
+        xNotEmpty.notify_one( );
+        return true;
+    } // method
+
+    std::unique_ptr<ImportBatch> pop( )
+    {
+        std::unique_lock<std::mutex> xLock( xMutex );
+        while( xBatches.empty( ) && uiNumProducers > 0 )
+            xNotEmpty.wait( xLock );
+        if( xBatches.empty( ) ) // we are completely done
+            return nullptr;
+        auto pRet = std::move( xBatches.front( ) );
+        xBatches.pop_front( );
+        xNotFull.notify_one( );
+        return pRet;
+    } // method
+
+    void producerFinished( )
+    {
+        std::unique_lock<std::mutex> xLock( xMutex );
+        uiNumProducers--;
+        if( uiNumProducers == 0 )
+            xNotEmpty.notify_all( );
+    } // method
+
+    void abort( )
+    {
+        std::unique_lock<std::mutex> xLock( xMutex );
+        bAborted = true;
+        xNotFull.notify_all( );
+    } // method
+}; // class
+
+/// @brief number of reads that a parsing thread collects before it hands them to the writer
+const size_t uiImportBatchSize = 256;
+/// @brief number of rows per insert statement of the writer (4 parameters per row; postgres allows 65535)
+const size_t uiImportBulkInsertSize = 5000;
+
+/**
+ * @brief the next read (or pair of reads) of the stream is appended to rReads
+ * @details
+ * Returns false if there are no more reads in the stream.
+ * The overloads cover unpaired (FileStream) and paired (PairedFileStream) reads.
+ * For paired reads, each read is directly followed by its mate in rReads.
+ * Only parses; the reads are compressed by compressBatch after the stream was released.
+ */
+inline bool readIntoBatch( FileReader& rReader, std::shared_ptr<FileStream> pStream,
+                           std::vector<std::shared_ptr<NucSeq>>& rReads )
+{
+    auto pRead = rReader.execute( pStream );
+    if( pRead == nullptr )
+        return false;
+    rReads.push_back( pRead );
+    return true;
+} // function
+
+inline bool readIntoBatch( PairedFileReader& rReader, std::shared_ptr<PairedFileStream> pStream,
+                           std::vector<std::shared_ptr<NucSeq>>& rReads )
+{
+    auto pReads = rReader.execute( pStream );
+    if( pReads == nullptr )
+        return false;
+    rReads.push_back( ( *pReads )[ 0 ] );
+    rReads.push_back( ( *pReads )[ 1 ] );
+    return true;
+} // function
+
+/**
+ * @brief compresses the reads that were collected by readIntoBatch
+ * @details
+ * If bPaired is set, rReads alternates between reads and their mates.
+ */
+inline std::unique_ptr<ImportBatch> compressBatch( const std::vector<std::shared_ptr<NucSeq>>& rReads, bool bPaired )
+{
+    auto pBatch = std::make_unique<ImportBatch>( );
+    for( size_t uiI = 0; uiI < rReads.size( ); uiI += bPaired ? 2 : 1 )
+    {
+        pBatch->vReads.emplace_back( rReads[ uiI ]->sName, makeSharedCompNucSeq( *rReads[ uiI ] ) );
+        if( bPaired )
+            pBatch->vMates.emplace_back( rReads[ uiI + 1 ]->sName, makeSharedCompNucSeq( *rReads[ uiI + 1 ] ) );
+    } // for
+    return pBatch;
+} // function
+
+/**
+ * @brief parses, compresses and counts the minimizers of reads until the queue of streams is empty
+ * @details
+ * Each worker holds a stream exclusively from pop till push, so streams do not need to be locked in between reads.
+ * The stream is held for parsing only: it is pushed back before the batch is compressed and its minimizers are
+ * counted, so that several workers can process the batches of a single file concurrently.
+ * The minimizers of a batch are sorted and counted in a thread local vector first. Then each distinct minimizer is
+ * added once to the shared counter. This keeps the memory bounded by the batch size (in contrast to one full
+ * HashCounter per thread) and takes one spin lock per distinct minimizer instead of one per occurrence.
+ */
+template <typename ReaderType, typename StreamType>
+void importReadsWorker( const ParameterSetManager& rParameters, CyclicQueue<StreamType>& rStreams,
+                        ImportBatchQueue& rBatches, HashCounter& rCounter )
+{
+    ReaderType xReader( rParameters );
+    const nucSeqIndex k = rParameters.getSelected( )->xMinimizerK->get( );
+    const nucSeqIndex w = rParameters.getSelected( )->xMinimizerW->get( );
+    std::vector<std::shared_ptr<NucSeq>> vReads;
+    std::vector<uint64_t> vHashes;
+    while( auto pStream = rStreams.pop( ) )
+    {
+        vReads.clear( );
+        while( vReads.size( ) < uiImportBatchSize && readIntoBatch( xReader, pStream, vReads ) )
+            ;
+        if( pStream->eof( ) )
+        {
+            pStream->close( );
+            rStreams.informThatContainerIsFinished( );
+        } // if
+        else
+            rStreams.push( pStream );
+        // from here on, other workers can parse the next batch of the stream
+
+        auto pBatch = compressBatch( vReads, std::is_same<ReaderType, PairedFileReader>::value );
+        vHashes.clear( );
+        for( auto& pRead : vReads )
+        {
+            auto vReadHashes =
+                minimizer::Index::_getHash( (const char*)pRead->pxSequenceRef, (int)pRead->length( ), k, w );
+            vHashes.insert( vHashes.end( ), vReadHashes.begin( ), vReadHashes.end( ) );
+        } // for
+        std::sort( vHashes.begin( ), vHashes.end( ) );
+        for( size_t uiI = 0; uiI < vHashes.size( ); )
+        {
+            size_t uiJ = uiI + 1;
+            while( uiJ < vHashes.size( ) && vHashes[ uiJ ] == vHashes[ uiI ] )
+                uiJ++;
+            rCounter.addHash( vHashes[ uiI ], uiJ - uiI );
+            uiI = uiJ;
+        } // for
+
+        if( !pBatch->vReads.empty( ) && !rBatches.push( std::move( pBatch ) ) )
+            return; // the writer failed
+    } // while
+} // function
+
+/**
+ * @brief imports all reads from the queue of streams into the DB
+ * @details
+ * In contrast to the ReadInserterModule graph, that runs one bulk inserter per thread, there is exactly one writer:
+ * - rParameters.getNumThreads( ) workers parse the reads, compress them and count their minimizers
+ *   (see importReadsWorker)
+ * - the calling thread inserts all batches within one transaction via a single, large bulk inserter
+ * - afterwards the minimizer counts that exceed uiCoverage are inserted into the mm_filter_table
+ *   and the indices of the read_table are created
+ * Returns the id of the new sequencer.
+ */
+template <typename DBCon, typename ReaderType, typename StreamType>
+int64_t importReadsFromQueue( const ParameterSetManager& rParameters, std::shared_ptr<DBCon> pConnection,
+                              const std::string& sSequencerName, std::shared_ptr<CyclicQueue<StreamType>> pStreams,
+                              size_t uiCoverage )
+{
+    const int64_t iSequencerId = SequencerTable<DBCon>( pConnection ).insert( sSequencerName );
+    auto pCounter = std::make_shared<HashCounter>( );
+
+    const size_t uiNumWorkers = std::max( (size_t)1, rParameters.getNumThreads( ) );
+    ImportBatchQueue xBatches( 4 * uiNumWorkers, uiNumWorkers );
+    {
+        ThreadPool xWorkers( uiNumWorkers );
+        std::vector<std::future<void>> vFutures;
+        for( size_t uiI = 0; uiI < uiNumWorkers; uiI++ )
+            vFutures.push_back( xWorkers.enqueue( [ & ]( size_t ) {
+                try
+                {
+                    importReadsWorker<ReaderType>( rParameters, *pStreams, xBatches, *pCounter );
+                } // try
+                catch( ... )
+                {
+                    xBatches.producerFinished( );
+                    throw;
+                } // catch
+                xBatches.producerFinished( );
+            } ) );
+
+        try
+        {
+            auto pTransaction = pConnection->sharedGuardedTrxn( );
+            auto pReadInserter = ReadTable<DBCon>( pConnection ).template getBulkInserter<uiImportBulkInsertSize>( );
+            // with half the size, the pairs are flushed right after the reads they reference
+            auto pPairInserter = PairedReadTable<DBCon>( pConnection, nullptr )
+                                     .template getBulkInserter<uiImportBulkInsertSize / 2>( );
+            while( auto pBatch = xBatches.pop( ) )
+                for( size_t uiI = 0; uiI < pBatch->vReads.size( ); uiI++ )
+                {
+                    auto iReadId = pReadInserter->insert( iSequencerId, pBatch->vReads[ uiI ].first,
+                                                          pBatch->vReads[ uiI ].second );
+                    if( !pBatch->vMates.empty( ) )
+                        pPairInserter->insert( iReadId,
+                                               pReadInserter->insert( iSequencerId, pBatch->vMates[ uiI ].first,
+                                                                      pBatch->vMates[ uiI ].second ) );
+                } // for
+            // the pairs reference the reads (foreign key), so the reads must be written first
+            pReadInserter->flush( );
+            pPairInserter->flush( );
+        } // try
+        catch( ... )
+        {
+            xBatches.abort( );
+            throw;
+        } // catch
+        for( auto& xFuture : vFutures )
+            xFuture.get( );
+    } // scope for xWorkers
+
+    HashFilterTable<DBCon>( pConnection ).insert_counter_set( iSequencerId, pCounter, uiCoverage );
+    ReadTable<DBCon>( pConnection ).genIndices( );
+    return iSequencerId;
+} // function
+
+/// @brief imports unpaired reads; see importReadsFromQueue
+template <typename DBCon>
+int64_t importReads( const ParameterSetManager& rParameters, std::shared_ptr<DBCon> pConnection,
+                     const std::string& sSequencerName, std::shared_ptr<FileStreamQueue> pStreams, size_t uiCoverage )
+{
+    return importReadsFromQueue<DBCon, FileReader>( rParameters, pConnection, sSequencerName, pStreams, uiCoverage );
+} // function
+
+/// @brief imports paired reads; see importReadsFromQueue and combineFileStreams
+template <typename DBCon>
+int64_t importPairedReads( const ParameterSetManager& rParameters, std::shared_ptr<DBCon> pConnection,
+                           const std::string& sSequencerName, std::shared_ptr<PairedFileStreamQueue> pStreams,
+                           size_t uiCoverage )
+{
+    return importReadsFromQueue<DBCon, PairedFileReader>( rParameters, pConnection, sSequencerName, pStreams,
+                                                          uiCoverage );
+} // function
+
+} // namespace libMSV
+
+#ifdef WITH_PYTHON
+/// @brief expose libMSV::importReads and libMSV::importPairedReads to python
+void exportReadImporter( libMS::SubmoduleOrganizer& xOrganizer );
+#endif
@@ -0,0 +1,302 @@
+/**
+ * @file overviewTile.h
+ * @details
+ * Precomputed level of detail tiles for the overview of calls and jumps in the SV visualization.
+ */
+#pragma once
+
+#include "msv/container/svJump.h"
+#include "msv/container/sv_db/svSchema.h"
+#include "msv/container/sv_db/tables/svCall.h"
+#include "sql_api.h"
+#include <unordered_map>
+
+namespace libMSV
+{
+
+template <typename DBCon>
+using OverviewTileTableType = SQLTable<DBCon,
+                                       PriKeyDefaultType, // sv_caller_run_id (foreign key)
+                                       uint32_t, // kind
+                                       double, // min_score
+                                       uint32_t, // level
+                                       uint32_t, // tile_x
+                                       uint32_t, // tile_y
+                                       uint32_t, // num_elements
+                                       double // max_score
+                                       >;
+const json jOverviewTileTableDef = {
+    { TABLE_NAME, "overview_tile_table" },
+    { TABLE_COLUMNS,
+      { { { COLUMN_NAME, "sv_caller_run_id" } },
+        { { COLUMN_NAME, "kind" } },
+        { { COLUMN_NAME, "min_score" } },
+        { { COLUMN_NAME, "level" } },
+        { { COLUMN_NAME, "tile_x" } },
+        { { COLUMN_NAME, "tile_y" } },
+        { { COLUMN_NAME, "num_elements" } },
+        { { COLUMN_NAME, "max_score" } } } },
+    { FOREIGN_KEY,
+      { { COLUMN_NAME, "sv_caller_run_id" }, { REFERENCES, "sv_caller_run_table(id) ON DELETE CASCADE" } } } };
+
+template <typename DBCon>
+using OverviewTileVersionTableType = SQLTable<DBCon,
+                                              PriKeyDefaultType, // sv_caller_run_id (foreign key)
+                                              uint32_t, // kind
+                                              double, // min_score
+                                              int64_t // calls_version
+                                              >;
+const json jOverviewTileVersionTableDef = {
+    { TABLE_NAME, "overview_tile_version_table" },
+    { TABLE_COLUMNS,
+      { { { COLUMN_NAME, "sv_caller_run_id" } },
+        { { COLUMN_NAME, "kind" } },
+        { { COLUMN_NAME, "min_score" } },
+        { { COLUMN_NAME, "calls_version" } } } },
+    { FOREIGN_KEY,
+      { { COLUMN_NAME, "sv_caller_run_id" }, { REFERENCES, "sv_caller_run_table(id) ON DELETE CASCADE" } } } };
+
+/**
+ * @brief this table stores tile pyramids of the calls and jumps of a caller run.
+ * @details
+ * Level 0 divides the genome into tiles of uiBaseTileSize x uiBaseTileSize nucleotides; each further level makes the
+ * tiles uiLevelFactor times wider and higher, until one tile covers the whole genome.
+ * Each tile stores the number of elements that start in it and their maximal score
+ * (calls: score; jumps: number of supporting nucleotides).
+ * The call pyramid is computed once per caller run and minimal call score via build, the jump pyramid once per caller
+ * run via buildJumps; afterwards an overview of any area can be served via tiles and jumpTiles without touching the
+ * call and jump tables.
+ * Calls can be inserted, deleted or changed after the build. Therefore, build stores the version of the calls of the
+ * run (see SvCallVersionTable) in the overview_tile_version_table. hasTiles compares it with the current version, so
+ * that an outdated pyramid is never served. Jumps are not changed after their run is computed.
+ */
+template <typename DBCon> class OverviewTileTable : public OverviewTileTableType<DBCon>
+{
+    OverviewTileVersionTableType<DBCon> xVersionTable;
+    SvCallVersionTable<DBCon> xCallVersions;
+    SQLQuery<DBCon, uint32_t, uint32_t, double> xGetCalls;
+    SQLQuery<DBCon, uint32_t, uint32_t, uint32_t, uint32_t> xGetJumps;
+    SQLQuery<DBCon, uint32_t, uint32_t, uint32_t> xGetTiles;
+    SQLQuery<DBCon, uint32_t> xNumLevels;
+    SQLQuery<DBCon, uint64_t> xUpToDate;
+    SQLQuery<DBCon, uint64_t> xHasVersion;
+    SQLStatement<DBCon> xDeleteTiles;
+    SQLStatement<DBCon> xDeleteVersion;
+
+    enum Kind
+    {
+        Calls = 0,
+        Jumps = 1
+    };
+
+    /// @brief number of levels, so that the tiles of the last level are at least as large as the genome
+    uint32_t numLevels( std::shared_ptr<Pack> pPack ) const
+    {
+        uint32_t uiNumLevels = 1;
+        while( tileSize( uiNumLevels - 1 ) < pPack->uiUnpackedSizeForwardStrand )
+            uiNumLevels++;
+        return uiNumLevels;
+    } // method
+
+    /// @brief adds an element with the given weight to all levels of vTiles
+    void addToTiles( std::vector<std::unordered_map<uint64_t, std::pair<uint32_t, double>>>& vTiles, uint32_t uiX,
+                     uint32_t uiY, uint32_t uiWeight, double dScore ) const
+    {
+        for( uint32_t uiLevel = 0; uiLevel < vTiles.size( ); uiLevel++ )
+        {
+            uint64_t uiKey = ( ( uiX / tileSize( uiLevel ) ) << 32 ) | ( uiY / tileSize( uiLevel ) );
+            auto& rTile = vTiles[ uiLevel ][ uiKey ];
+            rTile.second = rTile.first == 0 ? dScore : std::max( rTile.second, dScore );
+            rTile.first += uiWeight;
+        } // for
+    } // method
+
+    /// @brief stores vTiles and afterwards the version row (so that a version row implies complete tiles)
+    void storeTiles( const std::vector<std::unordered_map<uint64_t, std::pair<uint32_t, double>>>& vTiles,
+                     int64_t iCallerRunId, Kind xKind, double dMinScore, int64_t iVersion )
+    {
+        {
+            auto pBulkInserter = this->template getBulkInserter<500>( );
+            for( uint32_t uiLevel = 0; uiLevel < vTiles.size( ); uiLevel++ )
+                for( auto& xTile : vTiles[ uiLevel ] )
+                    pBulkInserter->insert( iCallerRunId, (uint32_t)xKind, dMinScore, uiLevel,
+                                           ( uint32_t )( xTile.first >> 32 ), ( uint32_t )( xTile.first & 0xFFFFFFFF ),
+                                           xTile.second.first, xTile.second.second );
+        } // scope (flushes the bulk inserter before the version is stored)
+        xVersionTable.insert( iCallerRunId, (uint32_t)xKind, dMinScore, iVersion );
+    } // method
+
+    /// @brief see tiles
+    std::vector<rect> tilesOfKind( int64_t iCallerRunId, Kind xKind, double dMinScore, std::shared_ptr<Pack> pPack,
+                                   int64_t iX, int64_t iY, uint64_t uiW, uint64_t uiH, uint64_t uiMaxTiles )
+    {
+        uint64_t uiX = iX > 0 ? (uint64_t)iX : 0;
+        uint64_t uiY = iY > 0 ? (uint64_t)iY : 0;
+        uint32_t uiNumLevels = xNumLevels.scalar( iCallerRunId, (uint32_t)xKind, dMinScore );
+        if( uiNumLevels == 0 )
+            return { };
+        uint32_t uiLevel = 0;
+        while( uiLevel + 1 < uiNumLevels &&
+               ( uiW / tileSize( uiLevel ) + 1 ) * ( uiH / tileSize( uiLevel ) + 1 ) > uiMaxTiles )
+            uiLevel++;
+        const uint64_t uiSize = tileSize( uiLevel );
+
+        std::vector<rect> vRet;
+        xGetTiles.execAndForAll(
+            [ & ]( uint32_t uiTileX, uint32_t uiTileY, uint32_t uiNumElements ) {
+                uint64_t uiStartX = uiTileX * uiSize;
+                uint64_t uiStartY = uiTileY * uiSize;
+                vRet.emplace_back( (uint32_t)uiStartX, (uint32_t)uiStartY, (uint32_t)uiSize, (uint32_t)uiSize,
+                                   uiNumElements, (uint32_t)pPack->uiSequenceIdForPosition( uiStartX ),
+                                   (uint32_t)pPack->uiSequenceIdForPosition( uiStartY ) );
+            },
+            iCallerRunId, (uint32_t)xKind, dMinScore, uiLevel, //
+            ( uint32_t )( uiX / uiSize ), ( uint32_t )( ( uiX + uiW ) / uiSize ), //
+            ( uint32_t )( uiY / uiSize ), ( uint32_t )( ( uiY + uiH ) / uiSize ) );
+        return vRet;
+    } // method
+
+  public:
+    /// @brief tile size of level 0
+    const uint64_t uiBaseTileSize = 1000;
+    /// @brief factor between the tile widths of two consecutive levels
+    const uint64_t uiLevelFactor = 4;
+
+    OverviewTileTable( std::shared_ptr<DBCon> pDB )
+        : OverviewTileTableType<DBCon>( pDB, jOverviewTileTableDef ),
+          xVersionTable( pDB, jOverviewTileVersionTableDef ),
+          xCallVersions( pDB ),
+          xGetCalls( pDB, "SELECT from_pos, to_pos, score FROM sv_call_table "
+                          "WHERE sv_caller_run_id = ? "
+                          "AND score >= ? " ),
+          // merged jumps (see CompactingJumpInserterContainer) count once per read
+          xGetJumps( pDB, "SELECT from_pos, to_pos, num_supporting_nt, num_reads FROM sv_jump_table "
+                          "WHERE sv_jump_run_id = ( SELECT sv_jump_run_id FROM sv_caller_run_table WHERE id = ? ) "
+                          "AND from_pos != ? "
+                          "AND to_pos != ? " ),
+          xGetTiles( pDB, "SELECT tile_x, tile_y, num_elements FROM overview_tile_table "
+                          "WHERE sv_caller_run_id = ? "
+                          "AND kind = ? "
+                          "AND min_score = ? "
+                          "AND level = ? "
+                          "AND tile_x >= ? AND tile_x <= ? "
+                          "AND tile_y >= ? AND tile_y <= ? " ),
+          xNumLevels( pDB, "SELECT COUNT(DISTINCT level) FROM overview_tile_table "
+                           "WHERE sv_caller_run_id = ? "
+                           "AND kind = ? "
+                           "AND min_score = ? " ),
+          xUpToDate( pDB, "SELECT COUNT(*) FROM overview_tile_version_table "
+                          "WHERE sv_caller_run_id = ? "
+                          "AND kind = ? "
+                          "AND min_score = ? "
+                          "AND calls_version = ( SELECT COALESCE( MAX( version ), 0 ) FROM sv_call_version_table "
+                          "                      WHERE sv_caller_run_id = ? ) " ),
+          xHasVersion( pDB, "SELECT COUNT(*) FROM overview_tile_version_table "
+                            "WHERE sv_caller_run_id = ? "
+                            "AND kind = ? " ),
+          xDeleteTiles( pDB, "DELETE FROM overview_tile_table "
+                             "WHERE sv_caller_run_id = ? AND kind = ? AND min_score = ? " ),
+          xDeleteVersion( pDB, "DELETE FROM overview_tile_version_table "
+                               "WHERE sv_caller_run_id = ? AND kind = ? AND min_score = ? " )
+    {
+        // create the index once with the table (instead of after every build)
+        this->addIndex( json{ { INDEX_NAME, "tile_index" },
+                              { INDEX_COLUMNS, "sv_caller_run_id, kind, min_score, level, tile_x, tile_y" } } );
+    } // default constructor
+
+    /// @brief width & height of the tiles on uiLevel
+    uint64_t tileSize( uint32_t uiLevel ) const
+    {
+        uint64_t uiSize = uiBaseTileSize;
+        for( uint32_t uiI = 0; uiI < uiLevel; uiI++ )
+            uiSize *= uiLevelFactor;
+        return uiSize;
+    } // method
+
+    /**
+     * @brief computes the tile pyramid of the calls (with score >= dMinScore) of the given caller run.
+     * @details
+     * Fetches all calls of the run once and aggregates them on all levels in memory.
+     * Replaces tiles of a previous build with the same run id and minimal score.
+     */
+    void build( int64_t iCallerRunId, std::shared_ptr<Pack> pPack, double dMinScore )
+    {
+        xDeleteVersion.exec( iCallerRunId, (uint32_t)Kind::Calls, dMinScore );
+        xDeleteTiles.exec( iCallerRunId, (uint32_t)Kind::Calls, dMinScore );
+        // the version is taken before the calls are fetched: if calls change during the build, the next hasTiles
+        // call fails and the pyramid is rebuilt
+        int64_t iVersion = xCallVersions.version( iCallerRunId );
+
+        // (tile_x << 32 | tile_y) -> (num_elements, max_score); for each level
+        std::vector<std::unordered_map<uint64_t, std::pair<uint32_t, double>>> vTiles( numLevels( pPack ) );
+        xGetCalls.execAndForAll(
+            [ & ]( uint32_t uiFrom, uint32_t uiTo, double dScore ) { addToTiles( vTiles, uiFrom, uiTo, 1, dScore ); },
+            iCallerRunId, dMinScore );
+        storeTiles( vTiles, iCallerRunId, Kind::Calls, dMinScore, iVersion );
+    } // method
+
+    /**
+     * @brief true if build was called for the run and minimal score and the calls of the run did not change since.
+     * @details
+     * Compares the stored version with the one row of the run in the sv_call_version_table; this is cheap enough to
+     * be called on every render.
+     */
+    bool hasTiles( int64_t iCallerRunId, double dMinScore )
+    {
+        return xUpToDate.scalar( iCallerRunId, (uint32_t)Kind::Calls, dMinScore, iCallerRunId ) > 0;
+    } // method
+
+    /**
+     * @brief computes the tile pyramid of the jumps of the jump run that the given caller run is based on.
+     * @details
+     * Jumps with an unknown from or to position are not part of the pyramid.
+     * Replaces tiles of a previous jump build of the run.
+     */
+    void buildJumps( int64_t iCallerRunId, std::shared_ptr<Pack> pPack )
+    {
+        xDeleteVersion.exec( iCallerRunId, (uint32_t)Kind::Jumps, 0.0 );
+        xDeleteTiles.exec( iCallerRunId, (uint32_t)Kind::Jumps, 0.0 );
+
+        std::vector<std::unordered_map<uint64_t, std::pair<uint32_t, double>>> vTiles( numLevels( pPack ) );
+        xGetJumps.execAndForAll(
+            [ & ]( uint32_t uiFrom, uint32_t uiTo, uint32_t uiNumSuppNt, uint32_t uiNumReads ) {
+                addToTiles( vTiles, uiFrom, uiTo, uiNumReads, uiNumSuppNt );
+            },
+            iCallerRunId, (uint32_t)SvJump::DUMMY_LOCATION, (uint32_t)SvJump::DUMMY_LOCATION );
+        storeTiles( vTiles, iCallerRunId, Kind::Jumps, 0.0, 0 );
+    } // method
+
+    /// @brief true if buildJumps was called for the run
+    bool hasJumpTiles( int64_t iCallerRunId )
+    {
+        return xHasVersion.scalar( iCallerRunId, (uint32_t)Kind::Jumps ) > 0;
+    } // method
+
+    /**
+     * @brief returns the tiles that overlap the given area.
+     * @details
+     * Uses the finest level, where the area is covered by at most uiMaxTiles tiles.
+     * The tiles are returned in the format of getCallOverview
+     * (i and j are the contigs of the bottom left corner of the tile).
+     * Call hasTiles beforehand, in order to make sure that the tiles are up to date.
+     */
+    std::vector<rect> tiles( int64_t iCallerRunId, double dMinScore, std::shared_ptr<Pack> pPack, int64_t iX,
+                             int64_t iY, uint64_t uiW, uint64_t uiH, uint64_t uiMaxTiles )
+    {
+        return tilesOfKind( iCallerRunId, Kind::Calls, dMinScore, pPack, iX, iY, uiW, uiH, uiMaxTiles );
+    } // method
+
+    /**
+     * @brief returns the jump tiles that overlap the given area.
+     * @details
+     * Same as tiles; the count of a tile is the number of jumps (merged jumps count once per read).
+     * Call hasJumpTiles beforehand.
+     */
+    std::vector<rect> jumpTiles( int64_t iCallerRunId, std::shared_ptr<Pack> pPack, int64_t iX, int64_t iY,
+                                 uint64_t uiW, uint64_t uiH, uint64_t uiMaxTiles )
+    {
+        return tilesOfKind( iCallerRunId, Kind::Jumps, 0.0, pPack, iX, iY, uiW, uiH, uiMaxTiles );
+    } // method
+}; // class
+
+} // namespace libMSV
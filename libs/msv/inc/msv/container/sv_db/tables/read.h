@@ -87,10 +87,30 @@ template <typename DBCon> class ReadTable : public ReadTableType<DBCon>
         return xGetReadId.scalar( (PriKeyDefaultType)iSeqId, sName );
     } // method
 
-    inline std::vector<std::shared_ptr<NucSeq>> getUsedReads( std::shared_ptr<DBCon> pDB )
+    /// @brief index for getReadId; create it after inserting the reads (see importReads)
+    inline void genIndices( )
+    {
+        this->addIndex( json{ { INDEX_NAME, "read_name_index" }, { INDEX_COLUMNS, "sequencer_id, _name_" } } );
+    } // method
+
+    inline void dropIndices( )
+    {
+        this->dropIndex( json{ { INDEX_NAME, "read_name_index" } } );
+    } // method
+
+    /**
+     * @brief all reads that support at least one jump
+     * @details
+     * Merged jumps (see CompactingJumpInserterContainer) keep the ids of all but their first read in the
+     * sv_jump_read_table (SvJumpTable creates it together with the sv_jump_table).
+     */
+    inline std::vector<std::shared_ptr<NucSeq>> getUsedReads( )
     {
         SQLQuery<DBCon, std::shared_ptr<CompressedNucSeq>, std::string> xGetAllUsedReads(
-            pDB, "SELECT sequence, _name_ FROM read_table WHERE id IN (SELECT DISTINCT read_id FROM sv_jump_table)" );
+            this->pDB, "SELECT sequence, _name_ FROM read_table "
+                       "WHERE id IN ( SELECT read_id FROM sv_jump_table "
+                       "              UNION "
+                       "              SELECT read_id FROM sv_jump_read_table )" );
         std::vector<std::shared_ptr<NucSeq>> vRet;
         xGetAllUsedReads.execAndForAll( [ & ]( std::shared_ptr<CompressedNucSeq> pComp, std::string sName ) {
             vRet.push_back( pComp->pUncomNucSeq );
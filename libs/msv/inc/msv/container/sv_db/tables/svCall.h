@@ -43,9 +43,64 @@ using SvCallTableType = SQLTableWithLibIncrPriKey<DBCon, // DB connector type
                                                   WKBUint64Rectangle // rectangle (geometry)
                                                   >;
 
+template <typename DBCon>
+using SvCallVersionTableType = SQLTable<DBCon,
+                                        PriKeyDefaultType, // sv_caller_run_id
+                                        int64_t // version
+                                        >;
+const json jSvCallVersionTableDef = {
+    { TABLE_NAME, "sv_call_version_table" },
+    { TABLE_COLUMNS,
+      { { { COLUMN_NAME, "sv_caller_run_id" }, { CONSTRAINTS, "NOT NULL PRIMARY KEY" } },
+        { { COLUMN_NAME, "version" } } } } };
+
+/**
+ * @brief counts the changes to the calls of each caller run
+ * @details
+ * The methods of SvCallTable that insert, update or delete calls and the SvCallInserterContainer bump the version of
+ * the affected run. Data that is derived from the calls (e.g. the OverviewTileTable) stores the version it was
+ * computed for; comparing it with the current version costs a single row lookup.
+ * Runs whose calls never changed have version 0.
+ */
+template <typename DBCon> class SvCallVersionTable : public SvCallVersionTableType<DBCon>
+{
+    SQLStatement<DBCon> xBump;
+    SQLStatement<DBCon> xBumpOfCall;
+    SQLQuery<DBCon, int64_t> xVersion;
+
+  public:
+    SvCallVersionTable( std::shared_ptr<DBCon> pDB )
+        : SvCallVersionTableType<DBCon>( pDB, jSvCallVersionTableDef ),
+          xBump( pDB, "INSERT INTO sv_call_version_table (sv_caller_run_id, version) VALUES (?, 1) "
+                      "ON CONFLICT (sv_caller_run_id) DO UPDATE SET version = sv_call_version_table.version + 1" ),
+          xBumpOfCall( pDB, "INSERT INTO sv_call_version_table (sv_caller_run_id, version) "
+                            "SELECT sv_caller_run_id, 1 FROM sv_call_table WHERE id = ? "
+                            "ON CONFLICT (sv_caller_run_id) DO UPDATE SET version = sv_call_version_table.version + 1" ),
+          xVersion( pDB, "SELECT COALESCE( MAX( version ), 0 ) FROM sv_call_version_table WHERE sv_caller_run_id = ?" )
+    {} // default constructor
+
+    /// @brief marks the calls of the run as changed
+    inline void bump( int64_t iCallerRunId )
+    {
+        xBump.exec( iCallerRunId );
+    } // method
+
+    /// @brief marks the calls of the run of the given call as changed; call this before deleting the call
+    inline void bumpOfCall( int64_t iCallId )
+    {
+        xBumpOfCall.exec( iCallId );
+    } // method
+
+    inline int64_t version( int64_t iCallerRunId )
+    {
+        return xVersion.scalar( iCallerRunId );
+    } // method
+}; // class
+
 template <typename DBCon> class SvCallTable : public SvCallTableType<DBCon>
 {
     std::shared_ptr<DBCon> pConnection;
+    SvCallVersionTable<DBCon> xVersions;
     SQLQuery<DBCon, uint64_t> xQuerySize;
     SQLQuery<DBCon, uint64_t> xQuerySizeSpecific;
     SQLQuery<DBCon, int64_t> xCallArea;
@@ -98,6 +153,7 @@ template <typename DBCon> class SvCallTable : public SvCallTableType<DBCon>
         : SvCallTableType<DBCon>( pConnection, // the database where the table resides
                                   jSvCallTableDef( ) ), // table definition
           pConnection( pConnection ),
+          xVersions( pConnection ),
           xQuerySize( pConnection, "SELECT COUNT(*) FROM sv_call_table" ),
 
           xQuerySizeSpecific( pConnection, "SELECT COUNT(*) FROM sv_call_table "
@@ -275,10 +331,12 @@ template <typename DBCon> class SvCallTable : public SvCallTableType<DBCon>
     inline void updateCoverage( SvCall& rCall )
     {
         xSetCoverageForCall.exec( (uint32_t)rCall.uiReferenceAmbiguity, rCall.iId );
+        xVersions.bumpOfCall( rCall.iId );
     } // method
 
     inline void deleteCall( int64_t iCallId )
     {
+        xVersions.bumpOfCall( iCallId );
         xDeleteCall.exec( iCallId );
     } // method
 
@@ -297,6 +355,7 @@ template <typename DBCon> class SvCallTable : public SvCallTableType<DBCon>
                         iAllowedDist, iAllowedDist,
                         // overlap distance to and to
                         iAllowedDist * 2, iAllowedDist * 2 );
+        xVersions.bump( iCallerRunIdTo );
     } // method
 
     inline int64_t insertCall( int64_t iSvCallerRunId, SvCall& rCall )
@@ -316,6 +375,7 @@ template <typename DBCon> class SvCallTable : public SvCallTableType<DBCon>
                                         (uint32_t)rCall.uiReferenceAmbiguity, rCall.iOrderID, rCall.iCtgOrderID,
                                         rCall.bMirrored, xRectangle );
         rCall.iId = iCallId;
+        xVersions.bump( iSvCallerRunId );
 
         return iCallId;
     } // method
@@ -331,6 +391,7 @@ template <typename DBCon> class SvCallTable : public SvCallTableType<DBCon>
             rCall.pInsertedSequence == nullptr ? 0 : rCall.pInsertedSequence->length( ), (uint32_t)rCall.uiNumSuppReads,
             (uint32_t)rCall.uiSuppNt, (uint32_t)rCall.uiReferenceAmbiguity, rCall.iOrderID, rCall.iCtgOrderID,
             rCall.bMirrored, xRectangle, rCall.iId );
+        xVersions.bump( iSvCallerRunId );
         return rCall.iId;
     } // method
 
@@ -361,6 +422,7 @@ template <typename DBCon> class SvCallTable : public SvCallTableType<DBCon>
         auto xTransaction = this->pConnection->sharedGuardedTrxn( );
         double dMinScore = minScore( iCallerRunId );
         double dMaxScore = maxScore( iCallerRunId );
+        xVersions.bump( iCallerRunId );
         return xFilterCallsWithHighScore.exec( iCallerRunId,
                                                dMinScore + ( dMaxScore - dMinScore ) * ( 1 - dPercentToFilter ) );
     } // method
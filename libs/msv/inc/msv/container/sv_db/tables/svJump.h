@@ -5,6 +5,7 @@
  * One table of the database.
  */
 #pragma once
+#include "msv/container/sv_db/tables/svJumpRead.h"
 #include "sql_api.h"
 
 namespace libMSV
@@ -21,6 +22,7 @@ using SvJumpTableType = SQLTableWithLibIncrPriKey<DBCon,
                                                   uint32_t, // query_from
                                                   uint32_t, // query_to
                                                   uint32_t, // num_supporting_nt
+                                                  uint32_t, // num_reads
                                                   bool, // from_forward
                                                   bool, // to_forward
                                                   bool, // was_mirrored
@@ -31,7 +33,11 @@ using SvJumpTableType = SQLTableWithLibIncrPriKey<DBCon,
 template <typename DBCon> class SvJumpTable : public SvJumpTableType<DBCon>
 {
     std::shared_ptr<DBCon> pDatabase;
+    // reads of merged jumps (see CompactingJumpInserterContainer)
+    SvJumpReadTable<DBCon> xReadTable;
     SQLQuery<DBCon, uint64_t> xQuerySize;
+    SQLQuery<DBCon, uint64_t> xQueryNumJumpsOfReads;
+    SQLQuery<DBCon, int64_t, uint64_t> xQueryStartHistogram;
     SQLStatement<DBCon> xDeleteRun;
     SQLStatement<DBCon> xEnableExtension;
 
@@ -50,6 +56,7 @@ template <typename DBCon> class SvJumpTable : public SvJumpTableType<DBCon>
                 { { COLUMN_NAME, "query_from" } },
                 { { COLUMN_NAME, "query_to" } },
                 { { COLUMN_NAME, "num_supporting_nt" } },
+                { { COLUMN_NAME, "num_reads" } },
                 { { COLUMN_NAME, "from_forward" } },
                 { { COLUMN_NAME, "to_forward" } },
                 { { COLUMN_NAME, "was_mirrored" } },
@@ -63,7 +70,18 @@ template <typename DBCon> class SvJumpTable : public SvJumpTableType<DBCon>
         : SvJumpTableType<DBCon>( pDatabase, // the database where the table resides
                                   jSvCallTableDef( ) ),
           pDatabase( pDatabase ),
+          xReadTable( pDatabase ),
           xQuerySize( pDatabase, "SELECT COUNT(*) FROM sv_jump_table WHERE sv_jump_run_id = ?" ),
+          xQueryNumJumpsOfReads( pDatabase, "SELECT COALESCE( SUM( num_reads ), 0 )::BIGINT FROM sv_jump_table "
+                                            "WHERE sv_jump_run_id = ?" ),
+          xQueryStartHistogram( pDatabase,
+                                "SELECT (sort_pos_start - ?) " INT_DIV " ?, COUNT(*) "
+                                "FROM sv_jump_table "
+                                "WHERE sv_jump_run_id = ? "
+                                "AND sort_pos_start >= ? "
+                                "AND sort_pos_start < ? "
+                                "GROUP BY 1 "
+                                "ORDER BY 1" ),
           xDeleteRun( pDatabase, "DELETE FROM sv_jump_table WHERE sv_jump_run_id IN ( SELECT id FROM "
                                  "sv_jump_run_table WHERE name = ?)" ),
           xEnableExtension( pDatabase, "CREATE EXTENSION IF NOT EXISTS btree_gist" )
@@ -81,18 +99,22 @@ template <typename DBCon> class SvJumpTable : public SvJumpTableType<DBCon>
         this->addIndex(
             json{ { INDEX_NAME, "sort_start" },
                   { INDEX_COLUMNS, "sort_pos_start, from_pos, to_pos, query_from, query_to, from_forward,"
-                                   " to_forward, was_mirrored, num_supporting_nt, id, read_id, sv_jump_run_id" } } );
+                                   " to_forward, was_mirrored, num_supporting_nt, num_reads, id, read_id,"
+                                   " sv_jump_run_id" } } );
 
         // index intended for the sweep over the end of all sv-rectangles
         this->addIndex(
             json{ { INDEX_NAME, "sort_end" },
                   { INDEX_COLUMNS, "sort_pos_end, from_pos, to_pos, query_from, query_to, from_forward,"
-                                   " to_forward, was_mirrored, num_supporting_nt, id, read_id, sv_jump_run_id" } } );
+                                   " to_forward, was_mirrored, num_supporting_nt, num_reads, id, read_id,"
+                                   " sv_jump_run_id" } } );
 
         this->addIndex( json{ { INDEX_NAME, "rect_jump" },
                               { INDEX_COLUMNS, "rectangle" },
                               { INDEX_TYPE, "SPATIAL" },
                               { INDEX_METHOD, "GIST" } } );
+
+        xReadTable.createIndices( );
     } // method
 
     inline void dropIndices( int64_t uiRun )
@@ -103,16 +125,49 @@ template <typename DBCon> class SvJumpTable : public SvJumpTableType<DBCon>
         this->dropIndex( json{ { INDEX_NAME, "sort_end" } } );
 
         this->dropIndex( json{ { INDEX_NAME, "rect_jump" } } );
+
+        xReadTable.dropIndices( );
     }
 
+    /**
+     * @brief number of rows of the run
+     * @details
+     * Merged jumps (see CompactingJumpInserterContainer) count once, regardless of their num_reads.
+     * This is the amount of work of the sweep (that processes rows), which is what GenomeSectionFactory balances.
+     * Use numJumpsOfReads for the number of jumps before merging.
+     */
     inline uint32_t numJumps( int64_t jump_run_id )
     {
         return xQuerySize.scalar( jump_run_id );
     } // method
 
+    /// @brief number of jumps of the run, where merged jumps count once per read (see numJumps)
+    inline uint64_t numJumpsOfReads( int64_t jump_run_id )
+    {
+        return xQueryNumJumpsOfReads.scalar( jump_run_id );
+    } // method
+
+    /**
+     * @brief histogram over the sort_pos_start of the jumps in [iFrom, iTo)
+     * @details
+     * Returns (bin index, number of jumps) for all non-empty bins in ascending order.
+     * Like numJumps, this counts rows (merged jumps count once).
+     * Bin i covers [iFrom + i * iBinSize, iFrom + (i + 1) * iBinSize).
+     */
+    inline std::vector<std::pair<int64_t, uint64_t>> startHistogram( int64_t jump_run_id, int64_t iFrom, int64_t iTo,
+                                                                     int64_t iBinSize )
+    {
+        std::vector<std::pair<int64_t, uint64_t>> vRet;
+        xQueryStartHistogram.execAndForAll(
+            [ & ]( int64_t iBin, uint64_t uiCount ) { vRet.emplace_back( iBin, uiCount ); }, iFrom, iBinSize,
+            jump_run_id, iFrom, iTo );
+        return vRet;
+    } // method
+
     inline void deleteRun( std::string& rS )
     {
-        xDeleteRun.execAndBind( rS );
+        xReadTable.deleteRun( rS );
+        xDeleteRun.exec( rS );
     } // method
 }; // class
 
@@ -0,0 +1,76 @@
+/**
+ * @file svJumpRead.h
+ * @details
+ * Database interface for the structural variant caller.
+ * One table of the database.
+ */
+#pragma once
+#include "sql_api.h"
+
+namespace libMSV
+{
+
+template <typename DBCon>
+using SvJumpReadTableType = SQLTable<DBCon,
+                                     PriKeyDefaultType, // jump_id
+                                     PriKeyDefaultType, // read_id (foreign key)
+                                     uint32_t, // query_from
+                                     uint32_t, // query_to
+                                     uint32_t // num_supporting_nt
+                                     >;
+
+/**
+ * @brief the additional reads of merged jumps
+ * @details
+ * CompactingJumpInserterContainer merges jumps of several reads into one row of the sv_jump_table.
+ * The read of the first merged jump is stored in the sv_jump_table itself, the reads of all others are stored here.
+ * Each row keeps the columns of the jump, that are not identical for all merged jumps.
+ * There is no foreign key on jump_id, since the rows are inserted with bulk inserters, that might write this table
+ * before the sv_jump_table.
+ */
+template <typename DBCon> class SvJumpReadTable : public SvJumpReadTableType<DBCon>
+{
+    SQLStatement<DBCon> xDeleteRun;
+
+  public:
+    json jSvJumpReadTableDef( )
+    {
+        return json{ { TABLE_NAME, "sv_jump_read_table" },
+                     { TABLE_COLUMNS,
+                       { { { COLUMN_NAME, "jump_id" } },
+                         { { COLUMN_NAME, "read_id" } },
+                         { { COLUMN_NAME, "query_from" } },
+                         { { COLUMN_NAME, "query_to" } },
+                         { { COLUMN_NAME, "num_supporting_nt" } } } },
+                     { FOREIGN_KEY, { { COLUMN_NAME, "read_id" }, { REFERENCES, "read_table(id)" } } } };
+    } // method
+
+    // increase the bulk inserter size on this table
+    using uiBulkInsertSize = std::integral_constant<size_t, 5000>;
+
+    SvJumpReadTable( std::shared_ptr<DBCon> pDatabase )
+        : SvJumpReadTableType<DBCon>( pDatabase, // the database where the table resides
+                                      jSvJumpReadTableDef( ) ),
+          xDeleteRun( pDatabase, "DELETE FROM sv_jump_read_table WHERE jump_id IN ( SELECT id FROM sv_jump_table "
+                                 "WHERE sv_jump_run_id IN ( SELECT id FROM sv_jump_run_table WHERE name = ?) )" )
+    {} // default constructor
+
+    inline void createIndices( )
+    {
+        this->addIndex( json{ { INDEX_NAME, "jump_read" },
+                              { INDEX_COLUMNS, "jump_id, read_id, query_from, query_to, num_supporting_nt" } } );
+    } // method
+
+    inline void dropIndices( )
+    {
+        this->dropIndex( json{ { INDEX_NAME, "jump_read" } } );
+    } // method
+
+    /// @brief must be called before the jumps of the run are deleted
+    inline void deleteRun( std::string& rS )
+    {
+        xDeleteRun.exec( rS );
+    } // method
+}; // class
+
+} // namespace libMSV
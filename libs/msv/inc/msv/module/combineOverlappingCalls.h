@@ -38,7 +38,9 @@ fetchCall( SQLQuery<DBCon, int64_t, uint32_t, uint32_t, uint32_t, uint32_t, bool
     xRet.first.iId = std::get<0>( xCallTup );
 
     metaMeasureAndLogDuration<LOG>( "xGetSupprotingJumps",
-                                    [ & ]( ) { xGetSupportingJumps.exec( std::get<0>( xCallTup ) ); } );
+                                    [ & ]( ) {
+                                        xGetSupportingJumps.exec( std::get<0>( xCallTup ), std::get<0>( xCallTup ) );
+                                    } );
     while( xGetSupportingJumps.next( ) )
     {
         auto xSupportTup = xGetSupportingJumps.get( );
@@ -237,6 +239,14 @@ size_t combineOverlappingCalls( const ParameterSetManager& rParameters,
             "sv_jump_table.id "
             "FROM sv_call_support_table "
             "JOIN sv_jump_table ON sv_call_support_table.jump_id = sv_jump_table.id "
+            "WHERE sv_call_support_table.call_id = ? "
+            // the additional reads of merged jumps (see CompactingJumpInserterContainer)
+            "UNION ALL "
+            "SELECT from_pos, to_pos, sv_jump_read_table.query_from, sv_jump_read_table.query_to, from_forward, "
+            "to_forward, was_mirrored, sv_jump_table.id "
+            "FROM sv_call_support_table "
+            "JOIN sv_jump_table ON sv_call_support_table.jump_id = sv_jump_table.id "
+            "JOIN sv_jump_read_table ON sv_jump_read_table.jump_id = sv_jump_table.id "
             "WHERE sv_call_support_table.call_id = ? ",
             json{ }, "combineOverlappingCalls::xGetSupprotingJumps" );
         SQLTable<DBCon, PriKeyDefaultType> xToDeleteTable( pOuterConnection,
@@ -311,6 +321,7 @@ size_t combineOverlappingCalls( const ParameterSetManager& rParameters,
                                                    "combineOverlappingCalls::xDeleteOverlapped" );
 
             metaMeasureAndLogDuration<LOG>( "xDeleteOverlapped", [ & ]( ) { xDeleteOverlapped.exec( ); } );
+            SvCallVersionTable<DBCon>( pOuterConnection ).bump( iSvCallerId );
         } // if
     } ); // xPool.run call
 
@@ -6,6 +6,10 @@
 #include "ms/container/sv_db/pool_container.h"
 #include "ma/module/needlemanWunsch.h"
 #include "msv/module/sweepSvJumps.h"
+#include <array>
+#include <atomic>
+#include <map>
+#include <unordered_map>
 
 namespace libMSV
 {
@@ -15,6 +19,11 @@ namespace libMSV
  * @details
  * Uses DP to check if the reference before and after the breakpoints matches better to itself than the reads to it.
  * If so it discards the SV.
+ * The reads of all calls in a batch are fetched up front with a few set based queries (instead of one query per
+ * supporting jump). The calls are scored sequentially, since the module already runs in each thread of the
+ * parallel graph.
+ * Jumps whose read is not in the database are skipped (and counted in uiNumMissingReads); calls without any
+ * available read are kept, since there is no evidence against them.
  */
 template <typename DBCon>
 class ConnectorPatternFilter : public Module<CompleteBipartiteSubgraphClusterVector, false,
@@ -22,136 +31,178 @@ class ConnectorPatternFilter : public Module<CompleteBipartiteSubgraphClusterVec
 {
   public:
     nucSeqIndex uiMaxExtensionSize = 100;
+    /// @brief maximal number of read ids per fetch query
+    size_t uiReadFetchChunkSize = 500;
     const KswCppParam<5> xKswParameters;
     const size_t uiZDrop;
+    /// @brief number of supporting jumps whose read could not be fetched
+    std::atomic<size_t> uiNumMissingReads;
+
+    /// @brief reference windows: left & right of the from position; down & up of the to position
+    typedef std::array<std::shared_ptr<NucSeq>, 4> RefWindows;
+    typedef std::unordered_map<int64_t, std::shared_ptr<NucSeq>> ReadCache;
 
     ConnectorPatternFilter( const ParameterSetManager& rParameters )
-        : uiZDrop( rParameters.getSelected( )->xZDrop->get( ) )
+        : uiZDrop( rParameters.getSelected( )->xZDrop->get( ) ), uiNumMissingReads( 0 )
     {} // constructor
 
+    /**
+     * @brief fetches the reads with the ids in vReadIds (sorted & unique) into rReads.
+     * @details
+     * Uses one "WHERE id IN ( ... )" query per uiReadFetchChunkSize reads.
+     * The ids are integers, so they can be inlined into the statement safely.
+     */
+    template <typename DBConPtr>
+    void fetchReads( DBConPtr pConnection, const std::vector<int64_t>& vReadIds, ReadCache& rReads )
+    {
+        for( size_t uiStart = 0; uiStart < vReadIds.size( ); uiStart += uiReadFetchChunkSize )
+        {
+            std::string sIds;
+            for( size_t uiI = uiStart; uiI < std::min( uiStart + uiReadFetchChunkSize, vReadIds.size( ) ); uiI++ )
+                sIds += ( uiI == uiStart ? "" : ", " ) + std::to_string( vReadIds[ uiI ] );
+            SQLQuery<DBCon, int64_t, std::shared_ptr<CompressedNucSeq>> xGetReads(
+                pConnection, "SELECT id, sequence FROM read_table WHERE id IN ( " + sIds + " ) " );
+            xGetReads.execAndForAll( [ & ]( int64_t iId, std::shared_ptr<CompressedNucSeq> pRead ) {
+                pRead->pUncomNucSeq->iId = iId;
+                rReads[ iId ] = pRead->pUncomNucSeq;
+            } ); // lambda
+        } // for
+    } // method
+
+    /**
+     * @brief extracts the reference windows of pCall.
+     * @details
+     * Calls in a batch often share breakpoints, so the extracted sections are cached in rCache.
+     */
+    RefWindows refWindows( std::shared_ptr<SvCall> pCall, Pack& rRef,
+                           std::map<std::pair<uint64_t, uint64_t>, std::shared_ptr<NucSeq>>& rCache )
+    {
+        auto fExtract = [ & ]( uint64_t iBegin, uint64_t iSize ) {
+            if( rRef.bridgingSubsection( iBegin, iSize ) )
+                rRef.unBridgeSubsection( iBegin, iSize );
+            auto& pCached = rCache[ std::make_pair( iBegin, iSize ) ];
+            if( pCached == nullptr )
+                pCached = rRef.vExtract( iBegin, iBegin + iSize );
+            // copy so that the cached section is not reversed / complemented
+            return std::make_shared<NucSeq>( *pCached );
+        }; // lambda
+
+        // uiMaxExtensionSize nucleotides before uiPos (reversed)
+        auto fBefore = [ & ]( nucSeqIndex uiPos ) {
+            auto pRet = uiPos > uiMaxExtensionSize ? fExtract( uiPos - uiMaxExtensionSize, uiMaxExtensionSize )
+                                                   : fExtract( 0, uiPos );
+            pRet->vReverse( );
+            return pRet;
+        }; // lambda
+
+        RefWindows aRet;
+        aRet[ 0 ] = fBefore( pCall->xXAxis.start( ) );
+        aRet[ 1 ] = fExtract( pCall->xXAxis.end( ), uiMaxExtensionSize );
+        aRet[ 2 ] = fBefore( pCall->xYAxis.start( ) );
+        aRet[ 3 ] = fExtract( pCall->xYAxis.end( ), uiMaxExtensionSize );
+
+        if( pCall->bFromForward != pCall->bToForward )
+        {
+            aRet[ 3 ].swap( aRet[ 2 ] );
+            aRet[ 3 ]->vSwitchAllBasePairsToComplement( );
+            aRet[ 2 ]->vSwitchAllBasePairsToComplement( );
+        } // if
+        return aRet;
+    } // method
+
+    /// @brief returns the score of the extension alignment of rA and rB (or 0 if it is negative)
+    int64_t extensionScore( NucSeq& rA, NucSeq& rB, AlignedMemoryManager& rMemoryManager )
+    {
+        Wrapper_ksw_extz_t ez;
+        kswcpp_dispatch( (int)rA.length( ), rA.pxSequenceRef, (int)rB.length( ), rB.pxSequenceRef, xKswParameters,
+                         100, (int)uiZDrop, KSW_EZ_EXTZ_ONLY, ez.ez, rMemoryManager );
+        return ez.ez->score > 0 ? ez.ez->score : 0;
+    } // method
+
+    /// @brief returns whether the reads match better to the reference windows of pCall than the windows to themselves
+    bool keepCall( std::shared_ptr<SvCall> pCall, RefWindows& rWindows, const ReadCache& rReads,
+                   AlignedMemoryManager& rMemoryManager )
+    {
+        auto& pNucSeqLeft = rWindows[ 0 ];
+        auto& pNucSeqRight = rWindows[ 1 ];
+        auto& pNucSeqDown = rWindows[ 2 ];
+        auto& pNucSeqUp = rWindows[ 3 ];
+
+        // compute the reference score
+        int64_t iReferenceScore = extensionScore( *pNucSeqLeft, *pNucSeqDown, rMemoryManager ) +
+                                  extensionScore( *pNucSeqRight, *pNucSeqUp, rMemoryManager );
+
+        // jumps whose read is missing do not contribute
+        int64_t iNumScoredJumps = 0;
+        for( auto pJump : pCall->vSupportingJumps )
+            if( rReads.count( pJump->iReadId ) != 0 )
+                iNumScoredJumps++;
+            else
+                uiNumMissingReads++;
+        if( iNumScoredJumps == 0 )
+            return true;
+
+        // compute the read scores
+        int64_t iReadScore = 0;
+        for( auto pJump : pCall->vSupportingJumps )
+        {
+            auto xRead = rReads.find( pJump->iReadId );
+            if( xRead == rReads.end( ) )
+                continue;
+            auto pRead = xRead->second;
+
+            int64_t iBegin = pJump->uiQueryFrom > uiMaxExtensionSize ? pJump->uiQueryFrom - uiMaxExtensionSize : 0;
+            int64_t iSize = pJump->uiQueryFrom > uiMaxExtensionSize ? uiMaxExtensionSize : pJump->uiQueryFrom;
+            NucSeq xReadLeft( pRead->fromTo( iBegin, iBegin + iSize ) );
+            xReadLeft.vReverse( );
+
+            iBegin = pJump->uiQueryTo;
+            iSize = pJump->uiQueryTo + uiMaxExtensionSize < pRead->length( ) ? uiMaxExtensionSize
+                                                                              : pRead->length( ) - pJump->uiQueryTo;
+            NucSeq xReadRight( pRead->fromTo( iBegin, iBegin + iSize ) );
+
+            iReadScore += extensionScore( xReadLeft, *pNucSeqUp, rMemoryManager ) +
+                          extensionScore( xReadRight, *pNucSeqDown, rMemoryManager );
+
+            if( iReadScore / iNumScoredJumps > iReferenceScore )
+                break;
+        } // for
+
+        // if the score for the read is better than the one purely on the reference, keep the call
+        return iReadScore / iNumScoredJumps > iReferenceScore;
+    } // method
+
+    /// @brief returns the calls of pCalls that pass the filter (in input order); rReads must hold their reads
+    std::shared_ptr<CompleteBipartiteSubgraphClusterVector>
+    filterCalls( std::shared_ptr<CompleteBipartiteSubgraphClusterVector> pCalls, const ReadCache& rReads, Pack& rRef )
+    {
+        std::map<std::pair<uint64_t, uint64_t>, std::shared_ptr<NucSeq>> xWindowCache;
+        AlignedMemoryManager xMemoryManager;
+        auto pRet = std::make_shared<CompleteBipartiteSubgraphClusterVector>( );
+        for( auto pCall : pCalls->vContent )
+        {
+            auto aWindows = refWindows( pCall, rRef, xWindowCache );
+            if( keepCall( pCall, aWindows, rReads, xMemoryManager ) )
+                pRet->vContent.push_back( pCall );
+        } // for
+        return pRet;
+    } // method
+
     std::shared_ptr<CompleteBipartiteSubgraphClusterVector>
     execute( std::shared_ptr<CompleteBipartiteSubgraphClusterVector> pCalls, std::shared_ptr<Pack> pRef,
              std::shared_ptr<libMS::PoolContainer<DBCon>> pPool )
     {
-        return pPool->xPool.run(
-            [this]( auto pConnection, std::shared_ptr<CompleteBipartiteSubgraphClusterVector> pCalls,
-                    std::shared_ptr<Pack> pRef ) {
-                SQLQuery<DBCon, std::shared_ptr<CompressedNucSeq>> xGetRead(
-                    pConnection, "SELECT sequence FROM read_table WHERE id = ? " );
-                AlignedMemoryManager xMemoryManager;
-
-                auto pRet = std::make_shared<CompleteBipartiteSubgraphClusterVector>( );
-
-                for( auto pCall : pCalls->vContent )
-                {
-                    int64_t iReferenceScore = 0;
-                    int64_t iReadScore = 0;
-
-                    // compute the reference score before the jump
-                    uint64_t iBegin =
-                        pCall->xXAxis.start( ) > uiMaxExtensionSize ? pCall->xXAxis.start( ) - uiMaxExtensionSize : 0;
-                    uint64_t iSize =
-                        pCall->xXAxis.start( ) > uiMaxExtensionSize ? uiMaxExtensionSize : pCall->xXAxis.start( );
-                    if( pRef->bridgingSubsection( iBegin, iSize ) )
-                        pRef->unBridgeSubsection( iBegin, iSize );
-                    auto pNucSeqLeft = pRef->vExtract( iBegin, iBegin + iSize );
-                    pNucSeqLeft->vReverse( );
-
-                    iBegin = pCall->xXAxis.end( );
-                    iSize = uiMaxExtensionSize;
-                    if( pRef->bridgingSubsection( iBegin, iSize ) )
-                        pRef->unBridgeSubsection( iBegin, iSize );
-                    auto pNucSeqRight = pRef->vExtract( iBegin, iBegin + iSize );
-
-                    iBegin =
-                        pCall->xYAxis.start( ) > uiMaxExtensionSize ? pCall->xYAxis.start( ) - uiMaxExtensionSize : 0;
-                    iSize = pCall->xYAxis.start( ) > uiMaxExtensionSize ? uiMaxExtensionSize : pCall->xYAxis.start( );
-                    if( pRef->bridgingSubsection( iBegin, iSize ) )
-                        pRef->unBridgeSubsection( iBegin, iSize );
-                    auto pNucSeqDown = pRef->vExtract( iBegin, iBegin + iSize );
-                    pNucSeqDown->vReverse( );
-
-                    iBegin = pCall->xYAxis.end( );
-                    iSize = uiMaxExtensionSize;
-                    if( pRef->bridgingSubsection( iBegin, iSize ) )
-                        pRef->unBridgeSubsection( iBegin, iSize );
-                    auto pNucSeqUp = pRef->vExtract( iBegin, iBegin + iSize );
-
-                    if( pCall->bFromForward != pCall->bToForward )
-                    {
-                        pNucSeqUp.swap( pNucSeqDown );
-                        pNucSeqUp->vSwitchAllBasePairsToComplement( );
-                        pNucSeqDown->vSwitchAllBasePairsToComplement( );
-                    } // if
-
-                    {
-                        Wrapper_ksw_extz_t ez;
-                        kswcpp_dispatch( (int)pNucSeqLeft->length( ), pNucSeqLeft->pxSequenceRef,
-                                         (int)pNucSeqDown->length( ), pNucSeqDown->pxSequenceRef, xKswParameters, 100,
-                                         (int)uiZDrop, KSW_EZ_EXTZ_ONLY, ez.ez, xMemoryManager );
-                        if( ez.ez->score > 0 )
-                            iReferenceScore += ez.ez->score;
-                    } // scope for ez
-                    {
-                        Wrapper_ksw_extz_t ez;
-                        kswcpp_dispatch( (int)pNucSeqRight->length( ), pNucSeqRight->pxSequenceRef,
-                                         (int)pNucSeqUp->length( ), pNucSeqUp->pxSequenceRef, xKswParameters, 100,
-                                         (int)uiZDrop, KSW_EZ_EXTZ_ONLY, ez.ez, xMemoryManager );
-                        if( ez.ez->score > 0 )
-                            iReferenceScore += ez.ez->score;
-                    } // scope for ez
-
-
-                    // compute the read scores
-                    for( auto pJump : pCall->vSupportingJumps )
-                    {
-                        // this db select puts quite the strain on the system...
-                        auto pRead = xGetRead.scalar( pJump->iReadId )->pUncomNucSeq;
-                        assert( pRead != nullptr );
-                        pRead->iId = pJump->iReadId;
-
-                        int64_t iBegin =
-                            pJump->uiQueryFrom > uiMaxExtensionSize ? pJump->uiQueryFrom - uiMaxExtensionSize : 0;
-                        int64_t iSize =
-                            pJump->uiQueryFrom > uiMaxExtensionSize ? uiMaxExtensionSize : pJump->uiQueryFrom;
-                        auto pNucSeqLeft = std::make_shared<NucSeq>( pRead->fromTo( iBegin, iBegin + iSize ) );
-                        pNucSeqLeft->vReverse( );
-
-                        iBegin = pJump->uiQueryTo;
-                        iSize = pJump->uiQueryTo + uiMaxExtensionSize < pRead->length( )
-                                    ? uiMaxExtensionSize
-                                    : pRead->length( ) - pJump->uiQueryTo;
-                        auto pNucSeqRight = std::make_shared<NucSeq>( pRead->fromTo( iBegin, iBegin + iSize ) );
-
-                        {
-                            Wrapper_ksw_extz_t ez;
-                            kswcpp_dispatch( (int)pNucSeqLeft->length( ), pNucSeqLeft->pxSequenceRef,
-                                             (int)pNucSeqUp->length( ), pNucSeqUp->pxSequenceRef, xKswParameters, 100,
-                                             (int)uiZDrop, KSW_EZ_EXTZ_ONLY, ez.ez, xMemoryManager );
-                            if( ez.ez->score > 0 )
-                                iReadScore += ez.ez->score;
-                        } // scope for ez
-                        {
-                            Wrapper_ksw_extz_t ez;
-                            kswcpp_dispatch( (int)pNucSeqRight->length( ), pNucSeqRight->pxSequenceRef,
-                                             (int)pNucSeqDown->length( ), pNucSeqDown->pxSequenceRef, xKswParameters,
-                                             100, (int)uiZDrop, KSW_EZ_EXTZ_ONLY, ez.ez, xMemoryManager );
-                            if( ez.ez->score > 0 )
-                                iReadScore += ez.ez->score;
-                        } // scope for ez
-
-                        if( iReadScore / (int64_t)pCall->vSupportingJumps.size( ) > iReferenceScore )
-                            break;
-                    } // for
-
-                    // if the score for the read is better than the one purely on the reference, keep the call
-                    if( iReadScore / (int64_t)pCall->vSupportingJumps.size( ) > iReferenceScore )
-                        pRet->vContent.push_back( pCall );
-                } // for
-
-                return pRet;
-            },
-            pCalls, pRef );
+        // fetch the reads of all calls
+        ReadCache xReads;
+        std::vector<int64_t> vReadIds;
+        for( auto pCall : pCalls->vContent )
+            for( auto pJump : pCall->vSupportingJumps )
+                vReadIds.push_back( pJump->iReadId );
+        std::sort( vReadIds.begin( ), vReadIds.end( ) );
+        vReadIds.erase( std::unique( vReadIds.begin( ), vReadIds.end( ) ), vReadIds.end( ) );
+        pPool->xPool.run( [ & ]( auto pConnection ) { fetchReads( pConnection, vReadIds, xReads ); } );
+
+        return filterCalls( pCalls, xReads, *pRef );
     } // method
 }; // class
 
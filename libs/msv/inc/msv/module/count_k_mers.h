@@ -409,12 +409,11 @@ class MMCounterModule : public Module<NucSeq, false, NucSeq, HashCounter>
 
     std::shared_ptr<NucSeq> execute( std::shared_ptr<NucSeq> pQuery, std::shared_ptr<HashCounter> pCounter )
     {
-        pQuery->vTranslateToCharacterForm( );
+        // the numeric form can be sketched directly (see minimizer::Index::seed_one)
         const char* sSeq = (const char*)pQuery->pxSequenceRef;
         const int iSize = (int)pQuery->length( );
         for( auto uiHash : minimizer::Index::_getHash( sSeq, iSize, k, w ) )
             pCounter->addHash( uiHash );
-        pQuery->vTranslateToNumericForm( );
         return pQuery;
     } // method
 }; // class
@@ -430,34 +429,33 @@ class MMFilteredSeeding : public Module<Seeds, false, minimizer::Index, NucSeq,
          bRectangular( rParameters.getSelected( )->xRectangularSoc->get( ) )
     {} // constructor
 
+    /**
+     * @brief filters query minimizers before they are turned to seeds via hash table lookup
+     * @details
+     * pArg must point to a std::pair<std::shared_ptr<HashCounter>, nucSeqIndex> (counter and max occurrence);
+     * a c function can only take void* as arguments.
+     */
+    static void filter( mm128_t* a, size_t& n, void* pArg )
+    {
+        // unpack arguments from c function
+        auto pPair = static_cast<std::pair<std::shared_ptr<HashCounter>, nucSeqIndex>*>( pArg );
+        size_t uiI = 0;
+        while( uiI < n )
+        {
+            if( !pPair->first->isUnique( minimizer::Index::_getHash( a[ uiI ] ), pPair->second ) )
+                a[ uiI ] = a[ --n ];
+            else
+                uiI++;
+        } // while
+    } // method
+
     std::shared_ptr<Seeds> execute( std::shared_ptr<minimizer::Index> pMMIndex, std::shared_ptr<NucSeq> pQuery,
                                     std::shared_ptr<Pack> pPack, std::shared_ptr<HashCounter> pCounter )
     {
-        pQuery->vTranslateToCharacterForm( );
-        const char* sSeq = (const char*)pQuery->pxSequenceRef;
-        const int iSize = (int)pQuery->length( );
         // pack arguments for c function
         auto xPtr = std::make_pair( pCounter, uiMaxOcc );
-        auto pRet = pMMIndex->seed_one(
-            sSeq, iSize, bRectangular, pPack,
-            // lambda function filters query minimizers before they are turned to seeds via hash table lookup
-            [/*cannot capture since lambda needs to be passed to c as function pointer*/]( mm128_t* a, size_t& n,
-                                                                                           void* pArg ) {
-                // unpack arguments from c function
-                auto pPair = static_cast<std::pair<std::shared_ptr<HashCounter>, nucSeqIndex>*>( pArg );
-                size_t uiI = 0;
-                while( uiI < n )
-                {
-                    if( !pPair->first->isUnique( minimizer::Index::_getHash( a[ uiI ] ), pPair->second ) )
-                        a[ uiI ] = a[ --n ];
-                    else
-                        uiI++;
-                } // while
-            },
-            // c function can only take void* as arguments
-            static_cast<void*>( &xPtr ) );
-        pQuery->vTranslateToNumericForm( );
-        return pRet;
+        return pMMIndex->seed_one( *pQuery, 0, pQuery->length( ), bRectangular, pPack, &filter,
+                                   static_cast<void*>( &xPtr ) );
     } // method
 
     static std::vector<size_t> for_( const Seed& rS, std::shared_ptr<minimizer::Index> pMMIndex,
@@ -465,14 +463,11 @@ class MMFilteredSeeding : public Module<Seeds, false, minimizer::Index, NucSeq,
                                      std::shared_ptr<HashCounter> pCounter, bool bRectangular )
     {
         assert( rS.end( ) <= pQuery->length( ) );
-        pQuery->vTranslateToCharacterForm( );
-        const char* sSeq = (const char*)( pQuery->pxSequenceRef + rS.start( ) );
-        const int iSize = (int)rS.size( );
         std::vector<size_t> vRet;
         // pack arguments for c function
         auto xPtr = std::make_pair( pCounter, &vRet );
-        auto pRet = pMMIndex->seed_one(
-            sSeq, iSize, bRectangular, pPack,
+        pMMIndex->seed_one(
+            *pQuery, rS.start( ), rS.end( ), bRectangular, pPack,
             // lambda function filters query minimizers before they are turned to seeds via hash table lookup
             [/*cannot capture since lambda needs to be passed to c as function pointer*/]( mm128_t* a, size_t& n,
                                                                                            void* pArg ) {
@@ -483,7 +478,6 @@ class MMFilteredSeeding : public Module<Seeds, false, minimizer::Index, NucSeq,
             },
             // c function can only take void* as arguments
             static_cast<void*>( &xPtr ) );
-        pQuery->vTranslateToNumericForm( );
         return vRet;
     } // method
 
@@ -513,6 +507,38 @@ class MMFilteredSeeding : public Module<Seeds, false, minimizer::Index, NucSeq,
     } // method
 }; // class
 
+/**
+ * @brief MMFilteredSeeding for a batch of reads.
+ * @details
+ * Seeds all reads with one minimizer::Index::seed_batch call,
+ * so that the minimizer lookups of the whole batch are grouped and prefetched.
+ */
+class MMFilteredBatchSeeding : public Module<ContainerVector<std::shared_ptr<Seeds>>, false, minimizer::Index,
+                                             ContainerVector<std::shared_ptr<NucSeq>>, Pack, HashCounter>
+{
+  public:
+    const nucSeqIndex uiMaxOcc;
+    bool bRectangular;
+
+    MMFilteredBatchSeeding( const ParameterSetManager& rParameters )
+        : uiMaxOcc( rParameters.getSelected( )->xMMFilterMaxOcc->get( ) ),
+          bRectangular( rParameters.getSelected( )->xRectangularSoc->get( ) )
+    {} // constructor
+
+    std::shared_ptr<ContainerVector<std::shared_ptr<Seeds>>>
+    execute( std::shared_ptr<minimizer::Index> pMMIndex,
+             std::shared_ptr<ContainerVector<std::shared_ptr<NucSeq>>> pQueries, std::shared_ptr<Pack> pPack,
+             std::shared_ptr<HashCounter> pCounter )
+    {
+        // pack arguments for c function
+        auto xPtr = std::make_pair( pCounter, uiMaxOcc );
+        auto pRet = std::make_shared<ContainerVector<std::shared_ptr<Seeds>>>( );
+        pRet->vContent = pMMIndex->seed_batch( pQueries->vContent, bRectangular, pPack, &MMFilteredSeeding::filter,
+                                               static_cast<void*>( &xPtr ) );
+        return pRet;
+    } // method
+}; // class
+
 } // namespace libMSV
 
 #ifdef WITH_PYTHON
@@ -26,9 +26,11 @@ class GenomeSection : public Container, public geom::Interval<int64_t>
 }; // class
 
 /**
- * @brief generates evenly spaced intervals over the length of the given pack
+ * @brief generates intervals over the length of the given pack
  * @details used for parallel implementation of the complete bipartite subgraph (CBSG) sweep.
- * last segment will most likely extend over the end of the genome.
+ * By default the intervals are evenly spaced; the last segment will most likely extend over the end of the genome.
+ * If the factory is given the jumps of a run, the intervals are sized by the number of jumps they contain instead
+ * (see computeBalancedSections).
  */
 class GenomeSectionFactory : public Module<GenomeSection, true>
 {
@@ -36,6 +38,17 @@ class GenomeSectionFactory : public Module<GenomeSection, true>
     int64_t iRefSize;
     int64_t iSectionSize;
     int64_t iCurrStart;
+    /// @brief precomputed sections (balanced mode only); handed out in this order
+    std::vector<std::shared_ptr<GenomeSection>> vSections;
+    /// @brief the number of jumps within each of vSections
+    std::vector<uint64_t> vNumJumps;
+
+    /// @brief the sweep should have roughly this many sections per thread
+    static constexpr size_t uiSectionsPerThread = 100;
+    /// @brief initial bin size of the jump histogram; oversized bins are refined by uiRefineFactor
+    static constexpr int64_t iInitialBinSize = 10000;
+    static constexpr int64_t iRefineFactor = 10;
+
     /**
      * @brief
      * @details
@@ -50,11 +63,120 @@ class GenomeSectionFactory : public Module<GenomeSection, true>
           iCurrStart( 0 )
     {} // constructor
 
+    /**
+     * @brief sizes the sections by the number of jumps of the run iSvCallerRunId
+     * @details
+     * The histogram over sort_pos_start is queried once here.
+     * Each section receives about #jumps / (#threads * uiSectionsPerThread) jumps.
+     * Histogram bins with more jumps than that are refined (by iRefineFactor) and split further,
+     * until the bins reach the overlap of the sweep (@see CompleteBipartiteSubgraphSweep::iMaxFuzziness).
+     * Below that size, splitting does not reduce the work per section anymore.
+     * The sections are handed out in descending order of their number of jumps,
+     * so that the largest ones do not end up last in the parallel sweep.
+     */
+    template <typename DBCon>
+    GenomeSectionFactory( const ParameterSetManager& rParameters, std::shared_ptr<Pack> pPack,
+                          std::shared_ptr<PoolContainer<DBCon>> pPool, int64_t iSvCallerRunId )
+        : GenomeSectionFactory( rParameters, pPack )
+    {
+        pPool->xPool.run( [ & ]( auto pConnection ) {
+            SvJumpTable<DBCon> xJumpTable( pConnection );
+            const uint64_t uiNumJumps = xJumpTable.numJumps( iSvCallerRunId );
+            const uint64_t uiTarget = std::max(
+                (uint64_t)1,
+                uiNumJumps / ( std::max( (size_t)1, rParameters.getNumThreads( ) ) * uiSectionsPerThread ) );
+            computeBalancedSections( xJumpTable, iSvCallerRunId, uiTarget );
+        } );
+    } // constructor
+
+    /// @brief fills vSections for all used sections of the sort_pos_start space (see SvJump::from_start)
+    template <typename DBCon>
+    void computeBalancedSections( SvJumpTable<DBCon>& rJumpTable, int64_t iSvCallerRunId, uint64_t uiTarget )
+    {
+        const int64_t iMinBinSize = std::max( (int64_t)1, (int64_t)pGlobalParams->xJumpH->get( ) * 10 );
+        const int64_t iStrandOffset = std::numeric_limits<int64_t>::max( ) / SvJump::FROM_POS_NUM_SECTIONS;
+        // jumps can start behind the end of the genome (e.g. dummy jumps with an unknown from position are moved by
+        // the seed direction fuzziness); the last section of each strand covers them as well
+        const int64_t iEndOverhang = (int64_t)pGlobalParams->xJumpH->get( ) * 10 +
+                                     (int64_t)pGlobalParams->xSeedDirFuzziness->get( );
+        std::vector<std::pair<std::shared_ptr<GenomeSection>, uint64_t>> vSectionsAndJumps;
+        for( int64_t iStrand = 0; iStrand < SvJump::FROM_POS_NUM_USED_SECTIONS; iStrand++ )
+        {
+            const int64_t iStrandStart = iStrand * iStrandOffset;
+            splitSection( rJumpTable, iSvCallerRunId, iStrandStart,
+                          std::min( iStrandStart + iStrandOffset, iStrandStart + iRefSize + iEndOverhang ),
+                          iInitialBinSize, iMinBinSize, uiTarget, vSectionsAndJumps );
+        } // for
+
+        std::stable_sort( vSectionsAndJumps.begin( ), vSectionsAndJumps.end( ),
+                          []( const auto& rA, const auto& rB ) { return rA.second > rB.second; } );
+        for( auto& xSection : vSectionsAndJumps )
+        {
+            vSections.push_back( xSection.first );
+            vNumJumps.push_back( xSection.second );
+        } // for
+    } // method
+
+    /**
+     * @brief splits [iFrom, iTo) into consecutive sections with about uiTarget jumps each
+     * @details
+     * Consecutive histogram bins are combined until they reach uiTarget jumps.
+     * A single bin with more than uiTarget jumps is split recursively with a finer histogram.
+     * The sections cover [iFrom, iTo) without gaps, since clusters are assigned to sections by their start.
+     */
+    template <typename DBCon>
+    void splitSection( SvJumpTable<DBCon>& rJumpTable, int64_t iSvCallerRunId, int64_t iFrom, int64_t iTo,
+                       int64_t iBinSize, int64_t iMinBinSize, uint64_t uiTarget,
+                       std::vector<std::pair<std::shared_ptr<GenomeSection>, uint64_t>>& rvOut )
+    {
+        int64_t iCurrFrom = iFrom;
+        uint64_t uiCurrNumJumps = 0;
+        for( auto& xBin : rJumpTable.startHistogram( iSvCallerRunId, iFrom, iTo, iBinSize ) )
+        {
+            const int64_t iBinStart = iFrom + xBin.first * iBinSize;
+            const int64_t iBinEnd = std::min( iTo, iBinStart + iBinSize );
+            // close the current section if this bin would make it too large
+            if( uiCurrNumJumps > 0 && uiCurrNumJumps + xBin.second > uiTarget )
+            {
+                rvOut.emplace_back( std::make_shared<GenomeSection>( iCurrFrom, iBinStart - iCurrFrom ),
+                                    uiCurrNumJumps );
+                iCurrFrom = iBinStart;
+                uiCurrNumJumps = 0;
+            } // if
+            if( xBin.second > uiTarget && iBinSize > iMinBinSize )
+            {
+                // an oversized bin: also covers the empty space before the bin
+                if( iCurrFrom < iBinStart )
+                    rvOut.emplace_back( std::make_shared<GenomeSection>( iCurrFrom, iBinStart - iCurrFrom ), 0 );
+                splitSection( rJumpTable, iSvCallerRunId, iBinStart, iBinEnd,
+                              std::max( iMinBinSize, iBinSize / iRefineFactor ), iMinBinSize, uiTarget, rvOut );
+                iCurrFrom = iBinEnd;
+                continue;
+            } // if
+            uiCurrNumJumps += xBin.second;
+            if( uiCurrNumJumps >= uiTarget )
+            {
+                rvOut.emplace_back( std::make_shared<GenomeSection>( iCurrFrom, iBinEnd - iCurrFrom ), uiCurrNumJumps );
+                iCurrFrom = iBinEnd;
+                uiCurrNumJumps = 0;
+            } // if
+        } // for
+        if( iCurrFrom < iTo )
+            rvOut.emplace_back( std::make_shared<GenomeSection>( iCurrFrom, iTo - iCurrFrom ), uiCurrNumJumps );
+    } // method
+
     virtual std::shared_ptr<GenomeSection> DLL_PORT( MSV ) execute( )
     {
         // setFinished( );
         // return std::make_shared<GenomeSection>( 0, std::numeric_limits<int64_t>::max( ) - 10000 );
 
+        if( !vSections.empty( ) )
+        {
+            if( (size_t)iCurrStart >= vSections.size( ) )
+                return nullptr;
+            return vSections[ iCurrStart++ ];
+        } // if
+
         auto pRet = std::make_shared<GenomeSection>(
             ( iCurrStart / SvJump::FROM_POS_NUM_USED_SECTIONS ) * iSectionSize +
                 ( iCurrStart % SvJump::FROM_POS_NUM_USED_SECTIONS ) *
@@ -122,12 +244,13 @@ class CompleteBipartiteSubgraphSweep
 
                 auto xInitStart = std::chrono::high_resolution_clock::now( );
                 // std::cout << "SortedSvJumpFromSql (" << pSection->iStart << ")" << std::endl;
-                SortedSvJumpFromSql<DBCon> xEdges(
-                    pConnection, iSvCallerRunId,
-                    // make sure we overlap the start of the next interval, so that clusters that span over two
-                    // intervals are being collected. -> for this we just keep going after the end of the interval
-                    pSection->start( ) > iMaxFuzziness ? pSection->start( ) - iMaxFuzziness : 0,
-                    pSection->end( ) + iMaxFuzziness );
+                // make sure we overlap the start of the next interval, so that clusters that span over two
+                // intervals are being collected. -> for this we just keep going after the end of the interval
+                int64_t iFetchStart = pSection->start( ) > iMaxFuzziness ? pSection->start( ) - iMaxFuzziness : 0;
+                int64_t iFetchEnd = pSection->end( ) + iMaxFuzziness;
+                SortedSvJumpFromSql<DBCon> xEdges( pConnection, iSvCallerRunId, iFetchStart, iFetchEnd );
+                // for jumps that were merged by a CompactingJumpInserterContainer
+                SvJumpReadsFromSql<DBCon> xJumpReads( pConnection, iSvCallerRunId, iFetchStart, iFetchEnd );
 
                 // std::cout << "sweep (" << pSection->iStart << ")" << std::endl;
 
@@ -244,7 +367,11 @@ class CompleteBipartiteSubgraphSweep
                             if( pCluster->xXAxis.start( ) < uiForwStrandEnd &&
                                 pCluster->xXAxis.start( ) >= uiForwStrandStart &&
                                 pCluster->uiNumSuppReads >= iMinReadsInCall )
+                            {
+                                // the following modules require one jump per read
+                                xJumpReads.expand( *pCluster );
                                 pRet->vContent.push_back( pCluster );
+                            } // if
                         } // if
                         auto xInnerEnd = std::chrono::high_resolution_clock::now( );
                         std::chrono::duration<double> xDiffInner = xInnerEnd - xInnerStart;
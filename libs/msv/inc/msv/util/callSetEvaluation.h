@@ -0,0 +1,139 @@
+/**
+ * @file callSetEvaluation.h
+ * @brief Evaluates the accuracy of a set of SV calls against a ground truth call set in memory.
+ */
+#pragma once
+
+#include "util/exported.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+namespace libMSV
+{
+/**
+ * @brief the information of a call that is required for the accuracy evaluation.
+ * @details
+ * The call covers the rectangle [uiFromStart, uiFromStart + uiFromSize] x [uiToStart, uiToStart + uiToSize]
+ * (the same rectangle as the rectangle column of the sv_call_table).
+ */
+struct EvaluationCall
+{
+    int64_t iId;
+    uint64_t uiFromStart;
+    uint64_t uiToStart;
+    uint64_t uiFromSize;
+    uint64_t uiToSize;
+    bool bFromForward;
+    bool bToForward;
+    double dScore;
+
+    EvaluationCall( int64_t iId, uint64_t uiFromStart, uint64_t uiToStart, uint64_t uiFromSize, uint64_t uiToSize,
+                    bool bFromForward, bool bToForward, double dScore )
+        : iId( iId ),
+          uiFromStart( uiFromStart ),
+          uiToStart( uiToStart ),
+          uiFromSize( uiFromSize ),
+          uiToSize( uiToSize ),
+          bFromForward( bFromForward ),
+          bToForward( bToForward ),
+          dScore( dScore )
+    {} // constructor
+
+    /// @brief the call mirrored on the matrix diagonal (the flipped_rectangle column of the sv_call_table)
+    EvaluationCall flipped( ) const
+    {
+        return EvaluationCall( iId, uiToStart, uiFromStart, uiToSize, uiFromSize, bFromForward, bToForward, dScore );
+    } // method
+}; // struct
+
+/**
+ * @brief spatial index over a set of calls.
+ * @details
+ * The calls are split into four buckets by their strand information.
+ * Within each bucket the calls are sorted by their from position, so that all calls within a distance of a rectangle
+ * can be found via binary search on the from position followed by a short linear scan.
+ * The index is immutable after construction and can therefore be queried by several threads at once.
+ */
+class CallSetIndex
+{
+    struct Bucket
+    {
+        std::vector<EvaluationCall> vCalls;
+        /// @brief maximal from size of all calls in the bucket; bounds the start of the scan
+        uint64_t uiMaxFromSize = 0;
+    }; // struct
+
+    std::array<Bucket, 4> aBuckets;
+
+    static size_t bucketId( bool bFromForward, bool bToForward )
+    {
+        return ( bFromForward ? 2 : 0 ) + ( bToForward ? 1 : 0 );
+    } // function
+
+    /// @brief calls fDo for all calls in the given bucket that are within iDist of the rectangle of rCall
+    template <typename F>
+    void forAllWithin( size_t uiBucket, const EvaluationCall& rCall, int64_t iDist, F&& fDo ) const
+    {
+        const Bucket& rBucket = aBuckets[ uiBucket ];
+        const int64_t iFirst = (int64_t)rCall.uiFromStart - iDist - (int64_t)rBucket.uiMaxFromSize;
+        const int64_t iLast = (int64_t)( rCall.uiFromStart + rCall.uiFromSize ) + iDist;
+        auto itBegin = std::lower_bound(
+            rBucket.vCalls.begin( ), rBucket.vCalls.end( ), iFirst,
+            []( const EvaluationCall& rA, int64_t iPos ) { return (int64_t)rA.uiFromStart < iPos; } );
+        for( auto itI = itBegin; itI != rBucket.vCalls.end( ) && (int64_t)itI->uiFromStart <= iLast; itI++ )
+            if( distanceSquared( *itI, rCall ) <= iDist * iDist )
+                fDo( *itI );
+    } // method
+
+  public:
+    CallSetIndex( std::vector<EvaluationCall> vCalls );
+
+    /// @brief squared euclidean distance of the rectangles of rA and rB (0 if they intersect)
+    static int64_t distanceSquared( const EvaluationCall& rA, const EvaluationCall& rB )
+    {
+        auto fGap = []( uint64_t uiStartA, uint64_t uiSizeA, uint64_t uiStartB, uint64_t uiSizeB ) {
+            if( uiStartA > uiStartB + uiSizeB )
+                return (int64_t)( uiStartA - ( uiStartB + uiSizeB ) );
+            if( uiStartB > uiStartA + uiSizeA )
+                return (int64_t)( uiStartB - ( uiStartA + uiSizeA ) );
+            return (int64_t)0;
+        }; // lambda
+        const int64_t iX = fGap( rA.uiFromStart, rA.uiFromSize, rB.uiFromStart, rB.uiFromSize );
+        const int64_t iY = fGap( rA.uiToStart, rA.uiToSize, rB.uiToStart, rB.uiToSize );
+        return iX * iX + iY * iY;
+    } // function
+
+    /**
+     * @brief calls fDo for all indexed calls that overlap rCall.
+     * @details
+     * Same semantic as SvCallTable::rectanglesOverlapSQL( rCall, indexed call ):
+     * Either the rectangles are within iDist and the strands match,
+     * or the indexed rectangle is within iDist of the flipped rectangle of rCall and the strands are inverted.
+     */
+    template <typename F> void forAllOverlapping( const EvaluationCall& rCall, int64_t iDist, F&& fDo ) const
+    {
+        forAllWithin( bucketId( rCall.bFromForward, rCall.bToForward ), rCall, iDist, fDo );
+        forAllWithin( bucketId( !rCall.bToForward, !rCall.bFromForward ), rCall.flipped( ), iDist, fDo );
+    } // method
+}; // class
+
+/**
+ * @brief computes the accuracy curve of vCalls with respect to vGroundTruth.
+ * @details
+ * Equivalent to the correlated PostGIS subqueries of SvCallsFromDb::countViaSql, but all calls are kept in memory:
+ * - ground truth calls that overlap a call of the ground truth with higher or equal score (with distance
+ *   2 * iAllowedDist) are ignored.
+ * - the data score of a ground truth call is the maximal score of all calls that overlap it (with distance
+ *   iAllowedDist) or -1 if there is no such call.
+ * Returns pair(list(tuple(x, calls with score >= x, ground truth calls with data score >= x)), |ground truth|),
+ * where x iterates over all distinct positive data scores in ascending order.
+ * The ground truth calls are processed by uiNumThreads threads.
+ */
+std::pair<std::vector<std::tuple<double, uint32_t, uint32_t>>, uint32_t> DLL_PORT( MSV )
+    evaluateCallSet( const std::vector<EvaluationCall>& vCalls, const std::vector<EvaluationCall>& vGroundTruth,
+                     int64_t iAllowedDist, size_t uiNumThreads = 1 );
+
+} // namespace libMSV
@@ -6,6 +6,7 @@
 #include "ma/container/nucSeq.h"
 #include "ma/container/pack.h"
 #include "util/geom.h"
+#include <vector>
 
 #pragma once
 
@@ -13,6 +14,52 @@ using namespace libMA;
 namespace libMSV
 {
 
+/**
+ * @brief Suffix array and LCP array of two concatenated sequences.
+ * @details
+ * The text is A $ B # (with unique separators $ and #, so that common prefixes never reach over the end of a sequence).
+ * The suffix array is built via induced sorting (SA-IS) and the LCP array via Kasai's algorithm; both in linear time.
+ * Repeat statistics of the two sequences can then be read off the LCP array without enumerating k-mers.
+ * This is the engine behind sampleKMerSize and sampleSequenceAmbiguity.
+ */
+class SequencePairSuffixArray
+{
+    /// @brief the text; nucleotides are shifted by two, so that 1 and 0 can be used as separator and sentinel
+    std::vector<size_t> vText;
+    /// @brief vSA[ i ] is the start of the i-th smallest suffix of vText
+    std::vector<size_t> vSA;
+    /// @brief vLCP[ i ] is the length of the longest common prefix of the suffixes vSA[ i - 1 ] and vSA[ i ]
+    std::vector<size_t> vLCP;
+    const nucSeqIndex uiSizeA;
+    const nucSeqIndex uiSizeB;
+
+    /// @brief returns the nucleotide left of the suffix at uiPos in vText or 0 if the suffix starts a sequence
+    inline size_t leftOf( size_t uiPos ) const
+    {
+        return uiPos == 0 || uiPos == uiSizeA + 1 ? 0 : vText[ uiPos - 1 ];
+    } // method
+
+  public:
+    DLL_PORT( MSV ) SequencePairSuffixArray( const NucSeq& rA, const NucSeq& rB );
+
+    /**
+     * @brief length of the longest substring that occurs at least twice in A and B (combined).
+     * @details
+     * So, longestRepeat() + 1 is the minimal k at which all k-mers of A and B are unique.
+     */
+    nucSeqIndex DLL_PORT( MSV ) longestRepeat( ) const;
+
+    /**
+     * @brief sum of the lengths of all maximal exact matches between A and B that are at least uiK long.
+     * @details
+     * A maximal exact match of length l consists of l - uiK + 1 consecutive k-mer matches on one diagonal.
+     * The k-mer matches are the pairs of an A and a B suffix within an interval of the suffix array where the LCP is
+     * >= uiK; the left maximal ones among them (different or no nucleotide on the left) start a maximal match.
+     * So, the sum is: #k-mer matches + ( uiK - 1 ) * #maximal matches.
+     */
+    nucSeqIndex DLL_PORT( MSV ) matchingNucleotides( nucSeqIndex uiK ) const;
+}; // class
+
 /**
  * @brief Determine the appropriate k-mers size for a "rectangle"
  * @details The formula used over here is:
@@ -25,10 +72,10 @@ nucSeqIndex DLL_PORT( MSV ) getKMerSizeForRectangle( geom::Rectangle<nucSeqIndex
 /**
  * @brief returns the size at which all k-mer's on the reference interval of xArea are unique.
  * @details
- * Currently implemented inefficiently.
+ * Returned relative to the statistically expected size (getKMerSizeForRectangle).
  */
-nucSeqIndex DLL_PORT( MSV ) sampleKMerSize( NucSeq& rSequenceA, NucSeq& rSequenceB, double t );
-inline nucSeqIndex sampleKMerSize( NucSeq& rSequence, double t )
+nucSeqIndex DLL_PORT( MSV ) sampleKMerSize( const NucSeq& rSequenceA, const NucSeq& rSequenceB, double t );
+inline nucSeqIndex sampleKMerSize( const NucSeq& rSequence, double t )
 {
     NucSeq xEmpty;
     return sampleKMerSize( rSequence, xEmpty, t );
@@ -37,12 +84,12 @@ inline nucSeqIndex sampleKMerSize( NucSeq& rSequence, double t )
 /**
  * @brief returns the number of non random nucleotide chains matching among the sequences
  * @details
- * Computes and lumps k-mers, so that all chains have lengths that have a likelyhood <= t to occur randomly.
- * Compares both sequences with themselves and each other, so the minimal returned value should be
- * the length of both sequences added together.
+ * Sums up the lengths of all maximal matches between the sequences, that have a likelyhood <= t to occur randomly.
+ * (Same result as lumping the HashMapSeeding k-mers; computed via SequencePairSuffixArray.)
+ * If both sequences are the same, the minimal returned value is the length of the sequence.
  */
-nucSeqIndex DLL_PORT( MSV ) sampleSequenceAmbiguity( NucSeq& rSequenceA, NucSeq& rSequenceB, double t );
-inline nucSeqIndex sampleSequenceAmbiguity( NucSeq& rSequence, double t )
+nucSeqIndex DLL_PORT( MSV ) sampleSequenceAmbiguity( const NucSeq& rSequenceA, const NucSeq& rSequenceB, double t );
+inline nucSeqIndex sampleSequenceAmbiguity( const NucSeq& rSequence, double t )
 {
     NucSeq xEmpty;
     return sampleSequenceAmbiguity( rSequence, xEmpty, t );
@@ -3,7 +3,10 @@ from MS import *
 from MA import *
 import datetime
 
-def compute_sv_jumps(parameter_set_manager, mm_index, pack, dataset_name, seq_ids=0, runtime_file=None):
+# compact_jumps: merge equal jumps of different reads into one row of the sv_jump_table
+# (see CompactingJumpInserterContainer); does not change the calls
+def compute_sv_jumps(parameter_set_manager, mm_index, pack, dataset_name, seq_ids=0, runtime_file=None,
+                     compact_jumps=False):
     #parameter_set_manager.by_name("Number of Threads").set(1)
     #parameter_set_manager.by_name("Use all Processor Cores").set(False)
     #assert parameter_set_manager.get_num_threads() == 1
@@ -22,9 +25,14 @@ def compute_sv_jumps(parameter_set_manager, mm_index, pack, dataset_name, seq_id
         jumps_from_seeds = SvJumpsFromExtractedSeeds(parameter_set_manager, pack)
         contig_filter = JumpsFilterContigBorder(parameter_set_manager)
         #filter_by_ambiguity = FilterJumpsByRefAmbiguity(parameter_set_manager)
-        get_jump_inserter = GetJumpInserter(parameter_set_manager, single_con, "MS-SV",
-                                            "python built comp graph")
-        jump_inserter_module = JumpInserterModule(parameter_set_manager)
+        if compact_jumps:
+            get_jump_inserter = GetCompactingJumpInserter(parameter_set_manager, single_con, "MS-SV",
+                                                          "python built comp graph")
+            jump_inserter_module = CompactingJumpInserterModule(parameter_set_manager)
+        else:
+            get_jump_inserter = GetJumpInserter(parameter_set_manager, single_con, "MS-SV",
+                                                "python built comp graph")
+            jump_inserter_module = JumpInserterModule(parameter_set_manager)
 
         mm_pledge = Pledge()
         mm_pledge.set(mm_index)
@@ -104,7 +112,7 @@ def compute_sv_jumps(parameter_set_manager, mm_index, pack, dataset_name, seq_id
 
     analyze = AnalyzeRuntimes()
 
-    print("num jumps:", jump_table.num_jumps(jump_id))
+    print("num jumps:", jump_table.num_jumps_of_reads(jump_id), "in", jump_table.num_jumps(jump_id), "rows")
 
     print("creating index...")
     start = datetime.datetime.now()
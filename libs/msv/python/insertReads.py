@@ -1,10 +1,27 @@
 from MS import *
 from MA import *
 from MSV import *
+import datetime
 
 
 def insert_reads(parameter_set, dataset_name, sequencer_name, file_queue, file_queue_2=None,
                  runtime_file=None, coverage=50):
+    # parse & compress on all threads, write through a single connection (see readImporter.h)
+    single_con = DbConn(dataset_name)
+    analyze = AnalyzeRuntimes()
+    start = datetime.datetime.now()
+    if file_queue_2 is None:
+        sequencer_id = import_reads(parameter_set, single_con, sequencer_name, file_queue, coverage)
+    else:
+        sequencer_id = import_paired_reads(parameter_set, single_con, sequencer_name,
+                                           combine_file_streams(file_queue, file_queue_2), coverage)
+    end = datetime.datetime.now()
+    analyze.register("import_reads", (end - start).total_seconds(), False, lambda x: x)
+    analyze.analyze(runtime_file)
+    return sequencer_id
+
+def insert_reads_graph(parameter_set, dataset_name, sequencer_name, file_queue, file_queue_2=None,
+                       runtime_file=None, coverage=50):
     #parameter_set.by_name("Number of Threads").set(16)
     #parameter_set.by_name("Use all Processor Cores").set(False)
     #assert parameter_set.get_num_threads() == 16
@@ -19,6 +19,8 @@ class Renderer():
         self.pack = None
         self.fm_index = None
         self.mm_counter = HashCounters()
+        # seeds of recently displayed reads; depends on the dataset, index and parameters (see _setup.py)
+        self.seed_cache = SeedDisplayCache()
         self.db_conn = None
         self.db_conn_2 = None
         self.db_pool = None
@@ -58,6 +60,8 @@ class Renderer():
         self.calls_from_db = None
         self.count_calls_from_db = None
         self.calls_from_db_gt = None
+        self.overview_tiles = None
+        self.do_overview_tiles = True
         self.print_to_tsv = True
 
     def get_run_id(self):
@@ -126,7 +130,7 @@ class Renderer():
     # imported methdos
     from ._render import render
     from ._setup import setup
-    from ._render_overview import render_overview
+    from ._render_overview import render_overview, render_jump_overview
     from ._render_calls import render_calls
     from ._render_jumps import render_jumps
     from ._render_reads import add_seed
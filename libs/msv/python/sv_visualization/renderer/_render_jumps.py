@@ -127,6 +127,8 @@ def render_jumps(self, jump_list=[], render_all=False):
                 self.main_plot.jump_x.data = patch
                 self.main_plot.update_selection(self)
             self.do_callback(callback)
+    elif self.do_overview_tiles and not self.do_render_call_jumps_only:
+        self.render_jump_overview()
 
     if self.w*3+self.h*3 < self.get_max_num_ele() or render_all:
         # render nucs in read plot
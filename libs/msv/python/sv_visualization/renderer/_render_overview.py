@@ -6,19 +6,7 @@ from MSV import *
 from .util import *
 
 
-def render_overview(self):
-    #self.plot.grid.visible = False
-    with self.measure("get_call_overview"):
-        if self.do_overview_cache():
-            rect_vec = self.get_global_overview()
-        else:
-            div = int(math.sqrt(self.get_max_num_ele()/10))
-            rect_vec = get_call_overview(self.db_pool, self.pack, self.get_run_id(), self.get_min_score(),
-                                            int(self.xs - self.w),
-                                            int(self.ys - self.h),
-                                            self.w*3, self.h*3,
-                                            self.w//div, self.h//div, self.give_up_factor)
-
+def overview_cds(self, rect_vec):
     cds = {
         'x': [],
         'y': [],
@@ -41,9 +29,50 @@ def render_overview(self):
             cds["f"].append(names[rect.i])
             cds["t"].append(names[rect.j])
             cds["i"].append(str(rect.c))
+    return cds
+
+def render_overview(self):
+    #self.plot.grid.visible = False
+    with self.measure("get_call_overview"):
+        if self.do_overview_tiles:
+            # serve the tile pyramid of the run (see OverviewTileTable.build); it is recomputed whenever the calls
+            # of the run changed
+            if not self.overview_tiles.has_tiles(self.get_run_id(), self.get_min_score()):
+                with self.measure("build overview tiles"):
+                    self.overview_tiles.build(self.get_run_id(), self.pack, self.get_min_score())
+            rect_vec = self.overview_tiles.tiles(self.get_run_id(), self.get_min_score(), self.pack,
+                                                 int(self.xs - self.w), int(self.ys - self.h), self.w*3, self.h*3,
+                                                 self.get_max_num_ele()//10)
+        elif self.do_overview_cache():
+            rect_vec = self.get_global_overview()
+        else:
+            div = int(math.sqrt(self.get_max_num_ele()/10))
+            rect_vec = get_call_overview(self.db_pool, self.pack, self.get_run_id(), self.get_min_score(),
+                                            int(self.xs - self.w),
+                                            int(self.ys - self.h),
+                                            self.w*3, self.h*3,
+                                            self.w//div, self.h//div, self.give_up_factor)
+
+    cds = overview_cds(self, rect_vec)
 
     def callback():
         self.main_plot.overview_quad.data = cds
     self.do_callback(callback)
 
     self.analyze.analyze()
+
+def render_jump_overview(self):
+    # there are too many jumps to render them individually: show the heatmap of the jump tiles of the run instead
+    # (see OverviewTileTable.build_jumps); it is computed once per run
+    with self.measure("get_jump_overview"):
+        if not self.overview_tiles.has_jump_tiles(self.get_run_id()):
+            with self.measure("build jump overview tiles"):
+                self.overview_tiles.build_jumps(self.get_run_id(), self.pack)
+        rect_vec = self.overview_tiles.jump_tiles(self.get_run_id(), self.pack,
+                                                  int(self.xs - self.w), int(self.ys - self.h), self.w*3, self.h*3,
+                                                  self.get_max_num_ele()//10)
+    cds = overview_cds(self, rect_vec)
+
+    def callback():
+        self.main_plot.jump_overview_quad.data = cds
+    self.do_callback(callback)
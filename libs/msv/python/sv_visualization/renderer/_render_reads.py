@@ -84,7 +84,7 @@ def render_reads(self, render_all=False):
             if self.do_render_seeds:
                 info_ret = seedDisplaysForReadIds(self.params, 
                                                         self.db_pool, self.read_ids, self.pack,
-                                                        self.mm_index, self.mm_counter,
+                                                        self.mm_index, self.mm_counter, self.seed_cache,
                                                         len(self.read_ids) > self.do_compressed_seeds, 
                                                         # 0 == infinite time for computing
                                                         3*self.get_max_num_ele()//10 if not render_all else 0)
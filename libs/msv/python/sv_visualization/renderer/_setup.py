@@ -33,6 +33,9 @@ def setup(self):
         self.calls_from_db = SvCallsFromDb(self.db_conn_3)
         self.count_calls_from_db = SvCallsFromDb(self.db_conn_4)
         self.calls_from_db_gt = SvCallsFromDb(self.db_conn_5)
+        self.overview_tiles = OverviewTileTable(self.db_conn)
+        self.mm_counter = HashCounters()
+        self.seed_cache.clear()
 
         # chromosome lines
         xs = [*self.pack.contigStarts(), self.pack.unpacked_size_single_strand]
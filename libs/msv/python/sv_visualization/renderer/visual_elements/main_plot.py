@@ -89,6 +89,14 @@ class MainPlot:
         self.plot.add_tools(HoverTool(tooltips=[("from", "@f"), ("to", "@t"), ("#calls", "@i")],
                                       names=["overview_quad"],
                                       name="Hover heatmap"))
+        # the overview of the jumps, if there are too many to render them individually
+        self.jump_overview_quad = ColumnDataSource({"x":[], "y":[], "w":[], "h":[], "c":[]})
+        self.plot.quad(left="x", bottom="y", right="w", top="h", color="c", line_width=0, fill_alpha=0.5,
+                       source=self.jump_overview_quad, name="jump_overview_quad")
+
+        self.plot.add_tools(HoverTool(tooltips=[("from", "@f"), ("to", "@t"), ("#jumps", "@i")],
+                                      names=["jump_overview_quad"],
+                                      name="Hover jump heatmap"))
 
         # make jumps and calls clickable
         self.plot.on_event(Tap, lambda tap: self.jump_or_call_tap(renderer, tap.x, tap.y))
@@ -210,4 +218,5 @@ class MainPlot:
         self.call_x.data = {"x":[], "y":[], "col":[]}
         self.ground_truth_x.data = {"x":[], "y":[], "col":[]}
         self.overview_quad.data = {"x":[], "y":[], "w":[], "h":[], "c":[]}
+        self.jump_overview_quad.data = {"x":[], "y":[], "w":[], "h":[], "c":[]}
         self.jump_x.data = {"x":[], "y":[]}
@@ -25,7 +25,8 @@ def sweep_sv_jumps(parameter_set_manager, dataset_name, run_id, name, desc, sequ
 
         assert len(sequencer_ids) == 1
 
-        section_fac = GenomeSectionFactory(parameter_set_manager, pack)
+        # sections are sized by their number of jumps, so that dense regions do not dominate the runtime
+        section_fac = BalancedGenomeSectionFactory(parameter_set_manager, pack, pool, run_id)
         lock_module = Lock(parameter_set_manager)
         sweep1 = CompleteBipartiteSubgraphSweep(parameter_set_manager, run_id)
         sweep2 = ExactCompleteBipartiteSubgraphSweep(parameter_set_manager)
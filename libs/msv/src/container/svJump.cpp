@@ -37,7 +37,8 @@ void exportSVJump( libMS::SubmoduleOrganizer& xOrganizer )
         .def_readwrite( "query_from", &SvJump::uiQueryFrom )
         .def_readwrite( "query_to", &SvJump::uiQueryTo )
         .def_readwrite( "id", &SvJump::iId )
-        .def_readonly( "read_id", &SvJump::iReadId );
+        .def_readonly( "read_id", &SvJump::iReadId )
+        .def_readonly( "num_reads", &SvJump::uiNumReads );
 
     // export the SvCall class
     py::bind_vector<std::vector<int64_t>>( xOrganizer._util( ), "int64_tVector", "docstr" );
@@ -26,7 +26,13 @@ void exportCallsFromDb( libMS::SubmoduleOrganizer& xOrganizer )
         .def( "init", ( void ( SvCallsFromDb<DBConSingle>::* )( int64_t, int64_t, int64_t, int64_t, int64_t ) ) &
                           SvCallsFromDb<DBConSingle>::initFetchQuery )
         .def( "next", &SvCallsFromDb<DBConSingle>::next )
-        .def( "count", &SvCallsFromDb<DBConSingle>::count )
+        .def( "count", ( std::pair<std::vector<std::tuple<double, uint32_t, uint32_t>>, uint32_t>(
+                             SvCallsFromDb<DBConSingle>::* )( int64_t, int64_t, int64_t, size_t ) ) &
+                             SvCallsFromDb<DBConSingle>::count )
+        .def( "count", ( std::pair<std::vector<std::tuple<double, uint32_t, uint32_t>>, uint32_t>(
+                             SvCallsFromDb<DBConSingle>::* )( int64_t, int64_t, int64_t ) ) &
+                             SvCallsFromDb<DBConSingle>::count )
+        .def( "countViaSql", &SvCallsFromDb<DBConSingle>::countViaSql )
         .def( "hasNext", &SvCallsFromDb<DBConSingle>::hasNext );
 } // function
 
@@ -11,6 +11,11 @@ void exportSvJumpInserter( libMS::SubmoduleOrganizer& xOrganizer )
     exportInserterContainer<GetJumpInserterContainerModule<DBCon, DBConSingle>>( xOrganizer, "JumpInserter" );
 
     exportModule<JumpInserterModule<DBCon>>( xOrganizer, "JumpInserterModule" );
+
+    exportInserterContainer<GetCompactingJumpInserterContainerModule<DBCon, DBConSingle>>( xOrganizer,
+                                                                                         "CompactingJumpInserter" );
+
+    exportModule<CompactingJumpInserterModule<DBCon>>( xOrganizer, "CompactingJumpInserterModule" );
 } // function
 
 #endif
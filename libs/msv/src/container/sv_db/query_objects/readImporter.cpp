@@ -0,0 +1,16 @@
+#include "msv/container/sv_db/query_objects/readImporter.h"
+
+using namespace libMSV;
+
+#ifdef WITH_PYTHON
+
+#include "ms/container/sv_db/py_db_conf.h"
+
+
+void exportReadImporter( libMS::SubmoduleOrganizer& xOrganizer )
+{
+    xOrganizer.util( ).def( "import_reads", &importReads<DBConSingle> );
+    xOrganizer.util( ).def( "import_paired_reads", &importPairedReads<DBConSingle> );
+} // function
+
+#endif
@@ -11,12 +11,20 @@
 #include "msv/container/sv_db/query_objects/jumpInserter.h"
 #include "msv/container/sv_db/query_objects/kMerInserter.h"
 #include "msv/container/sv_db/query_objects/nucSeqSql.h"
+#include "msv/container/sv_db/query_objects/readImporter.h"
 #include "msv/container/sv_db/query_objects/readInserter.h"
+#include "msv/container/sv_db/tables/overviewTile.h"
 #include "pybind11/stl.h"
 
 using namespace libMSV;
 
 
+/**
+ * @brief number of jumps in the given area (stops counting at uiLimit)
+ * @details
+ * Counts rows of the sv_jump_table: merged jumps (see CompactingJumpInserterContainer) count once, since the renderer
+ * draws them once.
+ */
 template <typename DBCon>
 uint32_t getNumJumpsInArea( std::shared_ptr<DBCon> pConnection, std::shared_ptr<Pack> pPack, int64_t iRunId, int64_t iX,
                             int64_t iY, uint64_t uiW, uint64_t uiH, uint64_t uiLimit )
@@ -147,7 +155,8 @@ void exportSoCDbWriter( libMS::SubmoduleOrganizer& xOrganizer )
         .def( py::init<std::shared_ptr<DBConSingle>>( ) )
         .def( "create_indices", &SvJumpTable<DBConSingle>::createIndices )
         .def( "drop_indices", &SvJumpTable<DBConSingle>::dropIndices )
-        .def( "num_jumps", &SvJumpTable<DBConSingle>::numJumps );
+        .def( "num_jumps", &SvJumpTable<DBConSingle>::numJumps )
+        .def( "num_jumps_of_reads", &SvJumpTable<DBConSingle>::numJumpsOfReads );
 
     py::class_<ReadTable<DBConSingle>, std::shared_ptr<ReadTable<DBConSingle>>>( xOrganizer.util( ), "ReadTable" )
         .def( py::init<std::shared_ptr<DBConSingle>>( ) )
@@ -155,7 +164,9 @@ void exportSoCDbWriter( libMS::SubmoduleOrganizer& xOrganizer )
         .def( "get_read_id", &ReadTable<DBConSingle>::getReadId )
         .def( "get_seq_id", &ReadTable<DBConSingle>::getSeqId )
         .def( "read_name", &ReadTable<DBConSingle>::readName )
-        .def( "get_used_reads", &ReadTable<DBConSingle>::getUsedReads );
+        .def( "get_used_reads", &ReadTable<DBConSingle>::getUsedReads )
+        .def( "drop_indices", &ReadTable<DBConSingle>::dropIndices )
+        .def( "gen_indices", &ReadTable<DBConSingle>::genIndices );
 
     py::class_<ReadRangeTable<DBConSingle>, std::shared_ptr<ReadRangeTable<DBConSingle>>>( xOrganizer.util( ),
                                                                                            "ReadRangeTable" )
@@ -189,6 +200,16 @@ void exportSoCDbWriter( libMS::SubmoduleOrganizer& xOrganizer )
         .def( "newest_unique_runs", &SvCallerRunTable<DBConSingle>::getNewestUnique )
         .def( "getDate", &SvCallerRunTable<DBConSingle>::getDate );
 
+    py::class_<OverviewTileTable<DBConSingle>, std::shared_ptr<OverviewTileTable<DBConSingle>>>( xOrganizer.util( ),
+                                                                                                 "OverviewTileTable" )
+        .def( py::init<std::shared_ptr<DBConSingle>>( ) )
+        .def( "build", &OverviewTileTable<DBConSingle>::build )
+        .def( "has_tiles", &OverviewTileTable<DBConSingle>::hasTiles )
+        .def( "tiles", &OverviewTileTable<DBConSingle>::tiles )
+        .def( "build_jumps", &OverviewTileTable<DBConSingle>::buildJumps )
+        .def( "has_jump_tiles", &OverviewTileTable<DBConSingle>::hasJumpTiles )
+        .def( "jump_tiles", &OverviewTileTable<DBConSingle>::jumpTiles );
+
     py::class_<rect>( xOrganizer.util( ), "rect" ) //
         .def_readonly( "x", &rect::x )
         .def_readonly( "y", &rect::y )
@@ -216,6 +237,7 @@ void exportSoCDbWriter( libMS::SubmoduleOrganizer& xOrganizer )
     exportSvJumpInserter( xOrganizer );
     exportNucSeqSql( xOrganizer );
     exportReadInserter( xOrganizer );
+    exportReadImporter( xOrganizer );
     exportKMerInserter( xOrganizer );
 } // function
 #endif // WITH_PYTHON
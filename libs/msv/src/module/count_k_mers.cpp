@@ -26,5 +26,6 @@ void exportCountKMers( libMS::SubmoduleOrganizer& xOrganizer )
         x.def( "get_min_count", &MMFilteredSeeding::getMinCount )
             .def( "get_max_count", &MMFilteredSeeding::getMaxCount );
     } );
+    exportModule<MMFilteredBatchSeeding>( xOrganizer, "MMFilteredBatchSeeding" );
 } // function
 #endif
\ No newline at end of file
@@ -283,9 +283,9 @@ void SvJumpsFromSeeds::computeSeeds( geom::Rectangle<nucSeqIndex>& xArea, std::s
         } // if
         return;
         auto pFAlignment = std::make_shared<Alignment>( xArea.xXAxis.start( ), xArea.xYAxis.start( ) );
-        AlignedMemoryManager xMemoryManager; // @todo this causes frequent (de-)&allocations; move this outwards
+        DPWorkspace& rWorkspace = DPWorkspace::local( );
         xNW.ksw( pQuery, pRef, xArea.xYAxis.start( ), xArea.xYAxis.end( ) - 1, 0, pRef->length( ) - 1, pFAlignment,
-                 xMemoryManager );
+                 rWorkspace );
         auto pForwSeeds = pFAlignment->toSeeds( pRefSeq );
         for( Seed& rSeed : *pForwSeeds )
             libMA::ExtractSeeds::setDeltaOfSeed( rSeed, pQuery->length( ), *pRefSeq, true );
@@ -293,7 +293,7 @@ void SvJumpsFromSeeds::computeSeeds( geom::Rectangle<nucSeqIndex>& xArea, std::s
         // and now the reverse strand seeds
         auto pRAlignment = std::make_shared<Alignment>( );
         xNW.ksw( pQuery, pRefRevComp, xArea.xYAxis.start( ), xArea.xYAxis.end( ) - 1, 0, pRefRevComp->length( ) - 1,
-                 pRAlignment, xMemoryManager );
+                 pRAlignment, rWorkspace );
         auto pRevSeeds = pRAlignment->toSeeds( pRefSeq );
         for( Seed& rSeed : *pRevSeeds )
         {
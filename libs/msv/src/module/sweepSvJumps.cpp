@@ -31,6 +31,8 @@ void exportSweepSvJump( libMS::SubmoduleOrganizer& xOrganizer )
         .def_readwrite( "content", &CompleteBipartiteSubgraphClusterVector::vContent );
 
     exportModule<GenomeSectionFactory, std::shared_ptr<Pack>>( xOrganizer, "GenomeSectionFactory" );
+    exportModuleAlternateConstructor<GenomeSectionFactory, std::shared_ptr<Pack>, std::shared_ptr<PoolContainer<DBCon>>,
+                                     int64_t>( xOrganizer, "BalancedGenomeSectionFactory" );
 
 
     exportModule<CompleteBipartiteSubgraphSweep<DBCon>, int64_t>(
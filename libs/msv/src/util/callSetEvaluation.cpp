@@ -0,0 +1,97 @@
+/**
+ * @file callSetEvaluation.cpp
+ */
+#include "msv/util/callSetEvaluation.h"
+#include <cmath>
+#include <iostream>
+#include <limits>
+// threadPool.h requires iostream
+#include "util/threadPool.h"
+
+using namespace libMSV;
+
+CallSetIndex::CallSetIndex( std::vector<EvaluationCall> vCalls )
+{
+    for( auto& rCall : vCalls )
+    {
+        Bucket& rBucket = aBuckets[ bucketId( rCall.bFromForward, rCall.bToForward ) ];
+        rBucket.uiMaxFromSize = std::max( rBucket.uiMaxFromSize, rCall.uiFromSize );
+        rBucket.vCalls.push_back( rCall );
+    } // for
+    for( auto& rBucket : aBuckets )
+        std::sort( rBucket.vCalls.begin( ), rBucket.vCalls.end( ), []( const EvaluationCall& rA,
+                                                                       const EvaluationCall& rB ) {
+            return rA.uiFromStart < rB.uiFromStart;
+        } ); // lambda
+} // constructor
+
+std::pair<std::vector<std::tuple<double, uint32_t, uint32_t>>, uint32_t>
+libMSV::evaluateCallSet( const std::vector<EvaluationCall>& vCalls, const std::vector<EvaluationCall>& vGroundTruth,
+                         int64_t iAllowedDist, size_t uiNumThreads )
+{
+    const CallSetIndex xCalls( vCalls );
+    const CallSetIndex xGroundTruth( vGroundTruth );
+
+    // data score of each ground truth call; NaN for ground truth calls that are overlapped by a better one
+    std::vector<double> vDataScores( vGroundTruth.size( ) );
+    {
+        const size_t uiNumTasks = std::max( (size_t)1, std::min( uiNumThreads, vGroundTruth.size( ) ) );
+        ThreadPool xWorkers( uiNumTasks > 1 ? uiNumTasks : 0 );
+        std::vector<std::future<void>> vFutures;
+        for( size_t uiTask = 0; uiTask < uiNumTasks; uiTask++ )
+            vFutures.push_back( xWorkers.enqueue(
+                [ & ]( size_t, size_t uiTask ) {
+                    for( size_t uiI = uiTask; uiI < vGroundTruth.size( ); uiI += uiNumTasks )
+                    {
+                        const EvaluationCall& rGT = vGroundTruth[ uiI ];
+                        // self intersection must be x2 other intersection to cancel out double true positive calls
+                        bool bOverlapped = false;
+                        xGroundTruth.forAllOverlapping( rGT, iAllowedDist * 2, [ & ]( const EvaluationCall& rOther ) {
+                            bOverlapped |= rOther.iId != rGT.iId && rOther.dScore >= rGT.dScore;
+                        } ); // lambda
+                        if( bOverlapped )
+                        {
+                            vDataScores[ uiI ] = std::numeric_limits<double>::quiet_NaN( );
+                            continue;
+                        } // if
+                        double dDataScore = -1;
+                        xCalls.forAllOverlapping( rGT, iAllowedDist, [ & ]( const EvaluationCall& rCall ) {
+                            dDataScore = std::max( dDataScore, rCall.dScore );
+                        } ); // lambda
+                        vDataScores[ uiI ] = dDataScore;
+                    } // for
+                },
+                uiTask ) );
+        for( auto& xFuture : vFutures )
+            xFuture.get( );
+    } // scope for xWorkers
+    vDataScores.erase( std::remove_if( vDataScores.begin( ), vDataScores.end( ),
+                                       []( double dScore ) { return std::isnan( dScore ); } ),
+                       vDataScores.end( ) );
+    std::sort( vDataScores.begin( ), vDataScores.end( ) );
+
+    std::vector<double> vCallScores;
+    vCallScores.reserve( vCalls.size( ) );
+    for( auto& rCall : vCalls )
+        vCallScores.push_back( rCall.dScore );
+    std::sort( vCallScores.begin( ), vCallScores.end( ) );
+
+    // walk over the distinct data scores in ascending order
+    std::vector<std::tuple<double, uint32_t, uint32_t>> vRet;
+    const size_t uiNumGT = vDataScores.size( );
+    for( size_t uiI = 0; uiI < uiNumGT; )
+    {
+        size_t uiJ = uiI + 1;
+        while( uiJ < uiNumGT && vDataScores[ uiJ ] == vDataScores[ uiI ] )
+            uiJ++;
+        if( vDataScores[ uiI ] > 0 )
+        {
+            // number of calls with score >= vDataScores[ uiI ]
+            size_t uiNumCalls = vCallScores.end( ) - std::lower_bound( vCallScores.begin( ), vCallScores.end( ),
+                                                                        vDataScores[ uiI ] );
+            vRet.emplace_back( vDataScores[ uiI ], (uint32_t)uiNumCalls, (uint32_t)( uiNumGT - uiI ) );
+        } // if
+        uiI = uiJ;
+    } // for
+    return std::make_pair( vRet, (uint32_t)uiNumGT );
+} // function
@@ -15,6 +15,11 @@
 #include "msv/container/sv_db/tables/read.h"
 #include "msv/module/count_k_mers.h"
 #include "msv/module/svJumpsFromSeeds.h"
+/// @cond DOXYGEN_SHOW_SYSTEM_INCLUDES
+#include <atomic>
+#include <list>
+#include <mutex>
+/// @endcond
 
 using namespace libMSV;
 using namespace libMS;
@@ -58,12 +63,11 @@ struct RectangleInfo
 }; // struct
 
 
-void addSeed( Seed& rSeed, std::vector<SeedInfo>& vRet, std::vector<std::pair<nucSeqIndex, int64_t>>& vEndColumn,
-              std::vector<int64_t>& vAllColIds, size_t uiCategoryCounter, bool bParlindrome, bool bOverlapping,
-              int64_t iLayer, int64_t iReadId, size_t uiSeedOrderOnQuery, std::string sReadName,
-              std::shared_ptr<HashCounter> pCounter, std::shared_ptr<Pack> pPack,
-              std::shared_ptr<minimizer::Index> pMMIndex, std::shared_ptr<NucSeq> pRead, bool bInSocReseed,
-              bool bRectSoc, size_t uiSocId )
+/// @brief display information of a seed; the column (uiCategory) is set by placeSeed
+SeedInfo seedInfo( Seed& rSeed, bool bParlindrome, bool bOverlapping, int64_t iLayer, int64_t iReadId,
+                   size_t uiSeedOrderOnQuery, std::string sReadName, std::shared_ptr<HashCounter> pCounter,
+                   std::shared_ptr<Pack> pPack, std::shared_ptr<minimizer::Index> pMMIndex,
+                   std::shared_ptr<NucSeq> pRead, bool bInSocReseed, bool bRectSoc, size_t uiSocId )
 {
     float fCenter = rSeed.start_ref( ) + rSeed.size( ) / 2.0f;
     nucSeqIndex uiR = rSeed.start_ref( );
@@ -75,52 +79,60 @@ void addSeed( Seed& rSeed, std::vector<SeedInfo>& vRet, std::vector<std::pair<nu
         xX = std::make_pair( rSeed.start_ref( ) + 1, rSeed.start_ref( ) - rSeed.size( ) + 1 );
     } // if
 
-    // picks y-axis column to render seed in
+    size_t uiMax = MMFilteredSeeding::getMinCount( rSeed, pMMIndex, pRead, pPack, pCounter, bRectSoc );
+    size_t uiMin = MMFilteredSeeding::getMaxCount( rSeed, pMMIndex, pRead, pPack, pCounter, bRectSoc );
+
+    return SeedInfo{ fCenter,
+                     iReadId,
+                     sReadName,
+                     rSeed.size( ),
+                     rSeed.start( ),
+                     uiR,
+                     rSeed.size( ),
+                     uiSeedOrderOnQuery,
+                     rSeed.bOnForwStrand,
+                     iLayer,
+                     bParlindrome,
+                     bOverlapping,
+                     bInSocReseed,
+                     xX,
+                     std::make_pair( rSeed.start( ), rSeed.end( ) ),
+                     0,
+                     uiMin,
+                     uiMax,
+                     rSeed.uiSoCNt,
+                     uiSocId };
+} // function
+
+/// @brief start_ref of the seed that rInfo was created from (see seedInfo)
+nucSeqIndex startRef( const SeedInfo& rInfo )
+{
+    return rInfo.bOnForward ? rInfo.uiR : rInfo.uiR + rInfo.uiSize - 1;
+} // function
+
+/// @brief picks the y-axis column to render the seed in and appends the seed to vRet
+void placeSeed( SeedInfo xInfo, std::vector<SeedInfo>& vRet, std::vector<std::pair<nucSeqIndex, int64_t>>& vEndColumn,
+                std::vector<int64_t>& vAllColIds, size_t uiCategoryCounter )
+{
     size_t uiCurrColumn = 0;
     while( uiCurrColumn < vEndColumn.size( ) &&
-           uiR <= std::get<0>( vEndColumn[ uiCurrColumn ] ) +
-                      ( std::get<1>( vEndColumn[ uiCurrColumn ] ) == iReadId ? 0 : 100 ) )
+           xInfo.uiR <= std::get<0>( vEndColumn[ uiCurrColumn ] ) +
+                            ( std::get<1>( vEndColumn[ uiCurrColumn ] ) == xInfo.iReadId ? 0 : 100 ) )
         uiCurrColumn++;
     if( uiCurrColumn >= vEndColumn.size( ) )
     {
         vEndColumn.emplace_back( 0, 0 );
         vAllColIds.push_back( uiCurrColumn + uiCategoryCounter );
     } // if
-    std::get<0>( vEndColumn[ uiCurrColumn ] ) = uiR + rSeed.size( );
-    std::get<1>( vEndColumn[ uiCurrColumn ] ) = iReadId;
-
-
-    size_t uiMax = MMFilteredSeeding::getMinCount( rSeed, pMMIndex, pRead, pPack, pCounter, bRectSoc );
-    size_t uiMin = MMFilteredSeeding::getMaxCount( rSeed, pMMIndex, pRead, pPack, pCounter, bRectSoc );
+    std::get<0>( vEndColumn[ uiCurrColumn ] ) = xInfo.uiR + xInfo.uiSize;
+    std::get<1>( vEndColumn[ uiCurrColumn ] ) = xInfo.iReadId;
 
-    vRet.emplace_back( SeedInfo{ fCenter,
-                                 iReadId,
-                                 sReadName,
-                                 rSeed.size( ),
-                                 rSeed.start( ),
-                                 uiR,
-                                 rSeed.size( ),
-                                 uiSeedOrderOnQuery,
-                                 rSeed.bOnForwStrand,
-                                 iLayer,
-                                 bParlindrome,
-                                 bOverlapping,
-                                 bInSocReseed,
-                                 xX,
-                                 std::make_pair( rSeed.start( ), rSeed.end( ) ),
-                                 uiCurrColumn + uiCategoryCounter,
-                                 uiMin,
-                                 uiMax,
-                                 rSeed.uiSoCNt,
-                                 uiSocId } );
+    xInfo.uiCategory = uiCurrColumn + uiCategoryCounter;
+    vRet.push_back( std::move( xInfo ) );
 } // function
 
-void addRectangle( std::vector<RectangleInfo>& vRectangles,
-                   HelperRetVal& xHelper,
-                   size_t uiCategoryCounter,
-                   int64_t iReadId,
-                   size_t uiEndColumnSize,
-                   bool bInSoCReseeding )
+/// @brief the rectangles of a read; uiCategory and uiEndColumnSize are set by the layout
+RectangleInfo rectangleInfo( HelperRetVal& xHelper, int64_t iReadId, bool bInSoCReseeding )
 {
     RectangleInfo xInfo{ };
     xInfo.vRectangles.swap( xHelper.vRectangles );
@@ -129,11 +141,11 @@ void addRectangle( std::vector<RectangleInfo>& vRectangles,
     xInfo.vRectangleReferenceAmbiguity.swap( xHelper.vRectangleReferenceAmbiguity );
     xInfo.vRectangleKMerSize.swap( xHelper.vRectangleKMerSize );
     xInfo.vRectangleUsedDp.swap( xHelper.vRectangleUsedDp );
-    xInfo.uiCategory = uiCategoryCounter;
-    xInfo.uiEndColumnSize = uiEndColumnSize;
+    xInfo.uiCategory = 0;
+    xInfo.uiEndColumnSize = 0;
     xInfo.iReadId = iReadId;
     xInfo.bInSoCReseeding = bInSoCReseeding;
-    vRectangles.push_back( xInfo );
+    return xInfo;
 } // function
 
 
@@ -152,6 +164,146 @@ struct HashCounters
     std::map<int64_t, std::shared_ptr<HashCounter>> xCounters;
 }; // struct
 
+/**
+ * @brief the seeds and rectangles of a single read
+ * @details
+ * Contains everything of the seed plot that only depends on the read: all but the columns of the seeds, which depend
+ * on the other reads that are displayed.
+ */
+struct ReadSeedDisplay
+{
+    std::shared_ptr<NucSeq> pRead;
+    /// sorted by start_ref; uiCategory is not set
+    std::vector<SeedInfo> vSeeds;
+    RectangleInfo xRectangles;
+}; // struct
+
+/**
+ * @brief LRU cache of the seed displays of reads (by read id)
+ * @details
+ * The viewer shows the seeds of the reads whose jumps are in the current area. Panning and zooming shows mostly the
+ * same reads again; with this cache seedDisplaysForReadIds only fetches and seeds the reads that were not shown
+ * recently.
+ * The seed displays depend on the parameters, the dataset and the index; clear the cache if one of them changes.
+ */
+class SeedDisplayCache
+{
+    typedef std::list<std::pair<int64_t, std::shared_ptr<ReadSeedDisplay>>> LruList;
+
+    std::mutex xMutex;
+    /// most recently used entry first
+    LruList xLru;
+    std::map<int64_t, LruList::iterator> xIndex;
+
+  public:
+    const size_t uiMaxReads;
+
+    SeedDisplayCache( size_t uiMaxReads ) : uiMaxReads( uiMaxReads )
+    {} // constructor
+
+    /// @brief nullptr if the read is not cached
+    std::shared_ptr<ReadSeedDisplay> get( int64_t iReadId )
+    {
+        std::lock_guard<std::mutex> xGuard( xMutex );
+        auto xIt = xIndex.find( iReadId );
+        if( xIt == xIndex.end( ) )
+            return nullptr;
+        xLru.splice( xLru.begin( ), xLru, xIt->second );
+        return xIt->second->second;
+    } // method
+
+    void put( int64_t iReadId, std::shared_ptr<ReadSeedDisplay> pDisplay )
+    {
+        std::lock_guard<std::mutex> xGuard( xMutex );
+        if( xIndex.count( iReadId ) != 0 )
+            return;
+        xLru.emplace_front( iReadId, pDisplay );
+        xIndex[ iReadId ] = xLru.begin( );
+        if( xLru.size( ) > uiMaxReads )
+        {
+            xIndex.erase( xLru.back( ).first );
+            xLru.pop_back( );
+        } // if
+    } // method
+
+    void clear( )
+    {
+        std::lock_guard<std::mutex> xGuard( xMutex );
+        xIndex.clear( );
+        xLru.clear( );
+    } // method
+
+    size_t size( )
+    {
+        std::lock_guard<std::mutex> xGuard( xMutex );
+        return xLru.size( );
+    } // method
+}; // class
+
+/// @brief fetches and seeds a read for the seed plot
+template <typename DBCon>
+std::shared_ptr<ReadSeedDisplay> seedDisplayForRead( const ParameterSetManager& rParameters, int64_t iReadId,
+                                                     std::shared_ptr<DBCon> pConn, ReadTable<DBCon>& rReadTable,
+                                                     std::shared_ptr<Pack> pPack,
+                                                     std::shared_ptr<minimizer::Index> pMMIndex,
+                                                     std::shared_ptr<HashCounters> pHashCounters, std::mutex& rLock,
+                                                     MMFilteredSeeding& rSeeding, SeedLumping& rLumping,
+                                                     StripOfConsiderationSeeds& rSoc,
+                                                     GetAllFeasibleSoCsAsSet& rSocFilter )
+{
+    // modules not threadsave if HelperRetVal is given
+    RecursiveReseedingSoCs xReseeding( rParameters, pPack );
+    int64_t uiSeqId = rReadTable.getSeqId( iReadId );
+    std::shared_ptr<HashCounter> pCounter;
+    {
+        std::lock_guard<std::mutex> xGuard( rLock );
+        auto pIt = pHashCounters->xCounters.find( uiSeqId );
+        if( pIt != pHashCounters->xCounters.end( ) )
+            pCounter = pIt->second;
+        else
+        {
+            pCounter = std::make_unique<HashFilterTable<DBCon>>( pConn )->getCounter( uiSeqId );
+            pHashCounters->xCounters[ uiSeqId ] = pCounter;
+        } // else
+    } // scope of xGuard
+    auto pRead = rReadTable.getRead( iReadId );
+    auto pMinimizers = rSeeding.execute( pMMIndex, pRead, pPack, pCounter );
+    auto pLumpedSeeds = rLumping.execute( pMinimizers, pRead, pPack );
+    auto pSoCs = rSoc.execute( pLumpedSeeds, pRead, pPack );
+    auto pFilteredSeeds = rSocFilter.execute( pSoCs );
+    HelperRetVal xReseedOutExtraInfo;
+    auto pReseeded = xReseeding.execute_helper( pFilteredSeeds, pPack, pRead, &xReseedOutExtraInfo );
+
+    // seed, overlapping
+    std::vector<std::pair<Seed, bool>> vSeeds;
+    for( auto& rSeed : *xReseedOutExtraInfo.pRemovedSeeds )
+        vSeeds.emplace_back( rSeed, true );
+    for( auto& rSeed : *pReseeded )
+        vSeeds.emplace_back( rSeed, false );
+    // the order on the query is displayed
+    std::sort( vSeeds.begin( ), vSeeds.end( ),
+               []( auto& xA, auto& xB ) { return xA.first.start( ) < xB.first.start( ); } );
+
+    auto pRet = std::make_shared<ReadSeedDisplay>( );
+    pRet->pRead = pRead;
+    for( size_t uiK = 0; uiK < vSeeds.size( ); uiK++ )
+        pRet->vSeeds.push_back( seedInfo( vSeeds[ uiK ].first, false, vSeeds[ uiK ].second, 0, iReadId, uiK,
+                                          pRead->sName, pCounter, pPack, pMMIndex, pRead, true,
+                                          rParameters.getSelected( )->xRectangularSoc->get( ), 0 ) );
+    std::sort( pRet->vSeeds.begin( ), pRet->vSeeds.end( ),
+               []( auto& rA, auto& rB ) { return startRef( rA ) < startRef( rB ); } );
+    pRet->xRectangles = rectangleInfo( xReseedOutExtraInfo, iReadId, true );
+    return pRet;
+} // function
+
+/**
+ * @brief computes the seed plot for the given reads
+ * @details
+ * Reads that are in pCache are neither fetched nor seeded again. The others are computed in parallel and added to
+ * pCache. If this takes longer than iMaxTime milliseconds (0 = no limit), an empty result is returned; the reads that
+ * were seeded until then stay cached, so that a later call is faster.
+ * The columns of the seeds are assigned afterwards in the order of the read ids (descending).
+ */
 template <typename DBCon>
 std::shared_ptr<ReadInfo> seedDisplaysForReadIds( const ParameterSetManager& rParameters,
                                                   std::shared_ptr<libMS::PoolContainer<DBCon>>
@@ -164,6 +316,8 @@ std::shared_ptr<ReadInfo> seedDisplaysForReadIds( const ParameterSetManager& rPa
                                                       pMMIndex,
                                                   std::shared_ptr<HashCounters>
                                                       pHashCounters,
+                                                  std::shared_ptr<SeedDisplayCache>
+                                                      pCache,
                                                   bool bDoCompress,
                                                   size_t iMaxTime )
 {
@@ -174,203 +328,97 @@ std::shared_ptr<ReadInfo> seedDisplaysForReadIds( const ParameterSetManager& rPa
     vReadIds.insert( vReadIds.begin( ), xReadIds.begin( ), xReadIds.end( ) );
     std::sort( vReadIds.begin( ), vReadIds.end( ), []( int64_t iA, int64_t iB ) { return iB < iA; } );
 
-    std::mutex xLock;
-    std::mutex xLock2;
-    std::vector<SeedInfo> vRet;
-    std::vector<RectangleInfo> vRectangles;
-    std::vector<std::pair<size_t, int64_t>> vReadsNCols;
-    std::vector<std::shared_ptr<NucSeq>> vReads;
-    vRet.reserve( vReadIds.size( ) * 500 );
+    std::vector<std::shared_ptr<ReadSeedDisplay>> vDisplays( vReadIds.size( ) );
+    std::vector<size_t> vMissing;
+    for( size_t uiI = 0; uiI < vReadIds.size( ); uiI++ )
+    {
+        vDisplays[ uiI ] = pCache->get( vReadIds[ uiI ] );
+        if( vDisplays[ uiI ] == nullptr )
+            vMissing.push_back( uiI );
+    } // for
 
     MMFilteredSeeding xSeeding( rParameters );
     SeedLumping xLumping( rParameters );
-    // JumpsFilterContigBorder xCtgFilter( rParameters );
     StripOfConsiderationSeeds xSoc( rParameters );
     GetAllFeasibleSoCsAsSet xSocFilter( rParameters );
 
+    std::mutex xLock;
+    std::atomic<bool> bStop( false );
     std::vector<std::future<void>> vFutures;
-    // seed_order_on_query, seed, layer, palindrome, overlapping, read_id, read_name, read, bInSocReseed
-    std::vector<std::tuple<size_t, Seed, size_t, bool, bool, int64_t, std::string, std::shared_ptr<NucSeq>, bool,
-                           std::shared_ptr<HashCounter>, size_t>>
-        vAllSeeds;
-    // x-end position of last seeds and the seeds read id for each column
-    std::vector<int64_t> vColIds;
-    std::vector<int64_t> vAllColIds;
-    size_t uiCategoryCounter = 0;
-    bool bStop = false;
-
-    for( size_t uiI = 0; uiI < rParameters.getNumThreads( ); uiI++ )
+    for( size_t uiI = 0; uiI < rParameters.getNumThreads( ) && uiI < vMissing.size( ); uiI++ )
         vFutures.push_back( pConPool->xPool.enqueue(
             [ & ]( std::shared_ptr<DBCon> pConn, size_t uiI ) { //
-                auto pReadTable = std::make_unique<ReadTable<DBCon>>( pConn );
-                for( size_t uiJ = uiI; uiJ < vReadIds.size( ); uiJ += rParameters.getNumThreads( ) )
+                ReadTable<DBCon> xReadTable( pConn );
+                for( size_t uiJ = uiI; uiJ < vMissing.size( ) && !bStop; uiJ += rParameters.getNumThreads( ) )
                 {
-                    // modules not threadsave if HelperRetVal is given
-                    RecursiveReseedingSoCs xReseeding( rParameters, pPack );
-                    SvJumpsFromSeeds xJumpsFromSeeds( rParameters, pPack );
-                    auto iReadId = vReadIds[ uiJ ];
-                    int64_t uiSeqId = pReadTable->getSeqId( iReadId );
-                    std::shared_ptr<HashCounter> pCounter;
-                    {
-                        std::lock_guard<std::mutex> xGuard2( xLock2 );
-                        auto pIt = pHashCounters->xCounters.find( uiSeqId );
-                        if( pIt != pHashCounters->xCounters.end( ) )
-                            pCounter = pIt->second;
-                        else
-                        {
-                            pCounter = std::make_unique<HashFilterTable<DBCon>>( pConn )->getCounter( uiSeqId );
-                            pHashCounters->xCounters[ uiSeqId ] = pCounter;
-                        } // else
-                    } // scope of xGuard2
-                    auto pRead = pReadTable->getRead( iReadId );
-                    auto pMinimizers = xSeeding.execute( pMMIndex, pRead, pPack, pCounter );
-                    auto pLumpedSeeds = xLumping.execute( pMinimizers, pRead, pPack );
-                    auto pSoCs = xSoc.execute( pLumpedSeeds, pRead, pPack );
-                    auto pFilteredSeeds = xSocFilter.execute( pSoCs );
-                    HelperRetVal xReseedOutExtraInfo;
-                    auto pReseeded = xReseeding.execute_helper( pFilteredSeeds, pPack, pRead, &xReseedOutExtraInfo );
-                    // auto pCtgFilteredSeeds = xCtgFilter.execute( pReseeded, pPack );
-
-                    // auto xHelperRet = xJumpsFromSeeds.execute_helper_py3( pReseeded, pPack, pRead );
-
-                    // seed_order_on_query, seed, layer, palindrome, overlapping, read_id, read_name, read,
-                    // bInSocReseed
-                    std::vector<std::tuple<size_t, Seed, size_t, bool, bool, int64_t, std::string,
-                                           std::shared_ptr<NucSeq>, bool, std::shared_ptr<HashCounter>, size_t>>
-                        vSeedsNIndex;
-                    // for( size_t uiK = 0; uiK < xReseedOutExtraInfo.pSeeds->size( ); uiK++ )
-                    //    if( !xReseedOutExtraInfo.vOverlappingSeed[ uiK ] )
-                    //        vSeedsNIndex.emplace_back(
-                    //            0, ( *xReseedOutExtraInfo.pSeeds )[ uiK ], xReseedOutExtraInfo.vLayerOfSeeds[ uiK ],
-                    //            xReseedOutExtraInfo.vParlindromeSeed[ uiK ],
-                    //            xReseedOutExtraInfo.vOverlappingSeed[ uiK ], iReadId, pRead->sName, pRead, true,
-                    //            pCounter, xReseedOutExtraInfo.vSocIds[ uiK ] );
-                    // for( auto& xSeeds : pFilteredSeeds->xContent )
-                    //    for( auto& rSeed : *xSeeds )
-                    //        vSeedsNIndex.emplace_back( 0, rSeed, 0, false, true, iReadId, pRead->sName, pRead, true,
-                    //                                   pCounter, 0 );
-                    for( auto& rSeed : *xReseedOutExtraInfo.pRemovedSeeds )
-                        vSeedsNIndex.emplace_back( 0, rSeed, 0, false, true, iReadId, pRead->sName, pRead, true,
-                                                   pCounter, 0 );
-                    for( auto& rSeed : *pReseeded )
-                        vSeedsNIndex.emplace_back( 0, rSeed, 0, false, false, iReadId, pRead->sName, pRead, true,
-                                                   pCounter, 0 );
-                    // for( size_t uiK = 0; uiK < xHelperRet.pSeeds->size( ); uiK++ )
-                    //    // only use seeds that we do not get from xReseedOutExtraInfo already
-                    //    if( xHelperRet.vLayerOfSeeds[ uiK ] > 0 )
-                    //        vSeedsNIndex.emplace_back(
-                    //            0, ( *xHelperRet.pSeeds )[ uiK ], xHelperRet.vLayerOfSeeds[ uiK ],
-                    //            xHelperRet.vParlindromeSeed[ uiK ], xHelperRet.vOverlappingSeed[ uiK ], iReadId,
-                    //            pRead->sName, pRead, false, pCounter, xHelperRet.vSocIds[ uiK ] );
-
-                    std::sort( vSeedsNIndex.begin( ), vSeedsNIndex.end( ), []( auto& xA, auto& xB ) {
-                        return std::get<1>( xA ).start( ) < std::get<1>( xB ).start( );
-                    } );
-                    for( size_t uiK = 0; uiK < vSeedsNIndex.size( ); uiK++ )
-                        std::get<0>( vSeedsNIndex[ uiK ] ) = uiK;
-
-
-                    if( bDoCompress )
-                    {
-                        std::lock_guard<std::mutex> xGuard( xLock );
-                        if( bStop )
-                            return;
-                        vAllSeeds.insert( vAllSeeds.end( ), vSeedsNIndex.begin( ), vSeedsNIndex.end( ) );
-                        // addRectangle( vRectangles, xReseedOutExtraInfo, uiCategoryCounter, iReadId, 0, false );
-                        addRectangle( vRectangles, xReseedOutExtraInfo, uiCategoryCounter, iReadId, 0, true );
-                        vReads.push_back( pRead );
-                    } // if
-                    else
-                    {
-                        std::sort( vSeedsNIndex.begin( ), vSeedsNIndex.end( ), []( auto& xA, auto& xB ) {
-                            return std::get<1>( xA ).start_ref( ) < std::get<1>( xB ).start_ref( );
-                        } );
-                        std::vector<std::pair<nucSeqIndex, int64_t>> vEndColumn;
-                        std::lock_guard<std::mutex> xGuard( xLock );
-                        if( bStop )
-                            return;
-                        for( auto& xTup : vSeedsNIndex )
-                            addSeed( std::get<1>( xTup ),
-                                     vRet,
-                                     vEndColumn,
-                                     vAllColIds,
-                                     uiCategoryCounter,
-                                     std::get<3>( xTup ),
-                                     std::get<4>( xTup ),
-                                     std::get<2>( xTup ),
-                                     std::get<5>( xTup ),
-                                     std::get<0>( xTup ),
-                                     std::get<6>( xTup ),
-                                     std::get<9>( xTup ),
-                                     pPack,
-                                     pMMIndex,
-                                     pRead,
-                                     std::get<8>( xTup ),
-                                     rParameters.getSelected( )->xRectangularSoc->get( ),
-                                     std::get<10>( xTup ) );
-                        vColIds.push_back( uiCategoryCounter + ( vEndColumn.size( ) - 1 ) / 2 );
-
-                        // addRectangle( vRectangles, xHelperRet, uiCategoryCounter, iReadId, vEndColumn.size( ), false
-                        // );
-                        addRectangle( vRectangles, xReseedOutExtraInfo, uiCategoryCounter, iReadId, vEndColumn.size( ),
-                                      true );
-
-                        uiCategoryCounter += vEndColumn.size( ) + 2;
-                        vReadsNCols.emplace_back( vColIds.back( ), iReadId );
-                        vReads.push_back( pRead );
-                    } // else
+                    size_t uiIdx = vMissing[ uiJ ];
+                    vDisplays[ uiIdx ] =
+                        seedDisplayForRead( rParameters, vReadIds[ uiIdx ], pConn, xReadTable, pPack, pMMIndex,
+                                            pHashCounters, xLock, xSeeding, xLumping, xSoc, xSocFilter );
+                    pCache->put( vReadIds[ uiIdx ], vDisplays[ uiIdx ] );
                 } // for
             },
             uiI ) );
 
-
     // wait for threads to finish at most iMaxTime seconds, then stop all work and give up
     for( auto& xFuture : vFutures )
     {
         // if maxtime is 0 wait for howeverlong the complete computation takes
-        if( iMaxTime > 0 )
+        if( iMaxTime > 0 && !bStop )
         {
             // get status until it is either timeout or ready
             std::future_status xStatus = std::future_status::deferred;
-            while( !bStop && xStatus == std::future_status::deferred )
+            while( xStatus == std::future_status::deferred )
                 xStatus = xFuture.wait_until( xEndTime );
 
             if( xStatus == std::future_status::timeout )
-            {
-                std::lock_guard<std::mutex> xGuard( xLock );
                 bStop = true;
-            } // if
         } // if
 
         xFuture.get( );
     } // for
 
+    auto pRet = std::make_shared<ReadInfo>( );
     if( bStop )
+        return pRet;
+
+    size_t uiCategoryCounter = 0;
+    if( bDoCompress )
     {
-        vRet.clear( );
-        vRectangles.clear( );
-        vReadsNCols.clear( );
-        vReads.clear( );
-        vColIds.clear( );
-        vAllColIds.clear( );
-    } // if
-    else if( bDoCompress && !vAllSeeds.empty( ) )
-    {
+        std::vector<const SeedInfo*> vAllSeeds;
+        for( auto& pDisplay : vDisplays )
+        {
+            for( auto& rInfo : pDisplay->vSeeds )
+                vAllSeeds.push_back( &rInfo );
+            pRet->vRectangles.push_back( pDisplay->xRectangles );
+            pRet->vReads.push_back( pDisplay->pRead );
+        } // for
         std::vector<std::pair<nucSeqIndex, int64_t>> vEndColumn;
-        std::sort( vAllSeeds.begin( ), vAllSeeds.end( ), []( auto& xA, auto& xB ) {
-            if( std::get<1>( xA ).start_ref( ) != std::get<1>( xB ).start_ref( ) )
-                return std::get<1>( xA ).start_ref( ) < std::get<1>( xB ).start_ref( );
-            return std::get<4>( xA ) < std::get<4>( xB );
+        std::stable_sort( vAllSeeds.begin( ), vAllSeeds.end( ), []( auto pA, auto pB ) {
+            if( startRef( *pA ) != startRef( *pB ) )
+                return startRef( *pA ) < startRef( *pB );
+            return pA->bOverlapping < pB->bOverlapping;
         } );
-        for( auto& xTup : vAllSeeds )
-            addSeed( std::get<1>( xTup ), vRet, vEndColumn, vAllColIds, uiCategoryCounter, std::get<3>( xTup ),
-                     std::get<4>( xTup ), std::get<2>( xTup ), std::get<5>( xTup ), std::get<0>( xTup ),
-                     std::get<6>( xTup ), std::get<9>( xTup ), pPack, pMMIndex, std::get<7>( xTup ),
-                     std::get<8>( xTup ), rParameters.getSelected( )->xRectangularSoc->get( ), std::get<10>( xTup ) );
-        uiCategoryCounter += vEndColumn.size( );
+        for( auto pInfo : vAllSeeds )
+            placeSeed( *pInfo, pRet->vRet, vEndColumn, pRet->vAllColIds, uiCategoryCounter );
     } // if
-
-    return std::make_shared<ReadInfo>( ReadInfo{ vRet, vRectangles, vReadsNCols, vReads, vColIds, vAllColIds } );
+    else
+        for( auto& pDisplay : vDisplays )
+        {
+            std::vector<std::pair<nucSeqIndex, int64_t>> vEndColumn;
+            for( auto& rInfo : pDisplay->vSeeds )
+                placeSeed( rInfo, pRet->vRet, vEndColumn, pRet->vAllColIds, uiCategoryCounter );
+            pRet->vColIds.push_back( uiCategoryCounter + ( vEndColumn.size( ) - 1 ) / 2 );
+            pRet->vRectangles.push_back( pDisplay->xRectangles );
+            pRet->vRectangles.back( ).uiCategory = uiCategoryCounter;
+            pRet->vRectangles.back( ).uiEndColumnSize = vEndColumn.size( );
+
+            uiCategoryCounter += vEndColumn.size( ) + 2;
+            pRet->vReadsNCols.emplace_back( pRet->vColIds.back( ), pDisplay->xRectangles.iReadId );
+            pRet->vReads.push_back( pDisplay->pRead );
+        } // for
+
+    return pRet;
 } // method
 
 
@@ -380,6 +428,11 @@ void exportRendererSpeedUp( libMS::SubmoduleOrganizer& xOrganizer )
 {
     py::class_<HashCounters, std::shared_ptr<HashCounters>>( xOrganizer.util( ), "HashCounters" ).def( py::init<>( ) );
 
+    py::class_<SeedDisplayCache, std::shared_ptr<SeedDisplayCache>>( xOrganizer.util( ), "SeedDisplayCache" )
+        .def( py::init<size_t>( ), py::arg( "max_reads" ) = 10000 )
+        .def( "clear", &SeedDisplayCache::clear )
+        .def( "size", &SeedDisplayCache::size );
+
     py::class_<SeedInfo>( xOrganizer._util( ), "SeedInfo" )
         .def_readwrite( "fCenter", &SeedInfo::fCenter )
         .def_readwrite( "iReadId", &SeedInfo::iReadId )
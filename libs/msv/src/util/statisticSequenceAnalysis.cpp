@@ -1,5 +1,208 @@
 #include "msv/util/statisticSequenceAnalysis.h"
-#include "ma/module/hashMapSeeding.h"
+#include <array>
+#include <limits>
+
+namespace
+{
+const size_t uiEmpty = std::numeric_limits<size_t>::max( );
+
+/**
+ * @brief computes the suffix array of rvText via induced sorting (Nong, Zhang & Chan; SA-IS).
+ * @details
+ * rvText must end with a unique smallest character 0; all characters must be < uiAlphabetSize.
+ * Runs in O( |rvText| + uiAlphabetSize ).
+ */
+void inducedSorting( const std::vector<size_t>& rvText, std::vector<size_t>& rvSA, size_t uiAlphabetSize )
+{
+    const size_t uiN = rvText.size( );
+    rvSA.assign( uiN, uiEmpty );
+    if( uiN == 1 )
+    {
+        rvSA[ 0 ] = 0;
+        return;
+    } // if
+
+    // classify suffixes into S (smaller than their right neighbor) and L (larger) type
+    std::vector<bool> vS( uiN );
+    vS[ uiN - 1 ] = true;
+    for( size_t uiI = uiN - 1; uiI > 0; uiI-- )
+        vS[ uiI - 1 ] = rvText[ uiI - 1 ] < rvText[ uiI ] || ( rvText[ uiI - 1 ] == rvText[ uiI ] && vS[ uiI ] );
+    auto fIsLMS = [ & ]( size_t uiI ) { return uiI > 0 && vS[ uiI ] && !vS[ uiI - 1 ]; };
+
+    std::vector<size_t> vBucketSize( uiAlphabetSize, 0 );
+    for( size_t uiC : rvText )
+        vBucketSize[ uiC ]++;
+    std::vector<size_t> vBucket( uiAlphabetSize );
+    auto fBucketStarts = [ & ]( ) {
+        size_t uiSum = 0;
+        for( size_t uiC = 0; uiC < uiAlphabetSize; uiC++ )
+        {
+            vBucket[ uiC ] = uiSum;
+            uiSum += vBucketSize[ uiC ];
+        } // for
+    }; // lambda
+    auto fBucketEnds = [ & ]( ) {
+        size_t uiSum = 0;
+        for( size_t uiC = 0; uiC < uiAlphabetSize; uiC++ )
+        {
+            uiSum += vBucketSize[ uiC ];
+            vBucket[ uiC ] = uiSum;
+        } // for
+    }; // lambda
+    // sorts the L suffixes and then the S suffixes, given the sorted LMS suffixes at the ends of their buckets
+    auto fInduce = [ & ]( ) {
+        fBucketStarts( );
+        for( size_t uiI = 0; uiI < uiN; uiI++ )
+            if( rvSA[ uiI ] != uiEmpty && rvSA[ uiI ] > 0 && !vS[ rvSA[ uiI ] - 1 ] )
+                rvSA[ vBucket[ rvText[ rvSA[ uiI ] - 1 ] ]++ ] = rvSA[ uiI ] - 1;
+        fBucketEnds( );
+        for( size_t uiI = uiN; uiI > 0; uiI-- )
+            if( rvSA[ uiI - 1 ] != uiEmpty && rvSA[ uiI - 1 ] > 0 && vS[ rvSA[ uiI - 1 ] - 1 ] )
+                rvSA[ --vBucket[ rvText[ rvSA[ uiI - 1 ] - 1 ] ] ] = rvSA[ uiI - 1 ] - 1;
+    }; // lambda
+
+    // sort the LMS substrings
+    fBucketEnds( );
+    std::vector<size_t> vLMS; // LMS positions in text order
+    for( size_t uiI = 1; uiI < uiN; uiI++ )
+        if( fIsLMS( uiI ) )
+        {
+            vLMS.push_back( uiI );
+            rvSA[ --vBucket[ rvText[ uiI ] ] ] = uiI;
+        } // if
+    fInduce( );
+
+    // name the LMS substrings (equal substrings get equal names)
+    std::vector<size_t> vName( uiN, uiEmpty );
+    size_t uiNumNames = 0;
+    size_t uiPrev = uiEmpty;
+    for( size_t uiI = 0; uiI < uiN; uiI++ )
+    {
+        const size_t uiPos = rvSA[ uiI ];
+        if( !fIsLMS( uiPos ) )
+            continue;
+        bool bDifferent = uiPrev == uiEmpty;
+        for( size_t uiD = 0; !bDifferent; uiD++ )
+        {
+            // the unique sentinel makes sure that this loop terminates before the end of the text
+            if( rvText[ uiPos + uiD ] != rvText[ uiPrev + uiD ] || vS[ uiPos + uiD ] != vS[ uiPrev + uiD ] )
+                bDifferent = true;
+            else if( uiD > 0 && ( fIsLMS( uiPos + uiD ) || fIsLMS( uiPrev + uiD ) ) )
+                break;
+        } // for
+        if( bDifferent )
+            uiNumNames++;
+        vName[ uiPos ] = uiNumNames - 1;
+        uiPrev = uiPos;
+    } // for
+
+    // sort the LMS suffixes (recursively, if their substrings are not unique)
+    std::vector<size_t> vReduced;
+    vReduced.reserve( vLMS.size( ) );
+    for( size_t uiPos : vLMS )
+        vReduced.push_back( vName[ uiPos ] );
+    std::vector<size_t> vReducedSA( vLMS.size( ) );
+    if( uiNumNames < vLMS.size( ) )
+        inducedSorting( vReduced, vReducedSA, uiNumNames );
+    else
+        for( size_t uiI = 0; uiI < vReduced.size( ); uiI++ )
+            vReducedSA[ vReduced[ uiI ] ] = uiI;
+
+    // induce the suffix array from the sorted LMS suffixes
+    std::fill( rvSA.begin( ), rvSA.end( ), uiEmpty );
+    fBucketEnds( );
+    for( size_t uiI = vReducedSA.size( ); uiI > 0; uiI-- )
+    {
+        const size_t uiPos = vLMS[ vReducedSA[ uiI - 1 ] ];
+        rvSA[ --vBucket[ rvText[ uiPos ] ] ] = uiPos;
+    } // for
+    fInduce( );
+} // function
+} // namespace
+
+libMSV::SequencePairSuffixArray::SequencePairSuffixArray( const NucSeq& rA, const NucSeq& rB )
+    : vText( ), vSA( ), vLCP( ), uiSizeA( rA.length( ) ), uiSizeB( rB.length( ) )
+{
+    // A $ B #; N (and all other non ACGT characters) become the same character, as with the former string k-mers
+    vText.reserve( uiSizeA + uiSizeB + 2 );
+    for( nucSeqIndex uiI = 0; uiI < uiSizeA; uiI++ )
+        vText.push_back( std::min( rA.pxSequenceRef[ uiI ], (uint8_t)4 ) + 2 );
+    vText.push_back( 1 );
+    for( nucSeqIndex uiI = 0; uiI < uiSizeB; uiI++ )
+        vText.push_back( std::min( rB.pxSequenceRef[ uiI ], (uint8_t)4 ) + 2 );
+    vText.push_back( 0 );
+
+    inducedSorting( vText, vSA, 7 );
+
+    // Kasai et al.: the LCP of a suffix and its predecessor is at least the one of the next longer suffix minus one
+    std::vector<size_t> vRank( vText.size( ) );
+    for( size_t uiI = 0; uiI < vSA.size( ); uiI++ )
+        vRank[ vSA[ uiI ] ] = uiI;
+    vLCP.assign( vText.size( ), 0 );
+    size_t uiH = 0;
+    for( size_t uiPos = 0; uiPos < vText.size( ); uiPos++ )
+    {
+        if( vRank[ uiPos ] == 0 )
+        {
+            uiH = 0;
+            continue;
+        } // if
+        const size_t uiPrev = vSA[ vRank[ uiPos ] - 1 ];
+        // the separator and sentinel are unique, so the comparison stops before the end of the text
+        while( vText[ uiPos + uiH ] == vText[ uiPrev + uiH ] )
+            uiH++;
+        vLCP[ vRank[ uiPos ] ] = uiH;
+        if( uiH > 0 )
+            uiH--;
+    } // for
+} // constructor
+
+nucSeqIndex libMSV::SequencePairSuffixArray::longestRepeat( ) const
+{
+    nucSeqIndex uiMax = 0;
+    for( size_t uiL : vLCP )
+        uiMax = std::max( uiMax, (nucSeqIndex)uiL );
+    return uiMax;
+} // method
+
+nucSeqIndex libMSV::SequencePairSuffixArray::matchingNucleotides( nucSeqIndex uiK ) const
+{
+    uiK = std::max( uiK, (nucSeqIndex)1 );
+    nucSeqIndex uiMatches = 0;
+    nucSeqIndex uiMaximalMatches = 0;
+    // number of A / B suffixes in the current interval in total and by their left nucleotide (0 = sequence start)
+    nucSeqIndex uiNumA = 0, uiNumB = 0;
+    std::array<nucSeqIndex, 7> aNumA{}, aNumB{};
+    auto fCloseInterval = [ & ]( ) {
+        nucSeqIndex uiSameLeft = 0;
+        for( size_t uiC = 2; uiC < 7; uiC++ )
+            uiSameLeft += aNumA[ uiC ] * aNumB[ uiC ];
+        uiMatches += uiNumA * uiNumB;
+        uiMaximalMatches += uiNumA * uiNumB - uiSameLeft;
+        uiNumA = uiNumB = 0;
+        aNumA.fill( 0 );
+        aNumB.fill( 0 );
+    }; // lambda
+    for( size_t uiI = 0; uiI < vSA.size( ); uiI++ )
+    {
+        // suffixes shorter than uiK never share an uiK long prefix, so they always form intervals on their own
+        if( vLCP[ uiI ] < uiK )
+            fCloseInterval( );
+        const size_t uiPos = vSA[ uiI ];
+        if( uiPos < uiSizeA )
+        {
+            uiNumA++;
+            aNumA[ leftOf( uiPos ) ]++;
+        } // if
+        else if( uiPos > uiSizeA && uiPos <= uiSizeA + uiSizeB )
+        {
+            uiNumB++;
+            aNumB[ leftOf( uiPos ) ]++;
+        } // else if
+    } // for
+    fCloseInterval( );
+    return uiMatches + ( uiK - 1 ) * uiMaximalMatches;
+} // method
 
 
 nucSeqIndex libMSV::getKMerSizeForRectangle( geom::Rectangle<nucSeqIndex>& rRect, double t )
@@ -24,49 +227,23 @@ nucSeqIndex libMSV::getKMerSizeForRectangle( geom::Rectangle<nucSeqIndex>& rRect
     return std::min( w, h ) + 1;
 } // function
 
-nucSeqIndex libMSV::sampleKMerSize( NucSeq& rSequenceA, NucSeq& rSequenceB, double t )
+nucSeqIndex libMSV::sampleKMerSize( const NucSeq& rSequenceA, const NucSeq& rSequenceB, double t )
 {
     geom::Rectangle<nucSeqIndex> xRect( 0, 0, rSequenceA.length( ) + rSequenceB.length( ),
                                         rSequenceA.length( ) + rSequenceB.length( ) );
     nucSeqIndex uiStaticsticalSize = getKMerSizeForRectangle( xRect, t );
-    nucSeqIndex uiSeedSize = uiStaticsticalSize;
-    for( ; uiSeedSize < rSequenceA.length( ) || uiSeedSize < rSequenceB.length( ); uiSeedSize++ )
-    {
-        std::set<std::string> xKMerSet;
-        bool bAllUnique = true;
-        for( auto& rSequence : {rSequenceA, rSequenceB} )
-            for( nucSeqIndex uiPos = 0; uiPos + uiSeedSize <= rSequence.length( ); uiPos++ )
-            {
-                std::string sKMer = rSequence.fromTo( uiPos, uiPos + uiSeedSize );
-                if( xKMerSet.find( sKMer ) != xKMerSet.end( ) )
-                {
-                    bAllUnique = false;
-                    break;
-                } // if
-                xKMerSet.insert( sKMer );
-            } // for
-        if( bAllUnique )
-            break;
-    } // while
-
-    return uiSeedSize - uiStaticsticalSize;
+    nucSeqIndex uiMaxSize = std::max( rSequenceA.length( ), rSequenceB.length( ) );
+    if( uiStaticsticalSize >= uiMaxSize )
+        return 0;
+
+    // all k-mers are unique once k is larger than the longest repeat
+    nucSeqIndex uiSeedSize = SequencePairSuffixArray( rSequenceA, rSequenceB ).longestRepeat( ) + 1;
+    return std::min( std::max( uiSeedSize, uiStaticsticalSize ), uiMaxSize ) - uiStaticsticalSize;
 } // function
 
-nucSeqIndex libMSV::sampleSequenceAmbiguity( NucSeq& rSequenceA, NucSeq& rSequenceB, double t )
+nucSeqIndex libMSV::sampleSequenceAmbiguity( const NucSeq& rSequenceA, const NucSeq& rSequenceB, double t )
 {
-    HashMapSeeding xSeeder;
-
     geom::Rectangle<nucSeqIndex> xRect( 0, 0, rSequenceA.length( ) + rSequenceB.length( ),
                                         rSequenceA.length( ) + rSequenceB.length( ) );
-    xSeeder.uiSeedSize = getKMerSizeForRectangle( xRect, t );
-
-    auto pLumped = SeedLumping( ).execute( xSeeder.execute( rSequenceA, rSequenceB ), rSequenceA, rSequenceB );
-    //pLumped->append( SeedLumping( ).execute( xSeeder.execute( rSequenceA, rSequenceA ), rSequenceA, rSequenceA ) );
-    //pLumped->append( SeedLumping( ).execute( xSeeder.execute( rSequenceB, rSequenceB ), rSequenceB, rSequenceB ) );
-
-    nucSeqIndex uiSum = 0;
-    for( auto xSeed : *pLumped )
-        uiSum += xSeed.size( );
-
-    return uiSum;
-} // function
\ No newline at end of file
+    return SequencePairSuffixArray( rSequenceA, rSequenceB ).matchingNucleotides( getKMerSizeForRectangle( xRect, t ) );
+} // function
@@ -0,0 +1,114 @@
+#define EXIT_SUCCESS 0
+#define EXIT_FAILURE 1
+
+#include "msv/util/callSetEvaluation.h"
+#include "util/system.h"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+using namespace libMSV;
+
+/*
+ * Compares libMSV::evaluateCallSet with a brute force implementation of the SQL semantic of
+ * SvCallsFromDb::countViaSql (every call against every call) on random call sets.
+ */
+
+/// @brief euclidean distance of two rectangles given as (x, y, w, h) (same as ST_Distance of two polygons)
+double rectDistance( double dXA, double dYA, double dWA, double dHA, double dXB, double dYB, double dWB, double dHB )
+{
+    double dX = std::max( 0.0, std::max( dXA - ( dXB + dWB ), dXB - ( dXA + dWA ) ) );
+    double dY = std::max( 0.0, std::max( dYA - ( dYB + dHB ), dYB - ( dYA + dHA ) ) );
+    return std::sqrt( dX * dX + dY * dY );
+} // function
+
+/// @brief SvCallTable::rectanglesOverlapSQL( rFrom, rTo )
+bool overlaps( const EvaluationCall& rFrom, const EvaluationCall& rTo, int64_t iDist )
+{
+    if( rTo.bFromForward == rFrom.bFromForward && rTo.bToForward == rFrom.bToForward &&
+        rectDistance( rTo.uiFromStart, rTo.uiToStart, rTo.uiFromSize, rTo.uiToSize, rFrom.uiFromStart,
+                      rFrom.uiToStart, rFrom.uiFromSize, rFrom.uiToSize ) <= iDist )
+        return true;
+    // flipped rectangle of rFrom
+    return rTo.bFromForward != rFrom.bToForward && rTo.bToForward != rFrom.bFromForward &&
+           rectDistance( rTo.uiFromStart, rTo.uiToStart, rTo.uiFromSize, rTo.uiToSize, rFrom.uiToStart,
+                         rFrom.uiFromStart, rFrom.uiToSize, rFrom.uiFromSize ) <= iDist;
+} // function
+
+std::pair<std::vector<std::tuple<double, uint32_t, uint32_t>>, uint32_t>
+bruteForce( const std::vector<EvaluationCall>& vCalls, const std::vector<EvaluationCall>& vGroundTruth,
+            int64_t iAllowedDist )
+{
+    std::vector<double> vScores;
+    for( auto& rGT : vGroundTruth )
+    {
+        bool bSelfIntersected = false;
+        for( auto& rOther : vGroundTruth )
+            if( rOther.iId != rGT.iId && rOther.dScore >= rGT.dScore && overlaps( rGT, rOther, iAllowedDist * 2 ) )
+                bSelfIntersected = true;
+        if( bSelfIntersected )
+            continue;
+        double dDataScore = -1;
+        for( auto& rCall : vCalls )
+            if( overlaps( rGT, rCall, iAllowedDist ) )
+                dDataScore = std::max( dDataScore, rCall.dScore );
+        vScores.push_back( dDataScore );
+    } // for
+    std::sort( vScores.begin( ), vScores.end( ) );
+
+    std::vector<std::tuple<double, uint32_t, uint32_t>> vRet;
+    for( size_t uiI = 0; uiI < vScores.size( ); uiI++ )
+    {
+        if( vScores[ uiI ] <= 0 || ( uiI > 0 && vScores[ uiI - 1 ] == vScores[ uiI ] ) )
+            continue;
+        uint32_t uiNumCalls = 0;
+        for( auto& rCall : vCalls )
+            if( rCall.dScore >= vScores[ uiI ] )
+                uiNumCalls++;
+        vRet.emplace_back( vScores[ uiI ], uiNumCalls, (uint32_t)( vScores.size( ) - uiI ) );
+    } // for
+    return std::make_pair( vRet, (uint32_t)vScores.size( ) );
+} // function
+
+/// @brief random calls; uiSpread controls how densely the calls are packed
+std::vector<EvaluationCall> randomCalls( size_t uiNum, uint64_t uiSpread, int64_t iFirstId )
+{
+    std::vector<EvaluationCall> vRet;
+    for( size_t uiI = 0; uiI < uiNum; uiI++ )
+        vRet.emplace_back( iFirstId + uiI, std::rand( ) % uiSpread, std::rand( ) % uiSpread, std::rand( ) % 20,
+                           std::rand( ) % 20, std::rand( ) % 2 == 0, std::rand( ) % 2 == 0,
+                           ( 1 + std::rand( ) % 50 ) / 10.0 );
+    return vRet;
+} // function
+
+int main( void )
+{
+    std::srand( 42 );
+    double dBruteForce = 0, dEvaluate = 0;
+    for( size_t uiRound = 0; uiRound < 50; uiRound++ )
+    {
+        int64_t iAllowedDist = std::rand( ) % 30;
+        uint64_t uiSpread = 200 + std::rand( ) % 5000;
+        auto vCalls = randomCalls( 500 + std::rand( ) % 500, uiSpread, 0 );
+        auto vGroundTruth = randomCalls( 100 + std::rand( ) % 200, uiSpread, 10000 );
+
+        std::pair<std::vector<std::tuple<double, uint32_t, uint32_t>>, uint32_t> xExpected, xActual;
+        dBruteForce += metaMeasureDuration( [ & ]( ) {
+                           xExpected = bruteForce( vCalls, vGroundTruth, iAllowedDist );
+                       } ).count( );
+        dEvaluate += metaMeasureDuration( [ & ]( ) {
+                         xActual = evaluateCallSet( vCalls, vGroundTruth, iAllowedDist, 1 + uiRound % 4 );
+                     } ).count( );
+
+        if( xExpected != xActual )
+        {
+            std::cerr << "round " << uiRound << ": evaluateCallSet differs from the brute force evaluation: |GT| "
+                      << xActual.second << " (expected " << xExpected.second << ") curve size "
+                      << xActual.first.size( ) << " (expected " << xExpected.first.size( ) << ")" << std::endl;
+            return EXIT_FAILURE;
+        } // if
+    } // for
+    std::cout << "brute force: " << dBruteForce * 1000 << " ms; evaluateCallSet: " << dEvaluate * 1000 << " ms"
+              << std::endl;
+    return EXIT_SUCCESS;
+} /// main function
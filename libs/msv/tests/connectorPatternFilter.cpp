@@ -0,0 +1,125 @@
+#define EXIT_SUCCESS 0
+#define EXIT_FAILURE 1
+
+#include "ms/container/sv_db/py_db_conf.h"
+#include "msv/module/connectorPatternFilter.h"
+#include <cstdlib>
+#include <iostream>
+
+using namespace libMA;
+using namespace libMSV;
+
+/*
+ * Checks the scoring of ConnectorPatternFilter (without a database; the reads are given directly):
+ * - calls between two copies of a repeat are discarded (the reference matches itself as well as the reads)
+ * - jumps whose read is missing are skipped instead of aborting the batch
+ * - calls without any available read are kept
+ * - the output keeps the order of the input
+ */
+
+std::shared_ptr<NucSeq> randomNucSeq( size_t uiLen )
+{
+    auto pRet = std::make_shared<NucSeq>( );
+    pRet->vReserveMemory( uiLen );
+    for( size_t i = 0; i < uiLen; i++ )
+        pRet->push_back( ( uint8_t )( std::rand( ) % 4 ) );
+    return pRet;
+} // function
+
+/// @brief a forward strand deletion call from uiFrom to uiTo supported by the given reads
+std::shared_ptr<SvCall> deletionCall( nucSeqIndex uiFrom, nucSeqIndex uiTo, nucSeqIndex uiQueryPos,
+                                      std::vector<int64_t> vReadIds )
+{
+    std::shared_ptr<SvCall> pCall;
+    for( int64_t iReadId : vReadIds )
+    {
+        auto pJump = std::make_shared<SvJump>( uiFrom, uiTo, uiQueryPos, uiQueryPos, true, true, (nucSeqIndex)100,
+                                               (int64_t)-1, iReadId );
+        if( pCall == nullptr )
+            pCall = std::make_shared<SvCall>( pJump );
+        else
+            pCall->vSupportingJumps.push_back( pJump );
+    } // for
+    return pCall;
+} // function
+
+int main( void )
+{
+    std::srand( 42 );
+    // reference with a repeat: [ 2000, 2500 ) is a copy of [ 1000, 1500 )
+    auto pRefSeq = randomNucSeq( 10000 );
+    for( size_t uiI = 0; uiI < 500; uiI++ )
+        pRefSeq->pxSequenceRef[ 2000 + uiI ] = pRefSeq->pxSequenceRef[ 1000 + uiI ];
+    Pack xPack;
+    xPack.vAppendSequence( "chr1", "desc", *pRefSeq );
+
+    ParameterSetManager xParameters;
+    ConnectorPatternFilter<DBCon> xFilter( xParameters );
+
+    // read of a deletion from 1249 to 2250 (within the repeat): identical to the reference itself
+    ConnectorPatternFilter<DBCon>::ReadCache xReads;
+    xReads[ 1 ] = std::make_shared<NucSeq>( pRefSeq->fromTo( 1000, 1250 ) + pRefSeq->fromTo( 2250, 2500 ) );
+    // read of a deletion from 5249 to 7250 (unique sequence)
+    xReads[ 2 ] = std::make_shared<NucSeq>( pRefSeq->fromTo( 5000, 5250 ) + pRefSeq->fromTo( 7250, 7500 ) );
+
+    auto pCalls = std::make_shared<CompleteBipartiteSubgraphClusterVector>( );
+    // 0: repeat call
+    pCalls->vContent.push_back( deletionCall( 1249, 2250, 250, { 1 } ) );
+    // 1: repeat call with an additional jump of a missing read
+    pCalls->vContent.push_back( deletionCall( 1249, 2250, 250, { 1, 99 } ) );
+    // 2: call of missing reads only
+    pCalls->vContent.push_back( deletionCall( 3249, 4250, 250, { 98, 99 } ) );
+    // 3: unique call
+    pCalls->vContent.push_back( deletionCall( 5249, 7250, 250, { 2 } ) );
+    // 4: unique call with an additional jump of a missing read
+    pCalls->vContent.push_back( deletionCall( 5249, 7250, 250, { 97, 2 } ) );
+
+    std::vector<bool> vExpected;
+    {
+        AlignedMemoryManager xMemoryManager;
+        std::map<std::pair<uint64_t, uint64_t>, std::shared_ptr<NucSeq>> xCache;
+        for( auto pCall : pCalls->vContent )
+        {
+            auto aWindows = xFilter.refWindows( pCall, xPack, xCache );
+            vExpected.push_back( xFilter.keepCall( pCall, aWindows, xReads, xMemoryManager ) );
+        } // for
+    } // scope
+    if( vExpected[ 0 ] || vExpected[ 1 ] )
+    {
+        std::cerr << "the call within the repeat was kept" << std::endl;
+        return EXIT_FAILURE;
+    } // if
+    if( !vExpected[ 2 ] )
+    {
+        std::cerr << "the call without available reads was discarded" << std::endl;
+        return EXIT_FAILURE;
+    } // if
+    if( vExpected[ 3 ] != vExpected[ 4 ] )
+    {
+        std::cerr << "the jump of a missing read changed the decision" << std::endl;
+        return EXIT_FAILURE;
+    } // if
+    if( xFilter.uiNumMissingReads != 4 )
+    {
+        std::cerr << "counted " << xFilter.uiNumMissingReads << " instead of 4 missing reads" << std::endl;
+        return EXIT_FAILURE;
+    } // if
+
+    // the batch keeps the order of the input
+    auto pFiltered = xFilter.filterCalls( pCalls, xReads, xPack );
+    size_t uiNext = 0;
+    for( size_t uiI = 0; uiI < pCalls->vContent.size( ); uiI++ )
+        if( vExpected[ uiI ] && ( uiNext >= pFiltered->vContent.size( ) ||
+                                  pFiltered->vContent[ uiNext++ ] != pCalls->vContent[ uiI ] ) )
+        {
+            std::cerr << "the filtered batch differs from the single calls" << std::endl;
+            return EXIT_FAILURE;
+        } // if
+    if( uiNext != pFiltered->vContent.size( ) )
+    {
+        std::cerr << "the filtered batch contains additional calls" << std::endl;
+        return EXIT_FAILURE;
+    } // if
+
+    return EXIT_SUCCESS;
+} /// main function
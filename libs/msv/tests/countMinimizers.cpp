@@ -2,8 +2,10 @@
 #define EXIT_FAILURE 1
 
 #include "msv/module/count_k_mers.h"
+#include "util/system.h"
 #include <iostream>
 #include <map>
+#include <thread>
 #include <time.h>
 
 using namespace libMA;
@@ -11,6 +13,111 @@ using namespace libMSV;
 
 
 #define MAX_VAL (2ull << 56)
+
+std::string randomSequence( size_t uiLen )
+{
+    std::string sRet;
+    sRet.reserve( uiLen );
+    for( size_t uiI = 0; uiI < uiLen; uiI++ )
+        sRet.push_back( "ACGT"[ std::rand( ) % 4 ] );
+    return sRet;
+} // function
+
+/**
+ * @brief Seeds queries via the string, NucSeq and batch entry points of the minimizer index; reports the throughput.
+ * @details
+ * All entry points must deliver the same seeds; the NucSeq entry point must leave the query untouched.
+ */
+bool seedingThroughput( )
+{
+    ParameterSetManager xParameters;
+    std::vector<std::string> vContigs{ randomSequence( 1000000 ), randomSequence( 500000 ) };
+    std::vector<std::string> vNames{ "chr1", "chr2" };
+    auto pPack = std::make_shared<Pack>( );
+    for( size_t uiI = 0; uiI < vContigs.size( ); uiI++ )
+        pPack->vAppendSequence( vNames[ uiI ], "", NucSeq( vContigs[ uiI ] ) );
+    auto pIndex = std::make_shared<minimizer::Index>( xParameters, vContigs, vNames );
+
+    // reads sampled from the contigs
+    std::vector<std::string> vQueries;
+    for( size_t uiI = 0; uiI < 20000; uiI++ )
+    {
+        auto& rContig = vContigs[ uiI % vContigs.size( ) ];
+        vQueries.push_back( rContig.substr( std::rand( ) % ( rContig.size( ) - 250 ), 250 ) );
+    } // for
+    std::vector<std::shared_ptr<NucSeq>> vNucSeqs;
+    for( auto& sQuery : vQueries )
+        vNucSeqs.push_back( std::make_shared<NucSeq>( sQuery ) );
+
+    size_t uiNumSeedsString = 0, uiNumSeedsNucSeq = 0;
+    double dString = metaMeasureDuration( [ & ]( ) {
+                         for( auto& sQuery : vQueries )
+                             uiNumSeedsString += pIndex->seed_one( sQuery, false, pPack )->size( );
+                     } ).count( );
+    double dNucSeq = metaMeasureDuration( [ & ]( ) {
+                         for( auto& pQuery : vNucSeqs )
+                             uiNumSeedsNucSeq += pIndex->seed_one( *pQuery, false, pPack )->size( );
+                     } ).count( );
+    // several threads seeding at once (each thread keeps its own seeding buffer)
+    const size_t uiNumThreads = 4;
+    std::vector<size_t> vNumSeedsThreads( uiNumThreads, 0 );
+    double dThreads = metaMeasureDuration( [ & ]( ) {
+                          std::vector<std::thread> vThreads;
+                          for( size_t uiT = 0; uiT < uiNumThreads; uiT++ )
+                              vThreads.emplace_back( [ & ]( size_t uiT ) {
+                                  for( size_t uiI = uiT; uiI < vNucSeqs.size( ); uiI += uiNumThreads )
+                                      vNumSeedsThreads[ uiT ] +=
+                                          pIndex->seed_one( *vNucSeqs[ uiI ], false, pPack )->size( );
+                              }, uiT ); // lambda
+                          for( auto& xThread : vThreads )
+                              xThread.join( );
+                      } ).count( );
+    // batches of queries (grouped & prefetched minimizer lookups)
+    const size_t uiBatchSize = 1000;
+    std::vector<std::shared_ptr<Seeds>> vBatchSeeds;
+    double dBatch = metaMeasureDuration( [ & ]( ) {
+                        for( size_t uiI = 0; uiI < vNucSeqs.size( ); uiI += uiBatchSize )
+                        {
+                            std::vector<std::shared_ptr<NucSeq>> vBatch(
+                                vNucSeqs.begin( ) + uiI,
+                                vNucSeqs.begin( ) + std::min( uiI + uiBatchSize, vNucSeqs.size( ) ) );
+                            for( auto pSeeds : pIndex->seed_batch( vBatch, false, pPack ) )
+                                vBatchSeeds.push_back( pSeeds );
+                        } // for
+                    } ).count( );
+    std::cout << "seeded " << vQueries.size( ) << " queries: string " << vQueries.size( ) / dString
+              << " queries/s; NucSeq " << vQueries.size( ) / dNucSeq << " queries/s; NucSeq " << uiNumThreads
+              << " threads " << vQueries.size( ) / dThreads << " queries/s; batches of " << uiBatchSize << " "
+              << vQueries.size( ) / dBatch << " queries/s" << std::endl;
+    size_t uiNumSeedsThreads = 0;
+    for( size_t uiN : vNumSeedsThreads )
+        uiNumSeedsThreads += uiN;
+    if( uiNumSeedsThreads != uiNumSeedsNucSeq )
+        return false;
+
+    if( vBatchSeeds.size( ) != vQueries.size( ) )
+        return false;
+    for( size_t uiI = 0; uiI < vQueries.size( ); uiI += 97 )
+    {
+        auto pA = pIndex->seed_one( vQueries[ uiI ], false, pPack );
+        auto pB = pIndex->seed_one( *vNucSeqs[ uiI ], false, pPack );
+        if( vNucSeqs[ uiI ]->toString( ) != vQueries[ uiI ] )
+            return false;
+        for( auto pC : {pB, vBatchSeeds[ uiI ]} )
+        {
+            if( pA->size( ) != pC->size( ) )
+                return false;
+            for( size_t uiJ = 0; uiJ < pA->size( ); uiJ++ )
+                if( ( *pA )[ uiJ ].start( ) != ( *pC )[ uiJ ].start( ) ||
+                    ( *pA )[ uiJ ].start_ref( ) != ( *pC )[ uiJ ].start_ref( ) ||
+                    ( *pA )[ uiJ ].size( ) != ( *pC )[ uiJ ].size( ) ||
+                    ( *pA )[ uiJ ].bOnForwStrand != ( *pC )[ uiJ ].bOnForwStrand )
+                    return false;
+        } // for
+    } // for
+    return uiNumSeedsString == uiNumSeedsNucSeq && uiNumSeedsString > 0;
+} // function
+
 int main( void )
 {
     srand( static_cast<unsigned int>( time( NULL ) ) );
@@ -56,5 +163,11 @@ int main( void )
     } );
     assert( vTestSet.size( ) == 0 );
 
+    if( !seedingThroughput( ) )
+    {
+        std::cerr << "string, NucSeq and batch seeding differ" << std::endl;
+        return EXIT_FAILURE;
+    } // if
+
     return EXIT_SUCCESS;
 } /// main function
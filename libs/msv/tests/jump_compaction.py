@@ -0,0 +1,79 @@
+from MA import *
+from MSV import *
+import random
+import tempfile
+
+#
+# Checks that merging equal jumps of different reads (compute_sv_jumps(..., compact_jumps=True); see
+# CompactingJumpInserterContainer) does not change the calls:
+# The same reads are turned into jumps with and without compaction. Both jump runs are swept and the calls are compared.
+# Also checks that get_used_reads delivers the reads of merged jumps (sv_jump_read_table).
+#
+
+def random_sequence(length):
+    return "".join(random.choice("ACGT") for _ in range(length))
+
+def reverse_complement(sequence):
+    return sequence[::-1].translate(str.maketrans("ACGT", "TGCA"))
+
+def fetch_calls(parameter_set, db_conn, run_id):
+    calls_from_db = SvCallsFromDb(parameter_set, db_conn, run_id)
+    ret = []
+    while calls_from_db.hasNext():
+        call = calls_from_db.next()
+        ret.append((call.x.start, call.y.start, call.x.size, call.y.size, call.from_forward, call.to_forward,
+                    call.num_supp_reads, call.num_supp_nt, call.reference_ambiguity))
+    return sorted(ret)
+
+if __name__ == "__main__":
+    random.seed(42)
+    parameter_set = ParameterSetManager()
+    parameter_set.by_name("Number of Threads").set(1)
+    parameter_set.by_name("Use all Processor Cores").set(False)
+
+    dataset_name = "tmp_jump_compaction"
+    db_conn = DbConn({"SCHEMA": {"NAME": dataset_name, "FLAGS": ["DROP_ON_CLOSURE"]}})
+
+    # the sequenced genome has a deletion (of b) and an inversion (of d)
+    a, b, c, d, e = (random_sequence(l) for l in [5000, 1000, 3000, 2000, 5000])
+    reference = Pack()
+    reference.append("chr1", "chr1-desc", NucSeq(a + b + c + d + e))
+    sequenced = a + c + reverse_complement(d) + e
+
+    # every read is sequenced three times, so that many jumps of different reads are equal
+    with tempfile.NamedTemporaryFile(mode="w", suffix=".fasta") as reads_file:
+        num_reads = 0
+        for start in range(0, len(sequenced) - 2000, 100):
+            for _ in range(3):
+                reads_file.write(">read" + str(num_reads) + "\n" + sequenced[start:start + 2000] + "\n")
+                num_reads += 1
+        reads_file.flush()
+        sequencer_id = insert_reads_path_string_vec(parameter_set, dataset_name, "reads", [reads_file.name])
+
+    mm_index = MinimizerIndex(parameter_set, reference.contigSeqs(), reference.contigNames())
+    jump_table = SvJumpTable(db_conn)
+
+    calls = []
+    for compact_jumps in [False, True]:
+        jump_run_id = compute_sv_jumps(parameter_set, mm_index, reference, dataset_name, sequencer_id,
+                                       compact_jumps=compact_jumps)
+        print("compact_jumps =", compact_jumps, ":", jump_table.num_jumps_of_reads(jump_run_id), "jumps in",
+              jump_table.num_jumps(jump_run_id), "rows")
+        caller_run_id = sweep_sv_jumps(parameter_set, dataset_name, jump_run_id, "compact=" + str(compact_jumps),
+                                       "", [sequencer_id], reference, silent=True)
+        calls.append(fetch_calls(parameter_set, db_conn, caller_run_id))
+        if compact_jumps:
+            assert jump_table.num_jumps(jump_run_id) < jump_table.num_jumps_of_reads(jump_run_id)
+
+    print("calls without compaction:", len(calls[0]), "with compaction:", len(calls[1]))
+    assert len(calls[0]) > 0
+    assert calls[0] == calls[1]
+
+    # reads of the first jump of each merged jump are in the sv_jump_table, the others in the sv_jump_read_table
+    used_read_names = set(read.name for read in ReadTable(db_conn).get_used_reads())
+    print("used reads:", len(used_read_names), "of", num_reads)
+    assert len(used_read_names) > 0
+    for idx in range(0, num_reads, 3):
+        # all three copies of a read have the same jumps
+        copies = set("read" + str(idx + i) for i in range(3))
+        assert len(copies & used_read_names) in [0, 3]
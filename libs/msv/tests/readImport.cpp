@@ -0,0 +1,156 @@
+#define EXIT_SUCCESS 0
+#define EXIT_FAILURE 1
+
+#include "msv/container/sv_db/query_objects/readImporter.h"
+#include "util/system.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+using namespace libMA;
+using namespace libMSV;
+
+/*
+ * Runs the parsing workers of the read import (importReadsWorker) without a database:
+ * - all reads of a single file arrive exactly once and decompress to their original sequence, regardless of the number
+ *   of workers
+ * - paired reads stay paired
+ * Reports the duration with one and with several workers on a single file. Since the workers release the stream before
+ * compressing a batch, several workers speed up the import of a single file.
+ */
+
+const size_t uiNumReads = 50000;
+
+std::string randomSequence( size_t uiLen )
+{
+    std::string sRet;
+    sRet.reserve( uiLen );
+    for( size_t uiI = 0; uiI < uiLen; uiI++ )
+        sRet.push_back( "ACGT"[ std::rand( ) % 4 ] );
+    return sRet;
+} // function
+
+void writeFasta( const std::string& sFileName, const std::vector<std::string>& vSequences )
+{
+    std::ofstream xOut( sFileName );
+    for( size_t uiI = 0; uiI < vSequences.size( ); uiI++ )
+        xOut << ">read" << uiI << "\n" << vSequences[ uiI ] << "\n";
+} // function
+
+std::shared_ptr<FileStreamQueue> fileQueue( const std::string& sFileName )
+{
+    auto pInitVec = std::make_shared<ContainerVector<std::shared_ptr<FileStream>>>( );
+    pInitVec->push_back( std::make_shared<FileStreamFromPath>( sFileName ) );
+    return std::make_shared<FileStreamQueue>( pInitVec );
+} // function
+
+/// @brief runs uiNumWorkers workers on pStreams and collects all batches (on the calling thread, like the DB writer)
+template <typename ReaderType, typename StreamType>
+std::vector<std::unique_ptr<ImportBatch>> runWorkers( std::shared_ptr<CyclicQueue<StreamType>> pStreams,
+                                                      size_t uiNumWorkers, double& rdSeconds )
+{
+    ParameterSetManager xParameters;
+    // compare the mates with the file as they are
+    xParameters.getSelected( )->xRevCompPairedReadMates->set( false );
+    auto pCounter = std::make_shared<HashCounter>( ); // too large for the stack
+    ImportBatchQueue xBatches( 4 * uiNumWorkers, uiNumWorkers );
+    std::vector<std::unique_ptr<ImportBatch>> vRet;
+    rdSeconds = metaMeasureDuration( [ & ]( ) {
+                    ThreadPool xWorkers( uiNumWorkers );
+                    std::vector<std::future<void>> vFutures;
+                    for( size_t uiI = 0; uiI < uiNumWorkers; uiI++ )
+                        vFutures.push_back( xWorkers.enqueue( [ & ]( size_t ) {
+                            importReadsWorker<ReaderType>( xParameters, *pStreams, xBatches, *pCounter );
+                            xBatches.producerFinished( );
+                        } ) );
+                    while( auto pBatch = xBatches.pop( ) )
+                        vRet.push_back( std::move( pBatch ) );
+                    for( auto& xFuture : vFutures )
+                        xFuture.get( );
+                } )
+                    .count( );
+    return vRet;
+} // function
+
+/// @brief true if rReads contains each sequence of rvExpected exactly once (under its name)
+bool checkReads( const std::vector<std::pair<std::string, std::shared_ptr<CompressedNucSeq>>>& rReads,
+                 const std::vector<std::string>& rvExpected )
+{
+    if( rReads.size( ) != rvExpected.size( ) )
+    {
+        std::cerr << "expected " << rvExpected.size( ) << " reads; got " << rReads.size( ) << std::endl;
+        return false;
+    } // if
+    std::vector<bool> vSeen( rvExpected.size( ), false );
+    for( auto& rRead : rReads )
+    {
+        size_t uiId = std::stoull( rRead.first.substr( 4 ) );
+        NucSeq xDecompressed;
+        rRead.second->decompress( xDecompressed );
+        if( uiId >= rvExpected.size( ) || vSeen[ uiId ] || xDecompressed.toString( ) != rvExpected[ uiId ] )
+        {
+            std::cerr << "read " << rRead.first << " is duplicated or differs from the file" << std::endl;
+            return false;
+        } // if
+        vSeen[ uiId ] = true;
+    } // for
+    return true;
+} // function
+
+int main( void )
+{
+    std::vector<std::string> vReads, vMates;
+    for( size_t uiI = 0; uiI < uiNumReads; uiI++ )
+    {
+        vReads.push_back( randomSequence( 100 + std::rand( ) % 200 ) );
+        vMates.push_back( randomSequence( 100 + std::rand( ) % 200 ) );
+    } // for
+    const std::string sReadFile = "read_import_test_reads.fasta";
+    const std::string sMateFile = "read_import_test_mates.fasta";
+    writeFasta( sReadFile, vReads );
+    writeFasta( sMateFile, vMates );
+
+    const size_t uiNumWorkers = std::max( 2u, std::thread::hardware_concurrency( ) );
+    for( size_t uiNumThreads : { (size_t)1, uiNumWorkers } )
+    {
+        double dSeconds;
+        auto vBatches = runWorkers<FileReader>( fileQueue( sReadFile ), uiNumThreads, dSeconds );
+        std::vector<std::pair<std::string, std::shared_ptr<CompressedNucSeq>>> vAll;
+        for( auto& pBatch : vBatches )
+            vAll.insert( vAll.end( ), pBatch->vReads.begin( ), pBatch->vReads.end( ) );
+        if( !checkReads( vAll, vReads ) )
+            return EXIT_FAILURE;
+        std::cout << uiNumReads << " reads of one file with " << uiNumThreads << " worker(s): " << dSeconds << " sec"
+                  << std::endl;
+    } // for
+
+    double dSeconds;
+    auto vBatches = runWorkers<PairedFileReader>(
+        combineFileStreams( fileQueue( sReadFile ), fileQueue( sMateFile ) ), uiNumWorkers, dSeconds );
+    std::vector<std::pair<std::string, std::shared_ptr<CompressedNucSeq>>> vAllReads, vAllMates;
+    for( auto& pBatch : vBatches )
+    {
+        if( pBatch->vReads.size( ) != pBatch->vMates.size( ) )
+        {
+            std::cerr << "batch with unpaired reads" << std::endl;
+            return EXIT_FAILURE;
+        } // if
+        for( size_t uiI = 0; uiI < pBatch->vReads.size( ); uiI++ )
+            if( pBatch->vReads[ uiI ].first != pBatch->vMates[ uiI ].first )
+            {
+                std::cerr << "mates are mixed up: " << pBatch->vReads[ uiI ].first << " "
+                          << pBatch->vMates[ uiI ].first << std::endl;
+                return EXIT_FAILURE;
+            } // if
+        vAllReads.insert( vAllReads.end( ), pBatch->vReads.begin( ), pBatch->vReads.end( ) );
+        vAllMates.insert( vAllMates.end( ), pBatch->vMates.begin( ), pBatch->vMates.end( ) );
+    } // for
+    if( !checkReads( vAllReads, vReads ) || !checkReads( vAllMates, vMates ) )
+        return EXIT_FAILURE;
+    std::cout << uiNumReads << " pairs with " << uiNumWorkers << " workers: " << dSeconds << " sec" << std::endl;
+
+    std::remove( sReadFile.c_str( ) );
+    std::remove( sMateFile.c_str( ) );
+    return EXIT_SUCCESS;
+} /// main function
@@ -0,0 +1,118 @@
+#define EXIT_SUCCESS 0
+#define EXIT_FAILURE 1
+
+#include "ma/module/hashMapSeeding.h"
+#include "ma/module/seedFilters.h"
+#include "msv/util/statisticSequenceAnalysis.h"
+#include "util/system.h"
+#include <iostream>
+#include <set>
+
+using namespace libMA;
+using namespace libMSV;
+
+/*
+ * Checks sampleKMerSize and sampleSequenceAmbiguity (suffix array based) against their former implementations
+ * (sets of k-mer strings; lumped HashMapSeeding k-mers) and reports the runtime of both.
+ */
+
+std::shared_ptr<NucSeq> randomNucSeq( size_t uiLen )
+{
+    auto pRet = std::make_shared<NucSeq>( );
+    pRet->vReserveMemory( uiLen );
+    for( size_t i = 0; i < uiLen; i++ )
+        pRet->push_back( ( uint8_t )( std::rand( ) % 4 ) );
+    return pRet;
+} // function
+
+/// @brief a sequence made of mutated copies of a short unit (like a tandem repeat) with some N stretches
+std::shared_ptr<NucSeq> repetitiveNucSeq( size_t uiLen )
+{
+    auto pUnit = randomNucSeq( 5 + std::rand( ) % 40 );
+    auto pRet = std::make_shared<NucSeq>( );
+    pRet->vReserveMemory( uiLen );
+    for( size_t i = 0; i < uiLen; i++ )
+        pRet->push_back( std::rand( ) % 100 == 0 ? 4 : std::rand( ) % 20 == 0 ? std::rand( ) % 4
+                                                                              : ( *pUnit )[ i % pUnit->length( ) ] );
+    return pRet;
+} // function
+
+/// @brief the former implementation of sampleKMerSize
+nucSeqIndex sampleKMerSizeSet( NucSeq& rSequenceA, NucSeq& rSequenceB, double t )
+{
+    geom::Rectangle<nucSeqIndex> xRect( 0, 0, rSequenceA.length( ) + rSequenceB.length( ),
+                                        rSequenceA.length( ) + rSequenceB.length( ) );
+    nucSeqIndex uiStaticsticalSize = getKMerSizeForRectangle( xRect, t );
+    nucSeqIndex uiSeedSize = uiStaticsticalSize;
+    for( ; uiSeedSize < rSequenceA.length( ) || uiSeedSize < rSequenceB.length( ); uiSeedSize++ )
+    {
+        std::set<std::string> xKMerSet;
+        bool bAllUnique = true;
+        for( NucSeq* pSequence : {&rSequenceA, &rSequenceB} )
+            for( nucSeqIndex uiPos = 0; uiPos + uiSeedSize <= pSequence->length( ); uiPos++ )
+                if( !xKMerSet.insert( pSequence->fromTo( uiPos, uiPos + uiSeedSize ) ).second )
+                    bAllUnique = false;
+        if( bAllUnique )
+            break;
+    } // for
+    return uiSeedSize - uiStaticsticalSize;
+} // function
+
+/// @brief the former implementation of sampleSequenceAmbiguity
+nucSeqIndex sampleSequenceAmbiguityLumping( NucSeq& rSequenceA, NucSeq& rSequenceB, double t )
+{
+    HashMapSeeding xSeeder;
+    geom::Rectangle<nucSeqIndex> xRect( 0, 0, rSequenceA.length( ) + rSequenceB.length( ),
+                                        rSequenceA.length( ) + rSequenceB.length( ) );
+    xSeeder.uiSeedSize = getKMerSizeForRectangle( xRect, t );
+    auto pLumped = SeedLumping( ).execute( xSeeder.execute( rSequenceA, rSequenceB ), rSequenceA, rSequenceB );
+    nucSeqIndex uiSum = 0;
+    for( auto& rSeed : *pLumped )
+        uiSum += rSeed.size( );
+    return uiSum;
+} // function
+
+int main( void )
+{
+    std::srand( 42 );
+    double dOld = 0, dNew = 0;
+    for( size_t uiI = 0; uiI < 200; uiI++ )
+    {
+        // windows of up to 500nt (like the regions compared by ComputeCallAmbiguity and SvJumpsFromSeeds)
+        size_t uiLenA = uiI % 50 == 0 ? 0 : std::rand( ) % 500;
+        size_t uiLenB = uiI % 40 == 0 ? 0 : std::rand( ) % 500;
+        auto pA = uiI % 2 == 0 ? randomNucSeq( uiLenA ) : repetitiveNucSeq( uiLenA );
+        auto pB = uiI % 3 == 0 ? randomNucSeq( uiLenB ) : repetitiveNucSeq( uiLenB );
+        if( uiI % 5 == 0 )
+        {
+            // a sequence and its reverse complement (like svJumpsFromSeeds)
+            pB = std::make_shared<NucSeq>( *pA );
+            pB->vReverseAll( );
+            pB->vSwitchAllBasePairsToComplement( );
+        } // if
+        if( uiI % 7 == 0 )
+            pB = pA;
+        for( double t : {0.001, 0.1} )
+        {
+            nucSeqIndex uiOldK = 0, uiNewK = 0, uiOldAmb = 0, uiNewAmb = 0;
+            dOld += metaMeasureDuration( [ & ]( ) {
+                        uiOldK = sampleKMerSizeSet( *pA, *pB, t );
+                        uiOldAmb = sampleSequenceAmbiguityLumping( *pA, *pB, t );
+                    } ).count( );
+            dNew += metaMeasureDuration( [ & ]( ) {
+                        uiNewK = sampleKMerSize( *pA, *pB, t );
+                        uiNewAmb = sampleSequenceAmbiguity( *pA, *pB, t );
+                    } ).count( );
+            if( uiOldK != uiNewK || uiOldAmb != uiNewAmb )
+            {
+                std::cerr << "pair " << uiI << " (" << uiLenA << ", " << pB->length( ) << ") t=" << t
+                          << ": k-mer size " << uiOldK << " vs " << uiNewK << "; ambiguity " << uiOldAmb << " vs "
+                          << uiNewAmb << std::endl;
+                return EXIT_FAILURE;
+            } // if
+        } // for
+    } // for
+    std::cout << "k-mer sets & lumping: " << dOld * 1000 << " ms; suffix array: " << dNew * 1000 << " ms"
+              << std::endl;
+    return EXIT_SUCCESS;
+} /// main function
@@ -0,0 +1,79 @@
+/**
+ * @file indexMemory.h
+ * @brief Implements IndexMemory and IndexAllocator.
+ */
+#pragma once
+
+#include "util/exported.h"
+
+/// @cond DOXYGEN_SHOW_SYSTEM_INCLUDES
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+/// @endcond
+
+/**
+ * @brief Placement of the large arrays of the indices (BWT, suffix array, packed sequence).
+ * @details
+ * The indices are accessed randomly, so with 4kb pages nearly every access is a TLB miss, and on multi-socket
+ * machines most accesses go to the memory of a remote node if all pages were placed on the node of the loading
+ * thread. If enabled:
+ * - bHugePages: the arrays are backed by transparent huge pages (madvise MADV_HUGEPAGE; 2MB aligned)
+ * - bInterleave: the pages of the arrays are interleaved over all NUMA nodes (mbind MPOL_INTERLEAVE), so that all
+ *   worker threads see the same average latency regardless of the node they run on.
+ * Both are hints: if the OS does not support them, the memory is used as is.
+ * The policy applies to arrays allocated after it was set, so it must be set before the index is loaded.
+ * Arrays smaller than uiMinBytes are always allocated normally.
+ */
+class DLL_PORT( util ) IndexMemory
+{
+  public:
+    static bool bHugePages;
+    static bool bInterleave;
+    static const size_t uiMinBytes = 1 << 21;
+    static const size_t uiHugePageSize = 1 << 21;
+
+    /// @brief allocates uiBytes with the current policy
+    static void* allocate( size_t uiBytes );
+    /// @brief frees memory returned by allocate (regardless of the policy at the time of allocation)
+    static void deallocate( void* p );
+}; // class
+
+/**
+ * @brief std allocator that places its memory according to IndexMemory
+ */
+template <typename T> class IndexAllocator
+{
+  public:
+    typedef T value_type;
+
+    IndexAllocator( ) noexcept
+    {} // constructor
+
+    template <typename U> IndexAllocator( const IndexAllocator<U>& ) noexcept
+    {} // constructor
+
+    T* allocate( size_t uiN )
+    {
+        return static_cast<T*>( IndexMemory::allocate( uiN * sizeof( T ) ) );
+    } // method
+
+    void deallocate( T* p, size_t )
+    {
+        IndexMemory::deallocate( p );
+    } // method
+
+    template <typename U> bool operator==( const IndexAllocator<U>& ) const noexcept
+    {
+        return true;
+    } // operator
+
+    template <typename U> bool operator!=( const IndexAllocator<U>& ) const noexcept
+    {
+        return false;
+    } // operator
+}; // class
+
+/// @brief vector for the large arrays of the indices (see IndexMemory)
+template <typename T> using IndexVector = std::vector<T, IndexAllocator<T>>;
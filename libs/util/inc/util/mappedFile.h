@@ -0,0 +1,47 @@
+/**
+ * @file mappedFile.h
+ * @brief Implements MappedFile.
+ */
+#pragma once
+
+#include "util/exported.h"
+
+/// @cond DOXYGEN_SHOW_SYSTEM_INCLUDES
+#include <cstddef>
+#include <cstdint>
+#include <string>
+/// @endcond
+
+/**
+ * @brief A file that is mapped read-only into memory.
+ * @details
+ * The mapping is shared: all processes that map the same file use the same physical pages (the page cache of the
+ * OS). So, several processes on one node that load the same index hold it only once in memory; the OS keeps track of
+ * the references. The content is paged in on first access, so mapping does not read the file upfront.
+ * Throws a std::runtime_error if the file cannot be mapped (or if mapping is not supported on the platform).
+ */
+class DLL_PORT( util ) MappedFile
+{
+    const uint8_t* pData;
+    size_t uiSize;
+
+  public:
+    MappedFile( const std::string& rsFileName );
+
+    MappedFile( const MappedFile& ) = delete;
+    MappedFile& operator=( const MappedFile& ) = delete;
+
+    ~MappedFile( );
+
+    /// @brief first byte of the file
+    inline const uint8_t* data( ) const
+    {
+        return pData;
+    } // method
+
+    /// @brief size of the file in bytes
+    inline size_t size( ) const
+    {
+        return uiSize;
+    } // method
+}; // class
@@ -0,0 +1,205 @@
+/**
+ * @file radixSort.h
+ * @brief Implements a LSD radix sort on 64 bit keys, that works on a compact key/index array.
+ */
+#pragma once
+
+#include "util/debug.h"
+
+/// @cond DOXYGEN_SHOW_SYSTEM_INCLUDES
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+/// @endcond
+
+/**
+ * @brief Ranges with fewer elements than this are sorted via std::sort instead of radix sort.
+ * @details
+ * For small ranges the histogram and permutation overhead of the radix sort is larger than the comparison sort.
+ */
+#define RADIX_SORT_MIN_SIZE ( 512 )
+
+/**
+ * @brief Sorts on several keys with more elements than this are done via std::sort instead of radix sort.
+ * @details
+ * Each key requires its own radix passes. Measured with the MA-radix_sort test (two keys, seeds of a human sized
+ * genome), the radix sort wins up to about 10k-20k elements and loses beyond (e.g. 100k: 15.3 ms std::sort vs
+ * 17.2 ms radix::sort).
+ */
+#define RADIX_SORT_MAX_SIZE_MULTI_KEY ( 16384 )
+
+/**
+ * @brief Thread local scratch buffers with a larger capacity (in elements) are released after the sort.
+ * @details
+ * Keeps the buffers of the common sizes around, while a single huge sort does not pin its memory for the lifetime of
+ * the thread.
+ */
+#define RADIX_SORT_MAX_KEEP_SIZE ( 1 << 20 )
+
+namespace radix
+{
+/// @brief element of the key/index array that is radix sorted instead of the actual elements
+typedef std::pair<uint64_t, uint32_t> KeyIndex;
+
+/// @brief distance (in elements) of the prefetch during the final permutation
+#define RADIX_SORT_PREFETCH_DIST ( 8 )
+
+/// @brief number of bits per radix digit
+#define RADIX_SORT_DIGIT_BITS ( 8 )
+/// @brief number of digits required to cover a 64 bit key
+#define RADIX_SORT_NUM_DIGITS ( ( 64 + RADIX_SORT_DIGIT_BITS - 1 ) / RADIX_SORT_DIGIT_BITS )
+
+/**
+ * @brief stable LSD radix sort of a key/index array.
+ * @details
+ * Uses 8 bit digits, so that the histograms of all digits fit into the L1 cache (8 * 256 * 4 bytes = 8kb).
+ * The histograms of all digits are computed in a single pass over the keys.
+ * Digits where all keys share the same value are skipped; (e.g. for seed positions on a human genome only 5 of the 8
+ * passes are actually performed).
+ * rvBuffer is used as scratch memory and is resized if necessary.
+ */
+inline void sortKeyIndex( std::vector<KeyIndex>& rvKeys, std::vector<KeyIndex>& rvBuffer )
+{
+    const uint64_t uiMask = ( 1 << RADIX_SORT_DIGIT_BITS ) - 1;
+    const size_t uiN = rvKeys.size( );
+    rvBuffer.resize( uiN );
+    std::array<std::array<uint32_t, 1 << RADIX_SORT_DIGIT_BITS>, RADIX_SORT_NUM_DIGITS> vHistograms{};
+    for( const KeyIndex& rKey : rvKeys )
+        for( size_t uiDigit = 0; uiDigit < RADIX_SORT_NUM_DIGITS; uiDigit++ )
+            vHistograms[ uiDigit ][ ( rKey.first >> ( uiDigit * RADIX_SORT_DIGIT_BITS ) ) & uiMask ]++;
+
+    for( size_t uiDigit = 0; uiDigit < RADIX_SORT_NUM_DIGITS; uiDigit++ )
+    {
+        const size_t uiShift = uiDigit * RADIX_SORT_DIGIT_BITS;
+        auto& rHistogram = vHistograms[ uiDigit ];
+        // skip digits that are equal for all keys
+        if( rHistogram[ ( rvKeys.front( ).first >> uiShift ) & uiMask ] == uiN )
+            continue;
+        // turn histogram into bucket offsets
+        uint32_t uiSum = 0;
+        for( uint32_t& rCount : rHistogram )
+        {
+            uint32_t uiCount = rCount;
+            rCount = uiSum;
+            uiSum += uiCount;
+        } // for
+        for( const KeyIndex& rKey : rvKeys )
+            rvBuffer[ rHistogram[ ( rKey.first >> uiShift ) & uiMask ]++ ] = rKey;
+        rvKeys.swap( rvBuffer );
+    } // for
+} // function
+
+/// @brief lexicographic comparison via the key functors (recursion anchor)
+template <typename TP_VAL> inline bool lexicographicLess( const TP_VAL&, const TP_VAL& )
+{
+    return false;
+} // function
+
+/// @brief lexicographic comparison via the key functors
+template <typename TP_VAL, typename TP_KEY, typename... TP_KEYS>
+inline bool lexicographicLess( const TP_VAL& rA, const TP_VAL& rB, TP_KEY& fKey, TP_KEYS&... fKeys )
+{
+    const uint64_t uiA = fKey( rA );
+    const uint64_t uiB = fKey( rB );
+    if( uiA != uiB )
+        return uiA < uiB;
+    return lexicographicLess( rA, rB, fKeys... );
+} // function
+
+/// @brief frees a thread local scratch buffer if it exceeds RADIX_SORT_MAX_KEEP_SIZE elements
+template <typename TP_VEC> inline void releaseIfLarge( TP_VEC& rvBuffer )
+{
+    if( rvBuffer.capacity( ) > RADIX_SORT_MAX_KEEP_SIZE )
+        TP_VEC( ).swap( rvBuffer );
+} // function
+
+/// @brief performs the radix passes (recursion anchor)
+template <typename TP_IT> inline void keyPasses( TP_IT, std::vector<KeyIndex>&, std::vector<KeyIndex>& )
+{} // function
+
+/**
+ * @brief performs the radix passes for all keys
+ * @details
+ * LSD order: the less significant keys are sorted first; stability maintains their order for ties of fKey.
+ */
+template <typename TP_IT, typename TP_KEY, typename... TP_KEYS>
+inline void keyPasses( TP_IT xBegin, std::vector<KeyIndex>& rvKeys, std::vector<KeyIndex>& rvBuffer, TP_KEY& fKey,
+                       TP_KEYS&... fKeys )
+{
+    keyPasses( xBegin, rvKeys, rvBuffer, fKeys... );
+    if( sizeof...( TP_KEYS ) == 0 )
+        // first pass: the key/index array is still in the order of the elements
+        for( KeyIndex& rKey : rvKeys )
+            rKey.first = fKey( xBegin[ rKey.second ] );
+    else
+    {
+        // extract the keys in order of the elements, so that the elements are read sequentially
+        thread_local std::vector<uint64_t> vKeyCache;
+        vKeyCache.resize( rvKeys.size( ) );
+        for( size_t uiI = 0; uiI < vKeyCache.size( ); uiI++ )
+            vKeyCache[ uiI ] = fKey( xBegin[ uiI ] );
+        for( KeyIndex& rKey : rvKeys )
+            rKey.first = vKeyCache[ rKey.second ];
+        releaseIfLarge( vKeyCache );
+    } // else
+    sortKeyIndex( rvKeys, rvBuffer );
+} // function
+
+/**
+ * @brief radix sort of the range [xBegin, xEnd) according to one or more 64 bit keys.
+ * @details
+ * The keys are given as functors that map an element to a uint64_t; the most significant key comes first.
+ * For descending order on a key, return the bitwise negation of the key value.
+ * Instead of moving the (potentially large) elements during each pass, a compact key/index array is sorted and the
+ * elements are permuted exactly once at the end.
+ * Small ranges and large ranges with several keys (see RADIX_SORT_MAX_SIZE_MULTI_KEY) are sorted with std::sort
+ * using the equivalent lexicographic comparison.
+ * @note Elements with equal keys keep their input order only if the range is radix sorted.
+ */
+template <typename TP_IT, typename... TP_KEYS> void sort( TP_IT xBegin, TP_IT xEnd, TP_KEYS... fKeys )
+{
+    typedef typename std::iterator_traits<TP_IT>::value_type TP_VAL;
+    const size_t uiN = std::distance( xBegin, xEnd );
+    if( uiN < 2 )
+        return;
+
+    if( uiN < RADIX_SORT_MIN_SIZE || uiN > UINT32_MAX ||
+        ( sizeof...( TP_KEYS ) > 1 && uiN > RADIX_SORT_MAX_SIZE_MULTI_KEY ) )
+    {
+        std::sort( xBegin, xEnd,
+                   [ & ]( const TP_VAL& rA, const TP_VAL& rB ) { return lexicographicLess( rA, rB, fKeys... ); } );
+        return;
+    } // if
+
+    // the scratch memory is kept per thread, so that repeated sorts do neither allocate nor page fault
+    thread_local std::vector<KeyIndex> vKeys;
+    thread_local std::vector<KeyIndex> vBuffer;
+    vKeys.resize( uiN );
+    for( uint32_t uiI = 0; uiI < uiN; uiI++ )
+        vKeys[ uiI ].second = uiI;
+
+    keyPasses( xBegin, vKeys, vBuffer, fKeys... );
+
+    // permute the elements once
+    // the elements are accessed randomly here, so we prefetch the upcoming ones
+    thread_local std::vector<TP_VAL> vSorted;
+    vSorted.reserve( uiN );
+    for( size_t uiI = 0; uiI < uiN; uiI++ )
+    {
+#ifdef __GNUC__
+        if( uiI + RADIX_SORT_PREFETCH_DIST < uiN )
+            __builtin_prefetch( &xBegin[ vKeys[ uiI + RADIX_SORT_PREFETCH_DIST ].second ] );
+#endif
+        vSorted.push_back( std::move( xBegin[ vKeys[ uiI ].second ] ) );
+    } // for
+    std::move( vSorted.begin( ), vSorted.end( ), xBegin );
+    vSorted.clear( );
+    releaseIfLarge( vKeys );
+    releaseIfLarge( vBuffer );
+    releaseIfLarge( vSorted );
+} // function
+
+} // namespace radix
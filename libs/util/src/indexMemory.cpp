@@ -0,0 +1,122 @@
+/**
+ * @file indexMemory.cpp
+ */
+#include "util/indexMemory.h"
+
+/// @cond DOXYGEN_SHOW_SYSTEM_INCLUDES
+#include <fstream>
+#include <string>
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+/// @endcond
+
+bool IndexMemory::bHugePages = false;
+bool IndexMemory::bInterleave = false;
+
+/* Each allocation is preceded by a header, so that deallocate knows how the memory was obtained.
+ * The header size keeps the alignment of operator new for the returned pointer.
+ */
+struct IndexMemoryHeader
+{
+    void* pMapping; // nullptr if the memory was obtained via operator new
+    size_t uiMappingSize;
+}; // struct
+static const size_t uiIndexMemoryHeaderSize = 64;
+
+#ifdef __linux__
+/* Reads the online NUMA nodes (e.g. "0-1,4") into a node mask.
+ * Returns the number of nodes.
+ */
+static size_t onlineNumaNodes( unsigned long* pMask, size_t uiMaskBits )
+{
+    std::ifstream xFile( "/sys/devices/system/node/online" );
+    std::string sRanges;
+    if( !( xFile >> sRanges ) )
+        return 0;
+    size_t uiNumNodes = 0;
+    size_t uiPos = 0;
+    while( uiPos < sRanges.size( ) )
+    {
+        size_t uiEnd = sRanges.find( ',', uiPos );
+        if( uiEnd == std::string::npos )
+            uiEnd = sRanges.size( );
+        const std::string sRange = sRanges.substr( uiPos, uiEnd - uiPos );
+        const size_t uiDash = sRange.find( '-' );
+        const size_t uiFirst = std::stoul( sRange.substr( 0, uiDash ) );
+        const size_t uiLast = uiDash == std::string::npos ? uiFirst : std::stoul( sRange.substr( uiDash + 1 ) );
+        for( size_t uiNode = uiFirst; uiNode <= uiLast && uiNode < uiMaskBits; uiNode++ )
+        {
+            pMask[ uiNode / ( 8 * sizeof( unsigned long ) ) ] |= 1UL << ( uiNode % ( 8 * sizeof( unsigned long ) ) );
+            uiNumNodes++;
+        } // for
+        uiPos = uiEnd + 1;
+    } // while
+    return uiNumNodes;
+} // function
+#endif
+
+void* IndexMemory::allocate( size_t uiBytes )
+{
+    const size_t uiTotal = uiBytes + uiIndexMemoryHeaderSize;
+#ifdef __linux__
+    if( ( bHugePages || bInterleave ) && uiBytes >= uiMinBytes )
+    {
+        // over allocate by one huge page, so that the used part can be aligned to huge pages
+        const size_t uiMappingSize = ( ( uiTotal + uiHugePageSize - 1 ) / uiHugePageSize ) * uiHugePageSize;
+        void* pRaw = mmap( nullptr, uiMappingSize + uiHugePageSize, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+        if( pRaw == MAP_FAILED )
+            throw std::bad_alloc( );
+        uint8_t* pMapping = (uint8_t*)( ( ( (uintptr_t)pRaw + uiHugePageSize - 1 ) / uiHugePageSize ) * uiHugePageSize );
+        // return the unaligned head and the unused tail
+        if( pMapping > (uint8_t*)pRaw )
+            munmap( pRaw, pMapping - (uint8_t*)pRaw );
+        if( (uint8_t*)pRaw + uiMappingSize + uiHugePageSize > pMapping + uiMappingSize )
+            munmap( pMapping + uiMappingSize, (uint8_t*)pRaw + uiHugePageSize - pMapping );
+
+        // both are hints only: we ignore failures (e.g. kernels without THP or without NUMA)
+#ifdef MADV_HUGEPAGE
+        if( bHugePages )
+            madvise( pMapping, uiMappingSize, MADV_HUGEPAGE );
+#endif
+#ifdef SYS_mbind
+        if( bInterleave )
+        {
+            unsigned long aNodes[ 16 ] = { 0 };
+            const size_t uiMaskBits = sizeof( aNodes ) * 8;
+            const int iMpolInterleave = 3; // MPOL_INTERLEAVE of numaif.h
+            // the pages are not touched yet, so the policy applies to all of them
+            if( onlineNumaNodes( aNodes, uiMaskBits ) > 1 )
+                syscall( SYS_mbind, pMapping, uiMappingSize, iMpolInterleave, aNodes, uiMaskBits + 1, 0 );
+        } // if
+#endif
+        auto pHeader = (IndexMemoryHeader*)pMapping;
+        pHeader->pMapping = pMapping;
+        pHeader->uiMappingSize = uiMappingSize;
+        return pMapping + uiIndexMemoryHeaderSize;
+    } // if
+#endif
+    auto pAllocated = (uint8_t*)::operator new( uiTotal );
+    auto pHeader = (IndexMemoryHeader*)pAllocated;
+    pHeader->pMapping = nullptr;
+    pHeader->uiMappingSize = 0;
+    return pAllocated + uiIndexMemoryHeaderSize;
+} // method
+
+void IndexMemory::deallocate( void* p )
+{
+    if( p == nullptr )
+        return;
+    auto pHeader = (IndexMemoryHeader*)( (uint8_t*)p - uiIndexMemoryHeaderSize );
+#ifdef __linux__
+    if( pHeader->pMapping != nullptr )
+    {
+        munmap( pHeader->pMapping, pHeader->uiMappingSize );
+        return;
+    } // if
+#endif
+    ::operator delete( pHeader );
+} // method
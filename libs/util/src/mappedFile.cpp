@@ -0,0 +1,64 @@
+/**
+ * @file mappedFile.cpp
+ */
+#include "util/mappedFile.h"
+
+/// @cond DOXYGEN_SHOW_SYSTEM_INCLUDES
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#ifndef _MSC_VER
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+/// @endcond
+
+#ifndef _MSC_VER
+
+MappedFile::MappedFile( const std::string& rsFileName ) : pData( nullptr ), uiSize( 0 )
+{
+    int iFd = open( rsFileName.c_str( ), O_RDONLY );
+    if( iFd == -1 )
+        throw std::runtime_error( "Could not open " + rsFileName + " for mapping: " + std::strerror( errno ) );
+    struct stat xStat;
+    if( fstat( iFd, &xStat ) == -1 )
+    {
+        int iErrno = errno;
+        close( iFd );
+        throw std::runtime_error( "Could not stat " + rsFileName + ": " + std::strerror( iErrno ) );
+    } // if
+    uiSize = (size_t)xStat.st_size;
+    if( uiSize > 0 ) // mmap rejects empty mappings
+    {
+        void* pMapped = mmap( nullptr, uiSize, PROT_READ, MAP_SHARED, iFd, 0 );
+        if( pMapped == MAP_FAILED )
+        {
+            int iErrno = errno;
+            close( iFd );
+            throw std::runtime_error( "Could not map " + rsFileName + ": " + std::strerror( iErrno ) );
+        } // if
+        pData = (const uint8_t*)pMapped;
+    } // if
+    // the mapping stays valid after closing the file descriptor
+    close( iFd );
+} // constructor
+
+MappedFile::~MappedFile( )
+{
+    if( pData != nullptr )
+        munmap( (void*)pData, uiSize );
+} // destructor
+
+#else
+
+MappedFile::MappedFile( const std::string& rsFileName ) : pData( nullptr ), uiSize( 0 )
+{
+    throw std::runtime_error( "Mapping files into memory is not supported on this platform (" + rsFileName + ")." );
+} // constructor
+
+MappedFile::~MappedFile( )
+{} // destructor
+
+#endif